@@ -34,6 +34,10 @@ VERSION = 1.0.0
 # deprecated API in order to know how to port your code away from it.
 DEFINES += QT_DEPRECATED_WARNINGS QCUSTOMPLOT_USE_LIBRARY
 
+# Lowest log level compiled into the LOG_* macros (0 = Debug ... 4 = Critical);
+# Debug logging is stripped from release builds
+CONFIG(release, debug|release): DEFINES += HORIZON_LOG_MIN_LEVEL=1
+
 # You can also make your code fail to compile if it uses deprecated APIs.
 # In order to do so, uncomment the following line.
 # You can also select to disable deprecated APIs only up to a certain version of Qt.
@@ -78,18 +82,36 @@ SOURCES += \
     src/domain/entities/Test.cpp \
     src/domain/entities/Sample.cpp \
     src/domain/entities/TestMethod.cpp \
+    src/domain/value_objects/Curve.cpp \
     # Domain - Services
+    src/domain/services/BreakCapture.cpp \
+    src/domain/services/BreakDetector.cpp \
+    src/domain/services/RecordingPolicy.cpp \
+    src/domain/services/SignalFilter.cpp \
+    src/domain/services/StrainIndex.cpp \
     src/domain/services/StressStrainCalculator.cpp \
     src/domain/services/TestMethodValidator.cpp \
     # Infrastructure - Hardware
     src/infrastructure/hardware/MockUTMDriver.cpp \
+    src/infrastructure/hardware/MaterialSimulator.cpp \
+    src/infrastructure/hardware/ReplayUTMDriver.cpp \
+    src/infrastructure/hardware/SimulationClock.cpp \
     # Infrastructure - Persistence
     src/infrastructure/persistence/DatabaseManager.cpp \
     src/infrastructure/persistence/SQLiteTestRepository.cpp \
+    src/infrastructure/persistence/CurveCache.cpp \
+    src/infrastructure/persistence/CurveSpillFile.cpp \
     # Infrastructure - Export
     src/infrastructure/export/CSVExportService.cpp \
+    src/infrastructure/export/ParallelExportPipeline.cpp \
+    src/infrastructure/export/BinaryCurveFormat.cpp \
+    src/infrastructure/export/BinaryExportService.cpp \
+    src/infrastructure/export/BinaryCurveReader.cpp \
     # Application - Controllers
     src/application/controllers/TestController.cpp \
+    src/application/controllers/TestFinalizer.cpp \
+    src/application/controllers/SampleQueueRunner.cpp \
+    src/application/controllers/FrameManager.cpp \
     src/application/controllers/HardwareController.cpp \
     src/application/controllers/DataExportController.cpp \
     # Presentation - Main Window
@@ -115,11 +137,13 @@ HEADERS += \
     src/third_party/qcustomplot/qcustomplot.h \
     # Core
     src/core/Logger.h \
+    src/core/LogThrottle.h \
     src/core/Config.h \
     src/core/Constants.h \
     # Domain - Interfaces
     src/domain/interfaces/IUTMDriver.h \
     src/domain/interfaces/ITestRepository.h \
+    src/domain/interfaces/ICurveSpillStore.h \
     src/domain/interfaces/IExportService.h \
     # Domain - Entities
     src/domain/entities/Test.h \
@@ -129,18 +153,37 @@ HEADERS += \
     src/domain/value_objects/SensorData.h \
     src/domain/value_objects/TestResult.h \
     src/domain/value_objects/MachineState.h \
+    src/domain/value_objects/Curve.h \
     # Domain - Services
+    src/domain/services/BreakCapture.h \
+    src/domain/services/BreakDetector.h \
+    src/domain/services/RecordingPolicy.h \
+    src/domain/services/SignalFilter.h \
+    src/domain/services/StrainIndex.h \
     src/domain/services/StressStrainCalculator.h \
     src/domain/services/TestMethodValidator.h \
     # Infrastructure - Hardware
     src/infrastructure/hardware/MockUTMDriver.h \
+    src/infrastructure/hardware/FastRandom.h \
+    src/infrastructure/hardware/MaterialSimulator.h \
+    src/infrastructure/hardware/ReplayUTMDriver.h \
+    src/infrastructure/hardware/SimulationClock.h \
     # Infrastructure - Persistence
     src/infrastructure/persistence/DatabaseManager.h \
     src/infrastructure/persistence/SQLiteTestRepository.h \
+    src/infrastructure/persistence/CurveCache.h \
+    src/infrastructure/persistence/CurveSpillFile.h \
     # Infrastructure - Export
     src/infrastructure/export/CSVExportService.h \
+    src/infrastructure/export/ParallelExportPipeline.h \
+    src/infrastructure/export/BinaryCurveFormat.h \
+    src/infrastructure/export/BinaryExportService.h \
+    src/infrastructure/export/BinaryCurveReader.h \
     # Application - Controllers
     src/application/controllers/TestController.h \
+    src/application/controllers/TestFinalizer.h \
+    src/application/controllers/SampleQueueRunner.h \
+    src/application/controllers/FrameManager.h \
     src/application/controllers/HardwareController.h \
     src/application/controllers/DataExportController.h \
     # Application - DTOs
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <QtGlobal>
+
+namespace HorizonUTM {
+namespace Bench {
+
+/**
+ * @brief Process-wide heap allocation counter for benchmarks
+ *
+ * With glibc, malloc/calloc/realloc are interposed, which covers Qt
+ * containers as well as operator new. Elsewhere only the global operator
+ * new is counted, so Qt container allocations are missed.
+ *
+ * Linking this file into an executable replaces the allocator entry points
+ * for the whole process; only do so in benchmark targets.
+ */
+namespace AllocationCounter {
+
+/**
+ * @brief Allocations made so far by all threads
+ */
+quint64 count();
+
+/**
+ * @brief true if Qt container allocations are counted too
+ */
+bool coversMalloc();
+
+} // namespace AllocationCounter
+} // namespace Bench
+} // namespace HorizonUTM
@@ -0,0 +1,28 @@
+#include "BenchLogging.h"
+#include "core/Logger.h"
+#include <QTextStream>
+
+namespace HorizonUTM {
+namespace Bench {
+
+namespace {
+
+bool g_verbose = false;
+
+void benchMessageHandler(QtMsgType type, const QMessageLogContext&, const QString& message) {
+    if (type == QtDebugMsg && !g_verbose) {
+        return;
+    }
+    QTextStream(stderr) << message << "\n";
+}
+
+} // namespace
+
+void initializeBenchLogging(bool verbose) {
+    g_verbose = verbose;
+    qInstallMessageHandler(benchMessageHandler);
+    Logger::initialize(verbose ? LogLevel::Debug : LogLevel::Warning);
+}
+
+} // namespace Bench
+} // namespace HorizonUTM
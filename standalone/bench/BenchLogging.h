@@ -0,0 +1,16 @@
+#pragma once
+
+namespace HorizonUTM {
+namespace Bench {
+
+/**
+ * @brief Set up logging for a benchmark tool
+ *
+ * Logger echoes records to the console through qDebug; unless verbose,
+ * debug output is dropped so it stays out of the timings. Everything else
+ * goes to stderr, keeping stdout for the report.
+ */
+void initializeBenchLogging(bool verbose);
+
+} // namespace Bench
+} // namespace HorizonUTM
@@ -0,0 +1,331 @@
+#include "FleetSimulator.h"
+#include "LatencyRecorder.h"
+#include "domain/services/StressStrainCalculator.h"
+#include "infrastructure/hardware/MaterialSimulator.h"
+#include "infrastructure/persistence/DatabaseManager.h"
+#include "infrastructure/persistence/SQLiteTestRepository.h"
+#include "core/Logger.h"
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QMutex>
+#include <QRandomGenerator>
+#include <QRunnable>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <QThread>
+#include <QThreadPool>
+#include <atomic>
+
+namespace HorizonUTM {
+namespace Bench {
+
+namespace {
+
+const QStringList OPERATORS = {"A. Weber", "M. Rossi", "J. Novak", "K. Tanaka", "S. Larsen"};
+
+/**
+ * @brief Uniform value in [low, high)
+ */
+double uniform(QRandomGenerator& random, double low, double high) {
+    return low + (high - low) * random.generateDouble();
+}
+
+/**
+ * @brief Material scattered around a preset, keeping the curve phases in order
+ */
+MaterialParameters randomizedMaterial(const MaterialParameters& base, QRandomGenerator& random) {
+    MaterialParameters p = base;
+    p.elasticModulus *= uniform(random, 0.85, 1.15);
+    p.yieldStress *= uniform(random, 0.9, 1.1);
+    p.ultimateStress = qMax(p.yieldStress, base.ultimateStress * uniform(random, 0.9, 1.1));
+
+    double strainScale = uniform(random, 0.85, 1.15);
+    p.elasticLimit *= strainScale;
+    p.yieldEnd = qMax(p.elasticLimit * 1.01, p.yieldEnd * strainScale);
+    p.plasticEnd = qMax(p.yieldEnd * 1.01, p.plasticEnd * strainScale * uniform(random, 0.9, 1.1));
+    p.breakStrain = qMax(p.plasticEnd * 1.01, p.breakStrain * strainScale * uniform(random, 0.9, 1.1));
+
+    p.noise = uniform(random, 0.5, 1.5) * base.noise;
+    p.hardeningExponent *= uniform(random, 0.8, 1.2);
+    p.mooneyRivlinRatio *= uniform(random, 0.5, 1.5);
+    return p;
+}
+
+/**
+ * @brief Curve as MockUTMDriver acquires it: sampling grid, constant speed, break
+ */
+Curve simulateCurve(const MaterialParameters& material, const Test& test, int samplingRateHz,
+                    qint64 startMs, FastRandom& random) {
+    constexpr int BATCH_SIZE = 4096;
+
+    MaterialSimulator simulator(material);
+    ConstantSpeedRun run;
+    run.speedMmPerMin = test.getSpeed();
+    run.gaugeLength = test.getGaugeLength();
+    run.crossSection = test.getCrossSectionArea();
+    run.samplingRateHz = samplingRateHz;
+    run.startMs = startMs;
+
+    CurveBuilder builder;
+    QVector<SensorData> samples;
+
+    for (qint64 first = 1; ; first += BATCH_SIZE) {
+        const int count = simulator.sampleBatch(run, first, BATCH_SIZE, samples, random);
+        for (int i = 0; i < count; ++i) {
+            if (samples[i].force >= test.getForceLimit()) {
+                return builder.seal();
+            }
+            builder.append(samples[i]);
+        }
+
+        if (count < BATCH_SIZE) {
+            return builder.seal();
+        }
+    }
+}
+
+/**
+ * @brief Stage latencies shared by the workers
+ */
+struct SharedStages {
+    QMutex mutex;
+    LatencyRecorder generate{"generate"};
+    LatencyRecorder save{"save"};
+    LatencyRecorder analyze{"analyze"};
+    LatencyRecorder persist{"persist"};
+
+    void record(LatencyRecorder& stage, qint64 ns) {
+        QMutexLocker locker(&mutex);
+        stage.record(ns);
+    }
+};
+
+} // namespace
+
+FleetSimulator::FleetSimulator(const FleetSimulatorConfig& config)
+    : m_config(config)
+{
+}
+
+bool FleetSimulator::run(FleetSimulatorReport& report, const std::function<void(int)>& progress) {
+    if (m_config.tests <= 0 || m_config.samplingRateHz <= 0 || m_config.speedMmPerMin <= 0) {
+        LOG_ERROR("Fleet simulation needs tests, a sampling rate and a speed");
+        return false;
+    }
+
+    QVector<MaterialParameters> materials;
+    for (const QString& name : m_config.materials) {
+        bool ok = false;
+        materials.append(MaterialParameters::byName(name, &ok));
+        if (!ok) {
+            LOG_ERROR(QString("Unknown material: %1").arg(name));
+            return false;
+        }
+    }
+    if (materials.isEmpty()) {
+        LOG_ERROR("Fleet simulation needs at least one material");
+        return false;
+    }
+
+    // Database
+    QTemporaryDir tempDir;
+    QString dbPath = m_config.databasePath;
+    if (dbPath.isEmpty()) {
+        if (!tempDir.isValid()) {
+            LOG_ERROR("Cannot create temporary directory for the database");
+            return false;
+        }
+        dbPath = tempDir.filePath("fleet_sim.db");
+    }
+
+    DatabaseManager& dbManager = DatabaseManager::instance();
+    if (!dbManager.initialize(dbPath)) {
+        LOG_ERROR("Failed to initialize fleet database");
+        return false;
+    }
+
+    SQLiteTestRepository repository;
+    SharedStages stages;
+    std::atomic<int> testsWritten{0};
+    std::atomic<int> testsFailed{0};
+    std::atomic<qint64> points{0};
+
+    // Tests start one minute apart, the last one now
+    const qint64 firstStartMs = QDateTime::currentMSecsSinceEpoch() - qint64(m_config.tests) * 60000;
+
+    const int threads = m_config.threads > 0 ? m_config.threads : QThread::idealThreadCount();
+    QElapsedTimer wallClock;
+    wallClock.start();
+
+    {
+        // Pool threads (and their database connections) end with this scope
+        QThreadPool pool;
+        pool.setMaxThreadCount(threads);
+
+        for (int i = 0; i < m_config.tests; ++i) {
+            pool.start(QRunnable::create([&, i]() {
+                QRandomGenerator random(m_config.seed + quint32(i));
+                MaterialParameters material = randomizedMaterial(materials.at(i % materials.size()), random);
+                qint64 startMs = firstStartMs + qint64(i) * 60000;
+
+                Test test;
+                test.setSampleName(QString("fleet-%1-%2").arg(material.name).arg(i + 1, 6, 10, QChar('0')));
+                test.setOperatorName(OPERATORS.at(random.bounded(OPERATORS.size())));
+                test.setTestMethod("ISO 527-2");
+                test.setWidth(uniform(random, 9.8, 10.2));
+                test.setThickness(uniform(random, 3.9, 4.1));
+                test.setGaugeLength(50.0);
+                test.setSpeed(m_config.speedMmPerMin);
+                test.setForceLimit(1.0e9); // run every specimen to break
+                test.setTemperature(uniform(random, 22.0, 24.0));
+                test.setStatus(TestStatus::Running);
+                test.setStartTime(QDateTime::fromMSecsSinceEpoch(startMs));
+
+                QElapsedTimer timer;
+                timer.start();
+                FastRandom noise(random.generate64());
+                Curve curve = simulateCurve(material, test, m_config.samplingRateHz, startMs, noise);
+                stages.record(stages.generate, timer.nsecsElapsed());
+
+                timer.restart();
+                bool ok = repository.saveTest(test);
+                stages.record(stages.save, timer.nsecsElapsed());
+
+                if (ok) {
+                    test.setCurve(curve);
+                    test.setStatus(TestStatus::Completed);
+                    test.setEndTime(QDateTime::fromMSecsSinceEpoch(
+                        curve.isEmpty() ? startMs : curve.last().timestamp));
+
+                    timer.restart();
+                    test.setResult(StressStrainCalculator::calculateResults(
+                        curve, test.getCrossSectionArea(), test.getGaugeLength()));
+                    stages.record(stages.analyze, timer.nsecsElapsed());
+
+                    timer.restart();
+                    ok = repository.updateTest(test);
+                    stages.record(stages.persist, timer.nsecsElapsed());
+                }
+
+                if (ok) {
+                    ++testsWritten;
+                    points += curve.size();
+                } else {
+                    ++testsFailed;
+                }
+            }));
+        }
+
+        while (!pool.waitForDone(1000)) {
+            if (progress) {
+                progress(testsWritten + testsFailed);
+            }
+        }
+    }
+
+    double elapsedSec = wallClock.nsecsElapsed() / 1.0e9;
+
+    QFileInfo dbInfo(dbPath);
+    qint64 dbBytes = dbInfo.size();
+    QFileInfo walInfo(dbPath + "-wal");
+    if (walInfo.exists()) {
+        dbBytes += walInfo.size();
+    }
+
+    dbManager.close();
+
+    report = FleetSimulatorReport();
+    report.config = m_config;
+    report.threads = threads;
+    report.testsWritten = testsWritten;
+    report.testsFailed = testsFailed;
+    report.points = points;
+    report.elapsedSec = elapsedSec;
+    report.testsPerHour = elapsedSec > 0 ? report.testsWritten * 3600.0 / elapsedSec : 0.0;
+    report.pointsPerSec = elapsedSec > 0 ? report.points / elapsedSec : 0.0;
+    report.stages = {
+        toStageStats(stages.generate),
+        toStageStats(stages.save),
+        toStageStats(stages.analyze),
+        toStageStats(stages.persist)
+    };
+    report.peakMemoryBytes = PipelineBenchmark::peakMemoryBytes();
+    report.databaseBytes = dbBytes;
+    report.databaseBytesPerPoint = report.points > 0
+        ? static_cast<double>(dbBytes) / report.points : 0.0;
+
+    return true;
+}
+
+QJsonObject FleetSimulatorReport::toJson() const {
+    QJsonObject configJson;
+    configJson["tests"] = config.tests;
+    configJson["threads"] = threads;
+    configJson["samplingRateHz"] = config.samplingRateHz;
+    configJson["speedMmPerMin"] = config.speedMmPerMin;
+    configJson["materials"] = QJsonArray::fromStringList(config.materials);
+    configJson["seed"] = static_cast<qint64>(config.seed);
+
+    QJsonArray stagesJson;
+    for (const StageStats& stage : stages) {
+        QJsonObject stageJson;
+        stageJson["name"] = stage.name;
+        stageJson["count"] = stage.count;
+        stageJson["meanUs"] = stage.meanUs;
+        stageJson["p50Us"] = stage.p50Us;
+        stageJson["p90Us"] = stage.p90Us;
+        stageJson["p99Us"] = stage.p99Us;
+        stageJson["maxUs"] = stage.maxUs;
+        stagesJson.append(stageJson);
+    }
+
+    QJsonObject json;
+    json["config"] = configJson;
+    json["testsWritten"] = testsWritten;
+    json["testsFailed"] = testsFailed;
+    json["points"] = points;
+    json["elapsedSec"] = elapsedSec;
+    json["testsPerHour"] = testsPerHour;
+    json["pointsPerSec"] = pointsPerSec;
+    json["stages"] = stagesJson;
+    json["peakMemoryBytes"] = peakMemoryBytes;
+    json["databaseBytes"] = databaseBytes;
+    json["databaseBytesPerPoint"] = databaseBytesPerPoint;
+    return json;
+}
+
+QString FleetSimulatorReport::toText() const {
+    QString text;
+    QTextStream out(&text);
+
+    out << "Materials:         " << config.materials.join(", ")
+        << " @ " << config.samplingRateHz << " Hz, " << config.speedMmPerMin << " mm/min\n";
+    out << "Threads:           " << threads << "\n";
+    out << "Elapsed:           " << QString::number(elapsedSec, 'f', 2) << " s\n";
+    out << "Tests written:     " << testsWritten << " (" << testsFailed << " failed)\n";
+    out << "Points:            " << points << "\n";
+    out << "Throughput:        " << QString::number(testsPerHour, 'f', 0) << " tests/h, "
+        << QString::number(pointsPerSec, 'f', 0) << " points/s\n";
+    out << "Peak memory:       " << QString::number(peakMemoryBytes / (1024.0 * 1024.0), 'f', 1) << " MiB\n";
+    out << "Database:          " << databaseBytes << " bytes, "
+        << QString::number(databaseBytesPerPoint, 'f', 1) << " bytes/point\n";
+    out << "\n";
+    out << QString("%1 %2 %3 %4 %5 %6 %7\n")
+        .arg("stage", -10).arg("count", 10).arg("mean us", 12).arg("p50 us", 12)
+        .arg("p90 us", 12).arg("p99 us", 12).arg("max us", 12);
+    for (const StageStats& stage : stages) {
+        out << QString("%1 %2 %3 %4 %5 %6 %7\n")
+            .arg(stage.name, -10).arg(stage.count, 10)
+            .arg(stage.meanUs, 12, 'f', 1).arg(stage.p50Us, 12, 'f', 1)
+            .arg(stage.p90Us, 12, 'f', 1).arg(stage.p99Us, 12, 'f', 1)
+            .arg(stage.maxUs, 12, 'f', 1);
+    }
+
+    out.flush();
+    return text;
+}
+
+} // namespace Bench
+} // namespace HorizonUTM
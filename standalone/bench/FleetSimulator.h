@@ -0,0 +1,82 @@
+#pragma once
+
+#include <QJsonObject>
+#include <functional>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include "PipelineBenchmark.h"
+
+namespace HorizonUTM {
+namespace Bench {
+
+/**
+ * @brief Parameters of a fleet simulation
+ */
+struct FleetSimulatorConfig {
+    int tests = 100;                ///< Tests to generate and write
+    int threads = 0;                ///< Worker threads, 0 = one per core
+    int samplingRateHz = 1000;      ///< Sampling rate of the simulated machines
+    double speedMmPerMin = 50.0;    ///< Crosshead speed of every test
+    QStringList materials = {"brittle", "ductile", "elastomer", "metal"}; ///< Base materials, used round-robin
+    quint32 seed = 42;              ///< Seed of test i is seed + i
+    QString databasePath;           ///< Database file, empty = temporary
+};
+
+/**
+ * @brief Result of a fleet simulation
+ */
+struct FleetSimulatorReport {
+    FleetSimulatorConfig config;
+    int threads = 0;                ///< Worker threads actually used
+    int testsWritten = 0;
+    int testsFailed = 0;
+    qint64 points = 0;              ///< Points written with the tests
+    double elapsedSec = 0.0;
+    double testsPerHour = 0.0;
+    double pointsPerSec = 0.0;
+    QVector<StageStats> stages;
+    qint64 peakMemoryBytes = 0;     ///< Process resident set high-water mark
+    qint64 databaseBytes = 0;
+    double databaseBytesPerPoint = 0.0;
+
+    QJsonObject toJson() const;
+    QString toText() const;
+};
+
+/**
+ * @brief Fills a database with realistic simulated tests
+ *
+ * Every test gets its own material, derived from a preset with randomized
+ * modulus, strengths, strains and noise, and a randomized specimen. Its
+ * curve is generated on the sampling grid with the MockUTMDriver material
+ * model, analyzed and written through SQLiteTestRepository the way a
+ * machine run is (insert on start, update with curve and results on
+ * completion). Tests are spread over a thread pool, so this also measures
+ * how the persistence layer scales with concurrent writers.
+ *
+ * Stages measured (per test):
+ *  - generate: curve generation
+ *  - save:     initial test insert
+ *  - analyze:  result calculation
+ *  - persist:  final test update with the full curve
+ */
+class FleetSimulator {
+public:
+    explicit FleetSimulator(const FleetSimulatorConfig& config);
+
+    /**
+     * @brief Run the simulation, blocking until every test is written
+     * @param report Filled on success
+     * @param progress Called from the calling thread about once a second
+     *        with the number of tests finished so far
+     * @return false if the database could not be set up
+     */
+    bool run(FleetSimulatorReport& report, const std::function<void(int)>& progress = {});
+
+private:
+    FleetSimulatorConfig m_config;
+};
+
+} // namespace Bench
+} // namespace HorizonUTM
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+#include <cmath>
+
+namespace HorizonUTM {
+namespace Bench {
+
+/**
+ * @brief Collects latencies of one pipeline stage
+ *
+ * Latencies go into logarithmic buckets 1% wide, so memory stays constant
+ * however long the run is (and does not distort the memory high-water mark)
+ * while percentiles remain accurate to about 0.5%.
+ */
+class LatencyRecorder {
+public:
+    explicit LatencyRecorder(const QString& name = QString())
+        : m_name(name)
+        , m_buckets(BUCKET_COUNT, 0)
+        , m_count(0)
+        , m_totalNs(0)
+        , m_maxNs(0)
+    {
+    }
+
+    void record(qint64 ns) {
+        ns = qMax<qint64>(1, ns);
+        int bucket = static_cast<int>(std::log(static_cast<double>(ns)) / LOG_GROWTH);
+        ++m_buckets[qMin(bucket, BUCKET_COUNT - 1)];
+        ++m_count;
+        m_totalNs += ns;
+        m_maxNs = qMax(m_maxNs, ns);
+    }
+
+    QString name() const { return m_name; }
+    qint64 count() const { return m_count; }
+    qint64 totalNs() const { return m_totalNs; }
+    qint64 maxNs() const { return m_maxNs; }
+
+    double meanNs() const {
+        return m_count == 0 ? 0.0 : static_cast<double>(m_totalNs) / m_count;
+    }
+
+    /**
+     * @brief Nearest-rank percentile
+     * @param p Percentile in [0, 100]
+     */
+    double percentileNs(double p) const {
+        if (m_count == 0) {
+            return 0.0;
+        }
+
+        qint64 rank = qMax<qint64>(1, static_cast<qint64>(std::ceil(p / 100.0 * m_count)));
+        qint64 seen = 0;
+        for (int i = 0; i < BUCKET_COUNT; ++i) {
+            seen += m_buckets[i];
+            if (seen >= rank) {
+                // Geometric middle of the bucket, never above the real maximum
+                double value = std::exp((i + 0.5) * LOG_GROWTH);
+                return qMin(value, static_cast<double>(m_maxNs));
+            }
+        }
+        return static_cast<double>(m_maxNs);
+    }
+
+private:
+    static constexpr double LOG_GROWTH = 0.00995033; // ln(1.01)
+    static constexpr int BUCKET_COUNT = 2600;        // covers up to ~170 s
+
+    QString m_name;
+    QVector<qint64> m_buckets;
+    qint64 m_count;
+    qint64 m_totalNs;
+    qint64 m_maxNs;
+};
+
+} // namespace Bench
+} // namespace HorizonUTM
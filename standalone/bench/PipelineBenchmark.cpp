@@ -0,0 +1,444 @@
+#include "PipelineBenchmark.h"
+#include "LatencyRecorder.h"
+#include "application/controllers/TestController.h"
+#include "application/controllers/HardwareController.h"
+#include "infrastructure/hardware/MockUTMDriver.h"
+#include "infrastructure/hardware/ReplayUTMDriver.h"
+#include "infrastructure/persistence/DatabaseManager.h"
+#include "infrastructure/persistence/SQLiteTestRepository.h"
+#include "core/Logger.h"
+#include <QEventLoop>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <QTemporaryDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QTextStream>
+#include <memory>
+#include <vector>
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#include <psapi.h>
+#elif !defined(Q_OS_LINUX)
+#include <sys/resource.h>
+#endif
+
+namespace HorizonUTM {
+namespace Bench {
+
+namespace {
+
+/**
+ * @brief Repository decorator timing the persistence calls of the pipeline
+ */
+class TimingTestRepository : public ITestRepository {
+public:
+    explicit TimingTestRepository(ITestRepository* inner)
+        : m_inner(inner)
+        , save("save")
+        , persist("persist")
+        , samplesPersisted(0)
+        , lastPersistNs(0)
+    {
+    }
+
+    bool saveTest(const Test& test) override {
+        QElapsedTimer timer;
+        timer.start();
+        bool ok = m_inner->saveTest(test);
+        save.record(timer.nsecsElapsed());
+        return ok;
+    }
+
+    bool updateTest(const Test& test) override {
+        QElapsedTimer timer;
+        timer.start();
+        bool ok = m_inner->updateTest(test);
+        lastPersistNs = timer.nsecsElapsed();
+        persist.record(lastPersistNs);
+        if (ok) {
+            samplesPersisted += test.getDataPointCount();
+        }
+        return ok;
+    }
+
+    bool deleteTest(int testId) override { return m_inner->deleteTest(testId); }
+    Test getTest(int testId) override { return m_inner->getTest(testId); }
+    QVector<Test> getAllTests() override { return m_inner->getAllTests(); }
+    QVector<Test> getTestsByStatus(TestStatus status) override { return m_inner->getTestsByStatus(status); }
+    QVector<Test> getTestsByDateRange(const QDateTime& start, const QDateTime& end) override {
+        return m_inner->getTestsByDateRange(start, end);
+    }
+
+    bool saveDataPoints(int testId, const QVector<SensorData>& data) override {
+        return m_inner->saveDataPoints(testId, data);
+    }
+    QVector<SensorData> getDataPoints(int testId) override { return m_inner->getDataPoints(testId); }
+    bool deleteDataPoints(int testId) override { return m_inner->deleteDataPoints(testId); }
+
+    bool saveSample(const Sample& sample) override { return m_inner->saveSample(sample); }
+    bool updateSample(const Sample& sample) override { return m_inner->updateSample(sample); }
+    bool deleteSample(int sampleId) override { return m_inner->deleteSample(sampleId); }
+    Sample getSample(int sampleId) override { return m_inner->getSample(sampleId); }
+    QVector<Sample> getAllSamples() override { return m_inner->getAllSamples(); }
+    QVector<Sample> getSamplesByStatus(SampleStatus status) override { return m_inner->getSamplesByStatus(status); }
+
+    int getTestCount() override { return m_inner->getTestCount(); }
+    int getTestCountByStatus(TestStatus status) override { return m_inner->getTestCountByStatus(status); }
+
+private:
+    ITestRepository* m_inner;
+
+public:
+    LatencyRecorder save;
+    LatencyRecorder persist;
+    qint64 samplesPersisted;
+    qint64 lastPersistNs;
+};
+
+/**
+ * @brief One simulated machine with its controller
+ */
+struct Station {
+    int index = 0;
+    std::unique_ptr<IUTMDriver> driver;
+    std::unique_ptr<HardwareController> controller;
+    QElapsedTimer sampleTimer;
+    QElapsedTimer completeTimer;
+    int testsStarted = 0;
+    bool running = false;
+};
+
+} // namespace
+
+StageStats toStageStats(const LatencyRecorder& recorder) {
+    StageStats stats;
+    stats.name = recorder.name();
+    stats.count = recorder.count();
+    stats.meanUs = recorder.meanNs() / 1000.0;
+    stats.p50Us = recorder.percentileNs(50) / 1000.0;
+    stats.p90Us = recorder.percentileNs(90) / 1000.0;
+    stats.p99Us = recorder.percentileNs(99) / 1000.0;
+    stats.maxUs = recorder.maxNs() / 1000.0;
+    return stats;
+}
+
+PipelineBenchmark::PipelineBenchmark(const PipelineBenchmarkConfig& config, QObject* parent)
+    : QObject(parent)
+    , m_config(config)
+{
+}
+
+PipelineBenchmark::~PipelineBenchmark() = default;
+
+bool PipelineBenchmark::run(PipelineBenchmarkReport& report) {
+    if (m_config.concurrentTests <= 0 || m_config.durationSec <= 0) {
+        LOG_ERROR("Benchmark needs at least one test and a positive duration");
+        return false;
+    }
+
+    // Database
+    QTemporaryDir tempDir;
+    QString dbPath = m_config.databasePath;
+    if (dbPath.isEmpty()) {
+        if (!tempDir.isValid()) {
+            LOG_ERROR("Cannot create temporary directory for the database");
+            return false;
+        }
+        dbPath = tempDir.filePath("horizon_bench.db");
+    }
+
+    DatabaseManager& dbManager = DatabaseManager::instance();
+    if (!dbManager.initialize(dbPath)) {
+        LOG_ERROR("Failed to initialize benchmark database");
+        return false;
+    }
+
+    SQLiteTestRepository sqliteRepository;
+    TimingTestRepository repository(&sqliteRepository);
+    TestController testController(&repository);
+
+    LatencyRecorder sampleStage("sample");
+    LatencyRecorder analyzeStage("analyze");
+    LatencyRecorder completeStage("complete");
+
+    qint64 samples = 0;
+    int testsCompleted = 0;
+    bool draining = false;
+
+    QEventLoop loop;
+    std::vector<std::unique_ptr<Station>> stations;
+
+    auto allIdle = [&stations]() {
+        for (const auto& station : stations) {
+            if (station->running) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    auto startNextTest = [&](Station* station) {
+        if (draining) {
+            station->running = false;
+            if (allIdle()) {
+                loop.quit();
+            }
+            return;
+        }
+
+        Test test = testController.createNewTest();
+        test.setSampleName(QString("bench-%1-%2").arg(station->index).arg(++station->testsStarted));
+        test.setOperatorName("horizon_bench");
+        test.setWidth(10.0);
+        test.setThickness(4.0);
+        test.setGaugeLength(50.0);
+        test.setSpeed(m_config.speedMmPerMin);
+        test.setForceLimit(1.0e9); // run every specimen to break
+
+        station->running = station->controller->startTest(test);
+        if (!station->running && allIdle()) {
+            loop.quit();
+        }
+    };
+
+    // Stations
+    for (int i = 0; i < m_config.concurrentTests; ++i) {
+        auto station = std::make_unique<Station>();
+        station->index = i + 1;
+        Station* s = station.get();
+
+        if (m_config.replayFile.isEmpty()) {
+            auto* mock = new MockUTMDriver();
+            mock->setSamplingRate(m_config.samplingRateHz);
+            if (m_config.simulationSpeed <= 0) {
+                mock->setSimulationMode(SimulationMode::AsFastAsConsumed);
+            } else if (m_config.simulationSpeed != 1.0) {
+                mock->setSimulationMode(SimulationMode::Accelerated, m_config.simulationSpeed);
+            }
+            station->driver.reset(mock);
+        } else {
+            auto* replay = new ReplayUTMDriver();
+            if (!replay->loadRecording(m_config.replayFile)) {
+                delete replay;
+                dbManager.close();
+                return false;
+            }
+            if (m_config.replaySpeed <= 0) {
+                replay->setReplayMode(ReplayMode::AsFastAsPossible);
+            } else if (m_config.replaySpeed != 1.0) {
+                replay->setReplayMode(ReplayMode::Accelerated, m_config.replaySpeed);
+            }
+            station->driver.reset(replay);
+        }
+
+        IUTMDriver* driver = station->driver.get();
+
+        // Connected before the controller so they bracket its slots
+        QObject::connect(driver, &IUTMDriver::sensorDataReceived, this, [s]() {
+            s->sampleTimer.start();
+        });
+        QObject::connect(driver, &IUTMDriver::testCompleted, this, [s, &repository]() {
+            repository.lastPersistNs = 0;
+            s->completeTimer.start();
+        });
+
+        station->controller = std::make_unique<HardwareController>(driver, &testController);
+
+        QObject::connect(driver, &IUTMDriver::sensorDataReceived, this, [s, &sampleStage, &samples]() {
+            sampleStage.record(s->sampleTimer.nsecsElapsed());
+            ++samples;
+        });
+        QObject::connect(driver, &IUTMDriver::testCompleted, this, [s, &repository, &analyzeStage, &completeStage]() {
+            qint64 completeNs = s->completeTimer.nsecsElapsed();
+            completeStage.record(completeNs);
+            analyzeStage.record(completeNs - repository.lastPersistNs);
+        });
+
+        // Next specimen once the previous one is fully processed
+        QObject::connect(station->controller.get(), &HardwareController::testCompleted, this,
+            [s, &testsCompleted, &startNextTest]() {
+                ++testsCompleted;
+                QTimer::singleShot(0, s->controller.get(), [s, &startNextTest]() { startNextTest(s); });
+            });
+        QObject::connect(station->controller.get(), &HardwareController::errorOccurred, this,
+            [s, &allIdle, &loop](const QString& error) {
+                LOG_ERROR(QString("Station %1 failed: %2").arg(s->index).arg(error));
+                s->running = false;
+                if (allIdle()) {
+                    loop.quit();
+                }
+            });
+
+        if (!station->controller->connectToHardware(m_config.replayFile.isEmpty() ? "mock" : m_config.replayFile)) {
+            LOG_ERROR(QString("Station %1 could not connect").arg(station->index));
+            dbManager.close();
+            return false;
+        }
+
+        stations.push_back(std::move(station));
+    }
+
+    QElapsedTimer wallClock;
+    wallClock.start();
+
+    for (const auto& station : stations) {
+        startNextTest(station.get());
+    }
+
+    // Stop starting tests after the duration; running tests finish normally
+    QTimer::singleShot(m_config.durationSec * 1000, &loop, [&]() {
+        draining = true;
+        if (allIdle()) {
+            loop.quit();
+        }
+    });
+
+    if (!allIdle()) {
+        loop.exec();
+    }
+
+    double elapsedSec = wallClock.nsecsElapsed() / 1.0e9;
+
+    // Tear down stations before the database
+    stations.clear();
+
+    QFileInfo dbInfo(dbPath);
+    qint64 dbBytes = dbInfo.size();
+    QFileInfo walInfo(dbPath + "-wal");
+    if (walInfo.exists()) {
+        dbBytes += walInfo.size();
+    }
+
+    dbManager.close();
+
+    report = PipelineBenchmarkReport();
+    report.config = m_config;
+    report.samples = samples;
+    report.samplesPersisted = repository.samplesPersisted;
+    report.testsCompleted = testsCompleted;
+    report.elapsedSec = elapsedSec;
+    report.samplesPerSec = elapsedSec > 0 ? samples / elapsedSec : 0.0;
+    report.stages = {
+        toStageStats(sampleStage),
+        toStageStats(repository.save),
+        toStageStats(analyzeStage),
+        toStageStats(repository.persist),
+        toStageStats(completeStage)
+    };
+    report.peakMemoryBytes = peakMemoryBytes();
+    report.databaseBytes = dbBytes;
+    report.databaseBytesPerSample = report.samplesPersisted > 0
+        ? static_cast<double>(dbBytes) / report.samplesPersisted : 0.0;
+
+    return true;
+}
+
+qint64 PipelineBenchmark::peakMemoryBytes() {
+#if defined(Q_OS_LINUX)
+    QFile status("/proc/self/status");
+    if (!status.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return 0;
+    }
+    QTextStream in(&status);
+    while (!in.atEnd()) {
+        QString line = in.readLine();
+        if (line.startsWith("VmHWM:")) {
+            // "VmHWM:     12345 kB"
+            return line.section(':', 1).trimmed().section(' ', 0, 0).toLongLong() * 1024;
+        }
+    }
+    return 0;
+#elif defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return static_cast<qint64>(counters.PeakWorkingSetSize);
+    }
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#if defined(Q_OS_MACOS)
+    return static_cast<qint64>(usage.ru_maxrss);          // bytes
+#else
+    return static_cast<qint64>(usage.ru_maxrss) * 1024;   // kilobytes
+#endif
+#endif
+}
+
+QJsonObject PipelineBenchmarkReport::toJson() const {
+    QJsonObject configJson;
+    configJson["samplingRateHz"] = config.samplingRateHz;
+    configJson["durationSec"] = config.durationSec;
+    configJson["concurrentTests"] = config.concurrentTests;
+    configJson["speedMmPerMin"] = config.speedMmPerMin;
+    configJson["simulationSpeed"] = config.simulationSpeed;
+    configJson["replayFile"] = config.replayFile;
+    configJson["replaySpeed"] = config.replaySpeed;
+
+    QJsonArray stagesJson;
+    for (const StageStats& stage : stages) {
+        QJsonObject stageJson;
+        stageJson["name"] = stage.name;
+        stageJson["count"] = stage.count;
+        stageJson["meanUs"] = stage.meanUs;
+        stageJson["p50Us"] = stage.p50Us;
+        stageJson["p90Us"] = stage.p90Us;
+        stageJson["p99Us"] = stage.p99Us;
+        stageJson["maxUs"] = stage.maxUs;
+        stagesJson.append(stageJson);
+    }
+
+    QJsonObject json;
+    json["config"] = configJson;
+    json["samples"] = samples;
+    json["samplesPersisted"] = samplesPersisted;
+    json["testsCompleted"] = testsCompleted;
+    json["elapsedSec"] = elapsedSec;
+    json["samplesPerSec"] = samplesPerSec;
+    json["stages"] = stagesJson;
+    json["peakMemoryBytes"] = peakMemoryBytes;
+    json["databaseBytes"] = databaseBytes;
+    json["databaseBytesPerSample"] = databaseBytesPerSample;
+    return json;
+}
+
+QString PipelineBenchmarkReport::toText() const {
+    QString text;
+    QTextStream out(&text);
+
+    out << "Source:            " << (config.replayFile.isEmpty()
+            ? QString("MockUTMDriver @ %1 Hz, %2").arg(config.samplingRateHz)
+                .arg(config.simulationSpeed <= 0 ? QString("as fast as consumed")
+                                                 : QString("%1x").arg(config.simulationSpeed))
+            : QString("replay %1").arg(config.replayFile)) << "\n";
+    out << "Concurrent tests:  " << config.concurrentTests << "\n";
+    out << "Elapsed:           " << QString::number(elapsedSec, 'f', 2) << " s\n";
+    out << "Tests completed:   " << testsCompleted << "\n";
+    out << "Samples:           " << samples << " (" << samplesPersisted << " persisted)\n";
+    out << "Throughput:        " << QString::number(samplesPerSec, 'f', 0) << " samples/s\n";
+    out << "Peak memory:       " << QString::number(peakMemoryBytes / (1024.0 * 1024.0), 'f', 1) << " MiB\n";
+    out << "Database:          " << databaseBytes << " bytes, "
+        << QString::number(databaseBytesPerSample, 'f', 1) << " bytes/sample\n";
+    out << "\n";
+    out << QString("%1 %2 %3 %4 %5 %6 %7\n")
+        .arg("stage", -10).arg("count", 10).arg("mean us", 12).arg("p50 us", 12)
+        .arg("p90 us", 12).arg("p99 us", 12).arg("max us", 12);
+    for (const StageStats& stage : stages) {
+        out << QString("%1 %2 %3 %4 %5 %6 %7\n")
+            .arg(stage.name, -10).arg(stage.count, 10)
+            .arg(stage.meanUs, 12, 'f', 1).arg(stage.p50Us, 12, 'f', 1)
+            .arg(stage.p90Us, 12, 'f', 1).arg(stage.p99Us, 12, 'f', 1)
+            .arg(stage.maxUs, 12, 'f', 1);
+    }
+
+    out.flush();
+    return text;
+}
+
+} // namespace Bench
+} // namespace HorizonUTM
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QVector>
+#include <QJsonObject>
+
+namespace HorizonUTM {
+namespace Bench {
+
+/**
+ * @brief Parameters of a pipeline benchmark run
+ */
+struct PipelineBenchmarkConfig {
+    int samplingRateHz = 1000;      ///< Mock driver sampling rate
+    int durationSec = 30;           ///< Time during which new tests are started
+    int concurrentTests = 1;        ///< Stations running tests at the same time
+    double speedMmPerMin = 50.0;    ///< Crosshead speed of every test
+    double simulationSpeed = 1.0;   ///< Mock driver speed factor, <= 0 = as fast as consumed
+    QString replayFile;             ///< Replay this recording instead of the simulator
+    double replaySpeed = 1.0;       ///< Replay speed factor, <= 0 = as fast as possible
+    QString databasePath;           ///< Database file, empty = temporary
+};
+
+/**
+ * @brief Latency summary of one stage
+ */
+struct StageStats {
+    QString name;
+    qint64 count = 0;
+    double meanUs = 0.0;
+    double p50Us = 0.0;
+    double p90Us = 0.0;
+    double p99Us = 0.0;
+    double maxUs = 0.0;
+};
+
+class LatencyRecorder;
+
+/**
+ * @brief Summary of a recorded stage
+ */
+StageStats toStageStats(const LatencyRecorder& recorder);
+
+/**
+ * @brief Result of a pipeline benchmark run
+ */
+struct PipelineBenchmarkReport {
+    PipelineBenchmarkConfig config;
+    qint64 samples = 0;             ///< Samples processed by the controllers
+    qint64 samplesPersisted = 0;    ///< Samples written with completed tests
+    int testsCompleted = 0;
+    double elapsedSec = 0.0;
+    double samplesPerSec = 0.0;
+    QVector<StageStats> stages;
+    qint64 peakMemoryBytes = 0;     ///< Process resident set high-water mark
+    qint64 databaseBytes = 0;
+    double databaseBytesPerSample = 0.0;
+
+    QJsonObject toJson() const;
+    QString toText() const;
+};
+
+/**
+ * @brief Drives the acquisition → analysis → persistence pipeline headless
+ *
+ * Runs N stations, each a driver (MockUTMDriver or ReplayUTMDriver) with its
+ * own HardwareController, through a shared TestController and
+ * SQLiteTestRepository — the same wiring as the application minus the
+ * windows. Every station starts tests back-to-back until the duration has
+ * elapsed; running tests are then allowed to finish.
+ *
+ * Stages measured:
+ *  - sample:   one sample through HardwareController and TestController
+ *  - save:     initial test insert when a test starts
+ *  - analyze:  result calculation on completion
+ *  - persist:  final test update with the full curve
+ *  - complete: the whole completion path (analyze + persist + bookkeeping)
+ */
+class PipelineBenchmark : public QObject {
+    Q_OBJECT
+
+public:
+    explicit PipelineBenchmark(const PipelineBenchmarkConfig& config, QObject* parent = nullptr);
+    ~PipelineBenchmark() override;
+
+    /**
+     * @brief Run the benchmark (spins its own event loop)
+     * @param report Filled on success
+     * @return false if the pipeline could not be set up
+     */
+    bool run(PipelineBenchmarkReport& report);
+
+    /**
+     * @brief Peak resident memory of this process in bytes (0 if unknown)
+     */
+    static qint64 peakMemoryBytes();
+
+private:
+    PipelineBenchmarkConfig m_config;
+};
+
+} // namespace Bench
+} // namespace HorizonUTM
@@ -0,0 +1,211 @@
+// Horizon UTM - StressStrainCalculator micro-benchmark
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QFile>
+#include <QTextStream>
+#include <functional>
+#include "AllocationCounter.h"
+#include "domain/services/StressStrainCalculator.h"
+#include "infrastructure/hardware/MaterialSimulator.h"
+
+using namespace HorizonUTM;
+using namespace HorizonUTM::Bench;
+
+namespace {
+
+constexpr double SPECIMEN_AREA = 40.0;        // mm²
+constexpr double SPECIMEN_GAUGE_LENGTH = 50.0; // mm
+
+/**
+ * @brief Reproducible curve from the MockUTMDriver material model
+ */
+QVector<SensorData> syntheticCurve(const MaterialParameters& material, int points, quint32 seed) {
+    MaterialSimulator simulator(material);
+    FastRandom random(seed);
+
+    QVector<SensorData> data;
+    data.reserve(points);
+
+    for (int i = 1; i <= points; ++i) {
+        SensorData point;
+        point.timestamp = i;
+        point.strain = material.breakStrain * i / points;
+        point.stress = simulator.stressAt(point.strain, random);
+        point.extension = point.strain / 100.0 * SPECIMEN_GAUGE_LENGTH;
+        point.force = point.stress * SPECIMEN_AREA;
+        point.temperature = 23.0;
+        data.append(point);
+    }
+
+    return data;
+}
+
+struct Measurement {
+    QString function;
+    QString material;
+    int points = 0;
+    int iterations = 0;
+    double nsPerCall = 0.0;
+    double nsPerPoint = 0.0;
+    double allocationsPerCall = 0.0;
+    double result = 0.0;    // keeps the call observable
+};
+
+/**
+ * @brief Call fn repeatedly for at least minTimeMs (and at least once)
+ */
+Measurement measure(const std::function<double()>& fn, int points, int minTimeMs) {
+    Measurement m;
+    m.points = points;
+
+    // Warm-up, also faults in the curve pages
+    m.result = fn();
+
+    quint64 allocationsBefore = AllocationCounter::count();
+    QElapsedTimer timer;
+    timer.start();
+
+    qint64 elapsedNs = 0;
+    do {
+        m.result += fn();
+        ++m.iterations;
+        elapsedNs = timer.nsecsElapsed();
+    } while (elapsedNs < qint64(minTimeMs) * 1000000);
+
+    quint64 allocations = AllocationCounter::count() - allocationsBefore;
+
+    m.nsPerCall = static_cast<double>(elapsedNs) / m.iterations;
+    m.nsPerPoint = m.nsPerCall / points;
+    m.allocationsPerCall = static_cast<double>(allocations) / m.iterations;
+    return m;
+}
+
+QJsonObject toJson(const Measurement& m) {
+    QJsonObject json;
+    json["function"] = m.function;
+    json["material"] = m.material;
+    json["points"] = m.points;
+    json["iterations"] = m.iterations;
+    json["nsPerCall"] = m.nsPerCall;
+    json["nsPerPoint"] = m.nsPerPoint;
+    json["allocationsPerCall"] = m.allocationsPerCall;
+    return json;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("calculator_bench");
+    app.setApplicationVersion("1.0.0");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+        "Measures StressStrainCalculator on seeded synthetic curves "
+        "(ns/point and heap allocations per call).");
+    parser.addHelpOption();
+    parser.addVersionOption();
+
+    QCommandLineOption sizesOption("sizes", "Comma-separated curve sizes (default 1000,...,10000000).",
+                                   "list", "1000,10000,100000,1000000,10000000");
+    QCommandLineOption materialsOption("materials", "Comma-separated materials (default brittle,ductile,elastomer,metal).",
+                                       "list", "brittle,ductile,elastomer,metal");
+    QCommandLineOption seedOption("seed", "Random seed for the curve noise (default 42).", "seed", "42");
+    QCommandLineOption minTimeOption("min-time", "Minimum measured time per case in ms (default 200).", "ms", "200");
+    QCommandLineOption jsonOption("json", "Write results as JSON to this file (\"-\" for stdout).", "file");
+
+    parser.addOptions({sizesOption, materialsOption, seedOption, minTimeOption, jsonOption});
+    parser.process(app);
+
+    QTextStream err(stderr);
+
+    QVector<int> sizes;
+    for (const QString& size : parser.value(sizesOption).split(',', Qt::SkipEmptyParts)) {
+        int points = size.trimmed().toInt();
+        if (points < 10) {
+            err << "Invalid curve size: " << size << "\n";
+            return 2;
+        }
+        sizes.append(points);
+    }
+
+    QVector<MaterialParameters> materials;
+    for (const QString& name : parser.value(materialsOption).split(',', Qt::SkipEmptyParts)) {
+        bool ok = false;
+        materials.append(MaterialParameters::byName(name.trimmed(), &ok));
+        if (!ok) {
+            err << "Unknown material: " << name << "\n";
+            return 2;
+        }
+    }
+
+    const quint32 seed = parser.value(seedOption).toUInt();
+    const int minTimeMs = qMax(1, parser.value(minTimeOption).toInt());
+    const QString jsonPath = parser.value(jsonOption);
+
+    // Table goes to stderr when stdout carries the JSON
+    QTextStream table(jsonPath == "-" ? stderr : stdout);
+    table << QString("%1 %2 %3 %4 %5 %6\n")
+        .arg("function", -24).arg("material", -10).arg("points", 10)
+        .arg("ns/call", 14).arg("ns/point", 10).arg("allocs/call", 12);
+
+    QJsonArray results;
+
+    for (const MaterialParameters& material : materials) {
+        for (int points : sizes) {
+            QVector<SensorData> data = syntheticCurve(material, points, seed);
+
+            const QVector<std::pair<QString, std::function<double()>>> cases = {
+                {"calculateResults", [&data]() {
+                    return StressStrainCalculator::calculateResults(data, SPECIMEN_AREA, SPECIMEN_GAUGE_LENGTH).maxStress;
+                }},
+                {"calculateElasticModulus", [&data]() {
+                    return StressStrainCalculator::calculateElasticModulus(data);
+                }},
+                {"calculateYieldStress", [&data]() {
+                    return StressStrainCalculator::calculateYieldStress(data, 0.2);
+                }}
+            };
+
+            for (const auto& benchCase : cases) {
+                Measurement m = measure(benchCase.second, points, minTimeMs);
+                m.function = benchCase.first;
+                m.material = material.name;
+
+                table << QString("%1 %2 %3 %4 %5 %6\n")
+                    .arg(m.function, -24).arg(m.material, -10).arg(m.points, 10)
+                    .arg(m.nsPerCall, 14, 'f', 0).arg(m.nsPerPoint, 10, 'f', 3)
+                    .arg(m.allocationsPerCall, 12, 'f', 1);
+                table.flush();
+
+                results.append(toJson(m));
+            }
+        }
+    }
+
+    if (!jsonPath.isEmpty()) {
+        QJsonObject root;
+        root["benchmark"] = "StressStrainCalculator";
+        root["seed"] = static_cast<qint64>(seed);
+        root["allocationsIncludeMalloc"] = AllocationCounter::coversMalloc();
+        root["results"] = results;
+
+        QByteArray json = QJsonDocument(root).toJson(QJsonDocument::Indented);
+        if (jsonPath == "-") {
+            QTextStream(stdout) << json;
+        } else {
+            QFile file(jsonPath);
+            if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+                err << "Cannot write " << jsonPath << "\n";
+                return 1;
+            }
+            file.write(json);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,90 @@
+// Horizon UTM - Fleet simulator: fills a database with simulated tests
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QJsonDocument>
+#include <QFile>
+#include <QTextStream>
+#include "FleetSimulator.h"
+#include "BenchLogging.h"
+
+using namespace HorizonUTM;
+using namespace HorizonUTM::Bench;
+
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    app.setOrganizationName("HorizonUTM");
+    app.setApplicationName("fleet_sim");
+    app.setApplicationVersion("1.0.0");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+        "Generates realistic simulated tests on a thread pool and writes them through "
+        "SQLiteTestRepository, reporting ingest throughput.");
+    parser.addHelpOption();
+    parser.addVersionOption();
+
+    QCommandLineOption testsOption({"n", "tests"}, "Number of tests to write (default 100).", "count", "100");
+    QCommandLineOption threadsOption({"j", "threads"}, "Worker threads (default: one per core).", "count", "0");
+    QCommandLineOption rateOption({"r", "rate"}, "Sampling rate in Hz (default 1000).", "hz", "1000");
+    QCommandLineOption speedOption("speed", "Crosshead speed in mm/min (default 50).", "mm/min", "50");
+    QCommandLineOption materialsOption("materials", "Comma-separated base materials (default brittle,ductile,elastomer,metal).",
+                                       "list", "brittle,ductile,elastomer,metal");
+    QCommandLineOption seedOption("seed", "Random seed (default 42).", "seed", "42");
+    QCommandLineOption databaseOption("db", "Database file to fill (default: temporary, deleted afterwards).", "file");
+    QCommandLineOption jsonOption("json", "Also write the report as JSON to this file (\"-\" for stdout).", "file");
+    QCommandLineOption verboseOption({"v", "verbose"}, "Keep persistence debug output.");
+
+    parser.addOptions({testsOption, threadsOption, rateOption, speedOption, materialsOption,
+                       seedOption, databaseOption, jsonOption, verboseOption});
+    parser.process(app);
+
+    initializeBenchLogging(parser.isSet(verboseOption));
+
+    FleetSimulatorConfig config;
+    config.tests = parser.value(testsOption).toInt();
+    config.threads = parser.value(threadsOption).toInt();
+    config.samplingRateHz = parser.value(rateOption).toInt();
+    config.speedMmPerMin = parser.value(speedOption).toDouble();
+    config.materials.clear();
+    for (const QString& name : parser.value(materialsOption).split(',', Qt::SkipEmptyParts)) {
+        config.materials.append(name.trimmed());
+    }
+    config.seed = parser.value(seedOption).toUInt();
+    config.databasePath = parser.value(databaseOption);
+
+    if (config.tests <= 0 || config.threads < 0 || config.samplingRateHz <= 0 || config.speedMmPerMin <= 0) {
+        QTextStream(stderr) << "Tests, rate and speed must be positive\n";
+        return 2;
+    }
+
+    QString jsonPath = parser.value(jsonOption);
+
+    FleetSimulator simulator(config);
+    FleetSimulatorReport report;
+    bool ok = simulator.run(report, [&config](int done) {
+        QTextStream(stderr) << done << "/" << config.tests << " tests\n";
+    });
+    if (!ok) {
+        QTextStream(stderr) << "Simulation failed, see log\n";
+        return 1;
+    }
+
+    // Keep stdout machine-readable when the JSON goes there
+    QTextStream(jsonPath == "-" ? stderr : stdout) << report.toText();
+
+    if (!jsonPath.isEmpty()) {
+        QByteArray json = QJsonDocument(report.toJson()).toJson(QJsonDocument::Indented);
+        if (jsonPath == "-") {
+            QTextStream(stdout) << json;
+        } else {
+            QFile file(jsonPath);
+            if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+                QTextStream(stderr) << "Cannot write " << jsonPath << "\n";
+                return 1;
+            }
+            file.write(json);
+        }
+    }
+
+    return report.testsFailed == 0 ? 0 : 1;
+}
@@ -0,0 +1,85 @@
+// Horizon UTM - Headless pipeline benchmark
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QJsonDocument>
+#include <QFile>
+#include <QTextStream>
+#include "PipelineBenchmark.h"
+#include "BenchLogging.h"
+
+using namespace HorizonUTM;
+using namespace HorizonUTM::Bench;
+
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    app.setOrganizationName("HorizonUTM");
+    app.setApplicationName("horizon_bench");
+    app.setApplicationVersion("1.0.0");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+        "Drives the acquisition, analysis and persistence pipeline without a UI "
+        "and reports throughput, per-stage latency, memory and database size.");
+    parser.addHelpOption();
+    parser.addVersionOption();
+
+    QCommandLineOption rateOption({"r", "rate"}, "Sampling rate in Hz (default 1000).", "hz", "1000");
+    QCommandLineOption durationOption({"d", "duration"}, "Seconds during which tests are started (default 30).", "seconds", "30");
+    QCommandLineOption testsOption({"n", "tests"}, "Number of concurrent tests (default 1).", "count", "1");
+    QCommandLineOption speedOption("speed", "Crosshead speed in mm/min (default 50).", "mm/min", "50");
+    QCommandLineOption simSpeedOption("sim-speed", "Simulation speed factor, or \"max\" (default 1).", "factor", "1");
+    QCommandLineOption replayOption("replay", "Replay a recorded curve (*.csv or *.hzb) instead of simulating.", "file");
+    QCommandLineOption replaySpeedOption("replay-speed", "Replay speed factor, or \"max\" (default max).", "factor", "max");
+    QCommandLineOption databaseOption("db", "Database file (default: temporary, deleted afterwards).", "file");
+    QCommandLineOption jsonOption("json", "Also write the report as JSON to this file (\"-\" for stdout).", "file");
+    QCommandLineOption verboseOption({"v", "verbose"}, "Keep pipeline debug output.");
+
+    parser.addOptions({rateOption, durationOption, testsOption, speedOption, simSpeedOption, replayOption,
+                       replaySpeedOption, databaseOption, jsonOption, verboseOption});
+    parser.process(app);
+
+    initializeBenchLogging(parser.isSet(verboseOption));
+
+    PipelineBenchmarkConfig config;
+    config.samplingRateHz = parser.value(rateOption).toInt();
+    config.durationSec = parser.value(durationOption).toInt();
+    config.concurrentTests = parser.value(testsOption).toInt();
+    config.speedMmPerMin = parser.value(speedOption).toDouble();
+    config.simulationSpeed = parser.value(simSpeedOption) == "max" ? 0.0 : parser.value(simSpeedOption).toDouble();
+    config.replayFile = parser.value(replayOption);
+    config.replaySpeed = parser.value(replaySpeedOption) == "max" ? 0.0 : parser.value(replaySpeedOption).toDouble();
+    config.databasePath = parser.value(databaseOption);
+
+    if (config.samplingRateHz <= 0 || config.durationSec <= 0 || config.concurrentTests <= 0 ||
+        config.speedMmPerMin <= 0) {
+        QTextStream(stderr) << "Rate, duration, tests and speed must be positive\n";
+        return 2;
+    }
+
+    PipelineBenchmark benchmark(config);
+    PipelineBenchmarkReport report;
+    if (!benchmark.run(report)) {
+        QTextStream(stderr) << "Benchmark failed, see log\n";
+        return 1;
+    }
+
+    // Keep stdout machine-readable when the JSON goes there
+    QString jsonPath = parser.value(jsonOption);
+    QTextStream(jsonPath == "-" ? stderr : stdout) << report.toText();
+
+    if (!jsonPath.isEmpty()) {
+        QByteArray json = QJsonDocument(report.toJson()).toJson(QJsonDocument::Indented);
+        if (jsonPath == "-") {
+            QTextStream(stdout) << json;
+        } else {
+            QFile file(jsonPath);
+            if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+                QTextStream(stderr) << "Cannot write " << jsonPath << "\n";
+                return 1;
+            }
+            file.write(json);
+        }
+    }
+
+    return 0;
+}
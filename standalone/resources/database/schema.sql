@@ -54,6 +54,34 @@ CREATE TABLE IF NOT EXISTS test_data_points (
     FOREIGN KEY (test_id) REFERENCES tests(id) ON DELETE CASCADE
 );
 
+-- Full-rate sensor readings around the specimen break
+CREATE TABLE IF NOT EXISTS test_break_points (
+    id INTEGER PRIMARY KEY AUTOINCREMENT,
+    test_id INTEGER NOT NULL,
+    timestamp INTEGER NOT NULL,
+    force REAL NOT NULL,
+    extension REAL NOT NULL,
+    stress REAL NOT NULL,
+    strain REAL NOT NULL,
+    temperature REAL,
+    
+    FOREIGN KEY (test_id) REFERENCES tests(id) ON DELETE CASCADE
+);
+
+-- Unfiltered sensor readings, when a filter stage was active
+CREATE TABLE IF NOT EXISTS test_raw_points (
+    id INTEGER PRIMARY KEY AUTOINCREMENT,
+    test_id INTEGER NOT NULL,
+    timestamp INTEGER NOT NULL,
+    force REAL NOT NULL,
+    extension REAL NOT NULL,
+    stress REAL NOT NULL,
+    strain REAL NOT NULL,
+    temperature REAL,
+    
+    FOREIGN KEY (test_id) REFERENCES tests(id) ON DELETE CASCADE
+);
+
 -- Samples table (pre-defined samples in queue)
 CREATE TABLE IF NOT EXISTS samples (
     id INTEGER PRIMARY KEY AUTOINCREMENT,
@@ -73,6 +101,8 @@ CREATE INDEX IF NOT EXISTS idx_tests_status ON tests(status);
 CREATE INDEX IF NOT EXISTS idx_tests_start_time ON tests(start_time);
 CREATE INDEX IF NOT EXISTS idx_test_data_points_test_id ON test_data_points(test_id);
 CREATE INDEX IF NOT EXISTS idx_test_data_points_timestamp ON test_data_points(timestamp);
+CREATE INDEX IF NOT EXISTS idx_test_break_points_test_id ON test_break_points(test_id);
+CREATE INDEX IF NOT EXISTS idx_test_raw_points_test_id ON test_raw_points(test_id);
 CREATE INDEX IF NOT EXISTS idx_samples_status ON samples(status);
 
 -- Trigger to update updated_at timestamp
@@ -1,14 +1,49 @@
 #include "DataExportController.h"
 #include "core/Logger.h"
+#include <QFileInfo>
+#include <QDir>
+#include <QRunnable>
+#include <QThread>
+#include <atomic>
 
 namespace HorizonUTM {
 
+/**
+ * @brief Background export job
+ *
+ * The tests and the cancel flag are shared with the worker thread;
+ * state is only touched on the controller thread.
+ */
+struct ExportJob {
+    int id = -1;
+    QVector<Test> tests;
+    QVector<int> testIds;           // loaded into tests by the worker
+    QString filePath;
+    QString format;
+    IExportService* service = nullptr;
+    bool toDirectory = false;       // one file per test in filePath
+    ExportJobState state = ExportJobState::Queued;
+    std::atomic<bool> cancelRequested{false};
+    int lastReportedPercent = -1;   // worker thread only
+};
+
 DataExportController::DataExportController(QObject* parent)
     : QObject(parent)
+    , m_nextJobId(1)
 {
+    qRegisterMetaType<HorizonUTM::ExportJobState>("HorizonUTM::ExportJobState");
+
+    // Leave one core for the GUI and acquisition
+    m_pool.setMaxThreadCount(qMax(1, QThread::idealThreadCount() - 1));
+
     LOG_INFO("DataExportController created");
 }
 
+DataExportController::~DataExportController() {
+    cancelAllExports();
+    m_pool.waitForDone();
+}
+
 void DataExportController::registerExportService(IExportService* service) {
     if (!service) {
         LOG_ERROR("Cannot register null export service");
@@ -31,6 +66,10 @@ QStringList DataExportController::getAvailableFormats() const {
     return formats;
 }
 
+void DataExportController::setTestLoader(ExportTestLoader loader) {
+    m_testLoader = std::move(loader);
+}
+
 bool DataExportController::exportTest(const Test& test, const QString& filePath, const QString& format) {
     IExportService* service = findService(format);
     
@@ -99,6 +138,133 @@ bool DataExportController::exportTests(const QVector<Test>& tests, const QString
     return success;
 }
 
+int DataExportController::submitExport(const QVector<Test>& tests, const QString& filePath, const QString& format) {
+    return enqueueJob(tests, {}, filePath, format, false);
+}
+
+int DataExportController::submitExport(const QVector<int>& testIds, const QString& filePath, const QString& format) {
+    return enqueueJob({}, testIds, filePath, format, false);
+}
+
+int DataExportController::submitBundleExport(const QVector<Test>& tests, const QString& dirPath, const QString& format) {
+    return enqueueJob(tests, {}, dirPath, format, true);
+}
+
+int DataExportController::submitBundleExport(const QVector<int>& testIds, const QString& dirPath, const QString& format) {
+    return enqueueJob({}, testIds, dirPath, format, true);
+}
+
+int DataExportController::enqueueJob(const QVector<Test>& tests, const QVector<int>& testIds,
+                                     const QString& path, const QString& format, bool toDirectory) {
+    IExportService* service = findService(format);
+
+    if (!service) {
+        QString error = QString("No export service found for format: %1").arg(format);
+        LOG_ERROR(error);
+        emit exportFailed(error);
+        return -1;
+    }
+
+    if (tests.isEmpty() && testIds.isEmpty()) {
+        QString error = "No tests to export";
+        LOG_WARNING(error);
+        emit exportFailed(error);
+        return -1;
+    }
+
+    if (!testIds.isEmpty() && !m_testLoader) {
+        QString error = "Cannot export stored tests: no test loader set";
+        LOG_ERROR(error);
+        emit exportFailed(error);
+        return -1;
+    }
+
+    const int testCount = tests.size() + testIds.size();
+    auto job = std::make_shared<ExportJob>();
+    job->id = m_nextJobId++;
+    job->tests = tests;
+    job->testIds = testIds;
+    job->filePath = path;
+    job->format = format.toLower();
+    job->service = service;
+    job->toDirectory = toDirectory;
+
+    m_jobs.insert(job->id, job);
+
+    LOG_INFO(QString("Export job %1 queued: %2 tests → %3")
+        .arg(job->id).arg(testCount).arg(path));
+    emit exportJobQueued(job->id, path);
+
+    m_pool.start(QRunnable::create([this, job]() { runJob(job); }));
+
+    return job->id;
+}
+
+QVector<int> DataExportController::submitExports(const QVector<Test>& tests,
+                                                 const QString& basePath,
+                                                 const QStringList& formats) {
+    QVector<int> jobIds;
+
+    QFileInfo baseInfo(basePath);
+    QString stem = baseInfo.dir().filePath(baseInfo.completeBaseName());
+
+    for (const QString& format : formats) {
+        int jobId = submitExport(tests, stem + "." + format.toLower(), format);
+        if (jobId > 0) {
+            jobIds.append(jobId);
+        }
+    }
+
+    return jobIds;
+}
+
+bool DataExportController::cancelExport(int jobId) {
+    auto it = m_jobs.find(jobId);
+    if (it == m_jobs.end()) {
+        return false;
+    }
+
+    const std::shared_ptr<ExportJob>& job = it.value();
+    if (job->state != ExportJobState::Queued && job->state != ExportJobState::Running) {
+        return false;
+    }
+
+    job->cancelRequested.store(true, std::memory_order_relaxed);
+    LOG_INFO(QString("Export job %1 cancellation requested").arg(jobId));
+    return true;
+}
+
+void DataExportController::cancelAllExports() {
+    for (auto it = m_jobs.begin(); it != m_jobs.end(); ++it) {
+        cancelExport(it.key());
+    }
+}
+
+ExportJobState DataExportController::getExportState(int jobId) const {
+    auto it = m_jobs.constFind(jobId);
+    if (it == m_jobs.constEnd()) {
+        return ExportJobState::Failed;
+    }
+    return it.value()->state;
+}
+
+int DataExportController::activeExportCount() const {
+    // Finished jobs are dropped in onJobFinished()
+    return m_jobs.size();
+}
+
+void DataExportController::setMaxConcurrentExports(int count) {
+    m_pool.setMaxThreadCount(qMax(1, count));
+}
+
+int DataExportController::maxConcurrentExports() const {
+    return m_pool.maxThreadCount();
+}
+
+bool DataExportController::waitForExports(int msecs) {
+    return m_pool.waitForDone(msecs);
+}
+
 QString DataExportController::getFileTypeDescription(const QString& format) const {
     IExportService* service = findService(format);
     
@@ -122,4 +288,111 @@ IExportService* DataExportController::findService(const QString& format) const {
     return nullptr;
 }
 
+void DataExportController::runJob(const std::shared_ptr<ExportJob>& job) {
+    // Worker thread: only the shared job payload and the cancel flag are used here,
+    // everything else is marshalled back to the controller thread
+    const int jobId = job->id;
+
+    if (job->cancelRequested.load(std::memory_order_relaxed)) {
+        job->tests.clear();
+        QMetaObject::invokeMethod(this, [this, jobId]() { onJobFinished(jobId, false); },
+                                  Qt::QueuedConnection);
+        return;
+    }
+
+    QMetaObject::invokeMethod(this, [this, jobId]() { onJobStarted(jobId); },
+                              Qt::QueuedConnection);
+
+    if (!loadTests(*job)) {
+        job->tests.clear();
+        QMetaObject::invokeMethod(this, [this, jobId]() { onJobFinished(jobId, false); },
+                                  Qt::QueuedConnection);
+        return;
+    }
+
+    ExportProgressCallback progress = [this, job, jobId](int completed, int total) {
+        // Throttle to whole percent steps so the event loop is not flooded
+        int percent = total > 0 ? (completed * 100) / total : 100;
+        if (percent != job->lastReportedPercent) {
+            job->lastReportedPercent = percent;
+            QMetaObject::invokeMethod(this, [this, jobId, completed, total]() {
+                onJobProgress(jobId, completed, total);
+            }, Qt::QueuedConnection);
+        }
+        return !job->cancelRequested.load(std::memory_order_relaxed);
+    };
+
+    bool success = job->toDirectory
+        ? job->service->exportTestsToDirectory(job->tests, job->filePath, progress)
+        : job->service->exportTestsWithProgress(job->tests, job->filePath, progress);
+
+    // Drop our reference to the test data as soon as it is written
+    job->tests.clear();
+
+    QMetaObject::invokeMethod(this, [this, jobId, success]() { onJobFinished(jobId, success); },
+                              Qt::QueuedConnection);
+}
+
+bool DataExportController::loadTests(ExportJob& job) const {
+    job.tests.reserve(job.tests.size() + job.testIds.size());
+    for (int testId : job.testIds) {
+        if (job.cancelRequested.load(std::memory_order_relaxed)) {
+            return false;
+        }
+
+        Test test = m_testLoader(testId);
+        if (test.getId() != testId) {
+            LOG_ERROR(QString("Export job %1: cannot load test ID=%2").arg(job.id).arg(testId));
+            return false;
+        }
+        job.tests.append(test);
+    }
+    return true;
+}
+
+void DataExportController::onJobStarted(int jobId) {
+    auto it = m_jobs.find(jobId);
+    if (it == m_jobs.end()) {
+        return;
+    }
+
+    it.value()->state = ExportJobState::Running;
+    LOG_INFO(QString("Export job %1 started: %2").arg(jobId).arg(it.value()->filePath));
+    emit exportStarted();
+}
+
+void DataExportController::onJobProgress(int jobId, int completed, int total) {
+    emit exportProgress(jobId, completed, total);
+}
+
+void DataExportController::onJobFinished(int jobId, bool success) {
+    auto it = m_jobs.find(jobId);
+    if (it == m_jobs.end()) {
+        return;
+    }
+
+    // Keep our own reference: slots may queue new jobs and rehash m_jobs
+    std::shared_ptr<ExportJob> job = it.value();
+    QString filePath = job->filePath;
+
+    if (success) {
+        job->state = ExportJobState::Completed;
+        LOG_INFO(QString("Export job %1 completed: %2").arg(jobId).arg(filePath));
+        emit exportCompleted(filePath);
+    } else if (job->cancelRequested.load(std::memory_order_relaxed)) {
+        job->state = ExportJobState::Cancelled;
+        LOG_INFO(QString("Export job %1 cancelled").arg(jobId));
+    } else {
+        job->state = ExportJobState::Failed;
+        QString error = QString("Export failed: %1").arg(filePath);
+        LOG_ERROR(error);
+        emit exportFailed(error);
+    }
+
+    emit exportJobFinished(jobId, job->state, filePath);
+
+    // Only unfinished jobs are tracked; the signal above carried the outcome
+    m_jobs.remove(jobId);
+}
+
 } // namespace HorizonUTM
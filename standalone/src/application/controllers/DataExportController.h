@@ -3,34 +3,81 @@
 #include <QObject>
 #include <QString>
 #include <QVector>
+#include <QHash>
+#include <QThreadPool>
+#include <functional>
 #include <memory>
 #include "domain/interfaces/IExportService.h"
 #include "domain/entities/Test.h"
 
 namespace HorizonUTM {
 
+/**
+ * @brief State of a background export job
+ */
+enum class ExportJobState {
+    Queued,     ///< Waiting for a free worker
+    Running,    ///< Being written by a worker
+    Completed,  ///< Finished successfully
+    Failed,     ///< Export service reported an error
+    Cancelled   ///< Cancelled before completion
+};
+
+/**
+ * @brief Convert ExportJobState to string
+ */
+inline QString exportJobStateToString(ExportJobState state) {
+    switch (state) {
+        case ExportJobState::Queued:    return "Queued";
+        case ExportJobState::Running:   return "Running";
+        case ExportJobState::Completed: return "Completed";
+        case ExportJobState::Failed:    return "Failed";
+        case ExportJobState::Cancelled: return "Cancelled";
+        default:                        return "Unknown";
+    }
+}
+
+struct ExportJob;
+
+/**
+ * @brief Loads a test with its curve by id; called on export worker threads
+ */
+using ExportTestLoader = std::function<Test(int testId)>;
+
 /**
  * @brief Controller for data export operations
+ *
+ * Synchronous exports run on the caller's thread. Submitted exports are
+ * queued as background jobs on a worker pool; all job signals are
+ * delivered on the controller's thread.
  */
 class DataExportController : public QObject {
     Q_OBJECT
 
 public:
     explicit DataExportController(QObject* parent = nullptr);
-    ~DataExportController() override = default;
-    
+    ~DataExportController() override;
+
     /**
      * @brief Register export service
      * @param service Export service (CSV, PDF, etc.)
      */
     void registerExportService(IExportService* service);
-    
+
     /**
      * @brief Get available export formats
      * @return List of format extensions
      */
     QStringList getAvailableFormats() const;
-    
+
+    /**
+     * @brief Set how jobs submitted by test id load their tests
+     *
+     * The loader runs on the worker threads and must be thread-safe; the
+     * SQLite repository is, each thread uses its own connection.
+     */
+    void setTestLoader(ExportTestLoader loader);
+
     /**
      * @brief Export single test
      * @param test Test to export
@@ -39,7 +86,7 @@ public:
      * @return true if successful
      */
     bool exportTest(const Test& test, const QString& filePath, const QString& format = "csv");
-    
+
     /**
      * @brief Export multiple tests
      * @param tests Tests to export
@@ -48,7 +95,86 @@ public:
      * @return true if successful
      */
     bool exportTests(const QVector<Test>& tests, const QString& filePath, const QString& format = "csv");
-    
+
+    /**
+     * @brief Queue a background export job
+     * @param tests Tests to export (shared, not deep-copied)
+     * @param filePath Output file path
+     * @param format Export format
+     * @return Job ID, or -1 if the job could not be queued
+     */
+    int submitExport(const QVector<Test>& tests, const QString& filePath, const QString& format = "csv");
+
+    /**
+     * @brief Queue a background export job for stored tests
+     *
+     * The tests are loaded by the worker through the test loader, so the
+     * caller's thread never reads curves.
+     * @param testIds Tests to export
+     * @return Job ID, or -1 if the job could not be queued
+     */
+    int submitExport(const QVector<int>& testIds, const QString& filePath, const QString& format = "csv");
+
+    /**
+     * @brief Queue one background job per format, exported concurrently
+     * @param tests Tests to export
+     * @param basePath Output path; its suffix is replaced by each format
+     * @param formats Export formats
+     * @return IDs of the queued jobs
+     */
+    QVector<int> submitExports(const QVector<Test>& tests, const QString& basePath, const QStringList& formats);
+
+    /**
+     * @brief Queue a background job writing one file per test into a directory
+     * @param tests Tests to export
+     * @param dirPath Output directory (created if missing)
+     * @param format Export format
+     * @return Job ID, or -1 if the job could not be queued
+     */
+    int submitBundleExport(const QVector<Test>& tests, const QString& dirPath, const QString& format = "csv");
+
+    /**
+     * @brief Queue a one-file-per-test job for stored tests, loaded by the worker
+     */
+    int submitBundleExport(const QVector<int>& testIds, const QString& dirPath, const QString& format = "csv");
+
+    /**
+     * @brief Request cancellation of a queued or running job
+     * @return true if the job exists and had not finished yet
+     */
+    bool cancelExport(int jobId);
+
+    /**
+     * @brief Request cancellation of all unfinished jobs
+     */
+    void cancelAllExports();
+
+    /**
+     * @brief Get state of an unfinished job
+     *
+     * Jobs are forgotten once exportJobFinished() has reported their
+     * outcome; unknown ids report Failed.
+     */
+    ExportJobState getExportState(int jobId) const;
+
+    /**
+     * @brief Number of queued or running jobs
+     */
+    int activeExportCount() const;
+
+    /**
+     * @brief Maximum number of jobs exported at the same time
+     */
+    void setMaxConcurrentExports(int count);
+    int maxConcurrentExports() const;
+
+    /**
+     * @brief Block until all workers are idle (for shutdown and headless use)
+     * @param msecs Timeout, -1 waits forever
+     * @return true if all jobs finished
+     */
+    bool waitForExports(int msecs = -1);
+
     /**
      * @brief Get file type description for format
      */
@@ -59,25 +185,71 @@ signals:
      * @brief Emitted when export starts
      */
     void exportStarted();
-    
+
     /**
      * @brief Emitted when export completes
      */
     void exportCompleted(const QString& filePath);
-    
+
     /**
      * @brief Emitted on export error
      */
     void exportFailed(const QString& error);
 
+    /**
+     * @brief Emitted when a background job is queued
+     */
+    void exportJobQueued(int jobId, const QString& filePath);
+
+    /**
+     * @brief Emitted as a background job makes progress
+     */
+    void exportProgress(int jobId, int completed, int total);
+
+    /**
+     * @brief Emitted when a background job finishes, fails or is cancelled
+     */
+    void exportJobFinished(int jobId, ExportJobState state, const QString& filePath);
+
 private:
     /**
      * @brief Find export service by format
      */
     IExportService* findService(const QString& format) const;
 
+    /**
+     * @brief Validate and queue a job
+     */
+    int enqueueJob(const QVector<Test>& tests, const QVector<int>& testIds,
+                   const QString& path, const QString& format, bool toDirectory);
+
+    /**
+     * @brief Load the tests of a job submitted by id (worker thread)
+     * @return false if a test could not be loaded or the job was cancelled
+     */
+    bool loadTests(ExportJob& job) const;
+
+    /**
+     * @brief Run a job on a worker thread
+     */
+    void runJob(const std::shared_ptr<ExportJob>& job);
+
+    /**
+     * @brief Handle job state changes (controller thread)
+     */
+    void onJobStarted(int jobId);
+    void onJobProgress(int jobId, int completed, int total);
+    void onJobFinished(int jobId, bool success);
+
 private:
     QVector<IExportService*> m_exportServices;
+    ExportTestLoader m_testLoader;
+
+    QThreadPool m_pool;
+    QHash<int, std::shared_ptr<ExportJob>> m_jobs;    // Queued and running only
+    int m_nextJobId;
 };
 
 } // namespace HorizonUTM
+
+Q_DECLARE_METATYPE(HorizonUTM::ExportJobState)
@@ -0,0 +1,167 @@
+#include "FrameManager.h"
+#include "HardwareController.h"
+#include "TestFinalizer.h"
+#include "core/Logger.h"
+#include <QThread>
+
+namespace HorizonUTM {
+
+FrameManager::FrameManager(TestController* testController, QObject* parent)
+    : QObject(parent)
+    , m_testController(testController)
+    , m_finalizer(new TestFinalizer(testController, this))
+{
+}
+
+FrameManager::~FrameManager() {
+    shutdown();
+}
+
+int FrameManager::addFrame(IUTMDriver* driver, const QString& name, bool dedicatedThread) {
+    const int index = m_frames.size();
+
+    Frame frame;
+    frame.name = name;
+    frame.driver = driver;
+    frame.controller = new HardwareController(driver, m_testController, m_finalizer);
+
+    if (dedicatedThread) {
+        frame.thread = new QThread(this);
+        frame.thread->setObjectName(name);
+        driver->moveToThread(frame.thread);
+        frame.controller->moveToThread(frame.thread);
+        frame.thread->start();
+    }
+
+    HardwareController* controller = frame.controller;
+    connect(controller, &HardwareController::testStarted, this, [this, index](int testId) {
+        emit testStarted(index, testId);
+    });
+    connect(controller, &HardwareController::testCompleted, this, [this, index](int testId) {
+        emit testEnded(index, testId);
+    });
+    connect(controller, &HardwareController::testStopped, this, [this, index](int testId) {
+        emit testEnded(index, testId);
+    });
+    connect(controller, &HardwareController::testFinalized, this, [this, index](int testId, bool saved) {
+        emit testFinalized(index, testId, saved);
+    });
+    connect(controller, &HardwareController::errorOccurred, this, [this, index](const QString& error) {
+        emit errorOccurred(index, error);
+    });
+
+    m_frames.append(frame);
+
+    LOG_INFO(QString("Frame %1 added: %2%3")
+        .arg(index).arg(name).arg(dedicatedThread ? " (own thread)" : ""));
+    return index;
+}
+
+QString FrameManager::frameName(int index) const {
+    return m_frames.value(index).name;
+}
+
+HardwareController* FrameManager::frame(int index) const {
+    return m_frames.value(index).controller;
+}
+
+template<typename Function>
+void FrameManager::post(int index, Function function) {
+    if (index < 0 || index >= m_frames.size()) {
+        LOG_ERROR(QString("No frame %1").arg(index));
+        return;
+    }
+
+    HardwareController* controller = m_frames[index].controller;
+    QMetaObject::invokeMethod(controller, [controller, function]() mutable {
+        function(controller);
+    }, Qt::AutoConnection);
+}
+
+void FrameManager::connectFrame(int index, const QString& connectionString) {
+    post(index, [connectionString](HardwareController* controller) {
+        controller->connectToHardware(connectionString);
+    });
+}
+
+void FrameManager::startTest(int index, const Test& test) {
+    post(index, [test](HardwareController* controller) mutable {
+        controller->startTest(test);
+    });
+}
+
+void FrameManager::stopTest(int index) {
+    post(index, [](HardwareController* controller) {
+        controller->stopTest();
+    });
+}
+
+void FrameManager::setLiveBufferBudget(qint64 budgetBytes, CurveSpillStoreFactory storeFactory) {
+    for (int index = 0; index < m_frames.size(); ++index) {
+        post(index, [budgetBytes, storeFactory](HardwareController* controller) {
+            controller->setLiveBufferBudget(budgetBytes, storeFactory);
+        });
+    }
+}
+
+void FrameManager::setFilter(const FilterSettings& settings) {
+    for (int index = 0; index < m_frames.size(); ++index) {
+        post(index, [settings](HardwareController* controller) {
+            controller->setFilter(settings);
+        });
+    }
+}
+
+void FrameManager::setRecordingPolicy(const RecordingSettings& settings) {
+    for (int index = 0; index < m_frames.size(); ++index) {
+        post(index, [settings](HardwareController* controller) {
+            controller->setRecordingPolicy(settings);
+        });
+    }
+}
+
+void FrameManager::setBreakCapture(const BreakCaptureSettings& settings) {
+    for (int index = 0; index < m_frames.size(); ++index) {
+        post(index, [settings](HardwareController* controller) {
+            controller->setBreakCapture(settings);
+        });
+    }
+}
+
+void FrameManager::setBreakDetector(const BreakDetectorSettings& settings) {
+    for (int index = 0; index < m_frames.size(); ++index) {
+        post(index, [settings](HardwareController* controller) {
+            controller->setBreakDetector(settings);
+        });
+    }
+}
+
+bool FrameManager::waitForFinalization(int msecs) {
+    return m_finalizer->waitForDone(msecs);
+}
+
+void FrameManager::shutdown() {
+    for (Frame& frame : m_frames) {
+        if (frame.thread) {
+            // Objects can only be pushed away from their own thread
+            QThread* home = thread();
+            QMetaObject::invokeMethod(frame.controller, [&frame, home]() {
+                frame.controller->moveToThread(home);
+                frame.driver->moveToThread(home);
+            }, Qt::BlockingQueuedConnection);
+
+            frame.thread->quit();
+            frame.thread->wait();
+            delete frame.thread;
+        }
+
+        // Stops a running test and disconnects
+        delete frame.controller;
+        delete frame.driver;
+    }
+    m_frames.clear();
+
+    m_finalizer->waitForDone();
+}
+
+} // namespace HorizonUTM
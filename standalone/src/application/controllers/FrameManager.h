@@ -0,0 +1,132 @@
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QVector>
+#include <memory>
+#include "domain/interfaces/IUTMDriver.h"
+#include "domain/interfaces/ICurveSpillStore.h"
+#include "domain/entities/Test.h"
+#include "domain/services/BreakCapture.h"
+#include "domain/services/BreakDetector.h"
+#include "domain/services/RecordingPolicy.h"
+#include "domain/services/SignalFilter.h"
+
+class QThread;
+
+namespace HorizonUTM {
+
+class HardwareController;
+class TestController;
+class TestFinalizer;
+
+/**
+ * @brief Runs several test frames from one process
+ *
+ * Each frame is a driver with its own HardwareController, i.e. its own
+ * test state and curve. Frames added with a dedicated thread acquire on
+ * that thread, so a busy frame does not hold up the others or the GUI.
+ * Finished tests of all frames go through one TestFinalizer, which writes
+ * their curves and results; startTest() only inserts the test row, from
+ * the frame's thread. Frame signals are re-emitted on the manager's
+ * thread with the frame index.
+ */
+class FrameManager : public QObject {
+    Q_OBJECT
+
+public:
+    explicit FrameManager(TestController* testController, QObject* parent = nullptr);
+    ~FrameManager() override;
+
+    /**
+     * @brief Add a frame
+     * @param driver Driver of the frame, ownership is taken
+     * @param name Display name
+     * @param dedicatedThread Run driver and controller on their own thread;
+     *        otherwise they stay on the manager's thread and may be called
+     *        directly (as the GUI does for the primary frame)
+     * @return Frame index
+     */
+    int addFrame(IUTMDriver* driver, const QString& name, bool dedicatedThread = true);
+
+    int frameCount() const { return m_frames.size(); }
+    QString frameName(int index) const;
+
+    /**
+     * @brief Controller of a frame
+     *
+     * Only call it directly for frames without a dedicated thread; use
+     * the methods below for the others.
+     */
+    HardwareController* frame(int index) const;
+
+    TestFinalizer* finalizer() const { return m_finalizer; }
+
+    // Thread-safe commands, run on the frame's thread
+    void connectFrame(int index, const QString& connectionString = "mock");
+    void startTest(int index, const Test& test);
+    void stopTest(int index);
+
+    /**
+     * @brief Bound the live curve RAM of every frame added so far
+     * @param budgetBytes Per frame
+     * @param storeFactory Creates the spill store of each test
+     */
+    void setLiveBufferBudget(qint64 budgetBytes, CurveSpillStoreFactory storeFactory);
+
+    /**
+     * @brief Set the acquisition filter of every frame added so far
+     */
+    void setFilter(const FilterSettings& settings);
+
+    /**
+     * @brief Set the recording policy of every frame added so far
+     */
+    void setRecordingPolicy(const RecordingSettings& settings);
+
+    /**
+     * @brief Set the break capture of every frame added so far
+     */
+    void setBreakCapture(const BreakCaptureSettings& settings);
+
+    /**
+     * @brief Set the break detector of every frame added so far
+     */
+    void setBreakDetector(const BreakDetectorSettings& settings);
+
+    /**
+     * @brief Block until the finished tests of all frames are saved
+     */
+    bool waitForFinalization(int msecs = -1);
+
+    /**
+     * @brief Stop running tests, disconnect and destroy all frames
+     */
+    void shutdown();
+
+signals:
+    void testStarted(int frameIndex, int testId);
+    void testEnded(int frameIndex, int testId);
+    void testFinalized(int frameIndex, int testId, bool saved);
+    void errorOccurred(int frameIndex, const QString& error);
+
+private:
+    struct Frame {
+        QString name;
+        IUTMDriver* driver = nullptr;
+        HardwareController* controller = nullptr;
+        QThread* thread = nullptr;          // nullptr: manager's thread
+    };
+
+    /**
+     * @brief Run a call on the frame's thread
+     */
+    template<typename Function>
+    void post(int index, Function function);
+
+    TestController* m_testController;
+    TestFinalizer* m_finalizer;
+    QVector<Frame> m_frames;
+};
+
+} // namespace HorizonUTM
@@ -1,61 +1,93 @@
 #include "HardwareController.h"
 #include "TestController.h"
+#include "TestFinalizer.h"
+#include "core/Constants.h"
 #include "core/Logger.h"
-#include <QDebug>
+#include "core/LogThrottle.h"
 #include <QMetaType>
 
 namespace HorizonUTM {
 
 HardwareController::HardwareController(IUTMDriver* driver, TestController* testController, QObject* parent)
+    : HardwareController(driver, testController, nullptr, parent)
+{
+}
+
+HardwareController::HardwareController(IUTMDriver* driver, TestController* testController,
+                                       TestFinalizer* finalizer, QObject* parent)
     : QObject(parent)
     , m_driver(driver)
     , m_testController(testController)
+    , m_finalizer(finalizer ? finalizer : new TestFinalizer(testController, this))
     , m_currentTest(nullptr)
-    , m_testInProgress(false)
+    , m_liveBufferBudget(0)
+    , m_phase(TestPhase::Idle)
+    , m_settleTimer(new QTimer(this))
 {
     // Register metatypes for queued connections
     qRegisterMetaType<HorizonUTM::MachineState>("HorizonUTM::MachineState");
     qRegisterMetaType<HorizonUTM::SensorData>("HorizonUTM::SensorData");
+    qRegisterMetaType<HorizonUTM::TestResult>("HorizonUTM::TestResult");
 
     // Connect driver signals - using old SIGNAL/SLOT syntax for all
     bool ok1 = QObject::connect(m_driver, SIGNAL(connected()),
                                 this, SLOT(onDriverConnected()));
-    qDebug() << "=== Connected 'connected':" << ok1;
 
     bool ok2 = QObject::connect(m_driver, SIGNAL(disconnected()),
                                 this, SLOT(onDriverDisconnected()));
-    qDebug() << "=== Connected 'disconnected':" << ok2;
 
     bool ok3 = QObject::connect(m_driver, SIGNAL(testCompleted()),
                                 this, SLOT(onTestCompleted()));
-    qDebug() << "=== Connected 'testCompleted':" << ok3;
 
     bool ok4 = QObject::connect(m_driver, SIGNAL(errorOccurred(QString)),
                                 this, SLOT(onErrorOccurred(QString)));
-    qDebug() << "=== Connected 'errorOccurred':" << ok4;
 
     // For custom types, use old syntax WITHOUT namespace in both SIGNAL and SLOT
     bool ok5 = QObject::connect(m_driver, SIGNAL(stateChanged(MachineState)),
                                 this, SLOT(onStateChanged(MachineState)));
-    qDebug() << "=== Connected 'stateChanged':" << ok5;
 
     bool ok6 = QObject::connect(m_driver, SIGNAL(sensorDataReceived(SensorData)),
                                 this, SLOT(onSensorDataReceived(SensorData)));
-    qDebug() << "=== Connected 'sensorDataReceived':" << ok6;
+
+    bool ok7 = QObject::connect(m_driver, SIGNAL(sampleRateChanged(double)),
+                                this, SLOT(onSampleRateChanged(double)));
+
+    if (!(ok1 && ok2 && ok3 && ok4 && ok5 && ok6 && ok7)) {
+        LOG_ERROR("Failed to connect one or more driver signals");
+    }
+
+    m_settleTimer->setSingleShot(true);
+    connect(m_settleTimer, &QTimer::timeout, this, &HardwareController::onSettleTimeout);
+
+    // A shared finalizer reports the tests of every frame, forward only ours
+    connect(m_finalizer, &TestFinalizer::testAnalyzed, this, [this](int testId, const TestResult& result) {
+        if (m_finalizing.contains(testId)) {
+            emit testAnalyzed(testId, result);
+        }
+    });
+    connect(m_finalizer, &TestFinalizer::testFinalized, this, [this](int testId, bool saved) {
+        if (m_finalizing.remove(testId)) {
+            emit testFinalized(testId, saved);
+        }
+    });
 
     LOG_INFO("HardwareController created");
 }
 
 HardwareController::~HardwareController() {
-    if (m_testInProgress) {
-        stopTest();
+    if (m_phase != TestPhase::Idle) {
+        // No event loop left to wait for the machine to settle
+        m_driver->stopTest();
+        if (m_phase != TestPhase::Idle) {
+            finishAcquisition(TestStatus::Stopped);
+        }
     }
 
     if (m_driver->isConnected()) {
         m_driver->disconnect();
     }
 
-    delete m_currentTest;
+    m_finalizer->waitForDone();
 }
 
 bool HardwareController::connectToHardware(const QString& connectionString) {
@@ -73,7 +105,7 @@ bool HardwareController::disconnectFromHardware() {
         return true;
     }
 
-    if (m_testInProgress) {
+    if (m_phase != TestPhase::Idle) {
         LOG_WARNING("Stopping test before disconnect");
         stopTest();
     }
@@ -97,7 +129,7 @@ bool HardwareController::startTest(Test& test) {
         return false;
     }
 
-    if (m_testInProgress) {
+    if (m_phase != TestPhase::Idle) {
         LOG_ERROR("Cannot start test: another test is in progress");
         emit errorOccurred("Test already in progress");
         return false;
@@ -121,6 +153,24 @@ bool HardwareController::startTest(Test& test) {
     m_currentTest->setStatus(TestStatus::Running);
     m_currentTest->setStartTime(QDateTime::currentDateTime());
     m_currentTest->clearData(); // Clear any existing data
+    m_curveBuilder.clear();
+    m_rawCurveBuilder.clear();
+
+    // A spill store per test, so its space is released with the test's curve
+    std::shared_ptr<ICurveSpillStore> store;
+    if (m_liveBufferBudget > 0 && m_spillStoreFactory) {
+        store = m_spillStoreFactory();
+    }
+    // Picks up a rate change that arrived during the previous test
+    applySampleRate();
+    // With the filter on, the raw curve is kept too: both share the one budget
+    const qint64 budget = m_filter.isEnabled() ? m_liveBufferBudget / 2 : m_liveBufferBudget;
+    m_curveBuilder.setMemoryBudget(budget, store);
+    m_rawCurveBuilder.setMemoryBudget(budget, store);
+    m_filter.reset();
+    m_recorder.reset();
+    m_breakDetector.reset();
+    m_breakCapture.reset();
 
     // Start hardware test
     if (!m_driver->startTest(test.getSpeed(), test.getForceLimit())) {
@@ -131,7 +181,7 @@ bool HardwareController::startTest(Test& test) {
         return false;
     }
 
-    m_testInProgress = true;
+    m_phase = TestPhase::Running;
 
     LOG_INFO(QString("Test started: ID=%1, Sample=%2")
         .arg(m_currentTest->getId()).arg(m_currentTest->getSampleName()));
@@ -142,39 +192,27 @@ bool HardwareController::startTest(Test& test) {
 }
 
 bool HardwareController::stopTest() {
-    if (!m_testInProgress || !m_currentTest) {
+    if (m_phase != TestPhase::Running || !m_currentTest) {
         LOG_WARNING("No test in progress");
         return false;
     }
 
     LOG_INFO(QString("Stopping test ID=%1").arg(m_currentTest->getId()));
 
-    // Stop hardware
-    m_driver->stopTest();
-
-    // Update test status
-    m_currentTest->setStatus(TestStatus::Stopped);
-    m_currentTest->setEndTime(QDateTime::currentDateTime());
+    m_phase = TestPhase::Stopping;
+    m_settleTimer->start(Constants::STOP_SETTLE_TIMEOUT_MS);
 
-    // Calculate results if we have data
-    if (m_currentTest->getDataPointCount() > 0) {
-        m_testController->completeTest(*m_currentTest);
+    // The driver reports the settled machine through stateChanged() or
+    // testCompleted(), possibly before this call returns
+    if (!m_driver->stopTest() && m_phase == TestPhase::Stopping) {
+        finishAcquisition(TestStatus::Stopped);
     }
 
-    int testId = m_currentTest->getId();
-
-    // Cleanup
-    delete m_currentTest;
-    m_currentTest = nullptr;
-    m_testInProgress = false;
-
-    emit testStopped(testId);
-
     return true;
 }
 
 bool HardwareController::pauseTest() {
-    if (!m_testInProgress) {
+    if (m_phase != TestPhase::Running) {
         return false;
     }
 
@@ -188,7 +226,7 @@ bool HardwareController::pauseTest() {
 }
 
 bool HardwareController::resumeTest() {
-    if (!m_testInProgress) {
+    if (m_phase != TestPhase::Running) {
         return false;
     }
 
@@ -207,7 +245,7 @@ bool HardwareController::zeroSensors() {
         return false;
     }
 
-    if (m_testInProgress) {
+    if (m_phase != TestPhase::Idle) {
         LOG_WARNING("Cannot zero sensors during test");
         return false;
     }
@@ -216,25 +254,97 @@ bool HardwareController::zeroSensors() {
 }
 
 bool HardwareController::isTestRunning() const {
-    return m_testInProgress;
+    return m_phase != TestPhase::Idle;
+}
+
+int HardwareController::pendingFinalizations() const {
+    return m_finalizing.size();
+}
+
+bool HardwareController::waitForFinalization(int msecs) {
+    return m_finalizer->waitForDone(msecs);
+}
+
+void HardwareController::setLiveBufferBudget(qint64 budgetBytes, CurveSpillStoreFactory storeFactory) {
+    m_liveBufferBudget = budgetBytes;
+    m_spillStoreFactory = std::move(storeFactory);
+    LOG_INFO(QString("Live curve buffer: %1 MB in RAM").arg(budgetBytes / (1024 * 1024)));
+}
+
+bool HardwareController::setFilter(const FilterSettings& settings) {
+    if (m_phase != TestPhase::Idle) {
+        LOG_WARNING("Cannot change the filter during a test");
+        return false;
+    }
+
+    m_filterSettings = settings;
+    if (!applySampleRate()) {
+        LOG_ERROR("Invalid filter settings, filtering disabled");
+        return false;
+    }
+
+    if (settings.isEnabled()) {
+        LOG_INFO(QString("Acquisition filter: %1 at %2 Hz, latency %3 ms")
+            .arg(filterTypeToString(settings.type)).arg(getFilter().sampleRateHz)
+            .arg(getFilter().latencyMs(), 0, 'f', 1));
+    }
+    return true;
+}
+
+bool HardwareController::setRecordingPolicy(const RecordingSettings& settings) {
+    if (m_phase != TestPhase::Idle) {
+        LOG_WARNING("Cannot change the recording policy during a test");
+        return false;
+    }
+
+    m_recorder.setSettings(settings);
+    if (settings.enabled) {
+        LOG_INFO(QString("Deadband recording: %1 N, %2 mm, at least every %3 ms")
+            .arg(settings.forceDeadband).arg(settings.extensionDeadband).arg(settings.maxIntervalMs));
+    }
+    return true;
+}
+
+bool HardwareController::setBreakCapture(const BreakCaptureSettings& settings) {
+    if (m_phase != TestPhase::Idle) {
+        LOG_WARNING("Cannot change the break capture during a test");
+        return false;
+    }
+
+    m_breakCapture.setSettings(settings);
+    applySampleRate();
+    if (settings.enabled) {
+        LOG_INFO(QString("Break capture: %1 ms before, %2 ms after the break")
+            .arg(settings.preTriggerMs).arg(settings.postTriggerMs));
+    }
+    return true;
+}
+
+bool HardwareController::setBreakDetector(const BreakDetectorSettings& settings) {
+    if (m_phase != TestPhase::Idle) {
+        LOG_WARNING("Cannot change the break detector during a test");
+        return false;
+    }
+
+    m_breakDetector.setSettings(settings);
+    LOG_INFO(QString("Break detection: %1 % force drop from %2 N")
+        .arg(settings.forceDropPercent).arg(settings.minForce));
+    return true;
 }
 
 // Private slots
 
 void HardwareController::onDriverConnected() {
-    qDebug() << "=== HardwareController::onDriverConnected SLOT CALLED ===";
     LOG_INFO("Driver connected");
-    qDebug() << "=== HardwareController: BEFORE emit hardwareConnected() ===";
     emit hardwareConnected();
-    qDebug() << "=== HardwareController: AFTER emit hardwareConnected() ===";
 }
 
 void HardwareController::onDriverDisconnected() {
     LOG_INFO("Driver disconnected");
 
-    // If test was in progress, stop it
-    if (m_testInProgress) {
-        stopTest();
+    // The machine is gone, keep what was acquired
+    if (m_phase != TestPhase::Idle) {
+        finishAcquisition(TestStatus::Stopped);
     }
 
     emit hardwareDisconnected();
@@ -243,64 +353,156 @@ void HardwareController::onDriverDisconnected() {
 void HardwareController::onStateChanged(MachineState state) {
     LOG_DEBUG(QString("Machine state changed: %1").arg(static_cast<int>(state)));
     emit machineStateChanged(state);
+
+    if (m_phase == TestPhase::Stopping && state == MachineState::Idle) {
+        finishAcquisition(TestStatus::Stopped);
+    }
 }
 
 void HardwareController::onSensorDataReceived(SensorData data) {
-    qDebug() << "=== HardwareController::onSensorDataReceived CALLED ===";
-    qDebug() << "=== m_testInProgress:" << m_testInProgress;
-    qDebug() << "=== m_currentTest:" << m_currentTest;
-
-    if (!m_testInProgress || !m_currentTest) {
-        qDebug() << "=== RETURNING: Test not in progress or currentTest is null ===";
+    if (m_phase == TestPhase::Idle || !m_currentTest) {
+        LOG_RATE_LIMITED(Debug, 1, 1000, "Sensor data ignored: no test in progress");
         return;
     }
 
+    // One break decision for the capture and the recorder, on the raw sample
+    const bool isBreak = m_breakDetector.process(data);
+    if (isBreak && m_breakDetector.triggerCount() > 1) {
+        LOG_INFO(QString("Test ID=%1: larger force drop at %2 N, break moved")
+            .arg(m_currentTest->getId()).arg(data.force, 0, 'f', 1));
+    }
+    if (m_breakCapture.isEnabled() && m_breakCapture.process(data, isBreak)) {
+        LOG_INFO(QString("Test ID=%1: break captured, %2 samples")
+            .arg(m_currentTest->getId()).arg(m_breakCapture.burst().size()));
+    }
+
+    if (m_filter.isEnabled()) {
+        m_rawCurveBuilder.append(data);
+        emit rawSensorDataReceived(data);
+        data = m_filter.process(data);
+    }
+
     // Process data through test controller
-    m_testController->processSensorData(*m_currentTest, data);
+    if (m_recorder.isEnabled()) {
+        RecordingEvent event = m_recorder.process(data, m_recorded, isBreak);
+        if (event != RecordingEvent::None) {
+            LOG_INFO(QString("Test ID=%1: %2 at %3 N, recording at full rate")
+                .arg(m_currentTest->getId()).arg(recordingEventToString(event)).arg(data.force, 0, 'f', 1));
+        }
+        for (const SensorData& sample : m_recorded) {
+            m_testController->processSensorData(*m_currentTest, m_curveBuilder, sample);
+        }
+    } else {
+        m_testController->processSensorData(*m_currentTest, m_curveBuilder, data);
+    }
+
+    LOG_EVERY_N(Debug, 1000, QString("Test ID=%1: %2 points, force=%3 N, strain=%4 %")
+        .arg(m_currentTest->getId()).arg(m_curveBuilder.size())
+        .arg(data.force, 0, 'f', 1).arg(data.strain, 0, 'f', 3));
 
     // Forward to UI
-    qDebug() << "=== EMITTING sensorDataReceived ===";
     emit sensorDataReceived(data);
 }
 
 void HardwareController::onTestCompleted() {
-    if (!m_testInProgress || !m_currentTest) {
+    if (m_phase == TestPhase::Idle || !m_currentTest) {
         return;
     }
 
-    LOG_INFO(QString("Test completed: ID=%1").arg(m_currentTest->getId()));
+    finishAcquisition(m_phase == TestPhase::Stopping ? TestStatus::Stopped : TestStatus::Completed);
+}
 
-    // Update test status
-    m_currentTest->setStatus(TestStatus::Completed);
-    m_currentTest->setEndTime(QDateTime::currentDateTime());
+void HardwareController::onErrorOccurred(const QString& error) {
+    LOG_ERROR(QString("Hardware error: %1").arg(error));
 
-    // Calculate final results
-    m_testController->completeTest(*m_currentTest);
+    // If test in progress, mark as failed
+    if (m_phase != TestPhase::Idle && m_currentTest) {
+        finishAcquisition(TestStatus::Failed);
+    }
 
-    int testId = m_currentTest->getId();
+    emit errorOccurred(error);
+}
 
-    // Cleanup
-    delete m_currentTest;
-    m_currentTest = nullptr;
-    m_testInProgress = false;
+void HardwareController::onSampleRateChanged(double rateHz) {
+    LOG_INFO(QString("Driver sample rate: %1 Hz").arg(rateHz, 0, 'f', 0));
 
-    emit testCompleted(testId);
+    // During a test the stages keep their design until startTest()
+    if (m_phase == TestPhase::Idle && !applySampleRate()) {
+        LOG_WARNING(QString("Filter cannot run at %1 Hz, filtering disabled").arg(rateHz, 0, 'f', 0));
+    }
 }
 
-void HardwareController::onErrorOccurred(const QString& error) {
-    LOG_ERROR(QString("Hardware error: %1").arg(error));
+void HardwareController::onSettleTimeout() {
+    if (m_phase != TestPhase::Stopping) {
+        return;
+    }
 
-    // If test in progress, mark as failed
-    if (m_testInProgress && m_currentTest) {
-        m_currentTest->setStatus(TestStatus::Failed);
-        m_testController->updateTest(*m_currentTest);
+    LOG_WARNING(QString("Machine did not settle within %1 ms, finishing test anyway")
+        .arg(Constants::STOP_SETTLE_TIMEOUT_MS));
+    finishAcquisition(TestStatus::Stopped);
+}
 
-        delete m_currentTest;
-        m_currentTest = nullptr;
-        m_testInProgress = false;
+bool HardwareController::applySampleRate() {
+    const double rateHz = m_driver->getSampleRateHz();
+    if (rateHz > 0.0) {
+        m_filterSettings.sampleRateHz = rateHz;
+
+        if (m_breakCapture.settings().sampleRateHz != rateHz) {
+            BreakCaptureSettings capture = m_breakCapture.settings();
+            capture.sampleRateHz = rateHz;
+            m_breakCapture.setSettings(capture);
+        }
+    }
+    return m_filter.setSettings(m_filterSettings);
+}
+
+void HardwareController::finishAcquisition(TestStatus status) {
+    m_settleTimer->stop();
+
+    if (m_recorder.isEnabled()) {
+        // The last sample ends the curve even if it was within the deadbands
+        m_recorder.flush(m_recorded);
+        for (const SensorData& sample : m_recorded) {
+            m_testController->processSensorData(*m_currentTest, m_curveBuilder, sample);
+        }
+        LOG_INFO(QString("Test ID=%1: stored %2 of %3 samples")
+            .arg(m_currentTest->getId()).arg(m_recorder.keptCount()).arg(m_recorder.seenCount()));
     }
 
-    emit errorOccurred(error);
+    // Publish the acquired curve
+    m_currentTest->extendCurve(m_curveBuilder.seal());
+    if (!m_rawCurveBuilder.isEmpty()) {
+        m_currentTest->setRawCurve(m_rawCurveBuilder.seal());
+    }
+    // The curves own the spilled segments now
+    m_curveBuilder.setMemoryBudget(m_liveBufferBudget, nullptr);
+    m_rawCurveBuilder.setMemoryBudget(m_liveBufferBudget, nullptr);
+    if (m_breakCapture.isTriggered()) {
+        // Post-trigger part is shorter if acquisition ended first
+        m_currentTest->setBreakBurst(m_breakCapture.burst());
+    }
+
+    // Update test status
+    m_currentTest->setStatus(status);
+    m_currentTest->setEndTime(QDateTime::currentDateTime());
+
+    int testId = m_currentTest->getId();
+    LOG_INFO(QString("Test %1: ID=%2, %3 points")
+        .arg(testStatusToString(status)).arg(testId).arg(m_currentTest->getDataPointCount()));
+
+    // Analysis and saving continue in the background
+    m_finalizing.insert(testId);
+    m_finalizer->finalize(*m_currentTest);
+
+    delete m_currentTest;
+    m_currentTest = nullptr;
+    m_phase = TestPhase::Idle;
+
+    if (status == TestStatus::Completed) {
+        emit testCompleted(testId);
+    } else if (status == TestStatus::Stopped) {
+        emit testStopped(testId);
+    }
 }
 
 } // namespace HorizonUTM
@@ -2,7 +2,14 @@
 
 #include <QObject>
 #include <QTimer>
+#include <QSet>
+#include <memory>
 #include "domain/interfaces/IUTMDriver.h"
+#include "domain/interfaces/ICurveSpillStore.h"
+#include "domain/services/BreakCapture.h"
+#include "domain/services/BreakDetector.h"
+#include "domain/services/RecordingPolicy.h"
+#include "domain/services/SignalFilter.h"
 #include "domain/entities/Test.h"
 #include "domain/value_objects/MachineState.h"
 #include "domain/value_objects/SensorData.h"
@@ -10,17 +17,37 @@
 namespace HorizonUTM {
 
 class TestController;
+class TestFinalizer;
+
+/**
+ * @brief Acquisition phase of the test on the machine
+ */
+enum class TestPhase {
+    Idle,       ///< No test on the machine
+    Running,    ///< Acquiring data (also while paused)
+    Stopping    ///< Stop requested, waiting for the machine to settle
+};
 
 /**
  * @brief Controller for hardware operations
  * 
- * Manages UTM driver and coordinates test execution
+ * Manages UTM driver and coordinates test execution. A test goes
+ * Running → Stopping → Idle on the machine without blocking; once the
+ * machine has settled, the test is handed to a TestFinalizer for analysis
+ * and saving, and the next test can start right away.
  */
 class HardwareController : public QObject {
     Q_OBJECT
 
 public:
     explicit HardwareController(IUTMDriver* driver, TestController* testController, QObject* parent = nullptr);
+    
+    /**
+     * @brief Controller handing finished tests to a shared finalizer
+     * @param finalizer Not owned; nullptr creates a private one
+     */
+    HardwareController(IUTMDriver* driver, TestController* testController,
+                       TestFinalizer* finalizer, QObject* parent = nullptr);
     ~HardwareController() override;
     
     /**
@@ -54,6 +81,9 @@ public:
     
     /**
      * @brief Stop current test
+     *
+     * Returns as soon as the stop is sent; testStopped() follows once the
+     * machine has settled.
      */
     bool stopTest();
     
@@ -77,10 +107,90 @@ public:
      */
     Test* getCurrentTest() const { return m_currentTest; }
     
+    /**
+     * @brief Unfiltered points acquired so far (empty without a filter)
+     */
+    Curve getLiveRawCurve() const { return m_rawCurveBuilder.snapshot(); }
+    
+    /**
+     * @brief Filter force, extension, stress and strain before they reach
+     *        the test's curve
+     *
+     * The raw samples are kept alongside: rawSensorDataReceived() and the
+     * test's raw curve. Filtered samples lag by settings.latencyMs().
+     * The filter is designed for the driver's sample rate when it reports
+     * one, and redesigned when that rate changes.
+     * @return false if a test is running or the settings are invalid
+     */
+    bool setFilter(const FilterSettings& settings);
+    const FilterSettings& getFilter() const { return m_filter.settings(); }
+    
+    /**
+     * @brief Store only the samples that change the curve
+     *
+     * Applies after the filter. The UI still receives every sample through
+     * sensorDataReceived(); the test's curve keeps what the policy keeps,
+     * at full rate around yield, peak and break, and lags acquisition by
+     * settings.eventWindowMs, up to settings.maxEventDelayMs while a
+     * maximum is unconfirmed, until the test ends.
+     * @return false if a test is running
+     */
+    bool setRecordingPolicy(const RecordingSettings& settings);
+    const RecordingSettings& getRecordingPolicy() const { return m_recorder.settings(); }
+    
+    /**
+     * @brief Keep the unfiltered samples around the specimen break at full rate
+     *
+     * The burst is stored with the test as its break burst, whatever the
+     * filter and recording policy did to the curve. The ring is sized for
+     * the driver's sample rate when it reports one.
+     * @return false if a test is running
+     */
+    bool setBreakCapture(const BreakCaptureSettings& settings);
+    const BreakCaptureSettings& getBreakCapture() const { return m_breakCapture.settings(); }
+    
+    /**
+     * @brief When the specimen broke, for the break capture and the recording policy
+     *
+     * Runs on the unfiltered samples, ahead of the filter.
+     * @return false if a test is running
+     */
+    bool setBreakDetector(const BreakDetectorSettings& settings);
+    const BreakDetectorSettings& getBreakDetector() const { return m_breakDetector.settings(); }
+    
+    /**
+     * @brief Bound the RAM used by the live curve
+     *
+     * Each test spills to a store of its own, which goes away with the
+     * test's curve once it is saved. Applies from the next test. With a
+     * filter enabled, the filtered and the raw curve get half each.
+     * @param budgetBytes Points kept in RAM; older blocks are spilled (0 = unbounded)
+     * @param storeFactory Creates the spill store of each test
+     */
+    void setLiveBufferBudget(qint64 budgetBytes, CurveSpillStoreFactory storeFactory);
+    
     /**
      * @brief Check if test is running
+     *
+     * True until the machine has settled after a stop.
      */
     bool isTestRunning() const;
+    
+    TestPhase getTestPhase() const { return m_phase; }
+    
+    /**
+     * @brief Tests still being analysed or saved in the background
+     */
+    int pendingFinalizations() const;
+    
+    /**
+     * @brief Block until all finished tests are analysed and saved
+     *
+     * With a shared finalizer this includes the tests of other frames.
+     * @param msecs Timeout, -1 for none
+     * @return false on timeout
+     */
+    bool waitForFinalization(int msecs = -1);
 
 signals:
     /**
@@ -103,6 +213,11 @@ signals:
      */
     void sensorDataReceived(SensorData data);
     
+    /**
+     * @brief Emitted with the unfiltered sample while a filter is active
+     */
+    void rawSensorDataReceived(SensorData data);
+    
     /**
      * @brief Emitted when test starts
      */
@@ -110,14 +225,27 @@ signals:
     
     /**
      * @brief Emitted when test completes
+     *
+     * The machine is free again; analysis and saving continue in the
+     * background.
      */
     void testCompleted(int testId);
     
     /**
-     * @brief Emitted when test is stopped
+     * @brief Emitted when a stopped test has settled
      */
     void testStopped(int testId);
     
+    /**
+     * @brief Emitted when the results of a finished test are calculated
+     */
+    void testAnalyzed(int testId, const TestResult& result);
+    
+    /**
+     * @brief Emitted when a finished test has been saved (or failed to)
+     */
+    void testFinalized(int testId, bool saved);
+    
     /**
      * @brief Emitted on error
      */
@@ -153,12 +281,46 @@ private slots:
      * @brief Handle errors
      */
     void onErrorOccurred(const QString& error);
+    
+    /**
+     * @brief Give up waiting for the machine to settle
+     */
+    void onSettleTimeout();
+    
+    /**
+     * @brief Redesign the rate-dependent stages, now or at the next test
+     */
+    void onSampleRateChanged(double rateHz);
 
 private:
+    /**
+     * @brief End acquisition and hand the test to the finalizer
+     */
+    void finishAcquisition(TestStatus status);
+
+    /**
+     * @brief Design the filter and break capture for the driver's sample rate
+     * @return false if the filter settings are invalid at that rate
+     */
+    bool applySampleRate();
+
     IUTMDriver* m_driver;
     TestController* m_testController;
+    TestFinalizer* m_finalizer;
     Test* m_currentTest;
-    bool m_testInProgress;
+    CurveBuilder m_curveBuilder;    // acquisition only
+    CurveBuilder m_rawCurveBuilder; // unfiltered, while m_filter is enabled
+    qint64 m_liveBufferBudget;
+    CurveSpillStoreFactory m_spillStoreFactory;
+    FilterSettings m_filterSettings; // as set, m_filter may have fallen back
+    SensorDataFilter m_filter;
+    RecordingPolicy m_recorder;
+    BreakDetector m_breakDetector;  // unfiltered
+    BreakCapture m_breakCapture;    // unfiltered
+    QVector<SensorData> m_recorded; // samples kept by m_recorder, reused
+    TestPhase m_phase;
+    QTimer* m_settleTimer;
+    QSet<int> m_finalizing;         // our tests still in the finalizer
 };
 
 } // namespace HorizonUTM
@@ -0,0 +1,288 @@
+#include "SampleQueueRunner.h"
+#include "HardwareController.h"
+#include "TestController.h"
+#include "core/Logger.h"
+#include <QDir>
+#include <QRegularExpression>
+#include <algorithm>
+
+namespace HorizonUTM {
+
+QString BatchReport::toString() const {
+    auto stage = [](const char* name, const StageTiming& timing) {
+        return QString("%1 %2 ms avg / %3 ms max")
+            .arg(name).arg(timing.meanMs(), 0, 'f', 0).arg(timing.maxMs);
+    };
+
+    QString text = QString("%1 specimens (%2 completed, %3 failed) in %4 s, %5 specimens/h")
+        .arg(specimens).arg(completed).arg(failed)
+        .arg(elapsedMs / 1000.0, 0, 'f', 1).arg(specimensPerHour(), 0, 'f', 1);
+    text += "; " + stage("setup", setup);
+    text += ", " + stage("acquisition", acquisition);
+    text += ", " + stage("analysis+save", finalization);
+    if (exporting.count > 0 || exportFailures > 0) {
+        text += ", " + stage("export", exporting);
+    }
+    return text;
+}
+
+SampleQueueRunner::SampleQueueRunner(HardwareController* hardwareController,
+                                     TestController* testController,
+                                     DataExportController* exportController,
+                                     QObject* parent)
+    : QObject(parent)
+    , m_hardwareController(hardwareController)
+    , m_testController(testController)
+    , m_exportController(exportController)
+    , m_nextIndex(0)
+    , m_acquiringTestId(-1)
+    , m_running(false)
+    , m_cancelRequested(false)
+{
+    connect(m_hardwareController, &HardwareController::testCompleted,
+            this, [this](int testId) { onTestEnded(testId, true); });
+    connect(m_hardwareController, &HardwareController::testStopped,
+            this, [this](int testId) { onTestEnded(testId, false); });
+    connect(m_hardwareController, &HardwareController::testFinalized,
+            this, &SampleQueueRunner::onTestFinalized);
+    connect(m_hardwareController, &HardwareController::errorOccurred,
+            this, &SampleQueueRunner::onHardwareError);
+
+    if (m_exportController) {
+        connect(m_exportController, &DataExportController::exportJobFinished,
+                this, &SampleQueueRunner::onExportJobFinished);
+    }
+}
+
+bool SampleQueueRunner::startBatch(const BatchOptions& options) {
+    if (m_running) {
+        LOG_WARNING("Sample batch already running");
+        return false;
+    }
+
+    if (!m_hardwareController->isConnected() || m_hardwareController->isTestRunning()) {
+        LOG_ERROR("Cannot start batch: hardware not connected or busy");
+        return false;
+    }
+
+    // Oldest first: the queue is worked in the order samples were added
+    QVector<Sample> ready = m_testController->getSamplesByStatus(SampleStatus::Ready);
+    std::sort(ready.begin(), ready.end(), [](const Sample& a, const Sample& b) {
+        if (a.getCreatedAt() != b.getCreatedAt()) {
+            return a.getCreatedAt() < b.getCreatedAt();
+        }
+        return a.getId() < b.getId();
+    });
+    if (options.maxSpecimens > 0 && ready.size() > options.maxSpecimens) {
+        ready.resize(options.maxSpecimens);
+    }
+    if (ready.isEmpty()) {
+        LOG_WARNING("Cannot start batch: no Ready samples");
+        return false;
+    }
+
+    m_options = options;
+    m_queue = ready;
+    m_nextIndex = 0;
+    m_acquiringTestId = -1;
+    m_inFlight.clear();
+    m_exportJobs.clear();
+    m_report = BatchReport();
+    m_cancelRequested = false;
+    m_running = true;
+    m_batchTimer.start();
+
+    LOG_INFO(QString("Sample batch started: %1 specimens").arg(m_queue.size()));
+    emit batchStarted(m_queue.size());
+
+    startNext();
+    return true;
+}
+
+void SampleQueueRunner::cancel() {
+    if (!m_running || m_cancelRequested) {
+        return;
+    }
+
+    LOG_INFO(QString("Sample batch cancelled, %1 specimens not started").arg(remainingCount()));
+    m_cancelRequested = true;
+
+    if (m_acquiringTestId > 0) {
+        m_hardwareController->stopTest();
+    }
+    finishBatchIfDone();
+}
+
+void SampleQueueRunner::startNext() {
+    while (!m_cancelRequested && m_nextIndex < m_queue.size()) {
+        SpecimenRun run;
+        run.sample = m_queue[m_nextIndex++];
+        run.stageTimer.start();
+        ++m_report.specimens;
+
+        run.sample.setStatus(SampleStatus::InProgress);
+        m_testController->updateSample(run.sample);
+
+        Test test = createTest(run.sample);
+        if (!m_hardwareController->startTest(test)) {
+            LOG_ERROR(QString("Could not start sample %1").arg(run.sample.getName()));
+            run.sample.setStatus(SampleStatus::Failed);
+            m_testController->updateSample(run.sample);
+            ++m_report.failed;
+            emit specimenFinished(run.sample.getId(), -1, false);
+            continue;
+        }
+
+        run.testId = test.getId();
+        m_report.setup.add(run.stageTimer.restart());
+
+        m_acquiringTestId = run.testId;
+        m_inFlight.insert(run.testId, run);
+
+        emit specimenStarted(run.sample.getId(), run.testId);
+        return;
+    }
+
+    finishBatchIfDone();
+}
+
+Test SampleQueueRunner::createTest(const Sample& sample) const {
+    Test test = m_testController->createNewTest();
+    test.setSampleName(sample.getName());
+    test.setOperatorName(sample.getOperatorName().isEmpty()
+        ? m_options.operatorName : sample.getOperatorName());
+    if (!sample.getTestMethod().isEmpty()) {
+        test.setTestMethod(sample.getTestMethod());
+    }
+    test.setWidth(sample.getWidth());
+    test.setThickness(sample.getThickness());
+    test.setGaugeLength(sample.getGaugeLength());
+    test.setSpeed(m_options.speedMmPerMin);
+    test.setForceLimit(m_options.forceLimitN);
+    test.setNotes(sample.getNotes());
+    return test;
+}
+
+void SampleQueueRunner::onTestEnded(int testId, bool completed) {
+    auto it = m_inFlight.find(testId);
+    if (it == m_inFlight.end()) {
+        return; // not ours
+    }
+
+    it->completed = completed;
+    m_report.acquisition.add(it->stageTimer.restart());
+    m_acquiringTestId = -1;
+
+    // The machine is free: overlap the next setup with this one's saving
+    startNext();
+}
+
+void SampleQueueRunner::onHardwareError(const QString& error) {
+    if (m_acquiringTestId < 0) {
+        return; // start failures are handled in startNext()
+    }
+
+    auto it = m_inFlight.find(m_acquiringTestId);
+    if (it != m_inFlight.end()) {
+        LOG_ERROR(QString("Sample %1 failed: %2").arg(it->sample.getName()).arg(error));
+        it->completed = false;
+        m_report.acquisition.add(it->stageTimer.restart());
+    }
+    m_acquiringTestId = -1;
+
+    // Let the driver finish reporting before the next start
+    QMetaObject::invokeMethod(this, [this]() { startNext(); }, Qt::QueuedConnection);
+}
+
+void SampleQueueRunner::onTestFinalized(int testId, bool saved) {
+    auto it = m_inFlight.find(testId);
+    if (it == m_inFlight.end()) {
+        return;
+    }
+
+    m_report.finalization.add(it->stageTimer.restart());
+
+    if (saved && it->completed && m_exportController && !m_options.exportDirectory.isEmpty()) {
+        startExport(*it);
+        return;
+    }
+
+    finishSpecimen(testId, saved && it->completed);
+}
+
+void SampleQueueRunner::startExport(SpecimenRun& run) {
+    QString name = run.sample.getName();
+    name.replace(QRegularExpression("[^A-Za-z0-9_.-]"), "_");
+
+    QDir dir(m_options.exportDirectory);
+    QString path = dir.filePath(QString("%1_%2.%3")
+        .arg(name).arg(run.testId).arg(m_options.exportFormat.toLower()));
+
+    // The worker loads the curve, not the GUI thread
+    int jobId = m_exportController->submitExport(QVector<int>{run.testId}, path, m_options.exportFormat);
+    if (jobId < 0) {
+        ++m_report.exportFailures;
+        finishSpecimen(run.testId, true);
+        return;
+    }
+
+    m_exportJobs.insert(jobId, run.testId);
+}
+
+void SampleQueueRunner::onExportJobFinished(int jobId, ExportJobState state, const QString& filePath) {
+    auto job = m_exportJobs.find(jobId);
+    if (job == m_exportJobs.end()) {
+        return;
+    }
+
+    int testId = job.value();
+    m_exportJobs.erase(job);
+
+    auto it = m_inFlight.find(testId);
+    if (it == m_inFlight.end()) {
+        return;
+    }
+
+    if (state == ExportJobState::Completed) {
+        m_report.exporting.add(it->stageTimer.elapsed());
+    } else {
+        LOG_WARNING(QString("Export of test ID=%1 to %2 failed").arg(testId).arg(filePath));
+        ++m_report.exportFailures;
+    }
+
+    // The test itself is saved, a failed export does not fail the specimen
+    finishSpecimen(testId, true);
+}
+
+void SampleQueueRunner::finishSpecimen(int testId, bool success) {
+    SpecimenRun run = m_inFlight.take(testId);
+
+    run.sample.setStatus(success ? SampleStatus::Completed : SampleStatus::Failed);
+    m_testController->updateSample(run.sample);
+
+    if (success) {
+        ++m_report.completed;
+    } else {
+        ++m_report.failed;
+    }
+
+    emit specimenFinished(run.sample.getId(), testId, success);
+    finishBatchIfDone();
+}
+
+void SampleQueueRunner::finishBatchIfDone() {
+    if (!m_running || m_acquiringTestId > 0 || !m_inFlight.isEmpty()) {
+        return;
+    }
+    if (!m_cancelRequested && m_nextIndex < m_queue.size()) {
+        return;
+    }
+
+    m_running = false;
+    m_report.elapsedMs = m_batchTimer.elapsed();
+
+    LOG_INFO(QString("Sample batch finished: %1").arg(m_report.toString()));
+    emit batchFinished(m_report);
+}
+
+} // namespace HorizonUTM
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QString>
+#include <QVector>
+#include "application/controllers/DataExportController.h"
+#include "domain/entities/Sample.h"
+#include "domain/entities/Test.h"
+#include "core/Constants.h"
+
+namespace HorizonUTM {
+
+class HardwareController;
+class TestController;
+
+/**
+ * @brief Accumulated wall time of one pipeline stage
+ */
+struct StageTiming {
+    int count = 0;
+    qint64 totalMs = 0;
+    qint64 maxMs = 0;
+
+    void add(qint64 ms) {
+        ++count;
+        totalMs += ms;
+        maxMs = qMax(maxMs, ms);
+    }
+
+    double meanMs() const { return count > 0 ? double(totalMs) / count : 0.0; }
+};
+
+/**
+ * @brief Throughput and stage timings of a batch
+ */
+struct BatchReport {
+    int specimens = 0;          ///< Samples taken from the queue
+    int completed = 0;          ///< Tested to completion and saved
+    int failed = 0;             ///< Failed to start, errored, stopped or not saved
+    int exportFailures = 0;
+    qint64 elapsedMs = 0;       ///< First setup to last specimen finished
+
+    StageTiming setup;          ///< Sample to running test
+    StageTiming acquisition;    ///< Running test to machine free
+    StageTiming finalization;   ///< Machine free to analysed and saved
+    StageTiming exporting;      ///< Saved to exported
+
+    double specimensPerHour() const {
+        return elapsedMs > 0 ? specimens * 3600000.0 / elapsedMs : 0.0;
+    }
+
+    QString toString() const;
+};
+
+/**
+ * @brief Batch options
+ */
+struct BatchOptions {
+    double speedMmPerMin = Constants::DEFAULT_SPEED_MM_PER_MIN;
+    double forceLimitN = Constants::DEFAULT_FORCE_LIMIT_N;
+    int maxSpecimens = 0;       ///< 0 = every Ready sample
+    QString operatorName;       ///< For samples that have none
+    QString exportDirectory;    ///< Empty = no export
+    QString exportFormat = "csv";
+};
+
+/**
+ * @brief Runs the Ready samples of the queue as one batch
+ *
+ * Each sample becomes a Test that runs on the machine back-to-back with
+ * the next one. Stages are pipelined: as soon as the machine is free the
+ * next specimen is set up and started, while the previous one is still
+ * being analysed and saved (HardwareController's finalizer) and exported
+ * (DataExportController's workers).
+ */
+class SampleQueueRunner : public QObject {
+    Q_OBJECT
+
+public:
+    /**
+     * @param exportController Used for the export stage; may be nullptr
+     */
+    SampleQueueRunner(HardwareController* hardwareController,
+                      TestController* testController,
+                      DataExportController* exportController = nullptr,
+                      QObject* parent = nullptr);
+    ~SampleQueueRunner() override = default;
+
+    /**
+     * @brief Take the Ready samples and start running them
+     * @return false if a batch or test is running, the hardware is not
+     *         connected or no sample is Ready
+     */
+    bool startBatch(const BatchOptions& options = BatchOptions());
+
+    /**
+     * @brief Stop the running specimen and start no further ones
+     *
+     * Specimens already in the pipeline are still saved; samples not yet
+     * started stay Ready.
+     */
+    void cancel();
+
+    bool isRunning() const { return m_running; }
+
+    /**
+     * @brief Samples of the batch not started yet
+     */
+    int remainingCount() const { return m_queue.size() - m_nextIndex; }
+
+    /**
+     * @brief Report of the running or last batch
+     */
+    const BatchReport& report() const { return m_report; }
+
+signals:
+    void batchStarted(int specimenCount);
+    void specimenStarted(int sampleId, int testId);
+    void specimenFinished(int sampleId, int testId, bool success);
+    void batchFinished(const BatchReport& report);
+
+private slots:
+    void onTestEnded(int testId, bool completed);
+    void onTestFinalized(int testId, bool saved);
+    void onExportJobFinished(int jobId, ExportJobState state, const QString& filePath);
+    void onHardwareError(const QString& error);
+
+private:
+    struct SpecimenRun {
+        Sample sample;
+        int testId = -1;
+        bool completed = false;
+        QElapsedTimer stageTimer;
+    };
+
+    /**
+     * @brief Set up and start the next sample, if any
+     */
+    void startNext();
+
+    Test createTest(const Sample& sample) const;
+    void startExport(SpecimenRun& run);
+    void finishSpecimen(int testId, bool success);
+    void finishBatchIfDone();
+
+    HardwareController* m_hardwareController;
+    TestController* m_testController;
+    DataExportController* m_exportController;
+
+    BatchOptions m_options;
+    QVector<Sample> m_queue;
+    int m_nextIndex;
+    int m_acquiringTestId;              // -1 while the machine is free
+    QHash<int, SpecimenRun> m_inFlight; // by test ID
+    QHash<int, int> m_exportJobs;       // job ID -> test ID
+    bool m_running;
+    bool m_cancelRequested;
+
+    BatchReport m_report;
+    QElapsedTimer m_batchTimer;
+};
+
+} // namespace HorizonUTM
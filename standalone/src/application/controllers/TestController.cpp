@@ -89,27 +89,28 @@ QVector<Test> TestController::getTestsByStatus(TestStatus status) {
     return m_repository->getTestsByStatus(status);
 }
 
-void TestController::processSensorData(Test& test, const SensorData& data) {
-    // Add data point to test
-    test.addDataPoint(data);
+void TestController::processSensorData(const Test& test, CurveBuilder& curve, const SensorData& data) {
+    // Add data point to the test's curve
+    curve.append(data);
 
     // Log periodically (every 100 points)
-    if (test.getDataPointCount() % 100 == 0) {
+    if (curve.size() % 100 == 0) {
         LOG_DEBUG(QString("Processed %1 data points for test ID=%2")
-            .arg(test.getDataPointCount()).arg(test.getId()));
+            .arg(curve.size()).arg(test.getId()));
     }
 }
 
 TestResult TestController::calculateResults(const Test& test) {
-    if (test.getData().isEmpty()) {
+    if (test.getCurve().isEmpty()) {
         LOG_WARNING("Cannot calculate results: no data");
         return TestResult();
     }
 
     TestResult result = StressStrainCalculator::calculateResults(
-        test.getData(),
+        test.getCurve(),
         test.getCrossSectionArea(),
-        test.getGaugeLength()
+        test.getGaugeLength(),
+        m_modulusMethod
     );
 
     LOG_INFO(QString("Results calculated: Max Stress=%1 MPa, E=%2 GPa")
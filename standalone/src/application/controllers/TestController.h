@@ -67,10 +67,11 @@ public:
     
     /**
      * @brief Process new sensor data point
-     * @param test Test to update
+     * @param test Test being acquired
+     * @param curve Builder collecting the test's curve
      * @param data Sensor data
      */
-    void processSensorData(Test& test, const SensorData& data);
+    void processSensorData(const Test& test, CurveBuilder& curve, const SensorData& data);
     
     /**
      * @brief Calculate final test results
@@ -79,6 +80,13 @@ public:
      */
     TestResult calculateResults(const Test& test);
     
+    /**
+     * @brief Set how calculateResults() determines the elastic modulus
+     * @note Set before tests are finalized; not synchronized with them
+     */
+    void setModulusMethod(ModulusMethod method) { m_modulusMethod = method; }
+    ModulusMethod modulusMethod() const { return m_modulusMethod; }
+    
     /**
      * @brief Complete test and calculate final results
      * @param test Test to complete
@@ -122,6 +130,7 @@ signals:
 
 private:
     ITestRepository* m_repository;
+    ModulusMethod m_modulusMethod = ModulusMethod::LinearRegion;
 };
 
 } // namespace HorizonUTM
@@ -0,0 +1,67 @@
+#include "TestFinalizer.h"
+#include "TestController.h"
+#include "core/Logger.h"
+#include <QRunnable>
+
+namespace HorizonUTM {
+
+TestFinalizer::TestFinalizer(TestController* testController, QObject* parent)
+    : QObject(parent)
+    , m_testController(testController)
+    , m_pending(0)
+{
+    // One worker keeps saves ordered and off each other's transactions
+    m_pool.setMaxThreadCount(1);
+}
+
+TestFinalizer::~TestFinalizer() {
+    m_pool.waitForDone();
+}
+
+void TestFinalizer::finalize(const Test& test) {
+    int pending = ++m_pending;
+
+    LOG_DEBUG(QString("Test ID=%1 queued for finalization (%2 pending)")
+        .arg(test.getId()).arg(pending));
+
+    // The copy shares the curve, so queueing costs no point copies
+    m_pool.start(QRunnable::create([this, test]() { run(test); }));
+}
+
+bool TestFinalizer::waitForDone(int msecs) {
+    return m_pool.waitForDone(msecs);
+}
+
+void TestFinalizer::run(Test test) {
+    const int testId = test.getId();
+
+    // Analysis
+    if (test.getStatus() != TestStatus::Failed && !test.getCurve().isEmpty()) {
+        TestResult result = m_testController->calculateResults(test);
+        test.setResult(result);
+
+        QMetaObject::invokeMethod(this, [this, testId, result]() {
+            emit testAnalyzed(testId, result);
+        }, Qt::QueuedConnection);
+    }
+
+    // Persistence, only what changed since the test was started
+    bool saved = m_testController->updateTest(test);
+
+    QMetaObject::invokeMethod(this, [this, testId, saved]() { onFinished(testId, saved); },
+                              Qt::QueuedConnection);
+}
+
+void TestFinalizer::onFinished(int testId, bool saved) {
+    --m_pending;
+
+    if (saved) {
+        LOG_INFO(QString("Test finalized: ID=%1").arg(testId));
+    } else {
+        LOG_ERROR(QString("Failed to save finalized test ID=%1").arg(testId));
+    }
+
+    emit testFinalized(testId, saved);
+}
+
+} // namespace HorizonUTM
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <QObject>
+#include <QThreadPool>
+#include <atomic>
+#include "domain/entities/Test.h"
+#include "domain/value_objects/TestResult.h"
+
+namespace HorizonUTM {
+
+class TestController;
+
+/**
+ * @brief Runs the post-acquisition stages of a test in the background
+ *
+ * Analysis and persistence of a finished test run on a single worker
+ * thread, one test after another in submission order, so the GUI thread
+ * is free and the next specimen can be started while the previous one is
+ * still being saved. All signals are delivered on the finalizer's thread.
+ *
+ * finalize() may be called from any thread, so one finalizer can be the
+ * single database writer for several frames.
+ */
+class TestFinalizer : public QObject {
+    Q_OBJECT
+
+public:
+    explicit TestFinalizer(TestController* testController, QObject* parent = nullptr);
+    ~TestFinalizer() override;
+
+    /**
+     * @brief Queue a finished test for analysis and saving
+     *
+     * Results are calculated unless the test failed or has no points.
+     */
+    void finalize(const Test& test);
+
+    /**
+     * @brief Tests queued or being finalized
+     */
+    int pendingCount() const { return m_pending.load(); }
+
+    /**
+     * @brief Block until the worker has finished every queued test
+     * @param msecs Timeout, -1 for none
+     * @return false on timeout
+     */
+    bool waitForDone(int msecs = -1);
+
+signals:
+    /**
+     * @brief Emitted when the results of a test have been calculated
+     */
+    void testAnalyzed(int testId, const TestResult& result);
+
+    /**
+     * @brief Emitted when a test has left the pipeline
+     * @param saved Whether the test was written to the repository
+     */
+    void testFinalized(int testId, bool saved);
+
+private:
+    void run(Test test);
+    void onFinished(int testId, bool saved);
+
+    TestController* m_testController;
+    QThreadPool m_pool;
+    std::atomic<int> m_pending;
+};
+
+} // namespace HorizonUTM
@@ -35,6 +35,14 @@ void Config::setDatabasePath(const QString& path) {
     m_settings->setValue("database/path", path);
 }
 
+int Config::getCurveCacheSizeMB() const {
+    return m_settings->value("database/curve_cache_mb", Constants::DEFAULT_CURVE_CACHE_MB).toInt();
+}
+
+void Config::setCurveCacheSizeMB(int megabytes) {
+    m_settings->setValue("database/curve_cache_mb", megabytes);
+}
+
 QString Config::getLastUsedPort() const {
     return m_settings->value("hardware/last_port", "COM1").toString();
 }
@@ -51,6 +59,150 @@ void Config::setDefaultSpeed(double speed) {
     m_settings->setValue("hardware/default_speed", speed);
 }
 
+int Config::getLiveBufferSizeMB() const {
+    return m_settings->value("hardware/live_buffer_mb", Constants::DEFAULT_LIVE_BUFFER_MB).toInt();
+}
+
+void Config::setLiveBufferSizeMB(int megabytes) {
+    m_settings->setValue("hardware/live_buffer_mb", megabytes);
+}
+
+QString Config::getFilterType() const {
+    return m_settings->value("acquisition/filter", "none").toString();
+}
+
+void Config::setFilterType(const QString& type) {
+    m_settings->setValue("acquisition/filter", type);
+}
+
+int Config::getFilterWindow() const {
+    return m_settings->value("acquisition/filter_window", 5).toInt();
+}
+
+void Config::setFilterWindow(int samples) {
+    m_settings->setValue("acquisition/filter_window", samples);
+}
+
+double Config::getFilterCutoffHz() const {
+    return m_settings->value("acquisition/filter_cutoff_hz", 10.0).toDouble();
+}
+
+void Config::setFilterCutoffHz(double hz) {
+    m_settings->setValue("acquisition/filter_cutoff_hz", hz);
+}
+
+bool Config::isRecordingDeadbandEnabled() const {
+    return m_settings->value("recording/deadband_enabled", false).toBool();
+}
+
+void Config::setRecordingDeadbandEnabled(bool enabled) {
+    m_settings->setValue("recording/deadband_enabled", enabled);
+}
+
+double Config::getRecordingForceDeadband() const {
+    return m_settings->value("recording/force_deadband_n", 1.0).toDouble();
+}
+
+void Config::setRecordingForceDeadband(double newtons) {
+    m_settings->setValue("recording/force_deadband_n", newtons);
+}
+
+double Config::getRecordingExtensionDeadband() const {
+    return m_settings->value("recording/extension_deadband_mm", 0.01).toDouble();
+}
+
+void Config::setRecordingExtensionDeadband(double mm) {
+    m_settings->setValue("recording/extension_deadband_mm", mm);
+}
+
+int Config::getRecordingMaxIntervalMs() const {
+    return m_settings->value("recording/max_interval_ms", 1000).toInt();
+}
+
+void Config::setRecordingMaxIntervalMs(int ms) {
+    m_settings->setValue("recording/max_interval_ms", ms);
+}
+
+int Config::getRecordingEventWindowMs() const {
+    return m_settings->value("recording/event_window_ms", 200).toInt();
+}
+
+void Config::setRecordingEventWindowMs(int ms) {
+    m_settings->setValue("recording/event_window_ms", ms);
+}
+
+int Config::getRecordingMaxEventDelayMs() const {
+    return m_settings->value("recording/max_event_delay_ms", 10000).toInt();
+}
+
+void Config::setRecordingMaxEventDelayMs(int ms) {
+    m_settings->setValue("recording/max_event_delay_ms", ms);
+}
+
+double Config::getRecordingPeakDropPercent() const {
+    return m_settings->value("recording/peak_drop_percent", 5.0).toDouble();
+}
+
+void Config::setRecordingPeakDropPercent(double percent) {
+    m_settings->setValue("recording/peak_drop_percent", percent);
+}
+
+double Config::getRecordingYieldSlopeRatio() const {
+    return m_settings->value("recording/yield_slope_ratio", 0.5).toDouble();
+}
+
+void Config::setRecordingYieldSlopeRatio(double ratio) {
+    m_settings->setValue("recording/yield_slope_ratio", ratio);
+}
+
+bool Config::isBreakCaptureEnabled() const {
+    return m_settings->value("recording/break_capture", false).toBool();
+}
+
+void Config::setBreakCaptureEnabled(bool enabled) {
+    m_settings->setValue("recording/break_capture", enabled);
+}
+
+int Config::getBreakPreTriggerMs() const {
+    return m_settings->value("recording/break_pre_trigger_ms", 100).toInt();
+}
+
+void Config::setBreakPreTriggerMs(int ms) {
+    m_settings->setValue("recording/break_pre_trigger_ms", ms);
+}
+
+int Config::getBreakPostTriggerMs() const {
+    return m_settings->value("recording/break_post_trigger_ms", 50).toInt();
+}
+
+void Config::setBreakPostTriggerMs(int ms) {
+    m_settings->setValue("recording/break_post_trigger_ms", ms);
+}
+
+double Config::getBreakForceDropPercent() const {
+    return m_settings->value("recording/break_force_drop_percent", 10.0).toDouble();
+}
+
+void Config::setBreakForceDropPercent(double percent) {
+    m_settings->setValue("recording/break_force_drop_percent", percent);
+}
+
+double Config::getBreakForceRateLimit() const {
+    return m_settings->value("recording/break_force_rate", 0.0).toDouble();
+}
+
+void Config::setBreakForceRateLimit(double newtonsPerSecond) {
+    m_settings->setValue("recording/break_force_rate", newtonsPerSecond);
+}
+
+double Config::getBreakMinForce() const {
+    return m_settings->value("recording/break_min_force_n", 10.0).toDouble();
+}
+
+void Config::setBreakMinForce(double newtons) {
+    m_settings->setValue("recording/break_min_force_n", newtons);
+}
+
 bool Config::isDarkTheme() const {
     return m_settings->value("ui/dark_theme", true).toBool();
 }
@@ -75,6 +227,14 @@ void Config::setDefaultGaugeLength(double length) {
     m_settings->setValue("test/default_gauge_length", length);
 }
 
+QString Config::getModulusMethod() const {
+    return m_settings->value("analysis/modulus_method", "linear_region").toString();
+}
+
+void Config::setModulusMethod(const QString& method) {
+    m_settings->setValue("analysis/modulus_method", method);
+}
+
 QString Config::getExportPath() const {
     QString defaultPath = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation) + "/HorizonUTM/Exports";
     return m_settings->value("export/path", defaultPath).toString();
@@ -17,6 +17,9 @@ public:
     QString getDatabasePath() const;
     void setDatabasePath(const QString& path);
     
+    int getCurveCacheSizeMB() const;
+    void setCurveCacheSizeMB(int megabytes);
+    
     // Hardware
     QString getLastUsedPort() const;
     void setLastUsedPort(const QString& port);
@@ -24,6 +27,63 @@ public:
     double getDefaultSpeed() const;
     void setDefaultSpeed(double speed);
     
+    int getLiveBufferSizeMB() const;
+    void setLiveBufferSizeMB(int megabytes);
+    
+    // Acquisition filter
+    QString getFilterType() const;      ///< "none", "moving_average", "median", "butterworth", "savitzky_golay"
+    void setFilterType(const QString& type);
+    
+    int getFilterWindow() const;        ///< Samples
+    void setFilterWindow(int samples);
+    
+    double getFilterCutoffHz() const;
+    void setFilterCutoffHz(double hz);
+    
+    // Deadband recording
+    bool isRecordingDeadbandEnabled() const;
+    void setRecordingDeadbandEnabled(bool enabled);
+    
+    double getRecordingForceDeadband() const;       ///< N
+    void setRecordingForceDeadband(double newtons);
+    
+    double getRecordingExtensionDeadband() const;   ///< mm
+    void setRecordingExtensionDeadband(double mm);
+    
+    int getRecordingMaxIntervalMs() const;
+    void setRecordingMaxIntervalMs(int ms);
+    
+    int getRecordingEventWindowMs() const;          ///< Full rate around yield, peak and break
+    void setRecordingEventWindowMs(int ms);
+    
+    int getRecordingMaxEventDelayMs() const;        ///< Longest hold while a peak or yield may show
+    void setRecordingMaxEventDelayMs(int ms);
+    
+    double getRecordingPeakDropPercent() const;     ///< Below the running maximum
+    void setRecordingPeakDropPercent(double percent);
+    
+    double getRecordingYieldSlopeRatio() const;     ///< Of the steepest slope
+    void setRecordingYieldSlopeRatio(double ratio);
+    
+    // Break detection and capture
+    bool isBreakCaptureEnabled() const;
+    void setBreakCaptureEnabled(bool enabled);
+    
+    int getBreakPreTriggerMs() const;
+    void setBreakPreTriggerMs(int ms);
+    
+    int getBreakPostTriggerMs() const;
+    void setBreakPostTriggerMs(int ms);
+    
+    double getBreakForceDropPercent() const;
+    void setBreakForceDropPercent(double percent);
+    
+    double getBreakForceRateLimit() const;  ///< N/s, 0 = off
+    void setBreakForceRateLimit(double newtonsPerSecond);
+    
+    double getBreakMinForce() const;        ///< N; no break before the force reached this
+    void setBreakMinForce(double newtons);
+    
     // UI
     bool isDarkTheme() const;
     void setDarkTheme(bool enabled);
@@ -35,6 +95,10 @@ public:
     double getDefaultGaugeLength() const;
     void setDefaultGaugeLength(double length);
     
+    // Analysis
+    QString getModulusMethod() const;   ///< "linear_region", "best_fit" or "chord"
+    void setModulusMethod(const QString& method);
+    
     // Paths
     QString getExportPath() const;
     void setExportPath(const QString& path);
@@ -12,11 +12,14 @@ constexpr const char* APP_ORGANIZATION = "Horizon Materials Testing";
 
 // Database
 constexpr const char* DB_NAME = "horizon_utm.db";
+constexpr int DEFAULT_CURVE_CACHE_MB = 256;
 
 // Hardware
 constexpr int DEFAULT_SAMPLING_RATE_HZ = 100;
 constexpr double DEFAULT_SPEED_MM_PER_MIN = 5.0;
 constexpr double DEFAULT_FORCE_LIMIT_N = 10000.0;
+constexpr int DEFAULT_LIVE_BUFFER_MB = 64;
+constexpr int STOP_SETTLE_TIMEOUT_MS = 5000;
 
 // Test Methods
 constexpr const char* METHOD_ISO_527_2 = "ISO 527-2";
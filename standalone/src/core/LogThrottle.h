@@ -0,0 +1,175 @@
+#pragma once
+
+#include "Logger.h"
+#include <QString>
+#include <atomic>
+#include <chrono>
+
+namespace HorizonUTM {
+
+/**
+ * @brief Monotonic clock of the throttles
+ */
+inline qint64 logThrottleNowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Outcome of asking a throttle whether a call site may log
+ */
+struct LogGate {
+    bool pass = false;
+    qint64 suppressed = 0;  // calls dropped since the last record that passed
+};
+
+/**
+ * @brief At most maxRecords per period for one call site
+ */
+class LogRateLimiter {
+public:
+    LogRateLimiter(int maxRecords, int periodMs)
+        : m_maxRecords(maxRecords)
+        , m_periodMs(periodMs)
+        , m_windowStart(logThrottleNowMs())
+        , m_inWindow(0)
+        , m_suppressed(0)
+    {
+    }
+
+    LogGate check() {
+        qint64 now = logThrottleNowMs();
+        qint64 start = m_windowStart.load(std::memory_order_relaxed);
+        if (now - start >= m_periodMs &&
+            m_windowStart.compare_exchange_strong(start, now, std::memory_order_relaxed)) {
+            m_inWindow.store(0, std::memory_order_relaxed);
+        }
+
+        LogGate gate;
+        if (m_inWindow.fetch_add(1, std::memory_order_relaxed) < m_maxRecords) {
+            gate.pass = true;
+            gate.suppressed = m_suppressed.exchange(0, std::memory_order_relaxed);
+        } else {
+            m_suppressed.fetch_add(1, std::memory_order_relaxed);
+        }
+        return gate;
+    }
+
+private:
+    const int m_maxRecords;
+    const qint64 m_periodMs;
+    std::atomic<qint64> m_windowStart;
+    std::atomic<qint64> m_inWindow;
+    std::atomic<qint64> m_suppressed;
+};
+
+/**
+ * @brief Pass the 1st, (n+1)th, (2n+1)th ... call of one call site
+ */
+class LogEveryN {
+public:
+    explicit LogEveryN(int n)
+        : m_n(n > 0 ? n : 1)
+        , m_count(0)
+    {
+    }
+
+    LogGate check() {
+        qint64 count = m_count.fetch_add(1, std::memory_order_relaxed);
+
+        LogGate gate;
+        gate.pass = count % m_n == 0;
+        gate.suppressed = gate.pass && count > 0 ? m_n - 1 : 0;
+        return gate;
+    }
+
+private:
+    const qint64 m_n;
+    std::atomic<qint64> m_count;
+};
+
+/**
+ * @brief Pass the first n calls, then one summary per period with the suppressed count
+ *
+ * After the first n, calls are dropped until summaryPeriodMs has passed
+ * since the last record; the next call then passes carrying the count.
+ */
+class LogFirstN {
+public:
+    explicit LogFirstN(int n, int summaryPeriodMs = 10000)
+        : m_n(n)
+        , m_periodMs(summaryPeriodMs)
+        , m_count(0)
+        , m_lastPass(logThrottleNowMs())
+        , m_suppressed(0)
+    {
+    }
+
+    LogGate check() {
+        if (m_count.load(std::memory_order_relaxed) < m_n &&
+            m_count.fetch_add(1, std::memory_order_relaxed) < m_n) {
+            m_lastPass.store(logThrottleNowMs(), std::memory_order_relaxed);
+            return LogGate{true, 0};
+        }
+
+        qint64 now = logThrottleNowMs();
+        qint64 last = m_lastPass.load(std::memory_order_relaxed);
+        if (now - last >= m_periodMs &&
+            m_lastPass.compare_exchange_strong(last, now, std::memory_order_relaxed)) {
+            return LogGate{true, m_suppressed.exchange(0, std::memory_order_relaxed)};
+        }
+
+        m_suppressed.fetch_add(1, std::memory_order_relaxed);
+        return LogGate{};
+    }
+
+private:
+    const qint64 m_n;
+    const qint64 m_periodMs;
+    std::atomic<qint64> m_count;
+    std::atomic<qint64> m_lastPass;
+    std::atomic<qint64> m_suppressed;
+};
+
+/**
+ * @brief Message with the number of suppressed repeats appended
+ */
+inline QString withSuppressedCount(const QString& message, qint64 suppressed) {
+    if (suppressed <= 0) {
+        return message;
+    }
+    return QString("%1 (%2 similar suppressed)").arg(message).arg(suppressed);
+}
+
+/**
+ * @brief Log through a per-call-site throttle
+ *
+ * The throttle is a function-local static, so each expansion has its own
+ * state. The level is checked first and the message is only built when the
+ * throttle lets the call through; a suppressed call costs a few atomic ops.
+ */
+#define HORIZON_LOG_THROTTLED(level, throttle, throttleArgs, msg) \
+    do { \
+        if constexpr (static_cast<int>(level) >= HORIZON_LOG_MIN_LEVEL) { \
+            HorizonUTM::Logger& horizonLogger_ = HorizonUTM::Logger::instance(); \
+            if (horizonLogger_.isEnabled(level)) { \
+                static throttle horizonThrottle_ throttleArgs; \
+                const HorizonUTM::LogGate horizonGate_ = horizonThrottle_.check(); \
+                if (horizonGate_.pass) { \
+                    horizonLogger_.log(level, \
+                        HorizonUTM::withSuppressedCount(msg, horizonGate_.suppressed), __FUNCTION__); \
+                } \
+            } \
+        } \
+    } while (0)
+
+// Hot-path helpers; level is a LogLevel name, e.g. LOG_EVERY_N(Debug, 1000, msg)
+#define LOG_RATE_LIMITED(level, maxRecords, periodMs, msg) \
+    HORIZON_LOG_THROTTLED(HorizonUTM::LogLevel::level, HorizonUTM::LogRateLimiter, \
+                          (maxRecords, periodMs), msg)
+#define LOG_EVERY_N(level, n, msg) \
+    HORIZON_LOG_THROTTLED(HorizonUTM::LogLevel::level, HorizonUTM::LogEveryN, (n), msg)
+#define LOG_FIRST_N(level, n, msg) \
+    HORIZON_LOG_THROTTLED(HorizonUTM::LogLevel::level, HorizonUTM::LogFirstN, (n), msg)
+
+} // namespace HorizonUTM
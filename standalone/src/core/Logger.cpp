@@ -2,12 +2,33 @@
 #include <QDebug>
 #include <QStandardPaths>
 #include <QDir>
+#include <QThread>
 
 namespace HorizonUTM {
 
+namespace {
+
+// Default interval between periodic flushes
+constexpr int DEFAULT_FLUSH_INTERVAL_MS = 100;
+
+// Wake the writer early once this many records are waiting
+constexpr qint64 BACKLOG_WAKEUP = 1024;
+
+} // namespace
+
 Logger::Logger() 
-    : m_minLevel(LogLevel::Debug)
+    : m_minLevel(static_cast<int>(LogLevel::Debug))
+    , m_head(&m_stub)
+    , m_tail(&m_stub)
+    , m_writer(nullptr)
+    , m_running(false)
+    , m_flushIntervalMs(DEFAULT_FLUSH_INTERVAL_MS)
+    , m_pending(0)
+    , m_enqueued(0)
+    , m_written(0)
 {
+    m_stub.next.store(nullptr, std::memory_order_relaxed);
+
     // Create logs directory
     QString logDir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/logs";
     QDir().mkpath(logDir);
@@ -20,9 +41,18 @@ Logger::Logger()
     if (m_logFile.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
         m_stream.setDevice(&m_logFile);
     }
+
+    // Background writer
+    m_running.store(true);
+    m_writer = QThread::create([this]() { run(); });
+    m_writer->setObjectName("Logger");
+    m_writer->start(QThread::LowPriority);
 }
 
 Logger::~Logger() {
+    shutdown();
+    delete m_writer;
+
     if (m_logFile.isOpen()) {
         m_logFile.close();
     }
@@ -42,27 +72,30 @@ Logger& Logger::instance() {
 }
 
 void Logger::log(LogLevel level, const QString& message, const QString& source) {
-    if (level < m_minLevel) {
+    if (!isEnabled(level)) {
         return;
     }
     
-    QMutexLocker locker(&m_mutex);
+    // Only capture here; formatting and I/O happen on the writer thread
+    Record* record = new Record;
+    record->level = level;
+    record->timestamp = QDateTime::currentMSecsSinceEpoch();
+    record->message = message;
+    record->source = source;
     
-    QString timestamp = QDateTime::currentDateTime().toString("yyyy-MM-dd HH:mm:ss.zzz");
-    QString levelStr = levelToString(level);
-    QString sourceStr = source.isEmpty() ? "" : QString(" [%1]").arg(source);
+    enqueue(record);
+    m_enqueued.fetch_add(1, std::memory_order_relaxed);
+    qint64 pending = m_pending.fetch_add(1, std::memory_order_relaxed) + 1;
     
-    QString formattedMessage = QString("%1 [%2]%3: %4")
-        .arg(timestamp)
-        .arg(levelStr)
-        .arg(sourceStr)
-        .arg(message);
-    
-    // Output to console
-    qDebug().noquote() << formattedMessage;
+    if (!m_running.load(std::memory_order_acquire)) {
+        // No writer (shut down): write synchronously
+        drain();
+        return;
+    }
     
-    // Write to file
-    writeToFile(formattedMessage);
+    if (level >= LogLevel::Error || pending == BACKLOG_WAKEUP) {
+        m_wakeup.release();
+    }
 }
 
 void Logger::debug(const QString& message, const QString& source) {
@@ -86,7 +119,10 @@ void Logger::critical(const QString& message, const QString& source) {
 }
 
 void Logger::setLogFile(const QString& filePath) {
-    QMutexLocker locker(&m_mutex);
+    // Records already queued still go to the previous file
+    flush();
+    
+    QMutexLocker locker(&m_fileMutex);
     
     if (m_logFile.isOpen()) {
         m_logFile.close();
@@ -99,7 +135,38 @@ void Logger::setLogFile(const QString& filePath) {
 }
 
 void Logger::setLogLevel(LogLevel level) {
-    m_minLevel = level;
+    m_minLevel.store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+void Logger::setFlushInterval(int msecs) {
+    m_flushIntervalMs.store(qMax(1, msecs), std::memory_order_relaxed);
+}
+
+void Logger::flush() {
+    if (!m_running.load(std::memory_order_acquire)) {
+        drain();
+        return;
+    }
+    
+    qint64 target = m_enqueued.load(std::memory_order_relaxed);
+    m_wakeup.release();
+    
+    QMutexLocker locker(&m_flushMutex);
+    while (m_written < target) {
+        m_flushed.wait(&m_flushMutex);
+    }
+}
+
+void Logger::shutdown() {
+    if (!m_running.exchange(false)) {
+        return;
+    }
+    
+    m_wakeup.release();
+    m_writer->wait();
+    
+    // Records pushed while the writer was stopping
+    drain();
 }
 
 QString Logger::levelToString(LogLevel level) const {
@@ -113,11 +180,108 @@ QString Logger::levelToString(LogLevel level) const {
     }
 }
 
+QString Logger::format(const Record& record) const {
+    QString timestamp = QDateTime::fromMSecsSinceEpoch(record.timestamp).toString("yyyy-MM-dd HH:mm:ss.zzz");
+    QString sourceStr = record.source.isEmpty() ? "" : QString(" [%1]").arg(record.source);
+    
+    return QString("%1 [%2]%3: %4")
+        .arg(timestamp)
+        .arg(levelToString(record.level))
+        .arg(sourceStr)
+        .arg(record.message);
+}
+
 void Logger::writeToFile(const QString& formattedMessage) {
+    // Flushed once per batch by drain()
     if (m_logFile.isOpen()) {
-        m_stream << formattedMessage << Qt::endl;
-        m_stream.flush();
+        m_stream << formattedMessage << '\n';
+    }
+}
+
+void Logger::enqueue(Record* record) {
+    record->next.store(nullptr, std::memory_order_relaxed);
+    Record* previous = m_head.exchange(record, std::memory_order_acq_rel);
+    previous->next.store(record, std::memory_order_release);
+}
+
+Logger::Record* Logger::dequeue() {
+    Record* tail = m_tail;
+    Record* next = tail->next.load(std::memory_order_acquire);
+    
+    // Skip the stub node
+    if (tail == &m_stub) {
+        if (!next) {
+            return nullptr;
+        }
+        m_tail = next;
+        tail = next;
+        next = next->next.load(std::memory_order_acquire);
+    }
+    
+    if (next) {
+        m_tail = next;
+        return tail;
     }
+    
+    // A producer has exchanged the head but not linked its node yet
+    if (tail != m_head.load(std::memory_order_acquire)) {
+        return nullptr;
+    }
+    
+    // tail is the last node: re-insert the stub so it can be detached
+    enqueue(&m_stub);
+    next = tail->next.load(std::memory_order_acquire);
+    if (next) {
+        m_tail = next;
+        return tail;
+    }
+    return nullptr;
+}
+
+void Logger::run() {
+    while (m_running.load(std::memory_order_acquire)) {
+        // Sleep until the flush interval elapses or a producer wakes us
+        if (m_wakeup.tryAcquire(1, m_flushIntervalMs.load(std::memory_order_relaxed))) {
+            m_wakeup.tryAcquire(m_wakeup.available());
+        }
+        drain();
+    }
+    drain();
+}
+
+qint64 Logger::drain() {
+    qint64 written = 0;
+    
+    {
+        // The file mutex also makes this the only consumer of the queue
+        QMutexLocker locker(&m_fileMutex);
+        
+        while (Record* record = dequeue()) {
+            QString formattedMessage = format(*record);
+            delete record;
+            
+            // Output to console
+            qDebug().noquote() << formattedMessage;
+            
+            // Write to file
+            writeToFile(formattedMessage);
+            ++written;
+        }
+        
+        if (written > 0) {
+            m_stream.flush();
+        }
+    }
+    
+    if (written > 0) {
+        m_pending.fetch_sub(written, std::memory_order_relaxed);
+        
+        QMutexLocker locker(&m_flushMutex);
+        m_written += written;
+        m_flushed.wakeAll();
+    }
+    
+    return written;
 }
 
 } // namespace HorizonUTM
@@ -5,6 +5,11 @@
 #include <QFile>
 #include <QTextStream>
 #include <QMutex>
+#include <QSemaphore>
+#include <QWaitCondition>
+#include <atomic>
+
+class QThread;
 
 namespace HorizonUTM {
 
@@ -16,42 +21,146 @@ enum class LogLevel {
     Critical
 };
 
+/**
+ * @brief Asynchronous application logger
+ *
+ * log() only timestamps the record and pushes it onto a lock-free
+ * multi-producer queue; formatting, console output and file writes happen
+ * in batches on a background thread. The file is flushed every
+ * flush interval, and immediately after Error and Critical records.
+ */
 class Logger {
 public:
     static Logger& instance();
     static void initialize(LogLevel level = LogLevel::Info, const QString& logFile = "horizon_utm.log");
-    
+
     void log(LogLevel level, const QString& message, const QString& source = "");
-    
+
     void debug(const QString& message, const QString& source = "");
     void info(const QString& message, const QString& source = "");
     void warning(const QString& message, const QString& source = "");
     void error(const QString& message, const QString& source = "");
     void critical(const QString& message, const QString& source = "");
-    
+
     void setLogFile(const QString& filePath);
     void setLogLevel(LogLevel level);
-    
+
+    /**
+     * @brief Check if a level passes the runtime filter
+     */
+    bool isEnabled(LogLevel level) const {
+        return static_cast<int>(level) >= m_minLevel.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Interval between periodic flushes of the log file
+     */
+    void setFlushInterval(int msecs);
+
+    /**
+     * @brief Block until everything logged so far is written and flushed
+     */
+    void flush();
+
+    /**
+     * @brief Stop the background thread after writing pending records
+     *
+     * Records logged afterwards are written synchronously.
+     */
+    void shutdown();
+
 private:
+    /**
+     * @brief Queued log record (intrusive MPSC queue node)
+     */
+    struct Record {
+        std::atomic<Record*> next;
+        LogLevel level;
+        qint64 timestamp;   // ms since epoch
+        QString message;
+        QString source;
+    };
+
     Logger();
     ~Logger();
     Logger(const Logger&) = delete;
     Logger& operator=(const Logger&) = delete;
-    
+
     QString levelToString(LogLevel level) const;
+    QString format(const Record& record) const;
     void writeToFile(const QString& formattedMessage);
-    
+
+    /**
+     * @brief Push a record (any thread, wait-free)
+     */
+    void enqueue(Record* record);
+
+    /**
+     * @brief Pop the oldest record (writer thread only)
+     * @return nullptr if the queue is empty or a push is in progress
+     */
+    Record* dequeue();
+
+    /**
+     * @brief Background writer loop
+     */
+    void run();
+
+    /**
+     * @brief Write all queued records and flush the file
+     * @return Number of records written
+     */
+    qint64 drain();
+
     QFile m_logFile;
     QTextStream m_stream;
-    QMutex m_mutex;
-    LogLevel m_minLevel;
+    QMutex m_fileMutex;          // file/stream, writer thread vs setLogFile
+    std::atomic<int> m_minLevel;
+
+    // Lock-free queue: producers exchange m_head, the writer owns m_tail
+    std::atomic<Record*> m_head;
+    Record* m_tail;
+    Record m_stub;
+
+    QThread* m_writer;
+    QSemaphore m_wakeup;
+    std::atomic<bool> m_running;
+    std::atomic<int> m_flushIntervalMs;
+    std::atomic<qint64> m_pending;
+    std::atomic<qint64> m_enqueued;
+
+    // flush() waits until m_written catches up
+    QMutex m_flushMutex;
+    QWaitCondition m_flushed;
+    qint64 m_written;
 };
 
+/**
+ * @brief Lowest level compiled into the LOG_* macros
+ *
+ * Set by the HORIZON_LOG_MIN_LEVEL CMake option (0 = Debug ... 4 = Critical).
+ * Calls below it compile to nothing, message expression included.
+ */
+#ifndef HORIZON_LOG_MIN_LEVEL
+#define HORIZON_LOG_MIN_LEVEL 0
+#endif
+
+// The message expression is only evaluated when the level is enabled
+#define HORIZON_LOG(level, msg) \
+    do { \
+        if constexpr (static_cast<int>(level) >= HORIZON_LOG_MIN_LEVEL) { \
+            HorizonUTM::Logger& horizonLogger_ = HorizonUTM::Logger::instance(); \
+            if (horizonLogger_.isEnabled(level)) { \
+                horizonLogger_.log(level, msg, __FUNCTION__); \
+            } \
+        } \
+    } while (0)
+
 // Convenience macros
-#define LOG_DEBUG(msg) HorizonUTM::Logger::instance().debug(msg, __FUNCTION__)
-#define LOG_INFO(msg) HorizonUTM::Logger::instance().info(msg, __FUNCTION__)
-#define LOG_WARNING(msg) HorizonUTM::Logger::instance().warning(msg, __FUNCTION__)
-#define LOG_ERROR(msg) HorizonUTM::Logger::instance().error(msg, __FUNCTION__)
-#define LOG_CRITICAL(msg) HorizonUTM::Logger::instance().critical(msg, __FUNCTION__)
+#define LOG_DEBUG(msg) HORIZON_LOG(HorizonUTM::LogLevel::Debug, msg)
+#define LOG_INFO(msg) HORIZON_LOG(HorizonUTM::LogLevel::Info, msg)
+#define LOG_WARNING(msg) HORIZON_LOG(HorizonUTM::LogLevel::Warning, msg)
+#define LOG_ERROR(msg) HORIZON_LOG(HorizonUTM::LogLevel::Error, msg)
+#define LOG_CRITICAL(msg) HORIZON_LOG(HorizonUTM::LogLevel::Critical, msg)
 
 } // namespace HorizonUTM
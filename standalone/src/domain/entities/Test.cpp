@@ -17,6 +17,9 @@ Test::Test()
     , m_forceLimit(10000.0)
     , m_temperature(23.0)
     , m_notes("")
+    , m_persistedCount(0)
+    , m_dirtyFields(DirtyAll)
+    , m_dataReset(false)
 {
 }
 
@@ -26,12 +29,33 @@ Test::Test(int id)
     m_id = id;
 }
 
-void Test::addDataPoint(const SensorData& data) {
-    m_data.append(data);
+void Test::clearData() {
+    setCurve(Curve());
 }
 
-void Test::clearData() {
-    m_data.clear();
+void Test::setData(const QVector<SensorData>& data) {
+    setCurve(Curve::fromVector(data));
+}
+
+void Test::setCurve(const Curve& curve) {
+    m_curve = curve;
+    m_persistedCount = 0;
+    m_dataReset = true;
+}
+
+void Test::extendCurve(const Curve& curve) {
+    Q_ASSERT(curve.size() >= m_curve.size());
+    m_curve = curve;
+}
+
+bool Test::hasUnsavedChanges() const {
+    return m_dirtyFields != DirtyNone || m_dataReset || m_persistedCount < m_curve.size();
+}
+
+void Test::markPersisted() {
+    m_persistedCount = getDataPointCount();
+    m_dirtyFields = DirtyNone;
+    m_dataReset = false;
 }
 
 bool Test::isValid() const {
@@ -58,10 +82,14 @@ qint64 Test::getDuration() const {
 
 QVector<QPair<double, double>> Test::getStressStrainData() const {
     QVector<QPair<double, double>> result;
-    result.reserve(m_data.size());
+    result.reserve(m_curve.size());
     
-    for (const SensorData& data : m_data) {
-        result.append(qMakePair(data.strain, data.stress));
+    // Per segment: points() would flatten a multi-block curve first
+    for (int s = 0; s < m_curve.segmentCount(); ++s) {
+        const Curve::Segment& segment = m_curve.segment(s);
+        for (qsizetype i = 0; i < segment.size; ++i) {
+            result.append(qMakePair(segment.data[i].strain, segment.data[i].stress));
+        }
     }
     
     return result;
@@ -4,6 +4,7 @@
 #include <QDateTime>
 #include <QVector>
 #include "domain/value_objects/SensorData.h"
+#include "domain/value_objects/Curve.h"
 #include "domain/value_objects/TestResult.h"
 
 namespace HorizonUTM {
@@ -40,9 +41,28 @@ inline QString testStatusToString(TestStatus status) {
  * 
  * Domain entity containing all information about a test including
  * parameters, sample information, collected data, and results.
+ * The data is an immutable shared Curve, so copying a Test is cheap;
+ * acquisition appends to a CurveBuilder and publishes the result here.
  */
 class Test {
 public:
+    /**
+     * @brief Groups of metadata columns changed since the last save
+     */
+    enum DirtyField : quint32 {
+        DirtyNone       = 0,
+        DirtyIdentity   = 1 << 0,   ///< Sample name, operator, test method
+        DirtyGeometry   = 1 << 1,   ///< Width, thickness, gauge length
+        DirtyParameters = 1 << 2,   ///< Speed, force limit, temperature
+        DirtyStatus     = 1 << 3,
+        DirtyTiming     = 1 << 4,   ///< Start and end time
+        DirtyResults    = 1 << 5,
+        DirtyNotes      = 1 << 6,
+        DirtyBreakBurst = 1 << 7,   ///< Full-rate samples around the break
+        DirtyRawCurve   = 1 << 8,   ///< Unfiltered acquisition
+        DirtyAll        = 0x1FF
+    };
+
     /**
      * @brief Constructor for new test
      */
@@ -79,39 +99,67 @@ public:
     double getTemperature() const { return m_temperature; }
     
     // Data and results
-    const QVector<SensorData>& getData() const { return m_data; }
+    /** @brief All points in one vector; flattens a multi-segment curve, prefer getCurve() */
+    const QVector<SensorData>& getData() const { return m_curve.points(); }
+    const Curve& getCurve() const { return m_curve; }
     const TestResult& getResult() const { return m_result; }
     
+    /**
+     * @brief Unfiltered acquisition when a filter stage was active, else empty
+     *
+     * Stored alongside the curve, which is the filtered one.
+     */
+    const Curve& getRawCurve() const { return m_rawCurve; }
+    
+    /**
+     * @brief Samples around the specimen break at full sensor rate, or empty
+     *
+     * Stored alongside the curve, which may have been thinned out.
+     */
+    const QVector<SensorData>& getBreakBurst() const { return m_breakBurst; }
+    
     QString getNotes() const { return m_notes; }
     
     // Setters
     void setId(int id) { m_id = id; }
-    void setSampleName(const QString& name) { m_sampleName = name; }
-    void setOperatorName(const QString& name) { m_operatorName = name; }
-    void setTestMethod(const QString& method) { m_testMethod = method; }
-    void setStartTime(const QDateTime& time) { m_startTime = time; }
-    void setEndTime(const QDateTime& time) { m_endTime = time; }
-    void setStatus(TestStatus status) { m_status = status; }
+    void setSampleName(const QString& name) { m_sampleName = name; m_dirtyFields |= DirtyIdentity; }
+    void setOperatorName(const QString& name) { m_operatorName = name; m_dirtyFields |= DirtyIdentity; }
+    void setTestMethod(const QString& method) { m_testMethod = method; m_dirtyFields |= DirtyIdentity; }
+    void setStartTime(const QDateTime& time) { m_startTime = time; m_dirtyFields |= DirtyTiming; }
+    void setEndTime(const QDateTime& time) { m_endTime = time; m_dirtyFields |= DirtyTiming; }
+    void setStatus(TestStatus status) { m_status = status; m_dirtyFields |= DirtyStatus; }
     
     // Sample dimensions
-    void setWidth(double width) { m_width = width; }
-    void setThickness(double thickness) { m_thickness = thickness; }
-    void setGaugeLength(double length) { m_gaugeLength = length; }
+    void setWidth(double width) { m_width = width; m_dirtyFields |= DirtyGeometry; }
+    void setThickness(double thickness) { m_thickness = thickness; m_dirtyFields |= DirtyGeometry; }
+    void setGaugeLength(double length) { m_gaugeLength = length; m_dirtyFields |= DirtyGeometry; }
     
     // Test parameters
-    void setSpeed(double speed) { m_speed = speed; }
-    void setForceLimit(double limit) { m_forceLimit = limit; }
-    void setTemperature(double temp) { m_temperature = temp; }
+    void setSpeed(double speed) { m_speed = speed; m_dirtyFields |= DirtyParameters; }
+    void setForceLimit(double limit) { m_forceLimit = limit; m_dirtyFields |= DirtyParameters; }
+    void setTemperature(double temp) { m_temperature = temp; m_dirtyFields |= DirtyParameters; }
     
     // Data management
-    void addDataPoint(const SensorData& data);
     void clearData();
-    void setData(const QVector<SensorData>& data) { m_data = data; }
+    void setData(const QVector<SensorData>& data);
+    void setCurve(const Curve& curve);
+    
+    /**
+     * @brief Replace the curve with a longer version of itself
+     *
+     * The new curve must start with the current points (as successive
+     * CurveBuilder snapshots do), so the persisted watermark is kept.
+     */
+    void extendCurve(const Curve& curve);
+    
+    void setRawCurve(const Curve& curve) { m_rawCurve = curve; m_dirtyFields |= DirtyRawCurve; }
+    
+    void setBreakBurst(const QVector<SensorData>& burst) { m_breakBurst = burst; m_dirtyFields |= DirtyBreakBurst; }
     
     // Results
-    void setResult(const TestResult& result) { m_result = result; }
+    void setResult(const TestResult& result) { m_result = result; m_dirtyFields |= DirtyResults; }
     
-    void setNotes(const QString& notes) { m_notes = notes; }
+    void setNotes(const QString& notes) { m_notes = notes; m_dirtyFields |= DirtyNotes; }
     
     /**
      * @brief Validate test parameters
@@ -128,13 +176,45 @@ public:
     /**
      * @brief Get number of data points collected
      */
-    int getDataPointCount() const { return m_data.size(); }
+    int getDataPointCount() const { return static_cast<int>(m_curve.size()); }
     
     /**
      * @brief Get stress-strain data points for plotting
      * @return Vector of (strain, stress) pairs
      */
     QVector<QPair<double, double>> getStressStrainData() const;
+    
+    // Persistence tracking
+    
+    /**
+     * @brief Number of leading data points already stored
+     *
+     * extendCurve() only appends, so points before this watermark never
+     * need to be written again.
+     */
+    int getPersistedCount() const { return m_persistedCount; }
+    
+    /**
+     * @brief DirtyField flags changed since the last save
+     */
+    quint32 getDirtyFields() const { return m_dirtyFields; }
+    
+    /**
+     * @brief Stored data points must be replaced (after clearData/setData)
+     */
+    bool isDataReset() const { return m_dataReset; }
+    
+    /**
+     * @brief Whether a save has anything to write
+     */
+    bool hasUnsavedChanges() const;
+    
+    /**
+     * @brief Record that the current state matches the database
+     *
+     * Called by the repository after a save or load.
+     */
+    void markPersisted();
 
 private:
     // Identification
@@ -159,11 +239,18 @@ private:
     double m_temperature;   // °C
     
     // Data
-    QVector<SensorData> m_data;
+    Curve m_curve;
+    Curve m_rawCurve;
+    QVector<SensorData> m_breakBurst;
     TestResult m_result;
     
     // Metadata
     QString m_notes;
+    
+    // Persistence tracking
+    int m_persistedCount;
+    quint32 m_dirtyFields;
+    bool m_dataReset;
 };
 
 } // namespace HorizonUTM
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "domain/value_objects/Curve.h"
+#include <functional>
+#include <memory>
+
+namespace HorizonUTM {
+
+/**
+ * @brief Interface for moving sealed curve blocks out of RAM
+ *
+ * Used by CurveBuilder when a live curve exceeds its memory budget. The
+ * returned segment must stay readable for as long as its owner is alive,
+ * from any thread.
+ */
+class ICurveSpillStore {
+public:
+    virtual ~ICurveSpillStore() = default;
+
+    /**
+     * @brief Store a sealed block
+     * @return Segment reading the same points from the store, or an
+     *         invalid segment if the block could not be stored
+     */
+    virtual Curve::Segment spill(const Curve::Block& block) = 0;
+};
+
+/**
+ * @brief Creates a fresh spill store, one per acquisition
+ *
+ * A store's space is released when it and every segment it returned are
+ * gone, so each test gets its own.
+ */
+using CurveSpillStoreFactory = std::function<std::shared_ptr<ICurveSpillStore>()>;
+
+} // namespace HorizonUTM
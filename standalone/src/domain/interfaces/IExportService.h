@@ -3,10 +3,20 @@
 #include <QString>
 #include <QStringList>
 #include <QVector>
+#include <QDir>
+#include <functional>
 #include "domain/entities/Test.h"
 
 namespace HorizonUTM {
 
+/**
+ * @brief Progress callback for long-running exports
+ * @param completed Number of tests written so far
+ * @param total Total number of tests in the export
+ * @return false to request cancellation
+ */
+using ExportProgressCallback = std::function<bool(int completed, int total)>;
+
 /**
  * @brief Interface for exporting test data
  * 
@@ -33,6 +43,62 @@ public:
      */
     virtual bool exportTests(const QVector<Test>& tests, const QString& filePath) = 0;
     
+    /**
+     * @brief Export multiple tests with progress reporting and cancellation
+     * 
+     * May be called from a worker thread. The default implementation has
+     * no intermediate progress and cannot be cancelled once started.
+     * 
+     * @param tests Vector of tests to export
+     * @param filePath Full path where file should be saved
+     * @param progress Callback invoked after each test; returning false aborts
+     * @return true if export successful (false if failed or cancelled)
+     */
+    virtual bool exportTestsWithProgress(const QVector<Test>& tests,
+                                         const QString& filePath,
+                                         const ExportProgressCallback& progress) {
+        if (progress && !progress(0, tests.size())) {
+            return false;
+        }
+        bool success = exportTests(tests, filePath);
+        if (success && progress) {
+            progress(tests.size(), tests.size());
+        }
+        return success;
+    }
+    
+    /**
+     * @brief Export each test to its own file inside a directory
+     * 
+     * The default implementation exports the tests one after another
+     * through exportTest(); services may override it to work in parallel.
+     * 
+     * @param tests Vector of tests to export
+     * @param dirPath Output directory (created if missing)
+     * @param progress Callback invoked after each test; returning false aborts
+     * @return true if all tests were exported
+     */
+    virtual bool exportTestsToDirectory(const QVector<Test>& tests,
+                                        const QString& dirPath,
+                                        const ExportProgressCallback& progress) {
+        QDir dir(dirPath);
+        if (!dir.mkpath(".")) {
+            return false;
+        }
+        
+        const QString extension = getSupportedExtensions().value(0);
+        for (int i = 0; i < tests.size(); ++i) {
+            QString fileName = QString("test_%1.%2").arg(tests[i].getId()).arg(extension);
+            if (!exportTest(tests[i], dir.filePath(fileName))) {
+                return false;
+            }
+            if (progress && !progress(i + 1, tests.size())) {
+                return false;
+            }
+        }
+        return true;
+    }
+    
     /**
      * @brief Get supported file extensions
      * @return List of extensions (e.g., ["csv"])
@@ -78,6 +78,15 @@ public:
      */
     virtual double getSpeed() const = 0;
     
+    /**
+     * @brief Samples per second on the emitted timestamps
+     *
+     * The spacing filters and capture windows are designed for; it does not
+     * change with playback speed.
+     * @return 0 if not known yet
+     */
+    virtual double getSampleRateHz() const = 0;
+    
     /**
      * @brief Zero all sensors (force, extension)
      */
@@ -111,6 +120,11 @@ signals:
      */
     void sensorDataReceived(SensorData data);
     
+    /**
+     * @brief Emitted when getSampleRateHz() changes
+     */
+    void sampleRateChanged(double rateHz);
+    
     /**
      * @brief Emitted when test completes naturally (break or limit reached)
      */
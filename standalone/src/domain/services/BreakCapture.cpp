@@ -0,0 +1,97 @@
+#include "BreakCapture.h"
+#include <QtMath>
+
+namespace HorizonUTM {
+
+BreakCapture::BreakCapture(const BreakCaptureSettings& settings)
+{
+    setSettings(settings);
+}
+
+void BreakCapture::setSettings(const BreakCaptureSettings& settings) {
+    m_settings = settings;
+
+    // Pre-trigger window plus the newest sample
+    const double rate = qMax(settings.sampleRateHz, 1.0);
+    const qsizetype capacity = qMax<qsizetype>(2, qCeil(settings.preTriggerMs * rate / 1000.0) + 1);
+    m_ring = QVector<SensorData>(capacity);
+    m_burst.reserve(capacity + qCeil(settings.postTriggerMs * rate / 1000.0) + 1);
+
+    reset();
+}
+
+void BreakCapture::reset() {
+    m_head = 0;
+    m_count = 0;
+
+    m_triggered = false;
+    m_complete = false;
+    m_triggerTimestamp = 0;
+    m_burst.clear();
+}
+
+bool BreakCapture::process(const SensorData& sample, bool trigger) {
+    if (!m_settings.enabled) {
+        return false;
+    }
+
+    // The ring keeps filling, a later trigger reaches back from there
+    push(sample);
+
+    if (trigger) {
+        m_triggered = true;
+        m_complete = false;
+        m_triggerTimestamp = sample.timestamp;
+
+        // Oldest first, from preTriggerMs back
+        m_burst.clear();
+        const qsizetype capacity = m_ring.size();
+        const qsizetype oldest = (m_head - m_count + capacity) % capacity;
+        for (qsizetype i = 0; i < m_count; ++i) {
+            const SensorData& buffered = m_ring[(oldest + i) % capacity];
+            if (buffered.timestamp >= m_triggerTimestamp - m_settings.preTriggerMs) {
+                m_burst.append(buffered);
+            }
+        }
+
+        if (m_settings.postTriggerMs <= 0) {
+            m_complete = true;
+            return true;
+        }
+        return false;
+    }
+
+    if (!m_triggered || m_complete) {
+        return false;
+    }
+
+    if (sample.timestamp > m_triggerTimestamp + m_settings.postTriggerMs) {
+        m_complete = true;
+        return true;
+    }
+    m_burst.append(sample);
+    return false;
+}
+
+void BreakCapture::push(const SensorData& sample) {
+    qsizetype capacity = m_ring.size();
+    const qsizetype oldest = (m_head - m_count + capacity) % capacity;
+
+    // Full while the oldest sample is still inside the window: grow, oldest first
+    if (m_count == capacity
+        && m_ring[oldest].timestamp >= sample.timestamp - m_settings.preTriggerMs) {
+        QVector<SensorData> grown(capacity * 2);
+        for (qsizetype i = 0; i < m_count; ++i) {
+            grown[i] = m_ring[(oldest + i) % capacity];
+        }
+        m_ring = grown;
+        m_head = m_count;
+        capacity = m_ring.size();
+    }
+
+    m_ring[m_head] = sample;
+    m_head = (m_head + 1) % capacity;
+    m_count = qMin(m_count + 1, capacity);
+}
+
+} // namespace HorizonUTM
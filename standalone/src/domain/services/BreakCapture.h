@@ -0,0 +1,76 @@
+#pragma once
+
+#include <QVector>
+#include "domain/value_objects/SensorData.h"
+
+namespace HorizonUTM {
+
+/**
+ * @brief Break burst parameters
+ */
+struct BreakCaptureSettings {
+    bool enabled = false;
+    qint64 preTriggerMs = 100;          ///< Kept before the trigger
+    qint64 postTriggerMs = 50;          ///< Kept after the trigger
+    double sampleRateHz = 100.0;        ///< Initial ring size; the ring grows for faster sensors
+};
+
+/**
+ * @brief Keeps the samples around the specimen break at full sensor rate
+ *
+ * Every sample goes into a circular buffer covering the last
+ * preTriggerMs. When the BreakDetector triggers, the buffer is copied out
+ * and the next postTriggerMs of samples are appended. A later trigger (a
+ * larger drop) replaces the burst. The ring is sized from sampleRateHz and doubles if the
+ * window holds more samples, so steady-state capture never allocates.
+ */
+class BreakCapture {
+public:
+    explicit BreakCapture(const BreakCaptureSettings& settings = BreakCaptureSettings());
+
+    const BreakCaptureSettings& settings() const { return m_settings; }
+    void setSettings(const BreakCaptureSettings& settings);
+    bool isEnabled() const { return m_settings.enabled; }
+
+    /**
+     * @brief Start a new test
+     */
+    void reset();
+
+    /**
+     * @brief Feed one acquired sample
+     * @param trigger The break detector triggered on this sample
+     * @return true when this sample completed the burst (again, after a
+     *         later trigger)
+     */
+    bool process(const SensorData& sample, bool trigger);
+
+    bool isTriggered() const { return m_triggered; }
+    bool isComplete() const { return m_complete; }
+    qint64 triggerTimestamp() const { return m_triggerTimestamp; }
+
+    /**
+     * @brief Samples from preTriggerMs before the trigger on, in order
+     *
+     * Complete once isComplete(); shorter post-trigger part if acquisition
+     * ended first.
+     */
+    const QVector<SensorData>& burst() const { return m_burst; }
+
+private:
+    void push(const SensorData& sample);
+
+    BreakCaptureSettings m_settings;
+
+    // Ring of the last preTriggerMs
+    QVector<SensorData> m_ring;
+    qsizetype m_head;       // Next write
+    qsizetype m_count;
+
+    bool m_triggered;
+    bool m_complete;
+    qint64 m_triggerTimestamp;
+    QVector<SensorData> m_burst;
+};
+
+} // namespace HorizonUTM
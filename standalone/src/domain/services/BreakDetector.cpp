@@ -0,0 +1,64 @@
+#include "BreakDetector.h"
+#include <QtGlobal>
+
+namespace HorizonUTM {
+
+BreakDetector::BreakDetector(const BreakDetectorSettings& settings)
+    : m_settings(settings)
+{
+    reset();
+}
+
+void BreakDetector::setSettings(const BreakDetectorSettings& settings) {
+    m_settings = settings;
+    reset();
+}
+
+void BreakDetector::reset() {
+    m_previous = SensorData();
+    m_hasPrevious = false;
+    m_maxForce = 0.0;
+
+    m_triggered = false;
+    m_collapsed = false;
+    m_triggerTimestamp = 0;
+    m_triggerDrop = 0.0;
+    m_triggerCount = 0;
+}
+
+bool BreakDetector::process(const SensorData& sample) {
+    // Re-armed for a larger drop until the force has collapsed
+    const bool trigger = !m_collapsed && isTrigger(sample)
+        && (!m_triggered || m_previous.force - sample.force > m_triggerDrop);
+    if (trigger) {
+        m_triggered = true;
+        m_triggerTimestamp = sample.timestamp;
+        m_triggerDrop = m_previous.force - sample.force;
+        ++m_triggerCount;
+    }
+    if (m_triggered && sample.force < m_settings.minForce) {
+        m_collapsed = true;
+    }
+
+    m_previous = sample;
+    m_hasPrevious = true;
+    m_maxForce = qMax(m_maxForce, sample.force);
+    return trigger;
+}
+
+bool BreakDetector::isTrigger(const SensorData& sample) const {
+    if (!m_hasPrevious || m_maxForce < m_settings.minForce) {
+        return false;
+    }
+
+    const double drop = m_previous.force - sample.force;
+    if (drop > m_maxForce * m_settings.forceDropPercent / 100.0) {
+        return true;
+    }
+
+    const qint64 elapsedMs = sample.timestamp - m_previous.timestamp;
+    return m_settings.forceRateLimit > 0.0 && elapsedMs > 0
+        && drop * 1000.0 / elapsedMs > m_settings.forceRateLimit;
+}
+
+} // namespace HorizonUTM
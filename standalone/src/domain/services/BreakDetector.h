@@ -0,0 +1,66 @@
+#pragma once
+
+#include "domain/value_objects/SensorData.h"
+
+namespace HorizonUTM {
+
+/**
+ * @brief Break detection thresholds
+ */
+struct BreakDetectorSettings {
+    double forceDropPercent = 10.0;     ///< Drop between two samples, % of the maximum force
+    double forceRateLimit = 0.0;        ///< N/s falling; 0 = off
+    double minForce = 10.0;             ///< N; no trigger before the force reached this
+};
+
+/**
+ * @brief Decides when the specimen broke, on the unfiltered samples
+ *
+ * Triggers on the first sample whose force falls by forceDropPercent of
+ * the maximum since the previous one, or faster than forceRateLimit, once
+ * the force has reached minForce. A partial drop (a jaw slipping, one
+ * fibre bundle failing) can come first, so it keeps watching until the
+ * force has collapsed below minForce and triggers again on any larger
+ * drop. One detector feeds both the break capture and the recording
+ * policy, so they agree on the break.
+ */
+class BreakDetector {
+public:
+    explicit BreakDetector(const BreakDetectorSettings& settings = BreakDetectorSettings());
+
+    const BreakDetectorSettings& settings() const { return m_settings; }
+    void setSettings(const BreakDetectorSettings& settings);
+
+    /**
+     * @brief Start a new test
+     */
+    void reset();
+
+    /**
+     * @brief Feed one acquired sample
+     * @return true at each sample that triggered, the latest being the break
+     */
+    bool process(const SensorData& sample);
+
+    bool isTriggered() const { return m_triggered; }
+    qint64 triggerTimestamp() const { return m_triggerTimestamp; }
+    int triggerCount() const { return m_triggerCount; }
+    double maxForce() const { return m_maxForce; }
+
+private:
+    bool isTrigger(const SensorData& sample) const;
+
+    BreakDetectorSettings m_settings;
+
+    SensorData m_previous;
+    bool m_hasPrevious;
+    double m_maxForce;
+
+    bool m_triggered;
+    bool m_collapsed;           // No more triggers
+    qint64 m_triggerTimestamp;
+    double m_triggerDrop;       // N, of the latest trigger
+    int m_triggerCount;
+};
+
+} // namespace HorizonUTM
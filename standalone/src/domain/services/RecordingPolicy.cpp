@@ -0,0 +1,193 @@
+#include "RecordingPolicy.h"
+#include <limits>
+
+namespace HorizonUTM {
+
+QString recordingEventToString(RecordingEvent event) {
+    switch (event) {
+    case RecordingEvent::None: return "None";
+    case RecordingEvent::Yield: return "Yield";
+    case RecordingEvent::Peak: return "Peak";
+    case RecordingEvent::Break: return "Break";
+    }
+    return "None";
+}
+
+RecordingPolicy::RecordingPolicy(const RecordingSettings& settings)
+    : m_settings(settings)
+{
+    reset();
+}
+
+void RecordingPolicy::setSettings(const RecordingSettings& settings) {
+    m_settings = settings;
+    reset();
+}
+
+void RecordingPolicy::reset() {
+    m_lastKept = SensorData();
+    m_hasKept = false;
+    m_fullRateUntil = std::numeric_limits<qint64>::min();
+    m_seen = 0;
+    m_kept = 0;
+
+    m_pending.clear();
+    m_pendingStart = 0;
+
+    m_slopeAnchor = SensorData();
+    m_maxForce = 0.0;
+    m_maxTimestamp = 0;
+    m_maxSequence = 0;
+    m_peakArmed = false;
+    m_yieldFound = false;
+    m_breakFound = false;
+    m_maxSlope = 0.0;
+}
+
+RecordingEvent RecordingPolicy::process(const SensorData& sample, QVector<SensorData>& kept, bool isBreak) {
+    kept.clear();
+    ++m_seen;
+
+    if (!m_settings.enabled) {
+        kept.append(sample);
+        ++m_kept;
+        return RecordingEvent::None;
+    }
+
+    const qint64 window = m_settings.eventWindowMs;
+    RecordingEvent event = RecordingEvent::None;
+    if (!m_hasKept) {
+        m_slopeAnchor = sample;
+        m_maxForce = sample.force;
+        m_maxTimestamp = sample.timestamp;
+        m_maxSequence = m_seen;
+    } else {
+        qint64 from = 0;
+        qint64 until = 0;
+        event = detectEvent(sample, isBreak, from, until);
+        if (event != RecordingEvent::None) {
+            keepAround(from - window, until + window);
+        }
+    }
+
+    const bool keep = !m_hasKept
+        || qAbs(sample.force - m_lastKept.force) > m_settings.forceDeadband
+        || qAbs(sample.extension - m_lastKept.extension) > m_settings.extensionDeadband
+        || sample.timestamp - m_lastKept.timestamp >= m_settings.maxIntervalMs
+        || sample.timestamp <= m_fullRateUntil;
+    if (keep) {
+        m_lastKept = sample;
+        m_hasKept = true;
+    }
+    m_pending.append({sample, m_seen, keep});
+
+    // Hold back what an unconfirmed maximum or slope interval may reach
+    qint64 before = sample.timestamp - window;
+    if (!m_breakFound) {
+        if (m_peakArmed) {
+            before = qMin(before, m_maxTimestamp - window);
+        }
+        if (!m_yieldFound) {
+            before = qMin(before, m_slopeAnchor.timestamp - window);
+        }
+        before = qMax(before, sample.timestamp - qMax(window, m_settings.maxEventDelayMs));
+    }
+
+    release(before, kept);
+    return event;
+}
+
+void RecordingPolicy::keepAround(qint64 from, qint64 until) {
+    // Pending samples in the span, then the ones still to come
+    for (qsizetype i = m_pending.size() - 1; i >= m_pendingStart; --i) {
+        const qint64 timestamp = m_pending[i].sample.timestamp;
+        if (timestamp < from) {
+            break;
+        }
+        if (timestamp <= until) {
+            m_pending[i].keep = true;
+        }
+    }
+    m_fullRateUntil = qMax(m_fullRateUntil, until);
+}
+
+void RecordingPolicy::flush(QVector<SensorData>& kept) {
+    kept.clear();
+    if (m_pendingStart < m_pending.size()) {
+        m_pending[m_pending.size() - 1].keep = true;
+    }
+    release(std::numeric_limits<qint64>::max(), kept);
+}
+
+void RecordingPolicy::release(qint64 before, QVector<SensorData>& kept) {
+    while (m_pendingStart < m_pending.size() && m_pending[m_pendingStart].sample.timestamp < before) {
+        const Pending& pending = m_pending[m_pendingStart++];
+        if (pending.keep || pending.sequence == m_maxSequence) {
+            kept.append(pending.sample);
+            ++m_kept;
+        }
+    }
+
+    // Reclaim the released front now and then instead of on every sample
+    if (m_pendingStart == m_pending.size()) {
+        m_pending.clear();
+        m_pendingStart = 0;
+    } else if (m_pendingStart > 1024 && m_pendingStart * 2 > m_pending.size()) {
+        m_pending.remove(0, m_pendingStart);
+        m_pendingStart = 0;
+    }
+}
+
+RecordingEvent RecordingPolicy::detectEvent(const SensorData& sample, bool isBreak, qint64& from, qint64& until) {
+    from = sample.timestamp;
+    until = sample.timestamp;
+
+    // Also a later, larger drop the detector re-triggered on
+    if (isBreak) {
+        m_breakFound = true;
+        if (m_peakArmed) {
+            // No peak before the break: the maximum is the ultimate force
+            keepAround(m_maxTimestamp - m_settings.eventWindowMs, m_maxTimestamp + m_settings.eventWindowMs);
+            m_peakArmed = false;
+        }
+        return RecordingEvent::Break;
+    }
+
+    if (m_breakFound) {
+        return RecordingEvent::None;
+    }
+
+    // Peak: first clear drop below the running maximum
+    if (sample.force > m_maxForce) {
+        m_maxForce = sample.force;
+        m_maxTimestamp = sample.timestamp;
+        m_maxSequence = m_seen;
+        m_peakArmed = true;
+    } else if (m_peakArmed && sample.force < m_maxForce * (1.0 - m_settings.peakDropPercent / 100.0)) {
+        m_peakArmed = false;
+        from = m_maxTimestamp;
+        until = m_maxTimestamp;
+        return RecordingEvent::Peak;
+    }
+
+    // Yield: knee in the force/extension slope, measured over one event
+    // window so sample noise averages out
+    if (!m_yieldFound && sample.timestamp - m_slopeAnchor.timestamp >= m_settings.eventWindowMs) {
+        const double deltaExtension = sample.extension - m_slopeAnchor.extension;
+        if (deltaExtension > 0.0) {
+            const double slope = (sample.force - m_slopeAnchor.force) / deltaExtension;
+            from = m_slopeAnchor.timestamp;
+            m_slopeAnchor = sample;
+            if (slope > m_maxSlope) {
+                m_maxSlope = slope;
+            } else if (slope < m_maxSlope * m_settings.yieldSlopeRatio) {
+                m_yieldFound = true;
+                return RecordingEvent::Yield;
+            }
+        }
+    }
+
+    return RecordingEvent::None;
+}
+
+} // namespace HorizonUTM
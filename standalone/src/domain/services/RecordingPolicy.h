@@ -0,0 +1,122 @@
+#pragma once
+
+#include <QString>
+#include <QVector>
+#include "domain/value_objects/SensorData.h"
+
+namespace HorizonUTM {
+
+/**
+ * @brief Curve feature detected while recording
+ */
+enum class RecordingEvent {
+    None,
+    Yield,  ///< Force/extension slope over an event window fell below yieldSlopeRatio of its maximum
+    Peak,   ///< Force fell peakDropPercent below its running maximum
+    Break   ///< The BreakDetector triggered, again on a larger drop
+};
+
+QString recordingEventToString(RecordingEvent event);
+
+/**
+ * @brief Deadband recording parameters
+ *
+ * Deadbands should sit above the sensor noise (or the acquisition filter
+ * should be on), otherwise noise alone keeps every sample.
+ */
+struct RecordingSettings {
+    bool enabled = false;
+    double forceDeadband = 1.0;         ///< N
+    double extensionDeadband = 0.01;    ///< mm
+    qint64 maxIntervalMs = 1000;        ///< Store at least this often
+    qint64 eventWindowMs = 200;         ///< Full rate before and after an event
+    qint64 maxEventDelayMs = 10000;     ///< Longest samples are held for a peak or yield to show
+    double peakDropPercent = 5.0;
+    double yieldSlopeRatio = 0.5;
+};
+
+/**
+ * @brief Decides which acquired samples are stored
+ *
+ * A sample is kept when force or extension moved beyond its deadband since
+ * the last kept sample, or maxIntervalMs has passed; every dropped sample
+ * is therefore within the deadbands of a kept one. Around an event every
+ * sample from eventWindowMs before to eventWindowMs after is kept: around
+ * the break, around the running maximum for a peak (and for a break no
+ * peak was seen before), and around the slope interval that showed the
+ * yield. To reach back, samples are released in acquisition order once no
+ * pending event can still reach them: eventWindowMs after they were
+ * acquired, longer while a maximum or slope interval is unconfirmed, but
+ * never more than maxEventDelayMs. The first sample and the running
+ * maximum are always kept, and flush() releases the rest including the
+ * last sample.
+ */
+class RecordingPolicy {
+public:
+    explicit RecordingPolicy(const RecordingSettings& settings = RecordingSettings());
+
+    const RecordingSettings& settings() const { return m_settings; }
+    void setSettings(const RecordingSettings& settings);
+    bool isEnabled() const { return m_settings.enabled; }
+
+    /**
+     * @brief Start a new test
+     */
+    void reset();
+
+    /**
+     * @brief Feed one acquired sample
+     * @param kept Cleared, then receives the samples to store, which are
+     *        eventWindowMs older than this one
+     * @param isBreak The break detector triggered on this sample
+     * @return Event detected at this sample, if any
+     */
+    RecordingEvent process(const SensorData& sample, QVector<SensorData>& kept, bool isBreak);
+
+    /**
+     * @brief End of acquisition: release the pending samples
+     * @param kept Cleared, then receives the samples to store; ends with the last sample
+     */
+    void flush(QVector<SensorData>& kept);
+
+    qint64 seenCount() const { return m_seen; }
+    qint64 keptCount() const { return m_kept; }
+
+private:
+    struct Pending {
+        SensorData sample;
+        qint64 sequence;    // m_seen when it arrived
+        bool keep;
+    };
+
+    /**
+     * @param from, until Set to the span the event lies in
+     */
+    RecordingEvent detectEvent(const SensorData& sample, bool isBreak, qint64& from, qint64& until);
+    void keepAround(qint64 from, qint64 until);
+    void release(qint64 before, QVector<SensorData>& kept);
+
+    RecordingSettings m_settings;
+
+    SensorData m_lastKept;
+    bool m_hasKept;
+    qint64 m_fullRateUntil;
+    qint64 m_seen;
+    qint64 m_kept;
+
+    // Samples of the last eventWindowMs, not yet released
+    QVector<Pending> m_pending;
+    qsizetype m_pendingStart;
+
+    // Event detection
+    SensorData m_slopeAnchor;   // Start of the current slope interval
+    double m_maxForce;
+    qint64 m_maxTimestamp;
+    qint64 m_maxSequence;       // Kept whenever it is released
+    bool m_peakArmed;
+    bool m_yieldFound;
+    bool m_breakFound;
+    double m_maxSlope;
+};
+
+} // namespace HorizonUTM
@@ -0,0 +1,374 @@
+#include "SignalFilter.h"
+#include <QtMath>
+#include <algorithm>
+
+namespace HorizonUTM {
+
+FilterType filterTypeFromString(const QString& name, bool* ok) {
+    const QString key = name.trimmed().toLower();
+    if (ok) *ok = true;
+
+    if (key == "moving_average") return FilterType::MovingAverage;
+    if (key == "median") return FilterType::Median;
+    if (key == "butterworth") return FilterType::Butterworth;
+    if (key == "savitzky_golay") return FilterType::SavitzkyGolay;
+    if (ok && key != "none" && !key.isEmpty()) *ok = false;
+    return FilterType::None;
+}
+
+QString filterTypeToString(FilterType type) {
+    switch (type) {
+    case FilterType::None: return "none";
+    case FilterType::MovingAverage: return "moving_average";
+    case FilterType::Median: return "median";
+    case FilterType::Butterworth: return "butterworth";
+    case FilterType::SavitzkyGolay: return "savitzky_golay";
+    }
+    return "none";
+}
+
+namespace {
+
+/**
+ * @brief Coefficients of a normalized low-pass biquad (a0 = 1)
+ */
+struct BiquadCoefficients {
+    double b0, b1, b2, a1, a2;
+};
+
+/**
+ * @brief Section k of a Butterworth low-pass (bilinear transform, one per pole pair)
+ */
+BiquadCoefficients butterworthSection(const FilterSettings& settings, int k) {
+    const int order = settings.order;
+    const double w0 = 2.0 * M_PI * settings.cutoffHz / settings.sampleRateHz;
+    const double cosW0 = qCos(w0);
+    const double q = 1.0 / (2.0 * qCos(M_PI * (2 * k + 1) / (2.0 * order)));
+    const double alpha = qSin(w0) / (2.0 * q);
+    const double a0 = 1.0 + alpha;
+
+    BiquadCoefficients c;
+    c.b0 = (1.0 - cosW0) / 2.0 / a0;
+    c.b1 = (1.0 - cosW0) / a0;
+    c.b2 = c.b0;
+    c.a1 = -2.0 * cosW0 / a0;
+    c.a2 = (1.0 - alpha) / a0;
+    return c;
+}
+
+} // namespace
+
+// ==================== FILTER SETTINGS ====================
+
+bool FilterSettings::isValid() const {
+    switch (type) {
+    case FilterType::None:
+        return true;
+    case FilterType::MovingAverage:
+        return windowSize >= 1;
+    case FilterType::Median:
+        return windowSize >= 1 && windowSize % 2 == 1;
+    case FilterType::SavitzkyGolay:
+        return windowSize >= 3 && windowSize % 2 == 1
+            && polynomialOrder >= 0 && polynomialOrder < windowSize;
+    case FilterType::Butterworth:
+        return order >= 2 && order <= 8 && order % 2 == 0
+            && sampleRateHz > 0 && cutoffHz > 0 && cutoffHz < sampleRateHz / 2.0;
+    }
+    return false;
+}
+
+double FilterSettings::latencySamples() const {
+    switch (type) {
+    case FilterType::None:
+        return 0.0;
+    case FilterType::MovingAverage:
+    case FilterType::Median:
+    case FilterType::SavitzkyGolay:
+        return (windowSize - 1) / 2.0;
+    case FilterType::Butterworth: {
+        if (!isValid()) return 0.0;
+        // DC group delay, sum over sections of sum(n b_n)/sum(b_n) - sum(n a_n)/sum(a_n);
+        // the numerator b0 (1, 2, 1) contributes 1
+        double delay = 0.0;
+        for (int k = 0; k < order / 2; ++k) {
+            const BiquadCoefficients c = butterworthSection(*this, k);
+            delay += 1.0 - (c.a1 + 2.0 * c.a2) / (1.0 + c.a1 + c.a2);
+        }
+        return delay;
+    }
+    }
+    return 0.0;
+}
+
+// ==================== SIGNAL FILTER ====================
+
+namespace {
+
+/**
+ * @brief Savitzky–Golay taps smoothing the centre of an odd window
+ *
+ * The centre value of a least-squares polynomial fit is e0ᵀ (AᵀA)⁻¹ Aᵀ x,
+ * so tap j is aᵀ A_j with (AᵀA) a = e0. Offsets are scaled to [-1, 1] to
+ * keep the normal equations well conditioned.
+ */
+QVector<double> savitzkyGolayTaps(int windowSize, int polynomialOrder) {
+    const int half = windowSize / 2;
+    const int n = polynomialOrder + 1;
+
+    auto offset = [half](int j) { return double(j - half) / half; };
+
+    // Normal equations [AᵀA | e0]
+    QVector<QVector<double>> m(n, QVector<double>(n + 1, 0.0));
+    for (int r = 0; r < n; ++r) {
+        for (int c = 0; c < n; ++c) {
+            for (int j = 0; j < windowSize; ++j) {
+                m[r][c] += qPow(offset(j), r + c);
+            }
+        }
+        m[r][n] = r == 0 ? 1.0 : 0.0;
+    }
+
+    // Gaussian elimination with partial pivoting
+    for (int col = 0; col < n; ++col) {
+        int pivot = col;
+        for (int r = col + 1; r < n; ++r) {
+            if (qAbs(m[r][col]) > qAbs(m[pivot][col])) pivot = r;
+        }
+        std::swap(m[col], m[pivot]);
+        for (int r = 0; r < n; ++r) {
+            if (r == col) continue;
+            double factor = m[r][col] / m[col][col];
+            for (int c = col; c <= n; ++c) {
+                m[r][c] -= factor * m[col][c];
+            }
+        }
+    }
+
+    QVector<double> taps(windowSize, 0.0);
+    for (int j = 0; j < windowSize; ++j) {
+        for (int r = 0; r < n; ++r) {
+            taps[j] += (m[r][n] / m[r][r]) * qPow(offset(j), r);
+        }
+    }
+    return taps;
+}
+
+} // namespace
+
+SignalFilter::SignalFilter(const FilterSettings& settings)
+    : m_primed(false)
+{
+    setSettings(settings);
+}
+
+bool SignalFilter::setSettings(const FilterSettings& settings) {
+    const bool valid = settings.isValid();
+    m_settings = valid ? settings : FilterSettings();
+    design();
+    return valid;
+}
+
+void SignalFilter::design() {
+    m_window.clear();
+    m_coefficients.clear();
+    m_sorted.clear();
+    m_sections.clear();
+
+    const int window = m_settings.windowSize;
+    switch (m_settings.type) {
+    case FilterType::None:
+        break;
+    case FilterType::MovingAverage:
+        m_coefficients.fill(1.0 / window, window);
+        m_window.resize(window - 1 + MAX_BLOCK_SIZE);
+        break;
+    case FilterType::SavitzkyGolay:
+        m_coefficients = savitzkyGolayTaps(window, m_settings.polynomialOrder);
+        m_window.resize(window - 1 + MAX_BLOCK_SIZE);
+        break;
+    case FilterType::Median:
+        // One more history sample: the one leaving the window
+        m_sorted.resize(window);
+        m_window.resize(window + MAX_BLOCK_SIZE);
+        break;
+    case FilterType::Butterworth:
+        for (int k = 0; k < m_settings.order / 2; ++k) {
+            const BiquadCoefficients c = butterworthSection(m_settings, k);
+            Biquad section;
+            section.b0 = c.b0;
+            section.b1 = c.b1;
+            section.b2 = c.b2;
+            section.a1 = c.a1;
+            section.a2 = c.a2;
+            m_sections.append(section);
+        }
+        break;
+    }
+
+    m_primed = false;
+}
+
+void SignalFilter::reset() {
+    m_primed = false;
+}
+
+void SignalFilter::prime(double sample) {
+    // State of a signal that has always been at sample
+    std::fill(m_window.begin(), m_window.end(), sample);
+    std::fill(m_sorted.begin(), m_sorted.end(), sample);
+    for (Biquad& section : m_sections) {
+        section.s2 = (section.b2 - section.a2) * sample;
+        section.s1 = (section.b1 - section.a1) * sample + section.s2;
+    }
+    m_primed = true;
+}
+
+double SignalFilter::process(double sample) {
+    double out;
+    processBlock(&sample, &out, 1);
+    return out;
+}
+
+void SignalFilter::process(const double* in, double* out, qsizetype count) {
+    for (qsizetype done = 0; done < count; done += MAX_BLOCK_SIZE) {
+        processBlock(in + done, out + done, qMin(MAX_BLOCK_SIZE, count - done));
+    }
+}
+
+void SignalFilter::processBlock(const double* in, double* out, qsizetype count) {
+    if (count <= 0) {
+        return;
+    }
+    if (!m_primed) {
+        prime(in[0]);
+    }
+
+    const FilterType type = m_settings.type;
+    if (type == FilterType::None) {
+        if (out != in) std::copy(in, in + count, out);
+        return;
+    }
+
+    if (type == FilterType::Butterworth) {
+        // The recursion is serial in time; run each section over the whole block
+        const double* source = in;
+        for (Biquad& s : m_sections) {
+            for (qsizetype i = 0; i < count; ++i) {
+                const double x = source[i];
+                const double y = s.b0 * x + s.s1;
+                s.s1 = s.b1 * x - s.a1 * y + s.s2;
+                s.s2 = s.b2 * x - s.a2 * y;
+                out[i] = y;
+            }
+            source = out;
+        }
+        return;
+    }
+
+    // Window filters: append the block behind the history
+    const qsizetype history = m_window.size() - MAX_BLOCK_SIZE;
+    std::copy(in, in + count, m_window.begin() + history);
+
+    if (type == FilterType::Median) {
+        medianBlock(count, out);
+    } else {
+        firBlock(count, out);
+    }
+
+    // Keep the newest samples as history
+    std::copy(m_window.cbegin() + count, m_window.cbegin() + count + history, m_window.begin());
+}
+
+void SignalFilter::firBlock(qsizetype count, double* out) const {
+    // out[i] = sum_k c[k] * window[i + k], one tap at a time over the block
+    const double* window = m_window.constData();
+    std::fill(out, out + count, 0.0);
+    for (qsizetype k = 0; k < m_coefficients.size(); ++k) {
+        const double c = m_coefficients[k];
+        const double* source = window + k;
+        for (qsizetype i = 0; i < count; ++i) {
+            out[i] += c * source[i];
+        }
+    }
+}
+
+void SignalFilter::medianBlock(qsizetype count, double* out) {
+    // window[i] leaves as window[i + size] enters; m_sorted holds the window
+    const qsizetype size = m_sorted.size();
+    double* sorted = m_sorted.data();
+    for (qsizetype i = 0; i < count; ++i) {
+        const double leaving = m_window[i];
+        const double entering = m_window[i + size];
+
+        qsizetype pos = std::lower_bound(sorted, sorted + size, leaving) - sorted;
+        // Slide the entering sample into the freed slot's ordered position
+        while (pos > 0 && sorted[pos - 1] > entering) {
+            sorted[pos] = sorted[pos - 1];
+            --pos;
+        }
+        while (pos + 1 < size && sorted[pos + 1] < entering) {
+            sorted[pos] = sorted[pos + 1];
+            ++pos;
+        }
+        sorted[pos] = entering;
+
+        out[i] = sorted[size / 2];
+    }
+}
+
+// ==================== SENSOR DATA FILTER ====================
+
+SensorDataFilter::SensorDataFilter(const FilterSettings& settings)
+    : m_channel(SignalFilter::MAX_BLOCK_SIZE)
+{
+    setSettings(settings);
+}
+
+bool SensorDataFilter::setSettings(const FilterSettings& settings) {
+    bool valid = m_force.setSettings(settings);
+    m_extension.setSettings(settings);
+    m_stress.setSettings(settings);
+    m_strain.setSettings(settings);
+    return valid;
+}
+
+void SensorDataFilter::reset() {
+    m_force.reset();
+    m_extension.reset();
+    m_stress.reset();
+    m_strain.reset();
+}
+
+SensorData SensorDataFilter::process(const SensorData& sample) {
+    SensorData out;
+    process(&sample, &out, 1);
+    return out;
+}
+
+void SensorDataFilter::process(const SensorData* in, SensorData* out, qsizetype count) {
+    if (out != in) {
+        std::copy(in, in + count, out);
+    }
+    if (!isEnabled()) {
+        return;
+    }
+
+    double* channel = m_channel.data();
+    auto filterChannel = [&](SignalFilter& filter, double SensorData::*field, SensorData* block, qsizetype n) {
+        for (qsizetype i = 0; i < n; ++i) channel[i] = block[i].*field;
+        filter.process(channel, channel, n);
+        for (qsizetype i = 0; i < n; ++i) block[i].*field = channel[i];
+    };
+
+    for (qsizetype done = 0; done < count; done += SignalFilter::MAX_BLOCK_SIZE) {
+        SensorData* block = out + done;
+        const qsizetype n = qMin(SignalFilter::MAX_BLOCK_SIZE, count - done);
+        filterChannel(m_force, &SensorData::force, block, n);
+        filterChannel(m_extension, &SensorData::extension, block, n);
+        filterChannel(m_stress, &SensorData::stress, block, n);
+        filterChannel(m_strain, &SensorData::strain, block, n);
+    }
+}
+
+} // namespace HorizonUTM
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <QString>
+#include <QVector>
+#include "domain/value_objects/SensorData.h"
+
+namespace HorizonUTM {
+
+/**
+ * @brief Streaming low-pass filter kind
+ */
+enum class FilterType {
+    None,           ///< Pass-through
+    MovingAverage,  ///< Mean of the last windowSize samples
+    Median,         ///< Median of the last windowSize samples (spike rejection)
+    Butterworth,    ///< Butterworth IIR low-pass of the given order
+    SavitzkyGolay   ///< Least-squares polynomial smoothing over windowSize samples
+};
+
+/**
+ * @brief Parse "none", "moving_average", "median", "butterworth", "savitzky_golay"
+ * @param ok Set to false if the name is unknown (None is returned)
+ */
+FilterType filterTypeFromString(const QString& name, bool* ok = nullptr);
+
+QString filterTypeToString(FilterType type);
+
+/**
+ * @brief Filter design parameters
+ */
+struct FilterSettings {
+    FilterType type = FilterType::None;
+    int windowSize = 5;             ///< Samples; MovingAverage, Median, SavitzkyGolay (odd)
+    int polynomialOrder = 2;        ///< SavitzkyGolay, below windowSize
+    int order = 2;                  ///< Butterworth, even, 2..8
+    double cutoffHz = 10.0;         ///< Butterworth -3 dB frequency
+    double sampleRateHz = 100.0;    ///< Butterworth design rate
+
+    bool isEnabled() const { return type != FilterType::None; }
+
+    /**
+     * @brief Check the parameters can be designed
+     */
+    bool isValid() const;
+
+    /**
+     * @brief Delay of the filtered signal in samples
+     *
+     * (windowSize - 1) / 2 for the window filters, the DC group delay for
+     * Butterworth.
+     */
+    double latencySamples() const;
+
+    double latencyMs() const { return latencySamples() * 1000.0 / sampleRateHz; }
+};
+
+/**
+ * @brief Causal low-pass filter for one channel
+ *
+ * Processes contiguous blocks: window filters copy the block behind their
+ * history and run an axpy-style FIR kernel the compiler can vectorize,
+ * Butterworth runs each biquad section over the whole block in turn. All
+ * buffers are sized when the filter is designed, so filtering never
+ * allocates. The first sample primes the state as if it had been constant
+ * before, so there is no start-up ramp.
+ */
+class SignalFilter {
+public:
+    /**
+     * @brief Largest block processed in one pass; longer input is chunked
+     */
+    static constexpr qsizetype MAX_BLOCK_SIZE = 1024;
+
+    explicit SignalFilter(const FilterSettings& settings = FilterSettings());
+
+    const FilterSettings& settings() const { return m_settings; }
+
+    /**
+     * @brief Redesign the filter and clear its state
+     * @return false if the settings are invalid (the filter passes through)
+     */
+    bool setSettings(const FilterSettings& settings);
+
+    /**
+     * @brief Forget the signal history
+     */
+    void reset();
+
+    /**
+     * @brief Filter count samples; in and out may be the same buffer
+     */
+    void process(const double* in, double* out, qsizetype count);
+
+    /**
+     * @brief Filter one sample
+     */
+    double process(double sample);
+
+private:
+    struct Biquad {
+        double b0, b1, b2, a1, a2;
+        double s1 = 0.0, s2 = 0.0;
+    };
+
+    void design();
+    void prime(double sample);
+    void processBlock(const double* in, double* out, qsizetype count);
+    void firBlock(qsizetype count, double* out) const;
+    void medianBlock(qsizetype count, double* out);
+
+    FilterSettings m_settings;
+    bool m_primed;
+
+    // Window filters: [history | block], history = windowSize - 1 (median: windowSize)
+    QVector<double> m_window;
+    QVector<double> m_coefficients;     // FIR taps, oldest first
+    QVector<double> m_sorted;           // Median: current window, sorted
+
+    QVector<Biquad> m_sections;
+};
+
+/**
+ * @brief Filters the force, extension, stress and strain of a sample stream
+ *
+ * Stress and strain are filtered with the same design as force and
+ * extension, so they stay proportional to them whatever the specimen
+ * geometry the driver used. All channels are delayed alike, which keeps
+ * the stress-strain relation intact. Timestamps and temperature pass
+ * through unchanged.
+ */
+class SensorDataFilter {
+public:
+    explicit SensorDataFilter(const FilterSettings& settings = FilterSettings());
+
+    const FilterSettings& settings() const { return m_force.settings(); }
+    bool setSettings(const FilterSettings& settings);
+    bool isEnabled() const { return m_force.settings().isEnabled(); }
+
+    void reset();
+
+    /**
+     * @brief Filter count samples; in and out may be the same buffer
+     */
+    void process(const SensorData* in, SensorData* out, qsizetype count);
+
+    SensorData process(const SensorData& sample);
+
+private:
+    SignalFilter m_force;
+    SignalFilter m_extension;
+    SignalFilter m_stress;
+    SignalFilter m_strain;
+
+    QVector<double> m_channel;  // Deinterleaved block
+};
+
+} // namespace HorizonUTM
@@ -0,0 +1,89 @@
+#include "StrainIndex.h"
+#include <algorithm>
+
+namespace HorizonUTM {
+
+StrainIndex::StrainIndex(const QVector<SensorData>& data) {
+    build(data);
+}
+
+StrainIndex::StrainIndex(const Curve& curve) {
+    build(curve);
+}
+
+template<typename Points>
+void StrainIndex::build(const Points& data) {
+    m_strain.resize(data.size());
+    m_stress.resize(data.size());
+
+    double envelope = 0.0;
+    for (qsizetype i = 0; i < data.size(); ++i) {
+        const SensorData& point = data[i];
+        envelope = i == 0 ? point.strain : qMax(envelope, point.strain);
+        m_strain[i] = envelope;
+        m_stress[i] = point.stress;
+    }
+}
+
+qsizetype StrainIndex::lowerBound(double strain) const {
+    return std::lower_bound(m_strain.cbegin(), m_strain.cend(), strain) - m_strain.cbegin();
+}
+
+bool StrainIndex::stressAtStrain(double strain, double& stress) const {
+    if (isEmpty() || strain < m_strain.first() || strain > m_strain.last()) {
+        return false;
+    }
+
+    qsizetype i = lowerBound(strain);
+    if (i == 0 || m_strain[i] == strain) {
+        stress = m_stress[i];
+        return true;
+    }
+
+    // m_strain[i - 1] < strain < m_strain[i]
+    double t = (strain - m_strain[i - 1]) / (m_strain[i] - m_strain[i - 1]);
+    stress = m_stress[i - 1] + t * (m_stress[i] - m_stress[i - 1]);
+    return true;
+}
+
+bool StrainIndex::firstCrossing(double intercept, double slope, qsizetype from, qsizetype to,
+                                double& strain, double& stress) const {
+    if (isEmpty()) {
+        return false;
+    }
+    from = qBound<qsizetype>(0, from, size() - 1);
+    to = qBound<qsizetype>(from, to, size() - 1);
+
+    auto distance = [&](qsizetype i) {
+        return m_stress[i] - (intercept + slope * m_strain[i]);
+    };
+
+    if (distance(from) <= 0) {
+        strain = m_strain[from];
+        stress = m_stress[from];
+        return true;
+    }
+    if (distance(to) > 0) {
+        return false;
+    }
+
+    // Above the line at lo, on or below it at hi
+    qsizetype lo = from;
+    qsizetype hi = to;
+    while (hi - lo > 1) {
+        qsizetype mid = lo + (hi - lo) / 2;
+        if (distance(mid) > 0) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+
+    double dLo = distance(lo);
+    double t = dLo / (dLo - distance(hi));
+    strain = m_strain[lo] + t * (m_strain[hi] - m_strain[lo]);
+    stress = m_stress[lo] + t * (m_stress[hi] - m_stress[lo]);
+    return true;
+}
+
+} // namespace HorizonUTM
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <QVector>
+#include "domain/value_objects/Curve.h"
+#include "domain/value_objects/SensorData.h"
+
+namespace HorizonUTM {
+
+/**
+ * @brief Strain-ordered view of a curve for interpolated lookups
+ *
+ * Strain is replaced by its running maximum, so noise that briefly moves
+ * strain backwards cannot break the ordering; stress is kept as measured.
+ * Lookups binary-search the envelope and interpolate linearly between the
+ * neighbouring samples, which makes results independent of the sample rate.
+ * Strains are in %, stresses in MPa.
+ */
+class StrainIndex {
+public:
+    StrainIndex() = default;
+    explicit StrainIndex(const QVector<SensorData>& data);
+    explicit StrainIndex(const Curve& curve);
+
+    qsizetype size() const { return m_strain.size(); }
+    bool isEmpty() const { return m_strain.isEmpty(); }
+
+    /**
+     * @brief Envelope strain of point index
+     */
+    double strainAt(qsizetype index) const { return m_strain[index]; }
+    double stressAt(qsizetype index) const { return m_stress[index]; }
+
+    /**
+     * @brief First index whose envelope strain is >= strain (size() if none)
+     */
+    qsizetype lowerBound(double strain) const;
+
+    /**
+     * @brief Interpolated stress at the given strain
+     * @return false if strain lies outside the curve
+     */
+    bool stressAtStrain(double strain, double& stress) const;
+
+    /**
+     * @brief First point where the curve drops onto the line
+     *        stress = intercept + slope * strain
+     *
+     * Bisects the sign of (curve - line) between from and to, so it finds
+     * the first crossing whenever the curve crosses the line once in that
+     * range, as the yield offset line does before maximum stress.
+     *
+     * @param from First index searched; the curve is expected above the line
+     * @param to Last index searched
+     * @param strain Output: interpolated strain of the crossing
+     * @param stress Output: interpolated stress of the crossing
+     * @return false if the curve is still above the line at to
+     */
+    bool firstCrossing(double intercept, double slope, qsizetype from, qsizetype to,
+                       double& strain, double& stress) const;
+
+private:
+    template<typename Points>
+    void build(const Points& data);
+
+    QVector<double> m_strain;   // Running maximum
+    QVector<double> m_stress;
+};
+
+} // namespace HorizonUTM
@@ -1,4 +1,5 @@
 #include "StressStrainCalculator.h"
+#include "StrainIndex.h"
 #include <QtMath>
 #include <algorithm>
 
@@ -16,57 +17,49 @@ double StressStrainCalculator::calculateStrain(double extension, double gaugeLen
     return (extension / gaugeLength) * 100.0;
 }
 
-TestResult StressStrainCalculator::calculateResults(const QVector<SensorData>& data,
-                                                     double area,
-                                                     double gaugeLength) {
-    TestResult result;
+namespace {
 
-    if (data.isEmpty() || area <= 0 || gaugeLength <= 0) {
-        return result;
-    }
+// The analysis is written once against any indexable point sequence, so a
+// curve read across RAM and spilled segments needs no contiguous copy.
 
-    // Max stress and strain
-    result.maxStress = findMaxStress(data);
-    result.maxStrain = findStrainAtMaxStress(data);
-
-    // Yield stress (0.2% offset)
-    result.yieldStress = calculateYieldStress(data, 0.2);
-
-    // Find yield strain
-    for (const auto& point : data) {
-        if (point.stress >= result.yieldStress) {
-            result.yieldStrain = point.strain;
-            break;
-        }
+void linearRegressionImpl(const QVector<double>& xData,
+                          const QVector<double>& yData,
+                          double& slope,
+                          double& intercept) {
+    int n = qMin(xData.size(), yData.size());
+    if (n < 2) {
+        slope = 0;
+        intercept = 0;
+        return;
     }
 
-    // Ultimate tensile strength
-    result.ultimateStress = findUltimateTensileStrength(data);
-
-    // Find ultimate strain
-    for (const auto& point : data) {
-        if (point.stress >= result.ultimateStress) {
-            result.ultimateStrain = point.strain;
-            break;
-        }
+    // Calculate means
+    double xMean = 0, yMean = 0;
+    for (int i = 0; i < n; ++i) {
+        xMean += xData[i];
+        yMean += yData[i];
     }
+    xMean /= n;
+    yMean /= n;
 
-    // Break stress and strain (last point)
-    if (!data.isEmpty()) {
-        result.breakStress = data.last().stress;
-        result.breakStrain = data.last().strain;
+    // Calculate slope and intercept
+    double numerator = 0, denominator = 0;
+    for (int i = 0; i < n; ++i) {
+        numerator += (xData[i] - xMean) * (yData[i] - yMean);
+        denominator += (xData[i] - xMean) * (xData[i] - xMean);
     }
 
-    // Elastic modulus
-    result.elasticModulus = calculateElasticModulus(data);
-
-    // Elongation at break
-    result.elongationAtBreak = calculateElongationAtBreak(data, gaugeLength);
-
-    return result;
+    if (denominator != 0) {
+        slope = numerator / denominator;
+        intercept = yMean - slope * xMean;
+    } else {
+        slope = 0;
+        intercept = yMean;
+    }
 }
 
-double StressStrainCalculator::findMaxStress(const QVector<SensorData>& data) {
+template<typename Points>
+double maxStressOf(const Points& data) {
     if (data.isEmpty()) return 0.0;
 
     double maxStress = 0.0;
@@ -78,7 +71,8 @@ double StressStrainCalculator::findMaxStress(const QVector<SensorData>& data) {
     return maxStress;
 }
 
-double StressStrainCalculator::findStrainAtMaxStress(const QVector<SensorData>& data) {
+template<typename Points>
+double strainAtMaxStressOf(const Points& data) {
     if (data.isEmpty()) return 0.0;
 
     double maxStress = 0.0;
@@ -93,54 +87,285 @@ double StressStrainCalculator::findStrainAtMaxStress(const QVector<SensorData>&
     return strainAtMax;
 }
 
-double StressStrainCalculator::calculateYieldStress(const QVector<SensorData>& data,
-                                                     double offsetPercent) {
-    if (data.size() < 10) return 0.0;
+template<typename Points>
+qsizetype peakIndexOf(const Points& data) {
+    qsizetype peak = 0;
+    for (qsizetype i = 1; i < data.size(); ++i) {
+        if (data[i].stress > data[peak].stress) {
+            peak = i;
+        }
+    }
+    return peak;
+}
 
-    // Calculate elastic modulus first
-    double modulus = calculateElasticModulus(data);
-    if (modulus <= 0) return 0.0;
+template<typename Points>
+bool linearRegionOf(const Points& data, qsizetype& startIdx, qsizetype& endIdx) {
+    if (data.size() < 10) return false;
 
-    // Find 0.2% offset line: stress = modulus * (strain - 0.2)
-    // Find where actual curve intersects this line
+    // Start from point where stress is significant (skip initial noise)
+    startIdx = 0;
+    for (qsizetype i = 0; i < data.size(); ++i) {
+        if (data[i].stress > 1.0) { // 1 MPa threshold
+            startIdx = i;
+            break;
+        }
+    }
 
-    for (int i = 1; i < data.size(); ++i) {
-        double offsetStress = (modulus * 1000.0) * ((data[i].strain - offsetPercent) / 100.0);
+    // Linear region typically ends at ~0.5% strain or 30% of max stress
+    double maxStress = maxStressOf(data);
+    double thresholdStress = maxStress * 0.3;
 
-        if (data[i].stress >= offsetStress && offsetStress > 0) {
-            return data[i].stress;
+    endIdx = startIdx;
+    for (qsizetype i = startIdx; i < data.size(); ++i) {
+        if (data[i].strain > 0.5 || data[i].stress > thresholdStress) {
+            endIdx = i;
+            break;
         }
     }
 
-    // If no yield found, return 0
-    return 0.0;
+    // Need at least 5 points for good regression
+    return (endIdx - startIdx) >= 5;
 }
 
-double StressStrainCalculator::calculateElasticModulus(const QVector<SensorData>& data) {
+template<typename Points>
+double elasticModulusOf(const Points& data) {
     if (data.size() < 10) return 0.0;
 
     // Find linear region (typically first 20-30% of data before yield)
-    int startIdx, endIdx;
-    if (!findLinearRegion(data, startIdx, endIdx)) {
+    qsizetype startIdx, endIdx;
+    if (!linearRegionOf(data, startIdx, endIdx)) {
         return 0.0;
     }
 
     // Extract strain and stress for linear region
     QVector<double> strains, stresses;
-    for (int i = startIdx; i <= endIdx && i < data.size(); ++i) {
+    for (qsizetype i = startIdx; i <= endIdx && i < data.size(); ++i) {
         strains.append(data[i].strain / 100.0); // Convert % to fraction
         stresses.append(data[i].stress);
     }
 
     // Perform linear regression
     double slope, intercept;
-    linearRegression(strains, stresses, slope, intercept);
+    linearRegressionImpl(strains, stresses, slope, intercept);
 
     // Slope is the elastic modulus in MPa (stress/strain)
     // Return in MPa (not GPa)
     return slope;
 }
 
+/**
+ * @brief Window sums of strain (x, fraction) and stress (y)
+ */
+struct RegressionSums {
+    double x = 0, y = 0, xy = 0, xx = 0, yy = 0;
+
+    RegressionSums operator-(const RegressionSums& other) const {
+        return {x - other.x, y - other.y, xy - other.xy, xx - other.xx, yy - other.yy};
+    }
+};
+
+template<typename Points>
+ModulusFit bestFitModulusOf(const Points& data, int windowPoints, double minRSquared) {
+    ModulusFit best;
+    if (data.size() < 10) return best;
+
+    // Pre-yield search range: up to maximum stress
+    const qsizetype count = peakIndexOf(data) + 1;
+    const qsizetype window = windowPoints > 0 ? windowPoints : qMax<qsizetype>(10, count / 20);
+    if (count < window || window < 3) return best;
+
+    // Prefix sums relative to the first point keep the differences precise;
+    // only the last window + 1 of them are needed, kept in a ring
+    const double x0 = data[0].strain / 100.0;
+    const double y0 = data[0].stress;
+    QVector<RegressionSums> prefix(window + 1);
+    RegressionSums running;
+    const double n = static_cast<double>(window);
+    ModulusFit bestFitting;
+
+    for (qsizetype i = 0; i < count; ++i) {
+        const double x = data[i].strain / 100.0 - x0;
+        const double y = data[i].stress - y0;
+        running.x += x;
+        running.y += y;
+        running.xy += x * y;
+        running.xx += x * x;
+        running.yy += y * y;
+        prefix[(i + 1) % (window + 1)] = running;
+
+        if (i + 1 < window) {
+            continue;
+        }
+
+        // Window [i - window + 1, i]
+        const RegressionSums s = running - prefix[(i + 1 - window) % (window + 1)];
+        const double sxy = n * s.xy - s.x * s.y;
+        const double sxx = n * s.xx - s.x * s.x;
+        const double syy = n * s.yy - s.y * s.y;
+        if (sxx <= 0 || syy <= 0) {
+            continue;
+        }
+
+        const double slope = sxy / sxx;
+        const double rSquared = (sxy * sxy) / (sxx * syy);
+        const qsizetype start = i - window + 1;
+
+        if (rSquared >= minRSquared && slope > best.modulus) {
+            best = {slope, rSquared, start, i};
+        }
+        if (slope > 0 && rSquared > bestFitting.rSquared) {
+            bestFitting = {slope, rSquared, start, i};
+        }
+    }
+
+    return best.isValid() ? best : bestFitting;
+}
+
+double chordModulusOf(const StrainIndex& index, double strain1, double strain2) {
+    double stress1 = 0.0;
+    double stress2 = 0.0;
+    if (strain2 <= strain1
+        || !index.stressAtStrain(strain1, stress1)
+        || !index.stressAtStrain(strain2, stress2)) {
+        return 0.0;
+    }
+    // Strain in % -> MPa
+    return (stress2 - stress1) / ((strain2 - strain1) / 100.0);
+}
+
+template<typename Points>
+double elasticModulusOf(const Points& data, const StrainIndex& index, ModulusMethod method) {
+    switch (method) {
+    case ModulusMethod::BestFitWindow:
+        return bestFitModulusOf(data, 0, StressStrainCalculator::DEFAULT_MIN_R_SQUARED).modulus;
+    case ModulusMethod::Chord:
+        return chordModulusOf(index, StressStrainCalculator::CHORD_START_STRAIN,
+                              StressStrainCalculator::CHORD_END_STRAIN);
+    case ModulusMethod::LinearRegion:
+        break;
+    }
+    return elasticModulusOf(data);
+}
+
+/**
+ * @brief Intersection of the curve with the offset line
+ *        stress = modulus * (strain - offset), searched up to maximum stress
+ */
+bool yieldPointOf(const StrainIndex& index, qsizetype peak, double modulus, double offsetPercent,
+                  double& stress, double& strain) {
+    if (index.size() < 10 || modulus <= 0) return false;
+
+    // Strain in % -> slope per %
+    const double slope = modulus / 100.0;
+    return index.firstCrossing(-slope * offsetPercent, slope, 0, peak, strain, stress);
+}
+
+template<typename Points>
+double yieldStressOf(const Points& data, double offsetPercent) {
+    if (data.size() < 10) return 0.0;
+
+    const StrainIndex index(data);
+    double stress = 0.0;
+    double strain = 0.0;
+    if (!yieldPointOf(index, peakIndexOf(data), elasticModulusOf(data), offsetPercent, stress, strain)) {
+        return 0.0;
+    }
+    return stress;
+}
+
+template<typename Points>
+TestResult resultsOf(const Points& data, double area, double gaugeLength, ModulusMethod modulusMethod) {
+    TestResult result;
+
+    if (data.isEmpty() || area <= 0 || gaugeLength <= 0) {
+        return result;
+    }
+
+    // Max stress and strain
+    result.maxStress = maxStressOf(data);
+    result.maxStrain = strainAtMaxStressOf(data);
+
+    // Elastic modulus
+    const StrainIndex index(data);
+    result.elasticModulus = elasticModulusOf(data, index, modulusMethod);
+
+    // Yield point (0.2% offset), interpolated between samples
+    const qsizetype peak = peakIndexOf(data);
+    yieldPointOf(index, peak, result.elasticModulus, 0.2,
+                 result.yieldStress, result.yieldStrain);
+
+    // Ultimate tensile strength is the maximum stress, reached first at the peak
+    result.ultimateStress = result.maxStress;
+    if (data[peak].stress >= result.ultimateStress) {
+        result.ultimateStrain = data[peak].strain;
+    }
+
+    // Break stress and strain (last point)
+    result.breakStress = data.last().stress;
+    result.breakStrain = data.last().strain;
+
+    // Elongation at break is the final strain
+    result.elongationAtBreak = data.last().strain;
+
+    return result;
+}
+
+} // namespace
+
+TestResult StressStrainCalculator::calculateResults(const QVector<SensorData>& data,
+                                                     double area,
+                                                     double gaugeLength,
+                                                     ModulusMethod modulusMethod) {
+    return resultsOf(data, area, gaugeLength, modulusMethod);
+}
+
+TestResult StressStrainCalculator::calculateResults(const Curve& curve,
+                                                     double area,
+                                                     double gaugeLength,
+                                                     ModulusMethod modulusMethod) {
+    return resultsOf(curve, area, gaugeLength, modulusMethod);
+}
+
+double StressStrainCalculator::findMaxStress(const QVector<SensorData>& data) {
+    return maxStressOf(data);
+}
+
+double StressStrainCalculator::findStrainAtMaxStress(const QVector<SensorData>& data) {
+    return strainAtMaxStressOf(data);
+}
+
+double StressStrainCalculator::calculateYieldStress(const QVector<SensorData>& data,
+                                                     double offsetPercent) {
+    return yieldStressOf(data, offsetPercent);
+}
+
+double StressStrainCalculator::calculateElasticModulus(const QVector<SensorData>& data) {
+    return elasticModulusOf(data);
+}
+
+double StressStrainCalculator::calculateElasticModulus(const QVector<SensorData>& data,
+                                                       ModulusMethod method) {
+    return elasticModulusOf(data, StrainIndex(data), method);
+}
+
+double StressStrainCalculator::calculateChordModulus(const QVector<SensorData>& data,
+                                                     double strain1,
+                                                     double strain2) {
+    return chordModulusOf(StrainIndex(data), strain1, strain2);
+}
+
+ModulusFit StressStrainCalculator::findBestFitModulus(const QVector<SensorData>& data,
+                                                      int windowPoints,
+                                                      double minRSquared) {
+    return bestFitModulusOf(data, windowPoints, minRSquared);
+}
+
+ModulusFit StressStrainCalculator::findBestFitModulus(const Curve& curve,
+                                                      int windowPoints,
+                                                      double minRSquared) {
+    return bestFitModulusOf(curve, windowPoints, minRSquared);
+}
+
 double StressStrainCalculator::findUltimateTensileStrength(const QVector<SensorData>& data) {
     // Ultimate tensile strength is the maximum stress
     return findMaxStress(data);
@@ -157,67 +382,18 @@ double StressStrainCalculator::calculateElongationAtBreak(const QVector<SensorDa
 bool StressStrainCalculator::findLinearRegion(const QVector<SensorData>& data,
                                               int& startIdx,
                                               int& endIdx) {
-    if (data.size() < 10) return false;
-
-    // Start from point where stress is significant (skip initial noise)
-    startIdx = 0;
-    for (int i = 0; i < data.size(); ++i) {
-        if (data[i].stress > 1.0) { // 1 MPa threshold
-            startIdx = i;
-            break;
-        }
-    }
-
-    // Linear region typically ends at ~0.5% strain or 30% of max stress
-    double maxStress = findMaxStress(data);
-    double thresholdStress = maxStress * 0.3;
-
-    endIdx = startIdx;
-    for (int i = startIdx; i < data.size(); ++i) {
-        if (data[i].strain > 0.5 || data[i].stress > thresholdStress) {
-            endIdx = i;
-            break;
-        }
-    }
-
-    // Need at least 5 points for good regression
-    return (endIdx - startIdx) >= 5;
+    qsizetype start = 0, end = 0;
+    bool found = linearRegionOf(data, start, end);
+    startIdx = int(start);
+    endIdx = int(end);
+    return found;
 }
 
 void StressStrainCalculator::linearRegression(const QVector<double>& xData,
                                               const QVector<double>& yData,
                                               double& slope,
                                               double& intercept) {
-    int n = qMin(xData.size(), yData.size());
-    if (n < 2) {
-        slope = 0;
-        intercept = 0;
-        return;
-    }
-
-    // Calculate means
-    double xMean = 0, yMean = 0;
-    for (int i = 0; i < n; ++i) {
-        xMean += xData[i];
-        yMean += yData[i];
-    }
-    xMean /= n;
-    yMean /= n;
-
-    // Calculate slope and intercept
-    double numerator = 0, denominator = 0;
-    for (int i = 0; i < n; ++i) {
-        numerator += (xData[i] - xMean) * (yData[i] - yMean);
-        denominator += (xData[i] - xMean) * (xData[i] - xMean);
-    }
-
-    if (denominator != 0) {
-        slope = numerator / denominator;
-        intercept = yMean - slope * xMean;
-    } else {
-        slope = 0;
-        intercept = yMean;
-    }
+    linearRegressionImpl(xData, yData, slope, intercept);
 }
 
 } // namespace HorizonUTM
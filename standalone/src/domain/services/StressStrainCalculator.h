@@ -1,11 +1,33 @@
 #pragma once
 
 #include <QVector>
+#include "domain/value_objects/Curve.h"
 #include "domain/value_objects/SensorData.h"
 #include "domain/value_objects/TestResult.h"
 
 namespace HorizonUTM {
 
+/**
+ * @brief How the elastic modulus is determined
+ */
+enum class ModulusMethod {
+    LinearRegion,   ///< Regression from 1 MPa up to 0.5% strain or 30% of max stress
+    BestFitWindow,  ///< Steepest well-fitting regression window before max stress
+    Chord           ///< Secant between 0.05% and 0.25% strain (ISO 527-1)
+};
+
+/**
+ * @brief Regression window chosen by the best-fit modulus search
+ */
+struct ModulusFit {
+    double modulus = 0.0;       ///< Slope in MPa
+    double rSquared = 0.0;      ///< Coefficient of determination of the window
+    qsizetype startIndex = 0;
+    qsizetype endIndex = 0;     ///< Inclusive
+
+    bool isValid() const { return modulus > 0.0; }
+};
+
 /**
  * @brief Service for calculating stress, strain, and mechanical properties
  * 
@@ -34,11 +56,24 @@ public:
      * @param data Vector of sensor data points
      * @param area Cross-section area in mm²
      * @param gaugeLength Gauge length in mm
+     * @param modulusMethod How the elastic modulus (and the yield offset line) is found
      * @return TestResult with all calculated properties
      */
     static TestResult calculateResults(const QVector<SensorData>& data, 
                                        double area, 
-                                       double gaugeLength);
+                                       double gaugeLength,
+                                       ModulusMethod modulusMethod = ModulusMethod::LinearRegion);
+
+    /**
+     * @brief Calculate full test results from a curve
+     *
+     * Reads the points in place, including spilled segments, without
+     * building a contiguous copy.
+     */
+    static TestResult calculateResults(const Curve& curve,
+                                       double area,
+                                       double gaugeLength,
+                                       ModulusMethod modulusMethod = ModulusMethod::LinearRegion);
     
     /**
      * @brief Find maximum stress in data
@@ -52,9 +87,13 @@ public:
     
     /**
      * @brief Calculate yield stress using 0.2% offset method
+     *
+     * Stress where the curve meets the offset line before maximum stress,
+     * interpolated between samples.
+     *
      * @param data Sensor data
      * @param offsetPercent Offset percentage (typically 0.2%)
-     * @return Yield stress in MPa
+     * @return Yield stress in MPa, 0 if the curve does not reach the line
      */
     static double calculateYieldStress(const QVector<SensorData>& data, 
                                        double offsetPercent = 0.2);
@@ -65,6 +104,52 @@ public:
      * @return Elastic modulus in GPa
      */
     static double calculateElasticModulus(const QVector<SensorData>& data);
+
+    /**
+     * @brief Calculate elastic modulus with the given method
+     * @return Elastic modulus in MPa, 0 if none could be determined
+     */
+    static double calculateElasticModulus(const QVector<SensorData>& data, ModulusMethod method);
+
+    /**
+     * @brief Best-fit modulus window search
+     *
+     * Slides a regression window over the curve up to maximum stress and
+     * returns the steepest window whose R² reaches minRSquared (or the
+     * best-fitting one if none does). Window sums come from running prefix
+     * sums of strain, stress and their products, so every window costs
+     * O(1) and the search is linear in the number of points.
+     *
+     * @param data Sensor data
+     * @param windowPoints Points per window, 0 = 5% of the pre-maximum
+     *        points (at least 10)
+     * @param minRSquared Fit quality a window needs to qualify
+     */
+    static ModulusFit findBestFitModulus(const QVector<SensorData>& data,
+                                         int windowPoints = 0,
+                                         double minRSquared = DEFAULT_MIN_R_SQUARED);
+    static ModulusFit findBestFitModulus(const Curve& curve,
+                                         int windowPoints = 0,
+                                         double minRSquared = DEFAULT_MIN_R_SQUARED);
+
+    static constexpr double DEFAULT_MIN_R_SQUARED = 0.995;
+
+    /**
+     * @brief Chord modulus between two strains
+     *
+     * Stresses at both strains are interpolated between samples, so the
+     * result does not depend on the sample rate.
+     *
+     * @param strain1 Lower strain in %
+     * @param strain2 Upper strain in %
+     * @return Modulus in MPa, 0 if the curve does not reach both strains
+     */
+    static double calculateChordModulus(const QVector<SensorData>& data,
+                                        double strain1 = CHORD_START_STRAIN,
+                                        double strain2 = CHORD_END_STRAIN);
+
+    static constexpr double CHORD_START_STRAIN = 0.05;  ///< ISO 527-1, %
+    static constexpr double CHORD_END_STRAIN = 0.25;    ///< ISO 527-1, %
     
     /**
      * @brief Find ultimate tensile strength (max stress before break)
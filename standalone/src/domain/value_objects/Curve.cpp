@@ -0,0 +1,183 @@
+#include "Curve.h"
+#include "domain/interfaces/ICurveSpillStore.h"
+#include <algorithm>
+
+namespace HorizonUTM {
+
+// ==================== CURVE ====================
+
+Curve::Segment Curve::Segment::fromBlock(std::shared_ptr<const Block> block) {
+    Segment segment;
+    segment.data = block->constData();
+    segment.size = block->size();
+    segment.block = block.get();
+    segment.owner = std::move(block);
+    return segment;
+}
+
+Curve::Curve() = default;
+
+Curve::Curve(std::shared_ptr<const Storage> storage)
+    : m_storage(std::move(storage))
+{
+}
+
+Curve Curve::fromVector(const QVector<SensorData>& points) {
+    if (points.isEmpty()) {
+        return Curve();
+    }
+
+    auto storage = std::make_shared<Storage>();
+    storage->segments.append(Segment::fromBlock(std::make_shared<const Block>(points)));
+    storage->size = points.size();
+    return Curve(std::move(storage));
+}
+
+const SensorData& Curve::at(qsizetype index) const {
+    Q_ASSERT(index >= 0 && index < size());
+
+    const auto& segments = m_storage->segments;
+    if (segments.size() == 1) {
+        return segments.first().data[index];
+    }
+    return segments[index / BLOCK_SIZE].data[index % BLOCK_SIZE];
+}
+
+qsizetype Curve::spilledCount() const {
+    qsizetype count = 0;
+    for (int i = 0; i < segmentCount(); ++i) {
+        if (segment(i).isSpilled()) {
+            count += segment(i).size;
+        }
+    }
+    return count;
+}
+
+const QVector<SensorData>& Curve::points() const {
+    static const QVector<SensorData> empty;
+    if (!m_storage) {
+        return empty;
+    }
+
+    const Storage& storage = *m_storage;
+    if (storage.segments.size() == 1 && !storage.segments.first().isSpilled()) {
+        return *storage.segments.first().block;
+    }
+
+    std::call_once(storage.flattenOnce, [&storage]() {
+        QVector<SensorData> flat(storage.size);
+        SensorData* out = flat.data();
+        for (const Segment& segment : storage.segments) {
+            out = std::copy(segment.data, segment.data + segment.size, out);
+        }
+        storage.flat = std::move(flat);
+    });
+    return storage.flat;
+}
+
+// ==================== CURVE BUILDER ====================
+
+CurveBuilder::CurveBuilder()
+    : m_sealedSize(0)
+    , m_memoryBudget(0)
+    , m_firstInRam(0)
+    , m_spilledCount(0)
+{
+    m_open.reserve(Curve::BLOCK_SIZE);
+}
+
+void CurveBuilder::append(const SensorData& point) {
+    m_open.append(point);
+
+    if (m_open.size() == Curve::BLOCK_SIZE) {
+        m_sealed.append(Curve::Segment::fromBlock(std::make_shared<const Curve::Block>(std::move(m_open))));
+        m_sealedSize += Curve::BLOCK_SIZE;
+
+        m_open = Curve::Block();
+        m_open.reserve(Curve::BLOCK_SIZE);
+
+        spillOldBlocks();
+    }
+}
+
+void CurveBuilder::clear() {
+    m_sealed.clear();
+    m_sealedSize = 0;
+    m_open.clear();
+    m_firstInRam = 0;
+    m_spilledCount = 0;
+}
+
+void CurveBuilder::setMemoryBudget(qint64 budgetBytes, std::shared_ptr<ICurveSpillStore> store) {
+    m_memoryBudget = qMax<qint64>(0, budgetBytes);
+    m_spillStore = std::move(store);
+    spillOldBlocks();
+}
+
+qint64 CurveBuilder::memoryBytes() const {
+    qsizetype inRam = size() - m_spilledCount;
+    return static_cast<qint64>(inRam) * qint64(sizeof(SensorData));
+}
+
+void CurveBuilder::spillOldBlocks() {
+    if (!m_spillStore || m_memoryBudget <= 0) {
+        return;
+    }
+
+    while (memoryBytes() > m_memoryBudget && m_firstInRam < m_sealed.size()) {
+        Curve::Segment& segment = m_sealed[m_firstInRam];
+
+        Curve::Segment spilled = m_spillStore->spill(*segment.block);
+        if (!spilled.isValid()) {
+            // Keep everything in RAM rather than lose points
+            return;
+        }
+
+        // Snapshots taken earlier keep their reference to the RAM block
+        m_spilledCount += segment.size;
+        segment = std::move(spilled);
+        ++m_firstInRam;
+    }
+}
+
+Curve CurveBuilder::snapshot() const {
+    if (isEmpty()) {
+        return Curve();
+    }
+
+    auto storage = std::make_shared<Curve::Storage>();
+    storage->segments = m_sealed;
+    if (!m_open.isEmpty()) {
+        // Detached copy: the builder keeps appending to m_open
+        auto tail = std::make_shared<const Curve::Block>(m_open.constBegin(), m_open.constEnd());
+        storage->segments.append(Curve::Segment::fromBlock(std::move(tail)));
+    }
+    storage->size = size();
+    return Curve(std::move(storage));
+}
+
+Curve CurveBuilder::seal() {
+    Curve curve;
+
+    if (m_sealed.isEmpty()) {
+        curve = Curve::fromVector(m_open);
+    } else if (m_spilledCount > 0) {
+        // Concatenating would read the spilled points back into RAM
+        curve = snapshot();
+    } else {
+        QVector<SensorData> points;
+        points.reserve(size());
+        for (const Curve::Segment& segment : m_sealed) {
+            points.append(*segment.block);
+        }
+        points.append(m_open);
+        curve = Curve::fromVector(points);
+    }
+
+    clear();
+    m_open = Curve::Block();
+    m_open.reserve(Curve::BLOCK_SIZE);
+    return curve;
+}
+
+} // namespace HorizonUTM
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <QVector>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include "domain/value_objects/SensorData.h"
+
+namespace HorizonUTM {
+
+class ICurveSpillStore;
+
+/**
+ * @brief Immutable, reference-counted test curve
+ *
+ * The points live in sealed segments that are never modified after they
+ * are published, so a Curve can be copied in O(1) and read from the UI,
+ * analysis, export and persistence threads at the same time without locks.
+ * A segment is either a block in RAM or a block spilled to a memory-mapped
+ * file (see ICurveSpillStore); readers cannot tell the difference. Every
+ * segment except the last holds BLOCK_SIZE points, which keeps at()
+ * constant time. Curves are built with CurveBuilder.
+ */
+class Curve {
+public:
+    using Block = QVector<SensorData>;
+
+    static constexpr qsizetype BLOCK_SIZE = 4096;
+
+    /**
+     * @brief Contiguous run of points and whatever keeps them alive
+     */
+    struct Segment {
+        const SensorData* data = nullptr;
+        qsizetype size = 0;
+        std::shared_ptr<const void> owner;
+        const Block* block = nullptr;   ///< Set when the points are a RAM block
+
+        bool isValid() const { return data != nullptr; }
+        bool isSpilled() const { return block == nullptr; }
+
+        static Segment fromBlock(std::shared_ptr<const Block> block);
+    };
+
+    /**
+     * @brief Forward iterator over all points
+     */
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = SensorData;
+        using difference_type = qsizetype;
+        using pointer = const SensorData*;
+        using reference = const SensorData&;
+
+        const_iterator(const Curve* curve, qsizetype index) : m_curve(curve), m_index(index) {}
+
+        reference operator*() const { return m_curve->at(m_index); }
+        pointer operator->() const { return &m_curve->at(m_index); }
+        const_iterator& operator++() { ++m_index; return *this; }
+        const_iterator operator++(int) { const_iterator previous = *this; ++m_index; return previous; }
+        bool operator==(const const_iterator& other) const { return m_index == other.m_index; }
+        bool operator!=(const const_iterator& other) const { return m_index != other.m_index; }
+
+    private:
+        const Curve* m_curve;
+        qsizetype m_index;
+    };
+
+    /**
+     * @brief Empty curve
+     */
+    Curve();
+
+    /**
+     * @brief Curve sharing the points of an existing vector (no copy)
+     */
+    static Curve fromVector(const QVector<SensorData>& points);
+
+    qsizetype size() const { return m_storage ? m_storage->size : 0; }
+    bool isEmpty() const { return size() == 0; }
+
+    /**
+     * @brief Point at index (0 <= index < size())
+     */
+    const SensorData& at(qsizetype index) const;
+    const SensorData& operator[](qsizetype index) const { return at(index); }
+    const SensorData& first() const { return at(0); }
+    const SensorData& last() const { return at(size() - 1); }
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, size()); }
+
+    int segmentCount() const { return m_storage ? m_storage->segments.size() : 0; }
+    const Segment& segment(int index) const { return m_storage->segments[index]; }
+
+    /**
+     * @brief Points held in spilled segments
+     */
+    qsizetype spilledCount() const;
+
+    /**
+     * @brief All points as one contiguous vector
+     *
+     * Free for a curve held in a single RAM block (loaded or finished
+     * ones); otherwise the points are concatenated into RAM once on first
+     * use and cached, so prefer at() or iteration for spilled curves.
+     */
+    const QVector<SensorData>& points() const;
+
+    /**
+     * @brief Whether both handles share the same storage
+     */
+    bool isSharedWith(const Curve& other) const { return m_storage == other.m_storage; }
+
+private:
+    friend class CurveBuilder;
+
+    struct Storage {
+        QVector<Segment> segments;
+        qsizetype size = 0;
+
+        // Contiguous copy of a multi-segment curve, built on demand
+        mutable std::once_flag flattenOnce;
+        mutable QVector<SensorData> flat;
+    };
+
+    explicit Curve(std::shared_ptr<const Storage> storage);
+
+    std::shared_ptr<const Storage> m_storage;
+};
+
+/**
+ * @brief Append-only builder for a Curve, used during acquisition
+ *
+ * Owned by a single thread. Full blocks are sealed as they fill up, so
+ * snapshot() shares them with the curves it returns and copies only the
+ * partly filled tail. With a memory budget, the oldest sealed blocks are
+ * moved to a spill store once the blocks in RAM exceed it, so only the
+ * most recent window stays resident.
+ */
+class CurveBuilder {
+public:
+    CurveBuilder();
+
+    void append(const SensorData& point);
+    void clear();
+
+    qsizetype size() const { return m_sealedSize + m_open.size(); }
+    bool isEmpty() const { return size() == 0; }
+
+    /**
+     * @brief Keep at most budgetBytes of points in RAM, spilling to store
+     * @param budgetBytes Budget for the points in RAM; 0 keeps everything
+     * @param store Where sealed blocks go; nullptr disables spilling
+     */
+    void setMemoryBudget(qint64 budgetBytes, std::shared_ptr<ICurveSpillStore> store);
+
+    /**
+     * @brief Bytes of points currently held in RAM
+     */
+    qint64 memoryBytes() const;
+
+    /**
+     * @brief Points moved to the spill store
+     */
+    qsizetype spilledCount() const { return m_spilledCount; }
+
+    /**
+     * @brief Immutable view of the points appended so far
+     */
+    Curve snapshot() const;
+
+    /**
+     * @brief Finish the curve and reset the builder
+     *
+     * Without spilled blocks the result is a single RAM block; otherwise
+     * the spilled segments are kept as they are.
+     */
+    Curve seal();
+
+private:
+    void spillOldBlocks();
+
+    QVector<Curve::Segment> m_sealed;
+    qsizetype m_sealedSize;
+    Curve::Block m_open;
+
+    qint64 m_memoryBudget;
+    std::shared_ptr<ICurveSpillStore> m_spillStore;
+    int m_firstInRam;           // index of the oldest sealed block still in RAM
+    qsizetype m_spilledCount;
+};
+
+} // namespace HorizonUTM
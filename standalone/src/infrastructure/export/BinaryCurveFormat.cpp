@@ -0,0 +1,96 @@
+#include "BinaryCurveFormat.h"
+#include <QJsonArray>
+
+namespace HorizonUTM {
+namespace BinaryCurveFormat {
+
+QJsonObject testToJson(const Test& test) {
+    QJsonObject json;
+
+    json["id"] = test.getId();
+    json["sample_name"] = test.getSampleName();
+    json["operator_name"] = test.getOperatorName();
+    json["test_method"] = test.getTestMethod();
+    json["status"] = testStatusToString(test.getStatus());
+    json["start_time"] = test.getStartTime().toString(Qt::ISODateWithMs);
+    json["end_time"] = test.getEndTime().toString(Qt::ISODateWithMs);
+    json["width"] = test.getWidth();
+    json["thickness"] = test.getThickness();
+    json["gauge_length"] = test.getGaugeLength();
+    json["speed"] = test.getSpeed();
+    json["force_limit"] = test.getForceLimit();
+    json["temperature"] = test.getTemperature();
+    json["notes"] = test.getNotes();
+
+    const TestResult& result = test.getResult();
+    QJsonObject resultJson;
+    resultJson["max_stress"] = result.maxStress;
+    resultJson["max_strain"] = result.maxStrain;
+    resultJson["yield_stress"] = result.yieldStress;
+    resultJson["yield_strain"] = result.yieldStrain;
+    resultJson["ultimate_stress"] = result.ultimateStress;
+    resultJson["ultimate_strain"] = result.ultimateStrain;
+    resultJson["break_stress"] = result.breakStress;
+    resultJson["break_strain"] = result.breakStrain;
+    resultJson["elastic_modulus"] = result.elasticModulus;
+    resultJson["elongation_at_break"] = result.elongationAtBreak;
+    json["result"] = resultJson;
+
+    // Describe the channel arrays so the file can be read without this header
+    QJsonArray channels;
+    for (int i = 0; i < CHANNEL_COUNT; ++i) {
+        Channel channel = static_cast<Channel>(i);
+        QJsonObject channelJson;
+        channelJson["name"] = channelName(channel);
+        channelJson["unit"] = channelUnit(channel);
+        channelJson["type"] = channel == Channel::Timestamp ? "int64le" : "float64le";
+        channels.append(channelJson);
+    }
+    json["channels"] = channels;
+
+    return json;
+}
+
+Test testFromJson(const QJsonObject& json) {
+    Test test(json["id"].toInt(-1));
+
+    test.setSampleName(json["sample_name"].toString());
+    test.setOperatorName(json["operator_name"].toString());
+    test.setTestMethod(json["test_method"].toString());
+    test.setStartTime(QDateTime::fromString(json["start_time"].toString(), Qt::ISODateWithMs));
+    test.setEndTime(QDateTime::fromString(json["end_time"].toString(), Qt::ISODateWithMs));
+    test.setWidth(json["width"].toDouble());
+    test.setThickness(json["thickness"].toDouble());
+    test.setGaugeLength(json["gauge_length"].toDouble());
+    test.setSpeed(json["speed"].toDouble());
+    test.setForceLimit(json["force_limit"].toDouble());
+    test.setTemperature(json["temperature"].toDouble());
+    test.setNotes(json["notes"].toString());
+
+    QString statusStr = json["status"].toString();
+    if (statusStr == "Ready") test.setStatus(TestStatus::Ready);
+    else if (statusStr == "Running") test.setStatus(TestStatus::Running);
+    else if (statusStr == "Paused") test.setStatus(TestStatus::Paused);
+    else if (statusStr == "Completed") test.setStatus(TestStatus::Completed);
+    else if (statusStr == "Failed") test.setStatus(TestStatus::Failed);
+    else if (statusStr == "Stopped") test.setStatus(TestStatus::Stopped);
+
+    QJsonObject resultJson = json["result"].toObject();
+    TestResult result;
+    result.maxStress = resultJson["max_stress"].toDouble();
+    result.maxStrain = resultJson["max_strain"].toDouble();
+    result.yieldStress = resultJson["yield_stress"].toDouble();
+    result.yieldStrain = resultJson["yield_strain"].toDouble();
+    result.ultimateStress = resultJson["ultimate_stress"].toDouble();
+    result.ultimateStrain = resultJson["ultimate_strain"].toDouble();
+    result.breakStress = resultJson["break_stress"].toDouble();
+    result.breakStrain = resultJson["break_strain"].toDouble();
+    result.elasticModulus = resultJson["elastic_modulus"].toDouble();
+    result.elongationAtBreak = resultJson["elongation_at_break"].toDouble();
+    test.setResult(result);
+
+    return test;
+}
+
+} // namespace BinaryCurveFormat
+} // namespace HorizonUTM
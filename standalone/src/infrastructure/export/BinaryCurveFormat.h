@@ -0,0 +1,129 @@
+#pragma once
+
+#include <QtGlobal>
+#include <QJsonObject>
+#include <QString>
+#include "domain/entities/Test.h"
+
+namespace HorizonUTM {
+
+/**
+ * @brief Layout of the Horizon binary curve file (*.hzb)
+ *
+ * All integers and doubles are little-endian and every array starts on an
+ * 8-byte boundary, so a memory-mapped file can be read in place.
+ *
+ * @code
+ *   FileHeader                       (32 bytes)
+ *   per test:
+ *     metadata                       (UTF-8 JSON: test parameters + TestResult)
+ *     padding to 8 bytes
+ *     channel arrays                 (pointCount values each, see Channel)
+ *   IndexHeader                      (8 bytes)
+ *   IndexEntry × testCount           (72 bytes each)
+ * @endcode
+ *
+ * FileHeader::indexOffset points at the index footer, which holds the
+ * offsets of every metadata block and channel array.
+ */
+namespace BinaryCurveFormat {
+
+constexpr char FILE_MAGIC[4] = {'H', 'Z', 'C', 'B'};
+constexpr char INDEX_MAGIC[4] = {'H', 'Z', 'I', 'X'};
+constexpr quint16 VERSION = 1;
+constexpr int ALIGNMENT = 8;
+
+/**
+ * @brief Per-sample channels stored as separate arrays
+ */
+enum class Channel {
+    Timestamp,      ///< qint64, ms since epoch
+    Force,          ///< double, N
+    Extension,      ///< double, mm
+    Stress,         ///< double, MPa
+    Strain,         ///< double, %
+    Temperature     ///< double, °C
+};
+
+constexpr int CHANNEL_COUNT = 6;
+
+#pragma pack(push, 1)
+
+struct FileHeader {
+    char magic[4];
+    quint16 version;
+    quint16 flags;
+    quint32 testCount;
+    quint32 reserved;
+    quint64 indexOffset;
+    quint64 reserved2;
+};
+
+struct IndexHeader {
+    char magic[4];
+    quint32 testCount;
+};
+
+struct IndexEntry {
+    qint32 testId;
+    quint32 metadataSize;
+    quint64 metadataOffset;
+    quint64 pointCount;
+    quint64 channelOffsets[CHANNEL_COUNT];
+};
+
+#pragma pack(pop)
+
+static_assert(sizeof(FileHeader) == 32, "FileHeader layout changed");
+static_assert(sizeof(IndexHeader) == 8, "IndexHeader layout changed");
+static_assert(sizeof(IndexEntry) == 72, "IndexEntry layout changed");
+
+/**
+ * @brief Channel name as stored in the metadata
+ */
+inline QString channelName(Channel channel) {
+    switch (channel) {
+        case Channel::Timestamp:   return "timestamp";
+        case Channel::Force:       return "force";
+        case Channel::Extension:   return "extension";
+        case Channel::Stress:      return "stress";
+        case Channel::Strain:      return "strain";
+        case Channel::Temperature: return "temperature";
+        default:                   return "unknown";
+    }
+}
+
+/**
+ * @brief Channel unit as stored in the metadata
+ */
+inline QString channelUnit(Channel channel) {
+    switch (channel) {
+        case Channel::Timestamp:   return "ms";
+        case Channel::Force:       return "N";
+        case Channel::Extension:   return "mm";
+        case Channel::Stress:      return "MPa";
+        case Channel::Strain:      return "%";
+        case Channel::Temperature: return "°C";
+        default:                   return "";
+    }
+}
+
+/**
+ * @brief Round offset up to the next aligned position
+ */
+inline quint64 alignOffset(quint64 offset) {
+    return (offset + ALIGNMENT - 1) & ~quint64(ALIGNMENT - 1);
+}
+
+/**
+ * @brief Serialize test parameters and results (without curve data)
+ */
+QJsonObject testToJson(const Test& test);
+
+/**
+ * @brief Restore test parameters and results (without curve data)
+ */
+Test testFromJson(const QJsonObject& json);
+
+} // namespace BinaryCurveFormat
+} // namespace HorizonUTM
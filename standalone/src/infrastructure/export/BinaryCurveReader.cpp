@@ -0,0 +1,269 @@
+#include "BinaryCurveReader.h"
+#include "core/Logger.h"
+#include <QJsonDocument>
+#include <QtEndian>
+#include <cstring>
+
+namespace HorizonUTM {
+
+using namespace BinaryCurveFormat;
+
+BinaryCurveReader::BinaryCurveReader()
+    : m_map(nullptr)
+    , m_size(0)
+{
+}
+
+BinaryCurveReader::~BinaryCurveReader() {
+    close();
+}
+
+bool BinaryCurveReader::open(const QString& filePath) {
+    close();
+
+    m_file.setFileName(filePath);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        m_lastError = QString("Cannot open file: %1").arg(filePath);
+        LOG_ERROR(m_lastError);
+        return false;
+    }
+
+    m_size = m_file.size();
+    if (m_size < qint64(sizeof(FileHeader))) {
+        m_lastError = QString("File too small: %1").arg(filePath);
+        LOG_ERROR(m_lastError);
+        close();
+        return false;
+    }
+
+    m_map = m_file.map(0, m_size);
+    if (!m_map) {
+        m_lastError = QString("Failed to map file: %1").arg(m_file.errorString());
+        LOG_ERROR(m_lastError);
+        close();
+        return false;
+    }
+
+    FileHeader header;
+    std::memcpy(&header, m_map, sizeof(header));
+
+    if (std::memcmp(header.magic, FILE_MAGIC, sizeof(header.magic)) != 0) {
+        m_lastError = QString("Not a Horizon binary curve file: %1").arg(filePath);
+        LOG_ERROR(m_lastError);
+        close();
+        return false;
+    }
+
+    quint16 version = qFromLittleEndian(header.version);
+    if (version > VERSION) {
+        m_lastError = QString("Unsupported binary curve version %1").arg(version);
+        LOG_ERROR(m_lastError);
+        close();
+        return false;
+    }
+
+    // Index footer
+    quint64 indexOffset = qFromLittleEndian(header.indexOffset);
+    quint32 testCount = qFromLittleEndian(header.testCount);
+    quint64 indexSize = sizeof(IndexHeader) + quint64(testCount) * sizeof(IndexEntry);
+
+    // Offsets come from the file: compare against what is left so the sum cannot wrap
+    const quint64 size = quint64(m_size);
+    if (indexOffset < sizeof(FileHeader) || indexOffset > size || indexSize > size - indexOffset) {
+        m_lastError = "Corrupt index offset";
+        LOG_ERROR(m_lastError);
+        close();
+        return false;
+    }
+
+    IndexHeader indexHeader;
+    std::memcpy(&indexHeader, m_map + indexOffset, sizeof(indexHeader));
+    if (std::memcmp(indexHeader.magic, INDEX_MAGIC, sizeof(indexHeader.magic)) != 0 ||
+        qFromLittleEndian(indexHeader.testCount) != testCount) {
+        m_lastError = "Corrupt index header";
+        LOG_ERROR(m_lastError);
+        close();
+        return false;
+    }
+
+    m_index.resize(testCount);
+    const uchar* entries = m_map + indexOffset + sizeof(IndexHeader);
+
+    for (quint32 i = 0; i < testCount; ++i) {
+        IndexEntry raw;
+        std::memcpy(&raw, entries + i * sizeof(IndexEntry), sizeof(raw));
+
+        IndexEntry& entry = m_index[i];
+        entry.testId = qFromLittleEndian(raw.testId);
+        entry.metadataSize = qFromLittleEndian(raw.metadataSize);
+        entry.metadataOffset = qFromLittleEndian(raw.metadataOffset);
+        entry.pointCount = qFromLittleEndian(raw.pointCount);
+        for (int c = 0; c < CHANNEL_COUNT; ++c) {
+            entry.channelOffsets[c] = qFromLittleEndian(raw.channelOffsets[c]);
+        }
+
+        if (!validateEntry(entry)) {
+            m_lastError = QString("Corrupt index entry %1").arg(i);
+            LOG_ERROR(m_lastError);
+            close();
+            return false;
+        }
+    }
+
+    LOG_INFO(QString("Binary curve file opened: %1 (%2 tests)").arg(filePath).arg(testCount));
+    return true;
+}
+
+void BinaryCurveReader::close() {
+    if (m_map) {
+        m_file.unmap(m_map);
+        m_map = nullptr;
+    }
+    if (m_file.isOpen()) {
+        m_file.close();
+    }
+    m_size = 0;
+    m_index.clear();
+}
+
+int BinaryCurveReader::testId(int testIndex) const {
+    return isValidIndex(testIndex) ? m_index[testIndex].testId : -1;
+}
+
+qint64 BinaryCurveReader::pointCount(int testIndex) const {
+    return isValidIndex(testIndex) ? qint64(m_index[testIndex].pointCount) : 0;
+}
+
+QJsonObject BinaryCurveReader::metadata(int testIndex) const {
+    if (!isValidIndex(testIndex)) {
+        return QJsonObject();
+    }
+
+    const IndexEntry& entry = m_index[testIndex];
+    QByteArray json = QByteArray::fromRawData(
+        reinterpret_cast<const char*>(m_map + entry.metadataOffset), entry.metadataSize);
+
+    return QJsonDocument::fromJson(json).object();
+}
+
+const double* BinaryCurveReader::channel(int testIndex, Channel channel) const {
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+    if (!isValidIndex(testIndex) || channel == Channel::Timestamp) {
+        return nullptr;
+    }
+    return reinterpret_cast<const double*>(
+        m_map + m_index[testIndex].channelOffsets[static_cast<int>(channel)]);
+#else
+    Q_UNUSED(testIndex);
+    Q_UNUSED(channel);
+    return nullptr;
+#endif
+}
+
+const qint64* BinaryCurveReader::timestamps(int testIndex) const {
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+    if (!isValidIndex(testIndex)) {
+        return nullptr;
+    }
+    return reinterpret_cast<const qint64*>(
+        m_map + m_index[testIndex].channelOffsets[static_cast<int>(Channel::Timestamp)]);
+#else
+    Q_UNUSED(testIndex);
+    return nullptr;
+#endif
+}
+
+QVector<double> BinaryCurveReader::channelValues(int testIndex, Channel channel) const {
+    QVector<double> values;
+    if (!isValidIndex(testIndex)) {
+        return values;
+    }
+
+    qint64 count = pointCount(testIndex);
+    values.resize(count);
+
+    for (qint64 i = 0; i < count; ++i) {
+        quint64 bits = rawValue(testIndex, static_cast<int>(channel), i);
+        if (channel == Channel::Timestamp) {
+            values[i] = static_cast<double>(static_cast<qint64>(bits));
+        } else {
+            std::memcpy(&values[i], &bits, sizeof(double));
+        }
+    }
+
+    return values;
+}
+
+QVector<SensorData> BinaryCurveReader::dataPoints(int testIndex) const {
+    QVector<SensorData> data;
+    if (!isValidIndex(testIndex)) {
+        return data;
+    }
+
+    qint64 count = pointCount(testIndex);
+    data.resize(count);
+
+    auto toDouble = [](quint64 bits) {
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    };
+
+    for (qint64 i = 0; i < count; ++i) {
+        SensorData& point = data[i];
+        point.timestamp = static_cast<qint64>(rawValue(testIndex, int(Channel::Timestamp), i));
+        point.force = toDouble(rawValue(testIndex, int(Channel::Force), i));
+        point.extension = toDouble(rawValue(testIndex, int(Channel::Extension), i));
+        point.stress = toDouble(rawValue(testIndex, int(Channel::Stress), i));
+        point.strain = toDouble(rawValue(testIndex, int(Channel::Strain), i));
+        point.temperature = toDouble(rawValue(testIndex, int(Channel::Temperature), i));
+    }
+
+    return data;
+}
+
+Test BinaryCurveReader::test(int testIndex, bool withData) const {
+    if (!isValidIndex(testIndex)) {
+        return Test();
+    }
+
+    Test result = testFromJson(metadata(testIndex));
+    result.setId(testId(testIndex));
+
+    if (withData) {
+        result.setData(dataPoints(testIndex));
+    }
+
+    return result;
+}
+
+bool BinaryCurveReader::validateEntry(const IndexEntry& entry) const {
+    const quint64 size = quint64(m_size);
+
+    // Offsets come from the file: compare against what is left so the sum cannot wrap
+    if (entry.metadataOffset > size || entry.metadataSize > size - entry.metadataOffset) {
+        return false;
+    }
+
+    // Guard the multiplication against absurd point counts
+    if (entry.pointCount > size / sizeof(quint64)) {
+        return false;
+    }
+
+    const quint64 arrayBytes = entry.pointCount * sizeof(quint64);
+    for (int c = 0; c < CHANNEL_COUNT; ++c) {
+        quint64 offset = entry.channelOffsets[c];
+        if (offset % ALIGNMENT != 0 || offset > size || arrayBytes > size - offset) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+quint64 BinaryCurveReader::rawValue(int testIndex, int channel, qint64 sample) const {
+    const uchar* src = m_map + m_index[testIndex].channelOffsets[channel] + sample * sizeof(quint64);
+    return qFromLittleEndian<quint64>(src);
+}
+
+} // namespace HorizonUTM
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <QFile>
+#include <QJsonObject>
+#include <QString>
+#include <QVector>
+#include "BinaryCurveFormat.h"
+#include "domain/entities/Test.h"
+#include "domain/value_objects/SensorData.h"
+
+namespace HorizonUTM {
+
+/**
+ * @brief Reader for Horizon binary curve files (*.hzb)
+ * 
+ * Memory-maps the file and exposes each channel as a pointer into the
+ * mapping, so downstream tools can process curves without copying or
+ * parsing. Pointers stay valid until close() or destruction.
+ * 
+ * Usage:
+ * @code
+ *   BinaryCurveReader reader;
+ *   if (reader.open("tests.hzb")) {
+ *       const double* stress = reader.channel(0, BinaryCurveFormat::Channel::Stress);
+ *       qint64 n = reader.pointCount(0);
+ *   }
+ * @endcode
+ */
+class BinaryCurveReader {
+public:
+    BinaryCurveReader();
+    ~BinaryCurveReader();
+    
+    BinaryCurveReader(const BinaryCurveReader&) = delete;
+    BinaryCurveReader& operator=(const BinaryCurveReader&) = delete;
+    
+    /**
+     * @brief Map file and validate header and index
+     * @param filePath Path to *.hzb file
+     * @return true if the file is a valid binary curve file
+     */
+    bool open(const QString& filePath);
+    
+    /**
+     * @brief Unmap file (invalidates all channel pointers)
+     */
+    void close();
+    
+    bool isOpen() const { return m_map != nullptr; }
+    QString lastError() const { return m_lastError; }
+    
+    /**
+     * @brief Number of tests in the file
+     */
+    int testCount() const { return m_index.size(); }
+    
+    /**
+     * @brief Test ID as stored in the index
+     */
+    int testId(int testIndex) const;
+    
+    /**
+     * @brief Number of samples of a test
+     */
+    qint64 pointCount(int testIndex) const;
+    
+    /**
+     * @brief Raw metadata (parameters, result, channel descriptors)
+     */
+    QJsonObject metadata(int testIndex) const;
+    
+    /**
+     * @brief Zero-copy access to a floating-point channel
+     * @return Pointer into the mapping, or nullptr for the timestamp
+     *         channel or when the host is not little-endian
+     */
+    const double* channel(int testIndex, BinaryCurveFormat::Channel channel) const;
+    
+    /**
+     * @brief Zero-copy access to timestamps (ms since epoch)
+     * @return Pointer into the mapping, or nullptr on big-endian hosts
+     */
+    const qint64* timestamps(int testIndex) const;
+    
+    /**
+     * @brief Copy a channel (works on any host byte order)
+     */
+    QVector<double> channelValues(int testIndex, BinaryCurveFormat::Channel channel) const;
+    
+    /**
+     * @brief Reassemble sensor data points (copies)
+     */
+    QVector<SensorData> dataPoints(int testIndex) const;
+    
+    /**
+     * @brief Materialize a Test entity
+     * @param testIndex Index in file
+     * @param withData Also load the curve
+     */
+    Test test(int testIndex, bool withData = true) const;
+
+private:
+    /**
+     * @brief Validate index entry bounds against the mapping
+     */
+    bool validateEntry(const BinaryCurveFormat::IndexEntry& entry) const;
+    
+    /**
+     * @brief Read a little-endian 64-bit value of a channel
+     */
+    quint64 rawValue(int testIndex, int channel, qint64 sample) const;
+    
+    bool isValidIndex(int testIndex) const { return testIndex >= 0 && testIndex < m_index.size(); }
+
+private:
+    QFile m_file;
+    uchar* m_map;
+    qint64 m_size;
+    QVector<BinaryCurveFormat::IndexEntry> m_index;
+    QString m_lastError;
+};
+
+} // namespace HorizonUTM
@@ -0,0 +1,185 @@
+#include "BinaryExportService.h"
+#include "BinaryCurveFormat.h"
+#include "core/Logger.h"
+#include <QFile>
+#include <QJsonDocument>
+#include <QtEndian>
+#include <cstring>
+
+namespace HorizonUTM {
+
+using namespace BinaryCurveFormat;
+
+namespace {
+
+// Channel arrays are converted and written in chunks of this many samples
+constexpr int WRITE_CHUNK_SAMPLES = 8192;
+
+quint64 channelBits(const SensorData& point, Channel channel) {
+    double value = 0.0;
+    switch (channel) {
+        case Channel::Timestamp:   return static_cast<quint64>(point.timestamp);
+        case Channel::Force:       value = point.force; break;
+        case Channel::Extension:   value = point.extension; break;
+        case Channel::Stress:      value = point.stress; break;
+        case Channel::Strain:      value = point.strain; break;
+        case Channel::Temperature: value = point.temperature; break;
+    }
+
+    quint64 bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+template <typename T>
+bool writeStruct(QIODevice& out, const T& value) {
+    return out.write(reinterpret_cast<const char*>(&value), sizeof(T)) == sizeof(T);
+}
+
+} // namespace
+
+bool BinaryExportService::exportTest(const Test& test, const QString& filePath) {
+    return exportTestsWithProgress({test}, filePath, ExportProgressCallback());
+}
+
+bool BinaryExportService::exportTests(const QVector<Test>& tests, const QString& filePath) {
+    return exportTestsWithProgress(tests, filePath, ExportProgressCallback());
+}
+
+bool BinaryExportService::exportTestsWithProgress(const QVector<Test>& tests,
+                                                  const QString& filePath,
+                                                  const ExportProgressCallback& progress) {
+    if (tests.isEmpty()) {
+        LOG_WARNING("No tests to export");
+        return false;
+    }
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        LOG_ERROR(QString("Failed to open file for writing: %1").arg(filePath));
+        return false;
+    }
+
+    // Header is rewritten with the index offset once all records are written
+    FileHeader header = {};
+    std::memcpy(header.magic, FILE_MAGIC, sizeof(header.magic));
+    header.version = qToLittleEndian<quint16>(VERSION);
+    header.testCount = qToLittleEndian<quint32>(static_cast<quint32>(tests.size()));
+
+    bool ok = writeStruct(file, header);
+    bool cancelled = false;
+
+    QVector<IndexEntry> index;
+    index.reserve(tests.size());
+
+    for (int i = 0; ok && i < tests.size(); ++i) {
+        const Test& test = tests[i];
+
+        IndexEntry entry = {};
+        entry.testId = qToLittleEndian<qint32>(test.getId());
+
+        // Metadata
+        QByteArray metadata = QJsonDocument(testToJson(test)).toJson(QJsonDocument::Compact);
+        entry.metadataOffset = qToLittleEndian<quint64>(static_cast<quint64>(file.pos()));
+        entry.metadataSize = qToLittleEndian<quint32>(static_cast<quint32>(metadata.size()));
+        ok = file.write(metadata) == metadata.size() && writePadding(file);
+
+        // Channel arrays
+        entry.pointCount = qToLittleEndian<quint64>(static_cast<quint64>(test.getDataPointCount()));
+        for (int channel = 0; ok && channel < CHANNEL_COUNT; ++channel) {
+            entry.channelOffsets[channel] = qToLittleEndian<quint64>(static_cast<quint64>(file.pos()));
+            ok = writeChannel(file, test, channel);
+        }
+
+        index.append(entry);
+
+        if (ok && progress && !progress(i + 1, tests.size())) {
+            cancelled = true;
+            ok = false;
+        }
+    }
+
+    // Index footer
+    if (ok) {
+        quint64 indexOffset = static_cast<quint64>(file.pos());
+
+        IndexHeader indexHeader = {};
+        std::memcpy(indexHeader.magic, INDEX_MAGIC, sizeof(indexHeader.magic));
+        indexHeader.testCount = qToLittleEndian<quint32>(static_cast<quint32>(index.size()));
+
+        ok = writeStruct(file, indexHeader) &&
+             file.write(reinterpret_cast<const char*>(index.constData()),
+                        index.size() * qint64(sizeof(IndexEntry))) == index.size() * qint64(sizeof(IndexEntry));
+
+        header.indexOffset = qToLittleEndian<quint64>(indexOffset);
+        ok = ok && file.seek(0) && writeStruct(file, header);
+    }
+
+    file.close();
+
+    if (!ok) {
+        // Don't leave a truncated file behind
+        file.remove();
+        if (cancelled) {
+            LOG_WARNING(QString("Binary export cancelled: %1").arg(filePath));
+        } else {
+            LOG_ERROR(QString("Failed to write binary file: %1").arg(filePath));
+        }
+        return false;
+    }
+
+    LOG_INFO(QString("%1 tests exported to binary: %2").arg(tests.size()).arg(filePath));
+    return true;
+}
+
+QStringList BinaryExportService::getSupportedExtensions() const {
+    return QStringList() << "hzb";
+}
+
+QString BinaryExportService::getFileTypeDescription() const {
+    return "Horizon Binary Curves (*.hzb)";
+}
+
+bool BinaryExportService::writePadding(QIODevice& out) const {
+    qint64 pos = out.pos();
+    qint64 padding = static_cast<qint64>(alignOffset(static_cast<quint64>(pos))) - pos;
+    if (padding == 0) {
+        return true;
+    }
+
+    static const char zeros[ALIGNMENT] = {};
+    return out.write(zeros, padding) == padding;
+}
+
+bool BinaryExportService::writeChannel(QIODevice& out, const Test& test, int channel) const {
+    const Curve& curve = test.getCurve();
+    const Channel ch = static_cast<Channel>(channel);
+
+    QVector<quint64> buffer(qMin(curve.size(), qsizetype(WRITE_CHUNK_SAMPLES)));
+    qsizetype count = 0;
+
+    auto flush = [&out, &buffer, &count]() {
+        qint64 bytes = count * qint64(sizeof(quint64));
+        count = 0;
+        return out.write(reinterpret_cast<const char*>(buffer.constData()), bytes) == bytes;
+    };
+
+    // Chunks fill across segment boundaries, the curve is never flattened
+    for (int s = 0; s < curve.segmentCount(); ++s) {
+        const Curve::Segment& segment = curve.segment(s);
+        for (qsizetype i = 0; i < segment.size; ++i) {
+            buffer[count++] = qToLittleEndian<quint64>(channelBits(segment.data[i], ch));
+            if (count == buffer.size() && !flush()) {
+                return false;
+            }
+        }
+    }
+    if (count > 0 && !flush()) {
+        return false;
+    }
+
+    // Every value is 8 bytes, so the next array stays aligned
+    return true;
+}
+
+} // namespace HorizonUTM
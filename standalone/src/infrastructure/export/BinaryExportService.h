@@ -0,0 +1,75 @@
+#pragma once
+
+#include "domain/interfaces/IExportService.h"
+#include "domain/entities/Test.h"
+#include <QString>
+#include <QIODevice>
+
+namespace HorizonUTM {
+
+/**
+ * @brief Binary export service implementation
+ * 
+ * Writes tests to the self-describing columnar Horizon binary curve
+ * format (see BinaryCurveFormat.h). Files can be read in place with
+ * BinaryCurveReader without any text parsing.
+ */
+class BinaryExportService : public IExportService {
+public:
+    BinaryExportService() = default;
+    ~BinaryExportService() override = default;
+    
+    /**
+     * @brief Export test to binary file
+     * @param test Test to export
+     * @param filePath Output file path
+     * @return true if successful
+     */
+    bool exportTest(const Test& test, const QString& filePath) override;
+    
+    /**
+     * @brief Export multiple tests to one binary file
+     * @param tests Tests to export
+     * @param filePath Output file path
+     * @return true if successful
+     */
+    bool exportTests(const QVector<Test>& tests, const QString& filePath) override;
+    
+    /**
+     * @brief Export multiple tests, reporting progress per test
+     * @param tests Tests to export
+     * @param filePath Output file path
+     * @param progress Progress callback; returning false cancels and removes the file
+     * @return true if successful
+     */
+    bool exportTestsWithProgress(const QVector<Test>& tests,
+                                 const QString& filePath,
+                                 const ExportProgressCallback& progress) override;
+    
+    /**
+     * @brief Get supported file extensions
+     * @return List of extensions (["hzb"])
+     */
+    QStringList getSupportedExtensions() const override;
+    
+    /**
+     * @brief Get file type description
+     */
+    QString getFileTypeDescription() const override;
+
+private:
+    /**
+     * @brief Write padding bytes up to the next aligned offset
+     */
+    bool writePadding(QIODevice& out) const;
+    
+    /**
+     * @brief Write one channel as a little-endian array
+     * @param out Output device (positioned at an aligned offset)
+     * @param test Test whose data is written
+     * @param channel Channel index (BinaryCurveFormat::Channel)
+     */
+    bool writeChannel(QIODevice& out, const Test& test, int channel) const;
+};
+
+} // namespace HorizonUTM
@@ -1,8 +1,9 @@
 #include "CSVExportService.h"
 #include "core/Logger.h"
 #include <QFile>
-#include <QTextStream>
 #include <QFileInfo>
+#include <QDir>
+#include <QRegularExpression>
 
 namespace HorizonUTM {
 
@@ -13,13 +14,11 @@ bool CSVExportService::exportTest(const Test& test, const QString& filePath) {
         return false;
     }
     
-    QTextStream out(&file);
-    
-    // Write header
-    out << createCsvHeader() << "\n";
-    
-    // Write test data
-    out << testToCsvRow(test) << "\n";
+    // Summary followed by the full curve
+    if (file.write(testToCsvDocument(test)) < 0) {
+        LOG_ERROR(QString("Failed to write CSV file: %1").arg(filePath));
+        return false;
+    }
     
     file.close();
     
@@ -28,6 +27,12 @@ bool CSVExportService::exportTest(const Test& test, const QString& filePath) {
 }
 
 bool CSVExportService::exportTests(const QVector<Test>& tests, const QString& filePath) {
+    return exportTestsWithProgress(tests, filePath, ExportProgressCallback());
+}
+
+bool CSVExportService::exportTestsWithProgress(const QVector<Test>& tests,
+                                               const QString& filePath,
+                                               const ExportProgressCallback& progress) {
     if (tests.isEmpty()) {
         LOG_WARNING("No tests to export");
         return false;
@@ -39,22 +44,74 @@ bool CSVExportService::exportTests(const QVector<Test>& tests, const QString& fi
         return false;
     }
     
-    QTextStream out(&file);
-    
     // Write header
-    out << createCsvHeader() << "\n";
+    file.write((createCsvHeader() + "\n").toUtf8());
     
-    // Write all tests
-    for (const Test& test : tests) {
-        out << testToCsvRow(test) << "\n";
-    }
+    // Rows are formatted in parallel and written in the original order
+    auto formatRow = [this, &tests](int index) {
+        return (testToCsvRow(tests[index]) + "\n").toUtf8();
+    };
+    
+    ParallelExportPipeline::Status status =
+        m_pipeline.writeOrdered(tests.size(), formatRow, file, progress);
     
     file.close();
     
+    if (status != ParallelExportPipeline::Status::Completed) {
+        // Don't leave a truncated file behind
+        file.remove();
+        if (status == ParallelExportPipeline::Status::Cancelled) {
+            LOG_WARNING(QString("CSV export cancelled: %1").arg(filePath));
+        } else {
+            LOG_ERROR(QString("Failed to write CSV file: %1").arg(filePath));
+        }
+        return false;
+    }
+    
     LOG_INFO(QString("%1 tests exported to CSV: %2").arg(tests.size()).arg(filePath));
     return true;
 }
 
+bool CSVExportService::exportTestsToDirectory(const QVector<Test>& tests,
+                                              const QString& dirPath,
+                                              const ExportProgressCallback& progress) {
+    if (tests.isEmpty()) {
+        LOG_WARNING("No tests to export");
+        return false;
+    }
+    
+    QDir dir(dirPath);
+    if (!dir.mkpath(".")) {
+        LOG_ERROR(QString("Failed to create export directory: %1").arg(dirPath));
+        return false;
+    }
+    
+    // One file per test: each worker formats and writes its own file
+    auto writeFile = [this, &tests, &dir](int index) {
+        const Test& test = tests[index];
+        QFile file(dir.filePath(testFileName(test)));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+            LOG_ERROR(QString("Failed to open file for writing: %1").arg(file.fileName()));
+            return false;
+        }
+        return file.write(testToCsvDocument(test)) >= 0;
+    };
+    
+    ParallelExportPipeline::Status status = m_pipeline.forEach(tests.size(), writeFile, progress);
+    
+    if (status != ParallelExportPipeline::Status::Completed) {
+        if (status == ParallelExportPipeline::Status::Cancelled) {
+            LOG_WARNING(QString("CSV bundle export cancelled: %1").arg(dirPath));
+        } else {
+            LOG_ERROR(QString("CSV bundle export failed: %1").arg(dirPath));
+        }
+        return false;
+    }
+    
+    LOG_INFO(QString("%1 tests exported to CSV bundle: %2").arg(tests.size()).arg(dirPath));
+    return true;
+}
+
 QStringList CSVExportService::getSupportedExtensions() const {
     return QStringList() << "csv";
 }
@@ -133,6 +190,71 @@ QString CSVExportService::testToCsvRow(const Test& test) const {
     return fields.join(",");
 }
 
+QString CSVExportService::createDataPointsHeader() const {
+    QStringList headers;
+    
+    headers << "Timestamp (ms)"
+            << "Time (s)"
+            << "Force (N)"
+            << "Extension (mm)"
+            << "Stress (MPa)"
+            << "Strain (%)"
+            << "Temperature (°C)";
+    
+    return headers.join(",");
+}
+
+QString CSVExportService::dataPointToCsvRow(const SensorData& point, qint64 startTimestamp) const {
+    QStringList fields;
+    
+    fields << QString::number(point.timestamp)
+           << QString::number((point.timestamp - startTimestamp) / 1000.0, 'f', 3)
+           << QString::number(point.force, 'f', 3)
+           << QString::number(point.extension, 'f', 4)
+           << QString::number(point.stress, 'f', 4)
+           << QString::number(point.strain, 'f', 4)
+           << QString::number(point.temperature, 'f', 1);
+    
+    return fields.join(",");
+}
+
+QByteArray CSVExportService::testToCsvDocument(const Test& test) const {
+    QString document;
+    
+    // Summary section
+    document += createCsvHeader() + "\n";
+    document += testToCsvRow(test) + "\n";
+    
+    // Curve section, separated by a blank line
+    const Curve& curve = test.getCurve();
+    if (!curve.isEmpty()) {
+        document += "\n";
+        document += createDataPointsHeader() + "\n";
+        
+        qint64 startTimestamp = curve.at(0).timestamp;
+        for (int s = 0; s < curve.segmentCount(); ++s) {
+            const Curve::Segment& segment = curve.segment(s);
+            for (qsizetype i = 0; i < segment.size; ++i) {
+                document += dataPointToCsvRow(segment.data[i], startTimestamp);
+                document += '\n';
+            }
+        }
+    }
+    
+    return document.toUtf8();
+}
+
+QString CSVExportService::testFileName(const Test& test) const {
+    // Keep only characters that are safe in file names on every platform
+    QString sample = test.getSampleName();
+    sample.replace(QRegularExpression("[^A-Za-z0-9_-]+"), "_");
+    
+    if (sample.isEmpty()) {
+        return QString("test_%1.csv").arg(test.getId());
+    }
+    return QString("test_%1_%2.csv").arg(test.getId()).arg(sample);
+}
+
 QString CSVExportService::escapeCsvField(const QString& field) const {
     // If field contains comma, quote, or newline, wrap in quotes and escape quotes
     if (field.contains(',') || field.contains('"') || field.contains('\n')) {
@@ -2,14 +2,17 @@
 
 #include "domain/interfaces/IExportService.h"
 #include "domain/entities/Test.h"
+#include "ParallelExportPipeline.h"
 #include <QString>
+#include <QByteArray>
 
 namespace HorizonUTM {
 
 /**
  * @brief CSV export service implementation
  * 
- * Exports test data and results to CSV format
+ * Exports test data and results to CSV format. Multi-test exports are
+ * formatted in parallel and written in the original order.
  */
 class CSVExportService : public IExportService {
 public:
@@ -17,7 +20,7 @@ public:
     ~CSVExportService() override = default;
     
     /**
-     * @brief Export test to CSV file
+     * @brief Export test summary and curve data to CSV file
      * @param test Test to export
      * @param filePath Output file path
      * @return true if successful
@@ -32,6 +35,28 @@ public:
      */
     bool exportTests(const QVector<Test>& tests, const QString& filePath) override;
     
+    /**
+     * @brief Export multiple tests to CSV, reporting progress per test
+     * @param tests Tests to export
+     * @param filePath Output file path
+     * @param progress Progress callback; returning false cancels and removes the file
+     * @return true if successful
+     */
+    bool exportTestsWithProgress(const QVector<Test>& tests,
+                                 const QString& filePath,
+                                 const ExportProgressCallback& progress) override;
+    
+    /**
+     * @brief Export each test (summary and curve) to its own CSV file
+     * @param tests Tests to export
+     * @param dirPath Output directory
+     * @param progress Progress callback; returning false cancels
+     * @return true if successful
+     */
+    bool exportTestsToDirectory(const QVector<Test>& tests,
+                                const QString& dirPath,
+                                const ExportProgressCallback& progress) override;
+    
     /**
      * @brief Get supported file extensions
      * @return List of extensions (e.g., ["csv"])
@@ -54,10 +79,33 @@ private:
      */
     QString testToCsvRow(const Test& test) const;
     
+    /**
+     * @brief Write data points header
+     */
+    QString createDataPointsHeader() const;
+    
+    /**
+     * @brief Convert data point to CSV row
+     */
+    QString dataPointToCsvRow(const SensorData& point, qint64 startTimestamp) const;
+    
+    /**
+     * @brief Format summary and curve sections of a single test
+     */
+    QByteArray testToCsvDocument(const Test& test) const;
+    
+    /**
+     * @brief File name for a test inside a bundle directory
+     */
+    QString testFileName(const Test& test) const;
+    
     /**
      * @brief Escape CSV field
      */
     QString escapeCsvField(const QString& field) const;
+
+private:
+    ParallelExportPipeline m_pipeline;
 };
 
 } // namespace HorizonUTM
@@ -0,0 +1,171 @@
+#include "ParallelExportPipeline.h"
+#include <QRunnable>
+#include <QThread>
+#include <atomic>
+#include <deque>
+#include <future>
+#include <memory>
+
+namespace HorizonUTM {
+
+namespace {
+
+// Keep shards large enough to amortize scheduling, small enough to balance load
+constexpr int MIN_SHARD_SIZE = 1;
+constexpr int MAX_SHARD_SIZE = 256;
+constexpr int SHARDS_PER_THREAD = 8;
+
+} // namespace
+
+ParallelExportPipeline::ParallelExportPipeline(int threadCount) {
+    setThreadCount(threadCount);
+}
+
+ParallelExportPipeline::~ParallelExportPipeline() {
+    m_pool.waitForDone();
+}
+
+int ParallelExportPipeline::threadCount() const {
+    return m_pool.maxThreadCount();
+}
+
+void ParallelExportPipeline::setThreadCount(int threadCount) {
+    if (threadCount <= 0) {
+        threadCount = QThread::idealThreadCount();
+    }
+    m_pool.setMaxThreadCount(qMax(1, threadCount));
+}
+
+int ParallelExportPipeline::shardSizeFor(int count) const {
+    int shards = threadCount() * SHARDS_PER_THREAD;
+    int size = (count + shards - 1) / shards;
+    return qBound(MIN_SHARD_SIZE, size, MAX_SHARD_SIZE);
+}
+
+int ParallelExportPipeline::maxShardsInFlight() const {
+    return qMax(2, threadCount() * 2);
+}
+
+ParallelExportPipeline::Status ParallelExportPipeline::writeOrdered(int count,
+                                                                   const FormatFunction& format,
+                                                                   QIODevice& out,
+                                                                   const ExportProgressCallback& progress) {
+    if (count <= 0) {
+        return Status::Completed;
+    }
+
+    const int shardSize = shardSizeFor(count);
+    const int shardCount = (count + shardSize - 1) / shardSize;
+
+    // Workers stop formatting early once the writer gives up
+    auto abort = std::make_shared<std::atomic<bool>>(false);
+    std::deque<std::future<QByteArray>> inFlight;
+
+    auto submit = [&](int shard) {
+        auto promise = std::make_shared<std::promise<QByteArray>>();
+        inFlight.push_back(promise->get_future());
+
+        const int begin = shard * shardSize;
+        const int end = qMin(count, begin + shardSize);
+
+        // format outlives the task: every future is drained before returning
+        m_pool.start(QRunnable::create([promise, begin, end, &format, abort]() {
+            QByteArray buffer;
+            for (int i = begin; i < end; ++i) {
+                if (abort->load(std::memory_order_relaxed)) {
+                    break;
+                }
+                buffer.append(format(i));
+            }
+            promise->set_value(std::move(buffer));
+        }));
+    };
+
+    int nextShard = 0;
+    while (nextShard < shardCount && static_cast<int>(inFlight.size()) < maxShardsInFlight()) {
+        submit(nextShard++);
+    }
+
+    Status status = Status::Completed;
+    int writtenShards = 0;
+
+    while (!inFlight.empty()) {
+        QByteArray chunk = inFlight.front().get();
+        inFlight.pop_front();
+
+        if (status == Status::Completed) {
+            if (out.write(chunk) != chunk.size()) {
+                status = Status::Failed;
+            } else {
+                ++writtenShards;
+                int written = qMin(count, writtenShards * shardSize);
+                if (progress && !progress(written, count)) {
+                    status = Status::Cancelled;
+                }
+            }
+
+            if (status != Status::Completed) {
+                abort->store(true, std::memory_order_relaxed);
+            } else if (nextShard < shardCount) {
+                submit(nextShard++);
+            }
+        }
+    }
+
+    return status;
+}
+
+ParallelExportPipeline::Status ParallelExportPipeline::forEach(int count,
+                                                              const TaskFunction& task,
+                                                              const ExportProgressCallback& progress) {
+    if (count <= 0) {
+        return Status::Completed;
+    }
+
+    auto abort = std::make_shared<std::atomic<bool>>(false);
+    std::deque<std::future<bool>> inFlight;
+
+    auto submit = [&](int index) {
+        auto promise = std::make_shared<std::promise<bool>>();
+        inFlight.push_back(promise->get_future());
+
+        m_pool.start(QRunnable::create([promise, index, &task, abort]() {
+            bool ok = !abort->load(std::memory_order_relaxed) && task(index);
+            promise->set_value(ok);
+        }));
+    };
+
+    // Tasks are independent, so allow a deeper queue than writeOrdered
+    const int maxInFlight = maxShardsInFlight() * 4;
+
+    int next = 0;
+    while (next < count && static_cast<int>(inFlight.size()) < maxInFlight) {
+        submit(next++);
+    }
+
+    Status status = Status::Completed;
+    int completed = 0;
+
+    while (!inFlight.empty()) {
+        bool ok = inFlight.front().get();
+        inFlight.pop_front();
+
+        if (status == Status::Completed) {
+            if (!ok) {
+                status = Status::Failed;
+            } else if (progress && !progress(++completed, count)) {
+                status = Status::Cancelled;
+            }
+
+            if (status != Status::Completed) {
+                abort->store(true, std::memory_order_relaxed);
+            } else if (next < count) {
+                submit(next++);
+            }
+        }
+    }
+
+    return status;
+}
+
+} // namespace HorizonUTM
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <QByteArray>
+#include <QIODevice>
+#include <QThreadPool>
+#include <functional>
+#include "domain/interfaces/IExportService.h"
+
+namespace HorizonUTM {
+
+/**
+ * @brief Shards independent per-test export work across cores
+ *
+ * Items are formatted on a worker pool into per-shard buffers and handed
+ * back to the calling thread strictly in item order, so the output is
+ * byte-identical to a sequential export. The number of shards in flight is
+ * bounded, which keeps memory flat and lets the writer become the
+ * bottleneck once the disk is saturated.
+ *
+ * Callbacks run concurrently on worker threads and must only read shared
+ * data. One pipeline may be used by several exports at the same time.
+ */
+class ParallelExportPipeline {
+public:
+    /**
+     * @brief Outcome of a pipeline run
+     */
+    enum class Status {
+        Completed,  ///< All items processed
+        Cancelled,  ///< Progress callback requested cancellation
+        Failed      ///< Write error or task failure
+    };
+
+    /**
+     * @brief Format one item into bytes (worker thread)
+     */
+    using FormatFunction = std::function<QByteArray(int index)>;
+
+    /**
+     * @brief Process one item independently (worker thread)
+     * @return false on failure
+     */
+    using TaskFunction = std::function<bool(int index)>;
+
+    /**
+     * @brief Constructor
+     * @param threadCount Worker threads, 0 = one per core
+     */
+    explicit ParallelExportPipeline(int threadCount = 0);
+    ~ParallelExportPipeline();
+
+    /**
+     * @brief Format items [0, count) in parallel and write them in order
+     * @param count Number of items
+     * @param format Formatter for a single item
+     * @param out Open output device (written on the calling thread only)
+     * @param progress Called on the calling thread as items are written
+     */
+    Status writeOrdered(int count,
+                        const FormatFunction& format,
+                        QIODevice& out,
+                        const ExportProgressCallback& progress = ExportProgressCallback());
+
+    /**
+     * @brief Run independent tasks for items [0, count) in parallel
+     * @param count Number of items
+     * @param task Task for a single item (e.g. writing one file)
+     * @param progress Called on the calling thread in item order
+     */
+    Status forEach(int count,
+                   const TaskFunction& task,
+                   const ExportProgressCallback& progress = ExportProgressCallback());
+
+    /**
+     * @brief Worker thread count
+     */
+    int threadCount() const;
+    void setThreadCount(int threadCount);
+
+private:
+    /**
+     * @brief Items per shard so each worker gets several shards
+     */
+    int shardSizeFor(int count) const;
+
+    /**
+     * @brief Maximum number of shards queued or being formatted
+     */
+    int maxShardsInFlight() const;
+
+private:
+    QThreadPool m_pool;
+};
+
+} // namespace HorizonUTM
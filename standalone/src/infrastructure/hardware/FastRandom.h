@@ -0,0 +1,68 @@
+#pragma once
+
+#include <QtGlobal>
+#include <QRandomGenerator>
+
+namespace HorizonUTM {
+
+/**
+ * @brief Small, fast pseudo-random generator for simulation noise
+ *
+ * xoshiro256** seeded through splitmix64. Not thread-safe and not
+ * cryptographic: give every thread (or driver) its own instance, or use
+ * threadLocal(). The same seed always produces the same sequence.
+ */
+class FastRandom {
+public:
+    explicit FastRandom(quint64 seed = 0x9E3779B97F4A7C15ull) { setSeed(seed); }
+
+    void setSeed(quint64 seed) {
+        for (quint64& word : m_state) {
+            // splitmix64
+            seed += 0x9E3779B97F4A7C15ull;
+            quint64 z = seed;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            word = z ^ (z >> 31);
+        }
+    }
+
+    quint64 next() {
+        const quint64 result = rotl(m_state[1] * 5, 7) * 9;
+        const quint64 t = m_state[1] << 17;
+
+        m_state[2] ^= m_state[0];
+        m_state[3] ^= m_state[1];
+        m_state[1] ^= m_state[2];
+        m_state[0] ^= m_state[3];
+        m_state[2] ^= t;
+        m_state[3] = rotl(m_state[3], 45);
+
+        return result;
+    }
+
+    /**
+     * @brief Uniform double in [0, 1)
+     */
+    double nextDouble() { return static_cast<double>(next() >> 11) * 0x1.0p-53; }
+
+    /**
+     * @brief Uniform double in [-1, 1)
+     */
+    double nextSigned() { return 2.0 * nextDouble() - 1.0; }
+
+    /**
+     * @brief Generator of the calling thread, seeded from the system generator
+     */
+    static FastRandom& threadLocal() {
+        thread_local FastRandom random(QRandomGenerator::global()->generate64());
+        return random;
+    }
+
+private:
+    static quint64 rotl(quint64 x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    quint64 m_state[4];
+};
+
+} // namespace HorizonUTM
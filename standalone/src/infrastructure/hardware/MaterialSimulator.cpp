@@ -0,0 +1,302 @@
+#include "MaterialSimulator.h"
+#include <QtMath>
+
+namespace HorizonUTM {
+
+namespace {
+
+// Intervals of the tabulated Ramberg–Osgood curve
+constexpr int RAMBERG_OSGOOD_TABLE_SIZE = 4096;
+
+// Ramberg–Osgood offset: plastic strain at the yield stress (0.2%)
+constexpr double RAMBERG_OSGOOD_OFFSET = 0.002;
+
+} // namespace
+
+MaterialParameters MaterialParameters::ductile() {
+    MaterialParameters p;
+    p.name = "ductile";
+    p.elasticModulus = 3.0;     // 3 GPa (typical for plastics)
+    p.yieldStress = 50.0;
+    p.ultimateStress = 60.0;
+    p.elasticLimit = 0.5;
+    p.yieldEnd = 1.5;
+    p.plasticEnd = 5.0;
+    p.breakStrain = 8.0;
+    p.noise = 0.01;
+    return p;
+}
+
+MaterialParameters MaterialParameters::brittle() {
+    // Hookean up to break, no yield, hardening or necking
+    MaterialParameters p;
+    p.name = "brittle";
+    p.model = MaterialModel::LinearElastic;
+    p.elasticModulus = 3.3;
+    p.yieldStress = 59.4;
+    p.ultimateStress = 59.4;
+    p.elasticLimit = 1.8;
+    p.yieldEnd = 1.8;
+    p.plasticEnd = 1.8;
+    p.breakStrain = 1.8;
+    p.noise = 0.01;
+    return p;
+}
+
+MaterialParameters MaterialParameters::elastomer() {
+    // Mooney–Rivlin, about 19 MPa at 500% elongation
+    MaterialParameters p;
+    p.name = "elastomer";
+    p.model = MaterialModel::Hyperelastic;
+    p.elasticModulus = 0.01;    // 10 MPa
+    p.yieldStress = 8.0;
+    p.ultimateStress = 20.0;
+    p.elasticLimit = 50.0;
+    p.yieldEnd = 100.0;
+    p.plasticEnd = 400.0;
+    p.breakStrain = 500.0;
+    p.noise = 0.01;
+    p.mooneyRivlinRatio = 0.05;
+    return p;
+}
+
+MaterialParameters MaterialParameters::metal() {
+    // S355-like steel: about 500 MPa at 15% uniform elongation
+    MaterialParameters p;
+    p.name = "metal";
+    p.model = MaterialModel::RambergOsgood;
+    p.elasticModulus = 200.0;
+    p.yieldStress = 355.0;
+    p.ultimateStress = 510.0;
+    p.elasticLimit = 0.15;
+    p.yieldEnd = 0.4;
+    p.plasticEnd = 15.0;
+    p.breakStrain = 22.0;
+    p.noise = 0.005;
+    p.hardeningExponent = 12.0;
+    return p;
+}
+
+MaterialParameters MaterialParameters::byName(const QString& name, bool* ok) {
+    if (ok) {
+        *ok = true;
+    }
+
+    QString key = name.toLower();
+    if (key == "brittle") return brittle();
+    if (key == "elastomer") return elastomer();
+    if (key == "ductile") return ductile();
+    if (key == "metal") return metal();
+
+    if (ok) {
+        *ok = false;
+    }
+    return ductile();
+}
+
+MaterialSimulator::MaterialSimulator(const MaterialParameters& parameters)
+    : m_parameters(parameters)
+{
+    buildRambergOsgoodTable();
+}
+
+void MaterialSimulator::setParameters(const MaterialParameters& parameters) {
+    m_parameters = parameters;
+    buildRambergOsgoodTable();
+}
+
+// Models are defined before their batch loops so they inline there
+
+inline double MaterialSimulator::piecewiseStress(double strain) const {
+    // Phases: elastic → yield → plastic deformation → necking → break
+    const MaterialParameters& p = m_parameters;
+
+    if (strain <= 0) return 0.0;
+
+    // Phase 1: Linear elastic region
+    double elasticStress = (p.elasticModulus * 1000.0) * (p.elasticLimit / 100.0); // GPa to MPa
+    if (strain <= p.elasticLimit) {
+        return (p.elasticModulus * 1000.0) * (strain / 100.0);
+    }
+
+    // Phase 2: Transition from elastic to plastic
+    if (strain <= p.yieldEnd) {
+        double t = (strain - p.elasticLimit) / (p.yieldEnd - p.elasticLimit);
+        return elasticStress + (p.yieldStress - elasticStress) * t;
+    }
+
+    // Phase 3: Gradual increase to ultimate stress
+    if (strain <= p.plasticEnd) {
+        double t = (strain - p.yieldEnd) / (p.plasticEnd - p.yieldEnd);
+        return p.yieldStress + (p.ultimateStress - p.yieldStress) * t;
+    }
+
+    // Phase 4: Necking, stress decreases by 20% before break
+    double t = (strain - p.plasticEnd) / (p.breakStrain - p.plasticEnd);
+    return p.ultimateStress * (1.0 - 0.2 * t);
+}
+
+inline double MaterialSimulator::rambergOsgoodStress(double strain) const {
+    if (strain <= 0 || m_table.isEmpty()) return 0.0;
+
+    // Uniform elongation: interpolate the solved curve
+    const MaterialParameters& p = m_parameters;
+    if (strain < p.plasticEnd) {
+        double position = strain / m_tableStep;
+        int index = qMin(static_cast<int>(position), RAMBERG_OSGOOD_TABLE_SIZE - 1);
+        double t = position - index;
+        return m_table[index] + (m_table[index + 1] - m_table[index]) * t;
+    }
+
+    // Necking, stress decreases by 20% before break
+    double t = (strain - p.plasticEnd) / (p.breakStrain - p.plasticEnd);
+    return m_table.last() * (1.0 - 0.2 * t);
+}
+
+inline double MaterialSimulator::hyperelasticStress(double strain) const {
+    if (strain <= 0) return 0.0;
+
+    // Engineering stress 2 (C1 + C2/λ)(λ - 1/λ²), initial modulus 6 (C1 + C2) = E
+    const MaterialParameters& p = m_parameters;
+    const double c1 = (p.elasticModulus * 1000.0) / (6.0 * (1.0 + p.mooneyRivlinRatio));
+    const double c2 = p.mooneyRivlinRatio * c1;
+    const double stretch = 1.0 + strain / 100.0;
+    return 2.0 * (c1 + c2 / stretch) * (stretch - 1.0 / (stretch * stretch));
+}
+
+double MaterialSimulator::stressAt(double strain, FastRandom& random) const {
+    double stress = idealStressAt(strain);
+    if (m_parameters.noise > 0) {
+        // Uniform noise in [-noise, +noise)
+        stress *= 1.0 + m_parameters.noise * random.nextSigned();
+    }
+    return stress;
+}
+
+void MaterialSimulator::stressBatch(const double* strains, double* stresses, qsizetype count,
+                                    FastRandom& random) const {
+    // One tight loop per model, then one noise pass
+    switch (m_parameters.model) {
+    case MaterialModel::Piecewise:
+        for (qsizetype i = 0; i < count; ++i) {
+            stresses[i] = piecewiseStress(strains[i]);
+        }
+        break;
+    case MaterialModel::LinearElastic: {
+        const double modulus = m_parameters.elasticModulus * 1000.0;
+        for (qsizetype i = 0; i < count; ++i) {
+            stresses[i] = modulus * (qMax(0.0, strains[i]) / 100.0);
+        }
+        break;
+    }
+    case MaterialModel::RambergOsgood:
+        for (qsizetype i = 0; i < count; ++i) {
+            stresses[i] = rambergOsgoodStress(strains[i]);
+        }
+        break;
+    case MaterialModel::Hyperelastic:
+        for (qsizetype i = 0; i < count; ++i) {
+            stresses[i] = hyperelasticStress(strains[i]);
+        }
+        break;
+    }
+
+    const double noise = m_parameters.noise;
+    if (noise > 0) {
+        for (qsizetype i = 0; i < count; ++i) {
+            stresses[i] *= 1.0 + noise * random.nextSigned();
+        }
+    }
+}
+
+double MaterialSimulator::idealStressAt(double strain) const {
+    switch (m_parameters.model) {
+    case MaterialModel::LinearElastic:
+        return (m_parameters.elasticModulus * 1000.0) * (qMax(0.0, strain) / 100.0);
+    case MaterialModel::RambergOsgood:
+        return rambergOsgoodStress(strain);
+    case MaterialModel::Hyperelastic:
+        return hyperelasticStress(strain);
+    case MaterialModel::Piecewise:
+        break;
+    }
+    return piecewiseStress(strain);
+}
+
+int MaterialSimulator::sampleBatch(const ConstantSpeedRun& run, qint64 firstIndex, int count,
+                                   QVector<SensorData>& samples, FastRandom& random) {
+    // Strains on the sampling grid up to the break, then all stresses at once
+    m_strainBuffer.resize(count);
+    m_stressBuffer.resize(count);
+
+    int valid = 0;
+    while (valid < count) {
+        double time = static_cast<double>(firstIndex + valid) / run.samplingRateHz; // seconds
+        double extension = (run.speedMmPerMin / 60.0) * time;                        // mm
+        double strain = (extension / run.gaugeLength) * 100.0;                       // %
+        if (strain >= m_parameters.breakStrain) {
+            break;
+        }
+        m_strainBuffer[valid++] = strain;
+    }
+
+    stressBatch(m_strainBuffer.constData(), m_stressBuffer.data(), valid, random);
+
+    samples.resize(valid);
+    for (int i = 0; i < valid; ++i) {
+        double time = static_cast<double>(firstIndex + i) / run.samplingRateHz;
+        SensorData& sample = samples[i];
+        sample.timestamp = run.startMs + static_cast<qint64>(time * 1000.0);
+        sample.extension = (run.speedMmPerMin / 60.0) * time;
+        sample.strain = m_strainBuffer[i];
+        sample.stress = m_stressBuffer[i];
+        sample.force = sample.stress * run.crossSection;
+        sample.temperature = 23.0; // Constant room temperature
+    }
+    return valid;
+}
+
+double MaterialSimulator::solveRambergOsgood(double strain) const {
+    const MaterialParameters& p = m_parameters;
+    const double modulus = p.elasticModulus * 1000.0;    // MPa
+    const double epsilon = strain / 100.0;
+    const double n = p.hardeningExponent;
+    if (epsilon <= 0) {
+        return 0.0;
+    }
+
+    // Both terms alone bound the stress from above; Newton on the convex,
+    // increasing residual then converges monotonically from there
+    double stress = qMin(modulus * epsilon,
+                         p.yieldStress * qPow(epsilon / RAMBERG_OSGOOD_OFFSET, 1.0 / n));
+    for (int iteration = 0; iteration < 50; ++iteration) {
+        double ratio = qPow(stress / p.yieldStress, n - 1.0);
+        double residual = stress / modulus + RAMBERG_OSGOOD_OFFSET * ratio * (stress / p.yieldStress) - epsilon;
+        double slope = 1.0 / modulus + RAMBERG_OSGOOD_OFFSET * n * ratio / p.yieldStress;
+        double step = residual / slope;
+        stress -= step;
+        if (qAbs(step) <= 1e-12 * stress) {
+            break;
+        }
+    }
+    return stress;
+}
+
+void MaterialSimulator::buildRambergOsgoodTable() {
+    m_table.clear();
+    m_tableStep = 0.0;
+    if (m_parameters.model != MaterialModel::RambergOsgood || m_parameters.plasticEnd <= 0 ||
+        m_parameters.yieldStress <= 0 || m_parameters.elasticModulus <= 0) {
+        return;
+    }
+
+    // Solving per sample would cost a few pow() calls each; interpolating a
+    // fine table is exact to well below the noise
+    m_tableStep = m_parameters.plasticEnd / RAMBERG_OSGOOD_TABLE_SIZE;
+    m_table.resize(RAMBERG_OSGOOD_TABLE_SIZE + 1);
+    for (int i = 0; i <= RAMBERG_OSGOOD_TABLE_SIZE; ++i) {
+        m_table[i] = solveRambergOsgood(i * m_tableStep);
+    }
+}
+
+} // namespace HorizonUTM
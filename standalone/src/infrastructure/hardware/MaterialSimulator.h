@@ -0,0 +1,162 @@
+#pragma once
+
+#include <QString>
+#include <QVector>
+#include "FastRandom.h"
+#include "domain/value_objects/SensorData.h"
+
+namespace HorizonUTM {
+
+/**
+ * @brief Constitutive model of a simulated material
+ */
+enum class MaterialModel {
+    Piecewise,      ///< Elastic, yield transition, hardening, necking (polymers)
+    LinearElastic,  ///< Hookean up to a sudden break (brittle)
+    RambergOsgood,  ///< Ramberg–Osgood hardening, then necking (metals)
+    Hyperelastic    ///< Mooney–Rivlin rubber elasticity (elastomers)
+};
+
+/**
+ * @brief Parameters of a simulated tensile curve
+ *
+ * Which fields apply depends on the model; strains are in %:
+ *  - Piecewise: linear elastic up to elasticLimit, transition to
+ *    yieldStress at yieldEnd, hardening to ultimateStress at plasticEnd and
+ *    necking (20% stress drop) up to breakStrain.
+ *  - LinearElastic: elasticModulus up to breakStrain.
+ *  - RambergOsgood: strain = stress/E + 0.2% (stress/yieldStress)^n with
+ *    n = hardeningExponent up to plasticEnd, then necking (20% stress
+ *    drop) up to breakStrain.
+ *  - Hyperelastic: uniaxial Mooney–Rivlin with C2/C1 = mooneyRivlinRatio
+ *    and an initial modulus of elasticModulus, up to breakStrain.
+ */
+struct MaterialParameters {
+    QString name;
+    MaterialModel model = MaterialModel::Piecewise;
+    double elasticModulus;  ///< GPa
+    double yieldStress;     ///< MPa
+    double ultimateStress;  ///< MPa
+    double elasticLimit;    ///< % strain
+    double yieldEnd;        ///< % strain
+    double plasticEnd;      ///< % strain
+    double breakStrain;     ///< % strain
+    double noise;           ///< Relative noise amplitude (0.01 = ±1%)
+    double hardeningExponent = 10.0;  ///< Ramberg–Osgood n
+    double mooneyRivlinRatio = 0.0;   ///< Mooney–Rivlin C2/C1, 0 = neo-Hookean
+
+    /**
+     * @brief Ductile thermoplastic (the MockUTMDriver default)
+     */
+    static MaterialParameters ductile();
+
+    /**
+     * @brief Brittle polymer, linear elastic up to break
+     */
+    static MaterialParameters brittle();
+
+    /**
+     * @brief Soft elastomer with very large elongation
+     */
+    static MaterialParameters elastomer();
+
+    /**
+     * @brief Structural steel with Ramberg–Osgood hardening
+     */
+    static MaterialParameters metal();
+
+    /**
+     * @brief Preset by name ("ductile", "brittle", "elastomer", "metal")
+     * @param ok Set to false if the name is unknown (ductile is returned)
+     */
+    static MaterialParameters byName(const QString& name, bool* ok = nullptr);
+};
+
+/**
+ * @brief Constant-speed tensile run sampled on a fixed grid
+ */
+struct ConstantSpeedRun {
+    double speedMmPerMin = 50.0;
+    double gaugeLength = 50.0;      ///< mm
+    double crossSection = 40.0;     ///< mm²
+    int samplingRateHz = 1000;
+    qint64 startMs = 0;             ///< Timestamp of sample time zero
+};
+
+/**
+ * @brief Generates stress for a given strain on a simulated material
+ *
+ * Shared by MockUTMDriver and the benchmarks so synthetic curves match what
+ * the simulated machine produces. Pass a seeded generator for reproducible
+ * curves. stressBatch() produces the same values as repeated stressAt()
+ * calls with the same generator, at a fraction of the cost; the driver goes
+ * through sampleBatch(), which builds the strains of a run and calls it.
+ */
+class MaterialSimulator {
+public:
+    explicit MaterialSimulator(const MaterialParameters& parameters = MaterialParameters::ductile());
+
+    const MaterialParameters& parameters() const { return m_parameters; }
+    void setParameters(const MaterialParameters& parameters);
+
+    /**
+     * @brief Stress at the given strain, with noise
+     * @param strain Strain in %
+     * @param random Noise source
+     * @return Stress in MPa
+     */
+    double stressAt(double strain, FastRandom& random) const;
+
+    /**
+     * @brief Stress for a batch of strains, with noise
+     * @param strains count strains in %
+     * @param stresses Receives count stresses in MPa
+     * @param count Batch size
+     * @param random Noise source
+     */
+    void stressBatch(const double* strains, double* stresses, qsizetype count, FastRandom& random) const;
+
+    /**
+     * @brief Stress at the given strain, without noise
+     */
+    double idealStressAt(double strain) const;
+
+    /**
+     * @brief Consecutive samples of a constant-speed run, up to the break
+     * @param run Speed, specimen and sampling grid
+     * @param firstIndex 1-based index of the first sample, sample time is index / rate
+     * @param count Number of samples
+     * @param samples Receives the generated samples
+     * @param random Noise source
+     * @return Samples generated, fewer than count once breakStrain is reached
+     */
+    int sampleBatch(const ConstantSpeedRun& run, qint64 firstIndex, int count,
+                    QVector<SensorData>& samples, FastRandom& random);
+
+private:
+    double piecewiseStress(double strain) const;
+    double rambergOsgoodStress(double strain) const;
+    double hyperelasticStress(double strain) const;
+
+    /**
+     * @brief Solve the Ramberg–Osgood relation for stress (Newton)
+     */
+    double solveRambergOsgood(double strain) const;
+
+    /**
+     * @brief Tabulate the Ramberg–Osgood curve on a uniform strain grid
+     */
+    void buildRambergOsgoodTable();
+
+    MaterialParameters m_parameters;
+
+    // Ramberg–Osgood stress at i * m_tableStep % strain, up to plasticEnd
+    QVector<double> m_table;
+    double m_tableStep = 0.0;
+
+    // sampleBatch() scratch
+    QVector<double> m_strainBuffer;
+    QVector<double> m_stressBuffer;
+};
+
+} // namespace HorizonUTM
@@ -1,13 +1,19 @@
 #include "MockUTMDriver.h"
 #include "core/Logger.h"
+#include "core/Constants.h"
 #include <QtMath>
 #include <QRandomGenerator>
-#include <QThread>
-#include <QDebug>
 #include <QTimer>
 
 namespace HorizonUTM {
 
+namespace {
+constexpr int DEFAULT_BATCH_SIZE = 1000;
+
+// Samples generated per sampleBatch() call
+constexpr int MAX_BATCH_SIZE = 4096;
+}
+
 MockUTMDriver::MockUTMDriver(QObject* parent)
     : IUTMDriver(parent)
     , m_connected(false)
@@ -18,18 +24,25 @@ MockUTMDriver::MockUTMDriver(QObject* parent)
     , m_gaugeLength(50.0)       // 50 mm
     , m_timer(new QTimer(this))
     , m_testStartTime(0)
+    , m_pauseStartTime(0)
+    , m_clock(std::make_shared<SimulationClock>())
+    , m_mode(SimulationMode::RealTime)
+    , m_speedFactor(1.0)
+    , m_batchSize(DEFAULT_BATCH_SIZE)
+    , m_anchorWallMs(0)
+    , m_anchorSimulatedMs(0.0)
     , m_currentTime(0.0)
     , m_currentExtension(0.0)
     , m_currentStrain(0.0)
     , m_currentStress(0.0)
     , m_currentForce(0.0)
-    , m_elasticModulus(3.0)     // 3 GPa (typical for plastics)
-    , m_yieldStress(50.0)       // 50 MPa
-    , m_ultimateStress(60.0)    // 60 MPa
-    , m_breakStrain(8.0)        // 8% elongation at break
-    , m_samplingRateHz(100)     // 100 Hz
+    , m_material(MaterialParameters::ductile())
+    , m_random(QRandomGenerator::global()->generate64())
+    , m_samplingRateHz(Constants::DEFAULT_SAMPLING_RATE_HZ)
     , m_dataPointCount(0)
+    , m_stopSettleMs(50)
 {
+    m_timer->setTimerType(Qt::PreciseTimer);
     QObject::connect(m_timer, &QTimer::timeout, this, &MockUTMDriver::generateDataPoint);
 
     LOG_INFO("MockUTMDriver created");
@@ -53,14 +66,9 @@ bool MockUTMDriver::connect(const QString& connectionString) {
     m_connected = true;
     m_state = MachineState::Idle;
 
-    qDebug() << "=== MockUTMDriver: About to emit signals ===";
-    qDebug() << "=== this pointer:" << this;
-
     emit connected();
     emit stateChanged(m_state);
 
-    qDebug() << "=== MockUTMDriver: Signals emitted ===";
-
     LOG_INFO("MockUTMDriver connected successfully");
     return true;
 }
@@ -111,15 +119,16 @@ bool MockUTMDriver::startTest(double speedMmPerMin, double forceLimitN) {
     resetSimulation();
 
     m_state = MachineState::Running;
-    m_testStartTime = QDateTime::currentMSecsSinceEpoch();
+    m_testStartTime = m_clock->nowMs();
+    anchorClock(0.0);
 
-    // Start data generation at 100 Hz
-    m_timer->start(static_cast<int>(1000 / m_samplingRateHz));
+    // Start data generation at the sampling rate
+    m_timer->start(timerIntervalMs());
 
     emit stateChanged(m_state);
 
-    LOG_INFO(QString("Test started: speed=%1 mm/min, limit=%2 N")
-        .arg(m_speed).arg(m_forceLimit));
+    LOG_INFO(QString("Test started: speed=%1 mm/min, limit=%2 N, mode=%3, factor=%4")
+        .arg(m_speed).arg(m_forceLimit).arg(static_cast<int>(m_mode)).arg(m_speedFactor));
 
     return true;
 }
@@ -133,25 +142,72 @@ bool MockUTMDriver::stopTest() {
     m_state = MachineState::Stopping;
     emit stateChanged(m_state);
 
-    // Simulate stop delay
-    QThread::msleep(50);
-
-    m_state = MachineState::Idle;
-    emit stateChanged(m_state);
-    emit testCompleted();
-
     LOG_INFO(QString("Test stopped at %1% strain, %2 data points")
         .arg(m_currentStrain, 0, 'f', 2).arg(m_dataPointCount));
 
+    // Simulate the crosshead settling without blocking the caller
+    QTimer::singleShot(m_stopSettleMs, this, [this]() {
+        if (m_state != MachineState::Stopping) {
+            return; // disconnected or restarted meanwhile
+        }
+        m_state = MachineState::Idle;
+        emit stateChanged(m_state);
+        emit testCompleted();
+    });
+
     return true;
 }
 
+void MockUTMDriver::setStopSettleTime(int ms) {
+    m_stopSettleMs = qMax(0, ms);
+}
+
+void MockUTMDriver::setSimulationMode(SimulationMode mode, double speedFactor) {
+    // Re-anchor so the simulated time doesn't jump
+    double positionMs = simulatedElapsedMs();
+
+    m_mode = mode;
+    m_speedFactor = (mode == SimulationMode::Accelerated && speedFactor > 0) ? speedFactor : 1.0;
+
+    anchorClock(positionMs);
+    if (m_timer->isActive()) {
+        m_timer->setInterval(timerIntervalMs());
+    }
+}
+
+void MockUTMDriver::setBatchSize(int samples) {
+    m_batchSize = qMax(1, samples);
+}
+
+void MockUTMDriver::setClock(std::shared_ptr<SimulationClock> clock) {
+    m_clock = clock ? std::move(clock) : std::make_shared<SimulationClock>();
+    anchorClock(simulatedElapsedMs());
+}
+
+double MockUTMDriver::simulatedElapsedMs() const {
+    if (m_state != MachineState::Running) {
+        return m_anchorSimulatedMs;
+    }
+    if (m_mode == SimulationMode::AsFastAsConsumed) {
+        // Time is whatever has been generated so far
+        return m_dataPointCount * 1000.0 / m_samplingRateHz;
+    }
+    return m_anchorSimulatedMs + (m_clock->nowMs() - m_anchorWallMs) * m_speedFactor;
+}
+
+void MockUTMDriver::anchorClock(double simulatedMs) {
+    m_anchorWallMs = m_clock->nowMs();
+    m_anchorSimulatedMs = simulatedMs;
+}
+
 bool MockUTMDriver::pauseTest() {
     if (m_state != MachineState::Running) {
         return false;
     }
 
     m_timer->stop();
+    m_anchorSimulatedMs = simulatedElapsedMs();
+    m_pauseStartTime = m_clock->nowMs();
     m_state = MachineState::Paused;
     emit stateChanged(m_state);
 
@@ -164,7 +220,16 @@ bool MockUTMDriver::resumeTest() {
         return false;
     }
 
-    m_timer->start(1000 / m_samplingRateHz);
+    // Paused time does not advance the simulation but shows in the
+    // timestamps, as it would on a real machine
+    qint64 pausedMs = m_clock->nowMs() - m_pauseStartTime;
+    if (m_mode != SimulationMode::AsFastAsConsumed) {
+        m_testStartTime += static_cast<qint64>(pausedMs * m_speedFactor);
+    }
+    m_pauseStartTime = 0;
+    anchorClock(m_anchorSimulatedMs);
+
+    m_timer->start(timerIntervalMs());
     m_state = MachineState::Running;
     emit stateChanged(m_state);
 
@@ -187,6 +252,43 @@ double MockUTMDriver::getSpeed() const {
     return m_speed;
 }
 
+bool MockUTMDriver::setSamplingRate(int rateHz) {
+    if (rateHz <= 0 || rateHz > 100000) {
+        LOG_ERROR(QString("Invalid sampling rate: %1 Hz").arg(rateHz));
+        return false;
+    }
+
+    if (rateHz == m_samplingRateHz) {
+        return true;
+    }
+
+    m_samplingRateHz = rateHz;
+    if (m_timer->isActive()) {
+        m_timer->setInterval(timerIntervalMs());
+    }
+
+    LOG_DEBUG(QString("Sampling rate set to %1 Hz").arg(m_samplingRateHz));
+    emit sampleRateChanged(m_samplingRateHz);
+    return true;
+}
+
+void MockUTMDriver::setRandomSeed(quint64 seed) {
+    m_random.setSeed(seed);
+}
+
+void MockUTMDriver::setMaterial(const MaterialParameters& material) {
+    m_material.setParameters(material);
+    LOG_DEBUG(QString("Simulated material set to %1").arg(material.name));
+}
+
+int MockUTMDriver::timerIntervalMs() const {
+    if (m_mode == SimulationMode::AsFastAsConsumed) {
+        return 0;
+    }
+    // Rates above 1 kHz are served in batches per timer tick
+    return qMax(1, static_cast<int>(1000 / (m_samplingRateHz * m_speedFactor)));
+}
+
 bool MockUTMDriver::zero() {
     if (m_state == MachineState::Running) {
         LOG_WARNING("Cannot zero while test is running");
@@ -200,7 +302,7 @@ bool MockUTMDriver::zero() {
 
 SensorData MockUTMDriver::getCurrentData() const {
     SensorData data;
-    data.timestamp = QDateTime::currentMSecsSinceEpoch();
+    data.timestamp = m_clock->nowMs();
     data.force = m_currentForce;
     data.extension = m_currentExtension;
     data.stress = m_currentStress;
@@ -210,94 +312,69 @@ SensorData MockUTMDriver::getCurrentData() const {
 }
 
 void MockUTMDriver::generateDataPoint() {
-    // Calculate elapsed time
-    qint64 currentMs = QDateTime::currentMSecsSinceEpoch();
-    m_currentTime = (currentMs - m_testStartTime) / 1000.0; // seconds
-
-    // Calculate extension based on speed
-    m_currentExtension = (m_speed / 60.0) * m_currentTime; // mm
-
-    // Calculate strain
-    m_currentStrain = (m_currentExtension / m_gaugeLength) * 100.0; // %
-
-    // Check if test should complete (material break)
-    if (m_currentStrain >= m_breakStrain) {
-        stopTest();
-        return;
+    // Catch up on every sample due by now; the timer cannot fire faster
+    // than once per millisecond and may be late under load
+    qint64 due = 0;
+    if (m_mode == SimulationMode::AsFastAsConsumed) {
+        due = qint64(m_dataPointCount) + m_batchSize;
+    } else {
+        due = static_cast<qint64>(simulatedElapsedMs() * m_samplingRateHz / 1000.0);
     }
 
-    // Simulate stress-strain curve
-    m_currentStress = simulateStressCurve(m_currentStrain);
-
-    // Calculate force
-    m_currentForce = stressToForce(m_currentStress);
-
-    // Check force limit
-    if (m_currentForce >= m_forceLimit) {
-        LOG_WARNING(QString("Force limit reached: %.0f N").arg(m_currentForce));
-        stopTest();
-        return;
-    }
-
-    // Create and emit sensor data
-    SensorData data = getCurrentData();
-    emit sensorDataReceived(data);
-
-    m_dataPointCount++;
-
-    // Log every 100 points
-    if (m_dataPointCount % 100 == 0) {
-        LOG_DEBUG(QString("Data point %1: Strain=%2%, Stress=%3 MPa, Force=%4 N")
-            .arg(m_dataPointCount).arg(m_currentStrain, 0, 'f', 3).arg(m_currentStress, 0, 'f', 2).arg(m_currentForce, 0, 'f', 0));
+    while (m_dataPointCount < due) {
+        int count = static_cast<int>(qMin<qint64>(due - m_dataPointCount, MAX_BATCH_SIZE));
+        if (!generateBatch(qint64(m_dataPointCount) + 1, count)) {
+            return;
+        }
     }
 }
 
-double MockUTMDriver::simulateStressCurve(double strain) {
-    // Realistic stress-strain curve for plastic material
-    // Phases: elastic → yield → plastic deformation → necking → break
-
-    if (strain <= 0) return 0.0;
-
-    // Add small random noise (±0.5%)
-    double noise = (QRandomGenerator::global()->bounded(200) - 100) / 10000.0;
-
-    // Phase 1: Linear elastic region (0 to ~0.5% strain)
-    double elasticLimit = 0.5; // % strain
-    if (strain <= elasticLimit) {
-        // Stress = E * strain
-        double stress = (m_elasticModulus * 1000.0) * (strain / 100.0); // Convert GPa to MPa
-        return stress * (1.0 + noise);
-    }
-
-    // Phase 2: Yield point (~0.5% to 1.5% strain)
-    double yieldEnd = 1.5;
-    if (strain <= yieldEnd) {
-        // Transition from elastic to plastic
-        double t = (strain - elasticLimit) / (yieldEnd - elasticLimit);
-        double stress = m_elasticModulus * 1000.0 * (elasticLimit / 100.0) +
-                       (m_yieldStress - m_elasticModulus * 1000.0 * (elasticLimit / 100.0)) * t;
-        return stress * (1.0 + noise);
+bool MockUTMDriver::generateBatch(qint64 firstIndex, int count) {
+    ConstantSpeedRun run;
+    run.speedMmPerMin = m_speed;
+    run.gaugeLength = m_gaugeLength;
+    run.crossSection = m_crossSection;
+    run.samplingRateHz = m_samplingRateHz;
+    run.startMs = m_testStartTime;
+    const int valid = m_material.sampleBatch(run, firstIndex, count, m_samples, m_random);
+
+    for (int i = 0; i < valid; ++i) {
+        const SensorData data = m_samples[i];
+        m_currentTime = static_cast<double>(firstIndex + i) / m_samplingRateHz;
+        m_currentExtension = data.extension;
+        m_currentStrain = data.strain;
+        m_currentStress = data.stress;
+        m_currentForce = data.force;
+
+        // Check force limit
+        if (m_currentForce >= m_forceLimit) {
+            LOG_WARNING(QString("Force limit reached: %1 N").arg(m_currentForce, 0, 'f', 0));
+            stopTest();
+            return false;
+        }
+
+        emit sensorDataReceived(data);
+
+        m_dataPointCount++;
+
+        // Log every 100 points
+        if (m_dataPointCount % 100 == 0) {
+            LOG_DEBUG(QString("Data point %1: Strain=%2%, Stress=%3 MPa, Force=%4 N")
+                .arg(m_dataPointCount).arg(m_currentStrain, 0, 'f', 3).arg(m_currentStress, 0, 'f', 2).arg(m_currentForce, 0, 'f', 0));
+        }
+
+        if (m_state != MachineState::Running) {
+            return false; // stopped or paused by a receiver
+        }
     }
 
-    // Phase 3: Plastic deformation (1.5% to 5% strain)
-    double plasticEnd = 5.0;
-    if (strain <= plasticEnd) {
-        // Gradual increase to ultimate stress
-        double t = (strain - yieldEnd) / (plasticEnd - yieldEnd);
-        double stress = m_yieldStress + (m_ultimateStress - m_yieldStress) * t;
-        return stress * (1.0 + noise);
+    // Material break
+    if (valid < count) {
+        stopTest();
+        return false;
     }
 
-    // Phase 4: Necking and approaching break (5% to break)
-    double t = (strain - plasticEnd) / (m_breakStrain - plasticEnd);
-    // Stress decreases slightly after ultimate
-    double stress = m_ultimateStress * (1.0 - 0.2 * t); // 20% decrease before break
-    return stress * (1.0 + noise);
-}
-
-double MockUTMDriver::stressToForce(double stress) {
-    // Force = Stress * Area
-    return stress * m_crossSection;
+    return true;
 }
 
 double MockUTMDriver::strainToExtension(double strain) {
@@ -313,6 +390,7 @@ void MockUTMDriver::resetSimulation() {
     m_currentForce = 0.0;
     m_dataPointCount = 0;
     m_testStartTime = 0;
+    m_anchorSimulatedMs = 0.0;
 }
 
 } // namespace HorizonUTM
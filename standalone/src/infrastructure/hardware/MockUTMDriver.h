@@ -2,18 +2,35 @@
 
 #include <QObject>
 #include <QTimer>
-#include <QDateTime>
+#include <memory>
 #include "domain/interfaces/IUTMDriver.h"
 #include "domain/value_objects/SensorData.h"
 #include "domain/value_objects/MachineState.h"
+#include "MaterialSimulator.h"
+#include "SimulationClock.h"
 
 namespace HorizonUTM {
 
+/**
+ * @brief How fast simulated time runs
+ */
+enum class SimulationMode {
+    RealTime,           ///< One simulated second per second
+    Accelerated,        ///< Simulated time runs speedFactor times faster
+    AsFastAsConsumed    ///< Batches of samples as fast as the event loop allows
+};
+
 /**
  * @brief Mock UTM driver for testing without real hardware
  * 
  * Simulates realistic stress-strain behavior for tensile testing
  * Generates data points at specified sampling rate
+ *
+ * Samples lie on the sampling grid of simulated time and are stamped
+ * test start + sample time, so a test produces the same timestamps
+ * whether it runs in real time, accelerated or as fast as consumed.
+ * Receivers on the driver's thread consume every batch before the next
+ * one is generated.
  */
 class MockUTMDriver : public IUTMDriver {
     Q_OBJECT
@@ -40,35 +57,86 @@ public:
     bool zero() override;
     
     SensorData getCurrentData() const override;
-
-signals:
-    void connected();
-    void disconnected();
-    void stateChanged(MachineState state);
-    void sensorDataReceived(SensorData data);
-    void testCompleted();
-    void errorOccurred(const QString& error);
+    
+    /**
+     * @brief Set sampling rate
+     * @param rateHz Samples per second of simulated time (1..100000)
+     * @return false if out of range
+     */
+    bool setSamplingRate(int rateHz);
+    int getSamplingRate() const { return m_samplingRateHz; }
+    double getSampleRateHz() const override { return m_samplingRateHz; }
+    
+    /**
+     * @brief Set simulated material (takes effect at the next test)
+     */
+    void setMaterial(const MaterialParameters& material);
+    const MaterialParameters& getMaterial() const { return m_material.parameters(); }
+    
+    /**
+     * @brief Seed the measurement noise, for reproducible curves
+     */
+    void setRandomSeed(quint64 seed);
+    
+    /**
+     * @brief Set how long the machine stays in Stopping after stopTest()
+     *
+     * stopTest() returns immediately; Idle and testCompleted() follow
+     * from the event loop once the settle time has passed.
+     */
+    void setStopSettleTime(int ms);
+    int getStopSettleTime() const { return m_stopSettleMs; }
+    
+    /**
+     * @brief Set how fast simulated time runs (may change during a test)
+     * @param mode Simulation mode
+     * @param speedFactor Speed multiplier for Accelerated mode
+     */
+    void setSimulationMode(SimulationMode mode, double speedFactor = 1.0);
+    SimulationMode getSimulationMode() const { return m_mode; }
+    double getSpeedFactor() const { return m_speedFactor; }
+    
+    /**
+     * @brief Samples generated per event loop turn in AsFastAsConsumed mode
+     */
+    void setBatchSize(int samples);
+    
+    /**
+     * @brief Use another wall-clock source (nullptr restores the system clock)
+     *
+     * Set it while no test is running.
+     */
+    void setClock(std::shared_ptr<SimulationClock> clock);
 
 private slots:
     /**
-     * @brief Generate next data point (called by timer)
+     * @brief Generate all data points due since the last tick (called by timer)
      */
     void generateDataPoint();
 
 private:
     /**
-     * @brief Simulate realistic stress-strain curve
-     * @param strain Current strain (%)
-     * @return Stress (MPa)
+     * @brief Generate and emit consecutive samples
+     * @param firstIndex 1-based index of the first sample, sample time is index / rate
+     * @param count Number of samples
+     * @return false if the test ended or was interrupted
      */
-    double simulateStressCurve(double strain);
+    bool generateBatch(qint64 firstIndex, int count);
     
     /**
-     * @brief Calculate force from stress
-     * @param stress Stress in MPa
-     * @return Force in N
+     * @brief Timer interval for the sampling rate and mode
      */
-    double stressToForce(double stress);
+    int timerIntervalMs() const;
+    
+    /**
+     * @brief Simulated time since test start (ms), excluding pauses
+     */
+    double simulatedElapsedMs() const;
+    
+    /**
+     * @brief Restart the wall-clock measurement from the current position
+     */
+    void anchorClock(double simulatedMs);
     
     /**
      * @brief Calculate extension from strain
@@ -95,24 +163,35 @@ private:
     
     // Simulation state
     QTimer* m_timer;
-    qint64 m_testStartTime;   // ms since epoch
+    qint64 m_testStartTime;   // ms since epoch, base of emitted timestamps
+    qint64 m_pauseStartTime;  // ms since epoch, 0 if not paused
+    
+    // Simulated time
+    std::shared_ptr<SimulationClock> m_clock;
+    SimulationMode m_mode;
+    double m_speedFactor;
+    int m_batchSize;
+    qint64 m_anchorWallMs;    // clock time at the last (re)start
+    double m_anchorSimulatedMs; // simulated time at the last (re)start
     double m_currentTime;     // seconds from test start
     double m_currentExtension; // mm
     double m_currentStrain;   // %
     double m_currentStress;   // MPa
     double m_currentForce;    // N
     
-    // Simulation parameters (material properties)
-    double m_elasticModulus;  // GPa
-    double m_yieldStress;     // MPa
-    double m_ultimateStress;  // MPa
-    double m_breakStrain;     // %
+    // Simulated material
+    MaterialSimulator m_material;
+    FastRandom m_random;
+    QVector<SensorData> m_samples;
     
     // Sampling
     int m_samplingRateHz;
     
     // Data point counter
     int m_dataPointCount;
+    
+    // Time spent in Stopping before reporting Idle
+    int m_stopSettleMs;
 };
 
 } // namespace HorizonUTM
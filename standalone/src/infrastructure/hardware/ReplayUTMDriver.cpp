@@ -0,0 +1,415 @@
+#include "ReplayUTMDriver.h"
+#include "infrastructure/export/BinaryCurveReader.h"
+#include "core/Logger.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+#include <QDateTime>
+
+namespace HorizonUTM {
+
+namespace {
+
+// Timer resolution for timed playback
+constexpr int REPLAY_TICK_MS = 5;
+
+// Default samples per event loop turn in AsFastAsPossible mode
+constexpr int DEFAULT_BATCH_SIZE = 500;
+
+} // namespace
+
+ReplayUTMDriver::ReplayUTMDriver(QObject* parent)
+    : IUTMDriver(parent)
+    , m_connected(false)
+    , m_state(MachineState::Disconnected)
+    , m_speed(5.0)
+    , m_forceLimit(10000.0)
+    , m_recordingStart(0)
+    , m_sampleRateHz(0.0)
+    , m_mode(ReplayMode::RealTime)
+    , m_speedFactor(1.0)
+    , m_batchSize(DEFAULT_BATCH_SIZE)
+    , m_timer(new QTimer(this))
+    , m_pausedPositionMs(0)
+    , m_testStartTime(0)
+    , m_position(0)
+{
+    QObject::connect(m_timer, &QTimer::timeout, this, &ReplayUTMDriver::replayTick);
+
+    LOG_INFO("ReplayUTMDriver created");
+}
+
+ReplayUTMDriver::~ReplayUTMDriver() {
+    if (m_connected) {
+        disconnect();
+    }
+    LOG_INFO("ReplayUTMDriver destroyed");
+}
+
+bool ReplayUTMDriver::loadRecording(const QString& filePath, int testIndex) {
+    if (m_state == MachineState::Running || m_state == MachineState::Paused) {
+        LOG_ERROR("Cannot load recording while a test is running");
+        return false;
+    }
+
+    QString suffix = QFileInfo(filePath).suffix().toLower();
+    bool loaded = (suffix == "hzb") ? loadBinary(filePath, testIndex) : loadCsv(filePath);
+
+    if (!loaded || m_recording.isEmpty()) {
+        LOG_ERROR(QString("Failed to load recording: %1").arg(filePath));
+        m_recording.clear();
+        return false;
+    }
+
+    recordingChanged();
+
+    LOG_INFO(QString("Recording loaded: %1 (%2 samples, %3 s, %4 Hz)")
+        .arg(filePath).arg(m_recording.size())
+        .arg((m_recording.last().timestamp - m_recordingStart) / 1000.0, 0, 'f', 1)
+        .arg(m_sampleRateHz, 0, 'f', 0));
+    return true;
+}
+
+void ReplayUTMDriver::setRecording(const QVector<SensorData>& data) {
+    m_recording = data;
+    recordingChanged();
+}
+
+void ReplayUTMDriver::recordingChanged() {
+    m_recordingStart = m_recording.isEmpty() ? 0 : m_recording.first().timestamp;
+
+    double rateHz = 0.0;
+    if (m_recording.size() > 1) {
+        const qint64 spanMs = m_recording.last().timestamp - m_recordingStart;
+        if (spanMs > 0) {
+            rateHz = (m_recording.size() - 1) * 1000.0 / spanMs;
+        }
+    }
+
+    if (rateHz != m_sampleRateHz) {
+        m_sampleRateHz = rateHz;
+        emit sampleRateChanged(m_sampleRateHz);
+    }
+}
+
+void ReplayUTMDriver::setReplayMode(ReplayMode mode, double speedFactor) {
+    m_mode = mode;
+    m_speedFactor = (mode == ReplayMode::Accelerated && speedFactor > 0) ? speedFactor : 1.0;
+
+    if (m_timer->isActive()) {
+        // Re-anchor the clock so the position doesn't jump
+        m_pausedPositionMs = playbackPositionMs();
+        m_clock.restart();
+        m_timer->setInterval(tickIntervalMs());
+    }
+}
+
+void ReplayUTMDriver::setBatchSize(int samples) {
+    m_batchSize = qMax(1, samples);
+}
+
+bool ReplayUTMDriver::connect(const QString& connectionString) {
+    if (m_connected) {
+        LOG_WARNING("ReplayUTMDriver already connected");
+        return true;
+    }
+
+    // A file path as connection string loads the recording
+    if (m_recording.isEmpty() && QFileInfo::exists(connectionString)) {
+        loadRecording(connectionString);
+    }
+
+    m_connected = true;
+    m_state = MachineState::Idle;
+
+    emit connected();
+    emit stateChanged(m_state);
+
+    LOG_INFO(QString("ReplayUTMDriver connected (%1 samples loaded)").arg(m_recording.size()));
+    return true;
+}
+
+bool ReplayUTMDriver::disconnect() {
+    if (!m_connected) {
+        return true;
+    }
+
+    if (m_state == MachineState::Running || m_state == MachineState::Paused) {
+        stopTest();
+    }
+
+    m_connected = false;
+    m_state = MachineState::Disconnected;
+
+    emit disconnected();
+    emit stateChanged(m_state);
+
+    LOG_INFO("ReplayUTMDriver disconnected");
+    return true;
+}
+
+bool ReplayUTMDriver::isConnected() const {
+    return m_connected;
+}
+
+MachineState ReplayUTMDriver::getState() const {
+    return m_state;
+}
+
+bool ReplayUTMDriver::startTest(double speedMmPerMin, double forceLimitN) {
+    if (!m_connected) {
+        LOG_ERROR("Cannot start replay: not connected");
+        emit errorOccurred("Not connected");
+        return false;
+    }
+
+    if (m_state == MachineState::Running) {
+        LOG_WARNING("Replay already running");
+        return false;
+    }
+
+    if (m_recording.isEmpty()) {
+        LOG_ERROR("Cannot start replay: no recording loaded");
+        emit errorOccurred("No recording loaded");
+        return false;
+    }
+
+    m_speed = speedMmPerMin;
+    m_forceLimit = forceLimitN;
+
+    m_position = 0;
+    m_pausedPositionMs = 0;
+    m_testStartTime = QDateTime::currentMSecsSinceEpoch();
+    m_clock.start();
+
+    m_state = MachineState::Running;
+    m_timer->start(tickIntervalMs());
+
+    emit stateChanged(m_state);
+
+    LOG_INFO(QString("Replay started: %1 samples, mode=%2, factor=%3")
+        .arg(m_recording.size()).arg(static_cast<int>(m_mode)).arg(m_speedFactor));
+
+    return true;
+}
+
+bool ReplayUTMDriver::stopTest() {
+    if (m_state != MachineState::Running && m_state != MachineState::Paused) {
+        return false;
+    }
+
+    m_timer->stop();
+    m_state = MachineState::Stopping;
+    emit stateChanged(m_state);
+
+    // Playback stops immediately, no settle delay to simulate
+    m_state = MachineState::Idle;
+    emit stateChanged(m_state);
+
+    LOG_INFO(QString("Replay stopped at sample %1 of %2")
+        .arg(m_position).arg(m_recording.size()));
+
+    return true;
+}
+
+bool ReplayUTMDriver::pauseTest() {
+    if (m_state != MachineState::Running) {
+        return false;
+    }
+
+    m_pausedPositionMs = playbackPositionMs();
+    m_timer->stop();
+    m_state = MachineState::Paused;
+    emit stateChanged(m_state);
+
+    LOG_INFO("Replay paused");
+    return true;
+}
+
+bool ReplayUTMDriver::resumeTest() {
+    if (m_state != MachineState::Paused) {
+        return false;
+    }
+
+    m_clock.restart();
+    m_timer->start(tickIntervalMs());
+    m_state = MachineState::Running;
+    emit stateChanged(m_state);
+
+    LOG_INFO("Replay resumed");
+    return true;
+}
+
+bool ReplayUTMDriver::setSpeed(double speedMmPerMin) {
+    if (speedMmPerMin <= 0 || speedMmPerMin > 500) {
+        LOG_ERROR(QString("Invalid speed: %1 mm/min").arg(speedMmPerMin, 0, 'f', 2));
+        return false;
+    }
+
+    // The recording dictates the motion; the speed is informational only
+    m_speed = speedMmPerMin;
+    return true;
+}
+
+double ReplayUTMDriver::getSpeed() const {
+    return m_speed;
+}
+
+bool ReplayUTMDriver::zero() {
+    if (m_state == MachineState::Running) {
+        LOG_WARNING("Cannot zero while replay is running");
+        return false;
+    }
+
+    m_lastData = SensorData();
+    LOG_INFO("Sensors zeroed");
+    return true;
+}
+
+SensorData ReplayUTMDriver::getCurrentData() const {
+    return m_lastData;
+}
+
+void ReplayUTMDriver::replayTick() {
+    if (m_state != MachineState::Running) {
+        return;
+    }
+
+    const int size = m_recording.size();
+
+    if (m_mode == ReplayMode::AsFastAsPossible) {
+        int end = qMin(size, m_position + m_batchSize);
+        while (m_position < end) {
+            if (!emitSample(m_recording[m_position++]) || m_state != MachineState::Running) {
+                return; // force limit, or stopped or paused by a receiver
+            }
+        }
+    } else {
+        qint64 positionMs = playbackPositionMs();
+        while (m_position < size &&
+               m_recording[m_position].timestamp - m_recordingStart <= positionMs) {
+            if (!emitSample(m_recording[m_position++]) || m_state != MachineState::Running) {
+                return;
+            }
+        }
+    }
+
+    if (m_position >= size) {
+        finishTest();
+    }
+}
+
+bool ReplayUTMDriver::emitSample(const SensorData& recorded) {
+    SensorData data = recorded;
+    data.timestamp = m_testStartTime + (recorded.timestamp - m_recordingStart);
+    m_lastData = data;
+
+    if (data.force >= m_forceLimit) {
+        LOG_WARNING(QString("Force limit reached: %1 N").arg(data.force, 0, 'f', 0));
+        finishTest();
+        return false;
+    }
+
+    emit sensorDataReceived(data);
+    return true;
+}
+
+qint64 ReplayUTMDriver::playbackPositionMs() const {
+    if (!m_clock.isValid()) {
+        return m_pausedPositionMs;
+    }
+    return m_pausedPositionMs + static_cast<qint64>(m_clock.elapsed() * m_speedFactor);
+}
+
+int ReplayUTMDriver::tickIntervalMs() const {
+    return m_mode == ReplayMode::AsFastAsPossible ? 0 : REPLAY_TICK_MS;
+}
+
+void ReplayUTMDriver::finishTest() {
+    m_timer->stop();
+    m_state = MachineState::Idle;
+    emit stateChanged(m_state);
+    emit testCompleted();
+
+    LOG_INFO(QString("Replay finished: %1 samples emitted").arg(m_position));
+}
+
+bool ReplayUTMDriver::loadCsv(const QString& filePath) {
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        LOG_ERROR(QString("Cannot open recording: %1").arg(filePath));
+        return false;
+    }
+
+    QTextStream in(&file);
+
+    // Skip the summary section up to the curve header
+    QStringList columns;
+    while (!in.atEnd()) {
+        QString line = in.readLine();
+        if (line.startsWith("Timestamp (ms)")) {
+            columns = line.split(',');
+            break;
+        }
+    }
+
+    if (columns.isEmpty()) {
+        LOG_ERROR(QString("No curve section found in %1").arg(filePath));
+        return false;
+    }
+
+    const int timestampCol = columns.indexOf("Timestamp (ms)");
+    const int forceCol = columns.indexOf("Force (N)");
+    const int extensionCol = columns.indexOf("Extension (mm)");
+    const int stressCol = columns.indexOf("Stress (MPa)");
+    const int strainCol = columns.indexOf("Strain (%)");
+    const int temperatureCol = columns.indexOf("Temperature (°C)");
+
+    if (forceCol < 0 || extensionCol < 0) {
+        LOG_ERROR(QString("Curve section in %1 lacks force/extension columns").arg(filePath));
+        return false;
+    }
+
+    auto field = [](const QStringList& fields, int column) {
+        return (column >= 0 && column < fields.size()) ? fields[column].toDouble() : 0.0;
+    };
+
+    m_recording.clear();
+
+    while (!in.atEnd()) {
+        QString line = in.readLine();
+        if (line.isEmpty()) {
+            break;
+        }
+
+        QStringList fields = line.split(',');
+        SensorData point;
+        point.timestamp = fields.value(timestampCol).toLongLong();
+        point.force = field(fields, forceCol);
+        point.extension = field(fields, extensionCol);
+        point.stress = field(fields, stressCol);
+        point.strain = field(fields, strainCol);
+        point.temperature = field(fields, temperatureCol);
+
+        m_recording.append(point);
+    }
+
+    return true;
+}
+
+bool ReplayUTMDriver::loadBinary(const QString& filePath, int testIndex) {
+    BinaryCurveReader reader;
+    if (!reader.open(filePath)) {
+        return false;
+    }
+
+    if (testIndex < 0 || testIndex >= reader.testCount()) {
+        LOG_ERROR(QString("Test index %1 out of range (%2 tests)").arg(testIndex).arg(reader.testCount()));
+        return false;
+    }
+
+    m_recording = reader.dataPoints(testIndex);
+    return true;
+}
+
+} // namespace HorizonUTM
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QVector>
+#include "domain/interfaces/IUTMDriver.h"
+#include "domain/value_objects/SensorData.h"
+#include "domain/value_objects/MachineState.h"
+
+namespace HorizonUTM {
+
+/**
+ * @brief Playback speed of a replayed recording
+ */
+enum class ReplayMode {
+    RealTime,           ///< Original sample spacing
+    Accelerated,        ///< Original spacing divided by the speed factor
+    AsFastAsPossible    ///< Batches of samples as fast as the event loop allows
+};
+
+/**
+ * @brief UTM driver that plays back a recorded curve
+ * 
+ * Reads a curve exported as CSV (test export with curve section) or as a
+ * Horizon binary curve file and emits it through the IUTMDriver signals
+ * exactly like a machine would, so the whole acquisition → analysis →
+ * persistence → UI pipeline can be driven by production data.
+ * 
+ * Emitted timestamps are rebased onto the replay start while keeping the
+ * recorded sample spacing, independent of the playback speed.
+ */
+class ReplayUTMDriver : public IUTMDriver {
+    Q_OBJECT
+
+public:
+    explicit ReplayUTMDriver(QObject* parent = nullptr);
+    ~ReplayUTMDriver() override;
+    
+    /**
+     * @brief Load a recording
+     * @param filePath *.csv or *.hzb file
+     * @param testIndex Test to replay for multi-test binary files
+     * @return true if at least one sample was loaded
+     */
+    bool loadRecording(const QString& filePath, int testIndex = 0);
+    
+    /**
+     * @brief Use already loaded samples as the recording
+     */
+    void setRecording(const QVector<SensorData>& data);
+    
+    /**
+     * @brief Set playback mode
+     * @param mode Playback mode
+     * @param speedFactor Speed multiplier for Accelerated mode
+     */
+    void setReplayMode(ReplayMode mode, double speedFactor = 1.0);
+    
+    /**
+     * @brief Samples emitted per event loop turn in AsFastAsPossible mode
+     */
+    void setBatchSize(int samples);
+    
+    ReplayMode getReplayMode() const { return m_mode; }
+    double getSpeedFactor() const { return m_speedFactor; }
+    
+    /**
+     * @brief Mean rate of the recording, whatever the replay mode
+     */
+    double getSampleRateHz() const override { return m_sampleRateHz; }
+    int getSampleCount() const { return m_recording.size(); }
+    int getReplayPosition() const { return m_position; }
+
+    // IUTMDriver interface implementation
+    bool connect(const QString& connectionString) override;
+    bool disconnect() override;
+    bool isConnected() const override;
+    
+    MachineState getState() const override;
+    
+    bool startTest(double speedMmPerMin, double forceLimitN) override;
+    bool stopTest() override;
+    bool pauseTest() override;
+    bool resumeTest() override;
+    
+    bool setSpeed(double speedMmPerMin) override;
+    double getSpeed() const override;
+    
+    bool zero() override;
+    
+    SensorData getCurrentData() const override;
+
+private slots:
+    /**
+     * @brief Emit all samples due at the current playback time
+     */
+    void replayTick();
+
+private:
+    /**
+     * @brief Parse curve section of a CSV test export
+     */
+    bool loadCsv(const QString& filePath);
+    
+    /**
+     * @brief Read curve from binary file
+     */
+    bool loadBinary(const QString& filePath, int testIndex);
+    
+    /**
+     * @brief Emit one recorded sample
+     * @return false if the test ended (force limit)
+     */
+    bool emitSample(const SensorData& recorded);
+    
+    /**
+     * @brief Rebase on the first sample and measure the recording's rate
+     */
+    void recordingChanged();
+    
+    /**
+     * @brief Playback time in recording milliseconds
+     */
+    qint64 playbackPositionMs() const;
+    
+    /**
+     * @brief Timer interval for the current mode
+     */
+    int tickIntervalMs() const;
+    
+    /**
+     * @brief Finish test at end of recording or on force limit
+     */
+    void finishTest();
+
+private:
+    // Connection state
+    bool m_connected;
+    MachineState m_state;
+    
+    // Test parameters
+    double m_speed;           // mm/min (informational)
+    double m_forceLimit;      // N
+    
+    // Recording
+    QVector<SensorData> m_recording;
+    qint64 m_recordingStart;  // first recorded timestamp
+    double m_sampleRateHz;    // 0 until the recording spans some time
+    
+    // Playback
+    ReplayMode m_mode;
+    double m_speedFactor;
+    int m_batchSize;
+    QTimer* m_timer;
+    QElapsedTimer m_clock;
+    qint64 m_pausedPositionMs; // recording time reached before last pause
+    qint64 m_testStartTime;    // ms since epoch, base of emitted timestamps
+    int m_position;            // next sample to emit
+    SensorData m_lastData;
+};
+
+} // namespace HorizonUTM
@@ -0,0 +1,10 @@
+#include "SimulationClock.h"
+#include <QDateTime>
+
+namespace HorizonUTM {
+
+qint64 SimulationClock::nowMs() const {
+    return QDateTime::currentMSecsSinceEpoch();
+}
+
+} // namespace HorizonUTM
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <QtGlobal>
+#include <atomic>
+
+namespace HorizonUTM {
+
+/**
+ * @brief Wall-clock source of a simulated machine
+ *
+ * MockUTMDriver reads the time through this interface so that tests can
+ * drive it deterministically and timestamps can be anchored anywhere.
+ * The default implementation is the system clock.
+ */
+class SimulationClock {
+public:
+    virtual ~SimulationClock() = default;
+
+    /**
+     * @brief Current time in ms since epoch
+     */
+    virtual qint64 nowMs() const;
+};
+
+/**
+ * @brief Clock that only moves when told to
+ *
+ * Safe to advance from another thread than the one reading it.
+ */
+class ManualClock : public SimulationClock {
+public:
+    explicit ManualClock(qint64 startMs = 0) : m_nowMs(startMs) {}
+
+    qint64 nowMs() const override { return m_nowMs.load(); }
+
+    void setTime(qint64 ms) { m_nowMs.store(ms); }
+    void advance(qint64 ms) { m_nowMs.fetch_add(ms); }
+
+private:
+    std::atomic<qint64> m_nowMs;
+};
+
+} // namespace HorizonUTM
@@ -0,0 +1,137 @@
+#include "CurveCache.h"
+
+namespace HorizonUTM {
+
+CurveCache::CurveCache(qint64 budgetBytes)
+    : m_clearGeneration(0)
+    , m_nextGeneration(0)
+    , m_budgetBytes(qMax<qint64>(0, budgetBytes))
+    , m_bytes(0)
+    , m_hits(0)
+    , m_misses(0)
+    , m_evictions(0)
+{
+}
+
+qint64 CurveCache::costOf(const Curve& curve) {
+    return static_cast<qint64>(curve.size()) * qint64(sizeof(SensorData));
+}
+
+bool CurveCache::lookup(int testId, Curve& curve, quint64* generation) {
+    QMutexLocker locker(&m_mutex);
+
+    if (generation) {
+        *generation = generationOf(testId);
+    }
+
+    auto it = m_entries.find(testId);
+    if (it == m_entries.end()) {
+        ++m_misses;
+        return false;
+    }
+
+    // Move to the front of the LRU list
+    m_order.splice(m_order.begin(), m_order, it->position);
+    curve = it->curve;
+    ++m_hits;
+    return true;
+}
+
+void CurveCache::insert(int testId, const Curve& curve) {
+    QMutexLocker locker(&m_mutex);
+    insertLocked(testId, curve);
+}
+
+bool CurveCache::insertIfCurrent(int testId, const Curve& curve, quint64 generation) {
+    QMutexLocker locker(&m_mutex);
+
+    if (generationOf(testId) != generation) {
+        return false;
+    }
+    insertLocked(testId, curve);
+    return true;
+}
+
+void CurveCache::insertLocked(int testId, const Curve& curve) {
+    auto existing = m_entries.find(testId);
+    if (existing != m_entries.end()) {
+        removeEntry(existing);
+    }
+
+    qint64 bytes = costOf(curve);
+    if (bytes > m_budgetBytes) {
+        return;
+    }
+
+    m_order.push_front(testId);
+    m_entries.insert(testId, Entry{curve, bytes, m_order.begin()});
+    m_bytes += bytes;
+
+    evictToBudget();
+}
+
+void CurveCache::invalidate(int testId) {
+    QMutexLocker locker(&m_mutex);
+    m_generations.insert(testId, ++m_nextGeneration);
+
+    auto it = m_entries.find(testId);
+    if (it != m_entries.end()) {
+        removeEntry(it);
+    }
+}
+
+void CurveCache::clear() {
+    QMutexLocker locker(&m_mutex);
+    m_entries.clear();
+    m_order.clear();
+    m_bytes = 0;
+
+    // Invalidates every id at once
+    m_generations.clear();
+    m_clearGeneration = ++m_nextGeneration;
+}
+
+void CurveCache::setBudget(qint64 budgetBytes) {
+    QMutexLocker locker(&m_mutex);
+    m_budgetBytes = qMax<qint64>(0, budgetBytes);
+    evictToBudget();
+}
+
+CurveCache::Stats CurveCache::stats() const {
+    QMutexLocker locker(&m_mutex);
+
+    Stats stats;
+    stats.hits = m_hits;
+    stats.misses = m_misses;
+    stats.evictions = m_evictions;
+    stats.entries = m_entries.size();
+    stats.bytes = m_bytes;
+    stats.budgetBytes = m_budgetBytes;
+    return stats;
+}
+
+void CurveCache::resetStats() {
+    QMutexLocker locker(&m_mutex);
+    m_hits = 0;
+    m_misses = 0;
+    m_evictions = 0;
+}
+
+void CurveCache::removeEntry(QHash<int, Entry>::iterator it) {
+    m_bytes -= it->bytes;
+    m_order.erase(it->position);
+    m_entries.erase(it);
+}
+
+quint64 CurveCache::generationOf(int testId) const {
+    return m_generations.value(testId, m_clearGeneration);
+}
+
+void CurveCache::evictToBudget() {
+    while (m_bytes > m_budgetBytes && !m_order.empty()) {
+        removeEntry(m_entries.find(m_order.back()));
+        ++m_evictions;
+    }
+}
+
+} // namespace HorizonUTM
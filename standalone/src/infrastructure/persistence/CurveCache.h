@@ -0,0 +1,95 @@
+#pragma once
+
+#include <QHash>
+#include <QMutex>
+#include <list>
+#include "domain/value_objects/Curve.h"
+
+namespace HorizonUTM {
+
+/**
+ * @brief Least-recently-used cache of test curves
+ *
+ * Keyed by test id and bounded by a byte budget. Curves are immutable
+ * shared handles, so a hit costs a reference count increment and the
+ * caller can keep the curve after it is evicted. Thread-safe.
+ */
+class CurveCache {
+public:
+    struct Stats {
+        qint64 hits = 0;
+        qint64 misses = 0;
+        qint64 evictions = 0;
+        qint64 entries = 0;
+        qint64 bytes = 0;
+        qint64 budgetBytes = 0;
+    };
+
+    explicit CurveCache(qint64 budgetBytes);
+
+    /**
+     * @brief Look up a curve and mark it most recently used
+     * @param generation Set to the id's generation, for insertIfCurrent() after a miss
+     * @return false on a miss
+     */
+    bool lookup(int testId, Curve& curve, quint64* generation = nullptr);
+
+    /**
+     * @brief Add or replace a curve, evicting old ones to stay in budget
+     *
+     * Curves larger than the whole budget are not cached.
+     */
+    void insert(int testId, const Curve& curve);
+
+    /**
+     * @brief Insert a curve loaded after a miss, unless the id was invalidated since
+     *
+     * A loader reading outside the cache lock can race a writer: the writer
+     * invalidates, then the loader inserts the curve it read before the write.
+     * @param generation As returned by lookup() at the miss
+     * @return false if the curve was stale and not inserted
+     */
+    bool insertIfCurrent(int testId, const Curve& curve, quint64 generation);
+
+    void invalidate(int testId);
+    void clear();
+
+    /**
+     * @brief Change the budget (0 disables caching)
+     */
+    void setBudget(qint64 budgetBytes);
+
+    Stats stats() const;
+    void resetStats();
+
+    /**
+     * @brief Bytes accounted for a curve
+     */
+    static qint64 costOf(const Curve& curve);
+
+private:
+    struct Entry {
+        Curve curve;
+        qint64 bytes;
+        std::list<int>::iterator position;
+    };
+
+    void insertLocked(int testId, const Curve& curve);
+    void removeEntry(QHash<int, Entry>::iterator it);
+    void evictToBudget();
+    quint64 generationOf(int testId) const;
+
+    mutable QMutex m_mutex;
+    QHash<int, Entry> m_entries;
+    std::list<int> m_order;     // most recently used first
+    QHash<int, quint64> m_generations;     // bumped by invalidate()
+    quint64 m_clearGeneration;              // ids not in m_generations
+    quint64 m_nextGeneration;
+    qint64 m_budgetBytes;
+    qint64 m_bytes;
+    qint64 m_hits;
+    qint64 m_misses;
+    qint64 m_evictions;
+};
+
+} // namespace HorizonUTM
@@ -0,0 +1,109 @@
+#include "CurveSpillFile.h"
+#include "core/Logger.h"
+#include <QDir>
+#include <QMutex>
+#include <QTemporaryFile>
+#include <cstring>
+
+namespace HorizonUTM {
+
+// Shared with the mappings so the file outlives the store if needed
+struct CurveSpillFile::File {
+    QMutex mutex;
+    QTemporaryFile file;
+    qint64 size = 0;        // Bytes reserved for mapped chunks
+    qint64 written = 0;     // Bytes of points
+    int mappings = 0;
+    bool failed = false;
+};
+
+CurveSpillFile::CurveSpillFile(const QString& directory)
+    : m_file(std::make_shared<File>())
+    , m_chunkUsed(0)
+    , m_chunkBytes(0)
+{
+    QString dir = directory.isEmpty() ? QDir::tempPath() : directory;
+    QDir().mkpath(dir);
+
+    m_file->file.setFileTemplate(dir + "/horizon_curve_XXXXXX.seg");
+    if (!m_file->file.open()) {
+        LOG_ERROR(QString("Cannot create curve spill file in %1: %2")
+            .arg(dir).arg(m_file->file.errorString()));
+        m_file->failed = true;
+    }
+}
+
+CurveSpillFile::~CurveSpillFile() = default;
+
+Curve::Segment CurveSpillFile::spill(const Curve::Block& block) {
+    // Released after the lock: its deleter takes the lock
+    std::shared_ptr<uchar> previous;
+    QMutexLocker locker(&m_file->mutex);
+
+    if (m_file->failed || block.isEmpty()) {
+        return Curve::Segment();
+    }
+
+    const qint64 bytes = block.size() * qint64(sizeof(SensorData));
+
+    if (!m_chunk || m_chunkUsed + bytes > m_chunkBytes) {
+        // Grow the file by one chunk and map it once
+        const qint64 chunkBytes = qMax(bytes, MAP_CHUNK_BLOCKS * Curve::BLOCK_SIZE * qint64(sizeof(SensorData)));
+        const qint64 offset = m_file->size;
+
+        QFile& file = m_file->file;
+        if (!file.resize(offset + chunkBytes)) {
+            LOG_ERROR(QString("Cannot grow curve spill file: %1").arg(file.errorString()));
+            m_file->failed = true;
+            return Curve::Segment();
+        }
+
+        uchar* mapped = file.map(offset, chunkBytes);
+        if (!mapped) {
+            LOG_ERROR(QString("Cannot map curve spill file: %1").arg(file.errorString()));
+            m_file->failed = true;
+            return Curve::Segment();
+        }
+        m_file->size += chunkBytes;
+        ++m_file->mappings;
+
+        // Unmapped when the store and the last curve holding a segment in it go away
+        std::shared_ptr<File> owner = m_file;
+        previous = std::move(m_chunk);
+        m_chunk = std::shared_ptr<uchar>(mapped, [owner](uchar* address) {
+            QMutexLocker locker(&owner->mutex);
+            owner->file.unmap(address);
+        });
+        m_chunkUsed = 0;
+        m_chunkBytes = chunkBytes;
+    }
+
+    uchar* target = m_chunk.get() + m_chunkUsed;
+    std::memcpy(target, block.constData(), bytes);
+    m_chunkUsed += bytes;
+    m_file->written += bytes;
+
+    Curve::Segment segment;
+    segment.data = reinterpret_cast<const SensorData*>(target);
+    segment.size = block.size();
+    segment.owner = std::shared_ptr<const void>(m_chunk, target);
+
+    return segment;
+}
+
+qint64 CurveSpillFile::bytesWritten() const {
+    QMutexLocker locker(&m_file->mutex);
+    return m_file->written;
+}
+
+int CurveSpillFile::mappingCount() const {
+    QMutexLocker locker(&m_file->mutex);
+    return m_file->mappings;
+}
+
+QString CurveSpillFile::fileName() const {
+    QMutexLocker locker(&m_file->mutex);
+    return m_file->file.fileName();
+}
+
+} // namespace HorizonUTM
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <QString>
+#include <memory>
+#include "domain/interfaces/ICurveSpillStore.h"
+
+namespace HorizonUTM {
+
+/**
+ * @brief Spill store backed by a memory-mapped segment file
+ *
+ * Blocks are copied into a temporary file through mappings of
+ * MAP_CHUNK_BLOCKS blocks at a time, so spilled points live in the page
+ * cache instead of process memory and a long test needs few mappings. A
+ * chunk is unmapped once the store has moved on and no segment in it is
+ * left; the file is removed once the store and every segment it returned
+ * are gone. Thread-safe.
+ */
+class CurveSpillFile : public ICurveSpillStore {
+public:
+    /**
+     * @brief Blocks per mapped region of the file
+     */
+    static constexpr qint64 MAP_CHUNK_BLOCKS = 64;
+
+    /**
+     * @param directory Where to create the segment file (default: system temp)
+     */
+    explicit CurveSpillFile(const QString& directory = QString());
+    ~CurveSpillFile() override;
+
+    Curve::Segment spill(const Curve::Block& block) override;
+
+    /**
+     * @brief Bytes of points written to the segment file so far
+     */
+    qint64 bytesWritten() const;
+
+    /**
+     * @brief Mappings made so far
+     */
+    int mappingCount() const;
+
+    QString fileName() const;
+
+private:
+    struct File;
+    std::shared_ptr<File> m_file;
+
+    // Chunk being filled; segments share ownership of it
+    std::shared_ptr<uchar> m_chunk;
+    qint64 m_chunkUsed;
+    qint64 m_chunkBytes;
+};
+
+} // namespace HorizonUTM
@@ -5,6 +5,7 @@
 #include <QFile>
 #include <QTextStream>
 #include <QDir>
+#include <QThread>
 
 namespace HorizonUTM {
 
@@ -13,8 +14,16 @@ DatabaseManager& DatabaseManager::instance() {
     return instance;
 }
 
+namespace {
+
+// Wait for a concurrent writer (e.g. the finalizer thread) instead of failing
+constexpr const char* CONNECT_OPTIONS = "QSQLITE_BUSY_TIMEOUT=5000";
+
+} // namespace
+
 DatabaseManager::DatabaseManager()
-    : m_initialized(false)
+    : m_ownerThread(nullptr)
+    , m_initialized(false)
 {
 }
 
@@ -44,6 +53,8 @@ bool DatabaseManager::initialize(const QString& dbPath) {
     // Create database connection
     m_db = QSqlDatabase::addDatabase("QSQLITE");
     m_db.setDatabaseName(dbPath);
+    m_db.setConnectOptions(CONNECT_OPTIONS);
+    m_ownerThread = QThread::currentThread();
     
     if (!m_db.open()) {
         m_lastError = m_db.lastError().text();
@@ -82,7 +93,34 @@ bool DatabaseManager::isOpen() const {
 }
 
 QSqlDatabase DatabaseManager::database() const {
-    return m_db;
+    if (!m_ownerThread || QThread::currentThread() == m_ownerThread) {
+        return m_db;
+    }
+    return threadDatabase();
+}
+
+QSqlDatabase DatabaseManager::threadDatabase() const {
+    QThread* thread = QThread::currentThread();
+    const QString name = QString("horizon_thread_%1").arg(quintptr(thread), 0, 16);
+
+    if (QSqlDatabase::contains(name)) {
+        return QSqlDatabase::database(name);
+    }
+
+    QSqlDatabase db = QSqlDatabase::cloneDatabase(m_db.connectionName(), name);
+    if (!db.open()) {
+        LOG_ERROR(QString("Failed to open database for worker thread: %1").arg(db.lastError().text()));
+        return db;
+    }
+
+    // Runs on the finishing thread itself, the only one allowed to close it
+    QObject::connect(thread, &QThread::finished, thread, [name]() {
+        QSqlDatabase::database(name, false).close();
+        QSqlDatabase::removeDatabase(name);
+    }, Qt::DirectConnection);
+
+    LOG_DEBUG(QString("Opened database connection %1").arg(name));
+    return db;
 }
 
 QString DatabaseManager::lastError() const {
@@ -208,6 +246,48 @@ bool DatabaseManager::createTables() {
         return false;
     }
     
+    // Full-rate samples around the specimen break
+    QString breakPointsTable = R"(
+        CREATE TABLE IF NOT EXISTS test_break_points (
+            id INTEGER PRIMARY KEY AUTOINCREMENT,
+            test_id INTEGER NOT NULL,
+            timestamp INTEGER NOT NULL,
+            force REAL NOT NULL,
+            extension REAL NOT NULL,
+            stress REAL NOT NULL,
+            strain REAL NOT NULL,
+            temperature REAL,
+            FOREIGN KEY (test_id) REFERENCES tests(id) ON DELETE CASCADE
+        )
+    )";
+    
+    if (!query.exec(breakPointsTable)) {
+        m_lastError = query.lastError().text();
+        LOG_ERROR(QString("Failed to create break points table: %1").arg(m_lastError));
+        return false;
+    }
+    
+    // Unfiltered acquisition when a filter stage was active
+    QString rawPointsTable = R"(
+        CREATE TABLE IF NOT EXISTS test_raw_points (
+            id INTEGER PRIMARY KEY AUTOINCREMENT,
+            test_id INTEGER NOT NULL,
+            timestamp INTEGER NOT NULL,
+            force REAL NOT NULL,
+            extension REAL NOT NULL,
+            stress REAL NOT NULL,
+            strain REAL NOT NULL,
+            temperature REAL,
+            FOREIGN KEY (test_id) REFERENCES tests(id) ON DELETE CASCADE
+        )
+    )";
+    
+    if (!query.exec(rawPointsTable)) {
+        m_lastError = query.lastError().text();
+        LOG_ERROR(QString("Failed to create raw points table: %1").arg(m_lastError));
+        return false;
+    }
+    
     // Samples queue table
     QString samplesTable = R"(
         CREATE TABLE IF NOT EXISTS samples (
@@ -242,6 +322,8 @@ bool DatabaseManager::createIndexes() {
         "CREATE INDEX IF NOT EXISTS idx_tests_start_time ON tests(start_time)",
         "CREATE INDEX IF NOT EXISTS idx_data_points_test_id ON test_data_points(test_id)",
         "CREATE INDEX IF NOT EXISTS idx_data_points_timestamp ON test_data_points(timestamp)",
+        "CREATE INDEX IF NOT EXISTS idx_break_points_test_id ON test_break_points(test_id)",
+        "CREATE INDEX IF NOT EXISTS idx_raw_points_test_id ON test_raw_points(test_id)",
         "CREATE INDEX IF NOT EXISTS idx_samples_status ON samples(status)"
     };
     
@@ -4,6 +4,8 @@
 #include <QString>
 #include <QSqlError>
 
+class QThread;
+
 namespace HorizonUTM {
 
 /**
@@ -37,6 +39,11 @@ public:
     
     /**
      * @brief Get database instance
+     *
+     * A QSqlDatabase connection may only be used by the thread that opened
+     * it. Calls from other threads get a connection of their own, cloned
+     * from the main one on first use and closed when that thread finishes;
+     * worker threads must therefore be done before close().
      */
     QSqlDatabase database() const;
     
@@ -85,9 +92,15 @@ private:
      * @brief Create triggers
      */
     bool createTriggers();
+    
+    /**
+     * @brief Connection for the calling (non-owner) thread
+     */
+    QSqlDatabase threadDatabase() const;
 
 private:
     QSqlDatabase m_db;
+    QThread* m_ownerThread;
     QString m_lastError;
     bool m_initialized;
 };
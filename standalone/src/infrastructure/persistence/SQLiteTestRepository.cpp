@@ -1,13 +1,17 @@
 #include "SQLiteTestRepository.h"
 #include "DatabaseManager.h"
 #include "core/Logger.h"
+#include "core/LogThrottle.h"
 #include <QSqlQuery>
 #include <QSqlError>
+#include <QStringList>
 #include <QVariant>
 
 namespace HorizonUTM {
 
-SQLiteTestRepository::SQLiteTestRepository() {
+SQLiteTestRepository::SQLiteTestRepository(qint64 curveCacheBytes)
+    : m_curveCache(curveCacheBytes)
+{
     LOG_INFO("SQLiteTestRepository created");
 }
 
@@ -19,30 +23,75 @@ QSqlDatabase SQLiteTestRepository::getDatabase() const {
 
 bool SQLiteTestRepository::saveTest(const Test& test) {
     int testId = test.getId();
+    bool isNew = testId <= 0;
 
-    // If test has no ID, insert new
-    if (testId <= 0) {
+    // Nothing changed since the last save or load
+    if (!isNew && !test.hasUnsavedChanges()) {
+        return true;
+    }
+
+    QSqlDatabase db = getDatabase();
+    db.transaction();
+
+    if (isNew) {
         if (!insertTest(test, testId)) {
+            db.rollback();
             return false;
         }
-        const_cast<Test&>(test).setId(testId);
     } else {
-        // Update existing
+        // Only the changed column groups
         if (!updateTestInDb(test)) {
+            db.rollback();
             return false;
         }
-    }
 
-    // Save data points
-    if (!test.getData().isEmpty()) {
-        if (!saveDataPoints(testId, test.getData())) {
-            LOG_ERROR("Failed to save data points");
+        if (test.isDataReset() && !deleteDataPoints(testId)) {
+            db.rollback();
             return false;
         }
     }
 
-    LOG_INFO(QString("Test saved: ID=%1, Sample=%2")
-        .arg(testId).arg(test.getSampleName()));
+    // Cached curve is stale once points are added or replaced
+    const bool curveChanged = !isNew
+        && (test.isDataReset() || test.getPersistedCount() < test.getDataPointCount());
+
+    // Only points past the persisted watermark
+    int firstNew = isNew ? 0 : test.getPersistedCount();
+    if (!insertDataPoints(testId, test.getCurve(), firstNew)) {
+        LOG_ERROR("Failed to save data points");
+        db.rollback();
+        return false;
+    }
+
+    if ((test.getDirtyFields() & Test::DirtyBreakBurst) && !replaceBreakBurst(testId, test.getBreakBurst())) {
+        db.rollback();
+        return false;
+    }
+
+    if ((test.getDirtyFields() & Test::DirtyRawCurve) && !replaceRawCurve(testId, test.getRawCurve())) {
+        db.rollback();
+        return false;
+    }
+
+    if (!db.commit()) {
+        LOG_ERROR(QString("Failed to commit test: %1").arg(db.lastError().text()));
+        db.rollback();
+        return false;
+    }
+
+    // Only once committed: a reader on another connection still sees the old rows before
+    if (curveChanged) {
+        m_curveCache.invalidate(testId);
+    }
+
+    Test& saved = const_cast<Test&>(test);
+    if (isNew) {
+        saved.setId(testId);
+    }
+    saved.markPersisted();
+
+    LOG_INFO(QString("Test saved: ID=%1, Sample=%2, %3 new data points")
+        .arg(testId).arg(test.getSampleName()).arg(test.getDataPointCount() - firstNew));
 
     return true;
 }
@@ -106,54 +155,65 @@ bool SQLiteTestRepository::updateTest(const Test& test) {
 }
 
 bool SQLiteTestRepository::updateTestInDb(const Test& test) {
-    QSqlQuery query(getDatabase());
+    const quint32 dirty = test.getDirtyFields();
+    if (dirty == Test::DirtyNone) {
+        return true;
+    }
 
-    query.prepare(R"(
-        UPDATE tests SET
-            sample_name = :sample_name,
-            operator_name = :operator_name,
-            test_method = :test_method,
-            width = :width,
-            thickness = :thickness,
-            gauge_length = :gauge_length,
-            speed = :speed,
-            force_limit = :force_limit,
-            temperature = :temperature,
-            status = :status,
-            start_time = :start_time,
-            end_time = :end_time,
-            max_stress = :max_stress,
-            yield_stress = :yield_stress,
-            ultimate_stress = :ultimate_stress,
-            break_stress = :break_stress,
-            elastic_modulus = :elastic_modulus,
-            elongation_at_break = :elongation_at_break,
-            notes = :notes
-        WHERE id = :id
-    )");
+    QStringList assignments;
+    QVector<QPair<QString, QVariant>> values;
+    auto set = [&](const QString& column, const QVariant& value) {
+        assignments.append(QString("%1 = :%1").arg(column));
+        values.append(qMakePair(":" + column, value));
+    };
+
+    if (dirty & Test::DirtyIdentity) {
+        set("sample_name", test.getSampleName());
+        set("operator_name", test.getOperatorName());
+        set("test_method", test.getTestMethod());
+    }
+    if (dirty & Test::DirtyGeometry) {
+        set("width", test.getWidth());
+        set("thickness", test.getThickness());
+        set("gauge_length", test.getGaugeLength());
+    }
+    if (dirty & Test::DirtyParameters) {
+        set("speed", test.getSpeed());
+        set("force_limit", test.getForceLimit());
+        set("temperature", test.getTemperature());
+    }
+    if (dirty & Test::DirtyStatus) {
+        set("status", testStatusToString(test.getStatus()));
+    }
+    if (dirty & Test::DirtyTiming) {
+        set("start_time", test.getStartTime());
+        set("end_time", test.getEndTime());
+    }
+    if (dirty & Test::DirtyResults) {
+        const TestResult& result = test.getResult();
+        set("max_stress", result.maxStress);
+        set("yield_stress", result.yieldStress);
+        set("ultimate_stress", result.ultimateStress);
+        set("break_stress", result.breakStress);
+        set("elastic_modulus", result.elasticModulus);
+        set("elongation_at_break", result.elongationAtBreak);
+    }
+    if (dirty & Test::DirtyNotes) {
+        set("notes", test.getNotes());
+    }
 
-    query.bindValue(":id", test.getId());
-    query.bindValue(":sample_name", test.getSampleName());
-    query.bindValue(":operator_name", test.getOperatorName());
-    query.bindValue(":test_method", test.getTestMethod());
-    query.bindValue(":width", test.getWidth());
-    query.bindValue(":thickness", test.getThickness());
-    query.bindValue(":gauge_length", test.getGaugeLength());
-    query.bindValue(":speed", test.getSpeed());
-    query.bindValue(":force_limit", test.getForceLimit());
-    query.bindValue(":temperature", test.getTemperature());
-    query.bindValue(":status", testStatusToString(test.getStatus()));
-    query.bindValue(":start_time", test.getStartTime());
-    query.bindValue(":end_time", test.getEndTime());
+    // Nothing in the tests table, e.g. only the break burst changed
+    if (assignments.isEmpty()) {
+        return true;
+    }
 
-    const TestResult& result = test.getResult();
-    query.bindValue(":max_stress", result.maxStress);
-    query.bindValue(":yield_stress", result.yieldStress);
-    query.bindValue(":ultimate_stress", result.ultimateStress);
-    query.bindValue(":break_stress", result.breakStress);
-    query.bindValue(":elastic_modulus", result.elasticModulus);
-    query.bindValue(":elongation_at_break", result.elongationAtBreak);
-    query.bindValue(":notes", test.getNotes());
+    QSqlQuery query(getDatabase());
+    query.prepare(QString("UPDATE tests SET %1 WHERE id = :id").arg(assignments.join(", ")));
+
+    query.bindValue(":id", test.getId());
+    for (const auto& value : values) {
+        query.bindValue(value.first, value.second);
+    }
 
     if (!query.exec()) {
         LOG_ERROR(QString("Failed to update test: %1").arg(query.lastError().text()));
@@ -164,43 +224,55 @@ bool SQLiteTestRepository::updateTestInDb(const Test& test) {
 }
 
 bool SQLiteTestRepository::deleteTest(int testId) {
-    QSqlQuery query(getDatabase());
+    QSqlDatabase db = getDatabase();
+    db.transaction();
+
+    // Foreign keys are not enforced, so no cascade
+    if (!deleteDataPoints(testId) || !replaceBreakBurst(testId, QVector<SensorData>())
+        || !replaceRawCurve(testId, Curve())) {
+        db.rollback();
+        return false;
+    }
+
+    QSqlQuery query(db);
     query.prepare("DELETE FROM tests WHERE id = :id");
     query.bindValue(":id", testId);
 
     if (!query.exec()) {
         LOG_ERROR(QString("Failed to delete test: %1").arg(query.lastError().text()));
+        db.rollback();
         return false;
     }
 
+    if (!db.commit()) {
+        LOG_ERROR(QString("Failed to commit test deletion: %1").arg(db.lastError().text()));
+        db.rollback();
+        return false;
+    }
+
+    m_curveCache.invalidate(testId);
+
     LOG_INFO(QString("Test deleted: ID=%1").arg(testId));
     return true;
 }
 
 Test SQLiteTestRepository::getTest(int testId) {
-    qDebug() << "=== SQLiteTestRepository::getTest ===";
-    qDebug() << "=== Test ID:" << testId;
-
     QSqlQuery query(getDatabase());
     query.prepare("SELECT * FROM tests WHERE id = :id");
     query.bindValue(":id", testId);
 
     if (!query.exec() || !query.next()) {
         LOG_ERROR(QString("Failed to get test ID=%1").arg(testId));
-        qDebug() << "=== ERROR: Query failed or no results ===";
         return Test();
     }
 
-    qDebug() << "=== Test found, creating from query ===";
     Test test = testFromQuery(query);
 
-    qDebug() << "=== Calling getDataPoints ===";
     // Load data points
-    QVector<SensorData> data = getDataPoints(testId);
-    qDebug() << "=== Got" << data.size() << "data points ===";
-
-    test.setData(data);
-    qDebug() << "=== After setData, test has" << test.getDataPointCount() << "points ===";
+    test.setCurve(loadCurve(testId));
+    test.setBreakBurst(loadBreakBurst(testId));
+    test.setRawCurve(loadRawCurve(testId));
+    test.markPersisted();
 
     return test;
 }
@@ -295,6 +367,7 @@ Test SQLiteTestRepository::testFromQuery(const QSqlQuery& query) {
     test.setResult(result);
 
     test.setNotes(query.value("notes").toString());
+    test.markPersisted();
 
     return test;
 }
@@ -309,7 +382,28 @@ bool SQLiteTestRepository::saveDataPoints(int testId, const QVector<SensorData>&
     QSqlDatabase db = getDatabase();
     db.transaction();
 
-    QSqlQuery query(db);
+    if (!insertDataPoints(testId, Curve::fromVector(data), 0)) {
+        db.rollback();
+        return false;
+    }
+
+    if (!db.commit()) {
+        LOG_ERROR(QString("Failed to commit data points: %1").arg(db.lastError().text()));
+        db.rollback();
+        return false;
+    }
+    m_curveCache.invalidate(testId);
+    LOG_DEBUG(QString("Saved %1 data points for test ID=%2").arg(data.size()).arg(testId));
+
+    return true;
+}
+
+bool SQLiteTestRepository::insertDataPoints(int testId, const Curve& data, qsizetype from) {
+    if (from >= data.size()) {
+        return true;
+    }
+
+    QSqlQuery query(getDatabase());
     query.prepare(R"(
         INSERT INTO test_data_points (
             test_id, timestamp, time_seconds,
@@ -320,9 +414,11 @@ bool SQLiteTestRepository::saveDataPoints(int testId, const QVector<SensorData>&
         )
     )");
 
+    // Time is relative to the first point of the whole curve
     qint64 startTime = data.first().timestamp;
 
-    for (const auto& point : data) {
+    for (qsizetype i = from; i < data.size(); ++i) {
+        const SensorData& point = data.at(i);
         query.bindValue(":test_id", testId);
         query.bindValue(":timestamp", point.timestamp);
         query.bindValue(":time_seconds", (point.timestamp - startTime) / 1000.0);
@@ -334,31 +430,33 @@ bool SQLiteTestRepository::saveDataPoints(int testId, const QVector<SensorData>&
 
         if (!query.exec()) {
             LOG_ERROR(QString("Failed to save data point: %1").arg(query.lastError().text()));
-            db.rollback();
             return false;
         }
     }
 
-    db.commit();
-    LOG_DEBUG(QString("Saved %1 data points for test ID=%2").arg(data.size()).arg(testId));
-
     return true;
 }
 
 QVector<SensorData> SQLiteTestRepository::getDataPoints(int testId) {
-    QVector<SensorData> data;
+    // Shares the cached block, no copy
+    return loadCurve(testId).points();
+}
 
-    qDebug() << "=== SQLiteTestRepository::getDataPoints ===";
-    qDebug() << "=== Test ID:" << testId;
+Curve SQLiteTestRepository::loadCurve(int testId) {
+    Curve cached;
+    quint64 generation = 0;
+    if (m_curveCache.lookup(testId, cached, &generation)) {
+        return cached;
+    }
 
+    QVector<SensorData> data;
     QSqlQuery query(getDatabase());
     query.prepare("SELECT * FROM test_data_points WHERE test_id = :test_id ORDER BY timestamp");
     query.bindValue(":test_id", testId);
 
     if (!query.exec()) {
         LOG_ERROR(QString("Failed to get data points: %1").arg(query.lastError().text()));
-        qDebug() << "=== ERROR:" << query.lastError().text();
-        return data;
+        return Curve();
     }
 
     while (query.next()) {
@@ -373,9 +471,96 @@ QVector<SensorData> SQLiteTestRepository::getDataPoints(int testId) {
         data.append(point);
     }
 
-    qDebug() << "=== Loaded" << data.size() << "data points ===";
+    LOG_RATE_LIMITED(Debug, 10, 1000, QString("Loaded %1 data points for test ID=%2").arg(data.size()).arg(testId));
+
+    Curve curve = Curve::fromVector(data);
+    if (!curve.isEmpty()) {
+        // Skipped if a save invalidated the test while we read
+        m_curveCache.insertIfCurrent(testId, curve, generation);
+    }
+    return curve;
+}
+
+bool SQLiteTestRepository::replaceBreakBurst(int testId, const QVector<SensorData>& burst) {
+    return replacePoints("test_break_points", testId, Curve::fromVector(burst));
+}
+
+QVector<SensorData> SQLiteTestRepository::loadBreakBurst(int testId) {
+    return loadPoints("test_break_points", testId);
+}
+
+bool SQLiteTestRepository::replaceRawCurve(int testId, const Curve& curve) {
+    return replacePoints("test_raw_points", testId, curve);
+}
+
+Curve SQLiteTestRepository::loadRawCurve(int testId) {
+    return Curve::fromVector(loadPoints("test_raw_points", testId));
+}
+
+bool SQLiteTestRepository::replacePoints(const QString& table, int testId, const Curve& points) {
+    QSqlQuery query(getDatabase());
+    query.prepare(QString("DELETE FROM %1 WHERE test_id = :test_id").arg(table));
+    query.bindValue(":test_id", testId);
+
+    if (!query.exec()) {
+        LOG_ERROR(QString("Failed to delete from %1: %2").arg(table, query.lastError().text()));
+        return false;
+    }
+
+    if (points.isEmpty()) {
+        return true;
+    }
+
+    query.prepare(QString(R"(
+        INSERT INTO %1 (
+            test_id, timestamp, force, extension, stress, strain, temperature
+        ) VALUES (
+            :test_id, :timestamp, :force, :extension, :stress, :strain, :temperature
+        )
+    )").arg(table));
+
+    for (const SensorData& point : points) {
+        query.bindValue(":test_id", testId);
+        query.bindValue(":timestamp", point.timestamp);
+        query.bindValue(":force", point.force);
+        query.bindValue(":extension", point.extension);
+        query.bindValue(":stress", point.stress);
+        query.bindValue(":strain", point.strain);
+        query.bindValue(":temperature", point.temperature);
+
+        if (!query.exec()) {
+            LOG_ERROR(QString("Failed to save into %1: %2").arg(table, query.lastError().text()));
+            return false;
+        }
+    }
+
+    return true;
+}
+
+QVector<SensorData> SQLiteTestRepository::loadPoints(const QString& table, int testId) {
+    QVector<SensorData> points;
+    QSqlQuery query(getDatabase());
+    query.prepare(QString("SELECT * FROM %1 WHERE test_id = :test_id ORDER BY id").arg(table));
+    query.bindValue(":test_id", testId);
+
+    if (!query.exec()) {
+        LOG_ERROR(QString("Failed to read %1: %2").arg(table, query.lastError().text()));
+        return points;
+    }
+
+    while (query.next()) {
+        SensorData point;
+        point.timestamp = query.value("timestamp").toLongLong();
+        point.force = query.value("force").toDouble();
+        point.extension = query.value("extension").toDouble();
+        point.stress = query.value("stress").toDouble();
+        point.strain = query.value("strain").toDouble();
+        point.temperature = query.value("temperature").toDouble();
+
+        points.append(point);
+    }
 
-    return data;
+    return points;
 }
 
 bool SQLiteTestRepository::deleteDataPoints(int testId) {
@@ -388,6 +573,8 @@ bool SQLiteTestRepository::deleteDataPoints(int testId) {
         return false;
     }
 
+    // Inside saveTest/deleteTest this is before the commit, which invalidates again
+    m_curveCache.invalidate(testId);
     return true;
 }
 
@@ -4,16 +4,24 @@
 #include "domain/entities/Test.h"
 #include "domain/entities/Sample.h"
 #include "domain/value_objects/SensorData.h"
+#include "CurveCache.h"
+#include "core/Constants.h"
 #include <QSqlDatabase>
 
 namespace HorizonUTM {
 
 /**
  * @brief SQLite implementation of test repository
+ *
+ * Saving an existing test is incremental: only the column groups the Test
+ * marks dirty are updated and only data points past its persisted
+ * watermark are inserted, so metadata updates cost the same for any
+ * curve length. Loaded curves are kept in an LRU CurveCache so reopening
+ * a recent test does not read its points from SQLite again.
  */
 class SQLiteTestRepository : public ITestRepository {
 public:
-    explicit SQLiteTestRepository();
+    explicit SQLiteTestRepository(qint64 curveCacheBytes = Constants::DEFAULT_CURVE_CACHE_MB * 1024 * 1024);
     ~SQLiteTestRepository() override = default;
     
     // Test operations
@@ -43,6 +51,10 @@ public:
     // Statistics
     int getTestCount() override;
     int getTestCountByStatus(TestStatus status) override;
+    
+    // Curve cache
+    CurveCache::Stats getCurveCacheStats() const { return m_curveCache.stats(); }
+    void setCurveCacheBudget(qint64 bytes) { m_curveCache.setBudget(bytes); }
 
 private:
     /**
@@ -50,16 +62,47 @@ private:
      */
     QSqlDatabase getDatabase() const;
     
+    /**
+     * @brief Curve of a test, from the cache or the database
+     */
+    Curve loadCurve(int testId);
+    
     /**
      * @brief Convert Test entity to database row
      */
     bool insertTest(const Test& test, int& outId);
     
     /**
-     * @brief Update existing test in database
+     * @brief Update the test's dirty column groups in database
      */
     bool updateTestInDb(const Test& test);
     
+    /**
+     * @brief Insert data[from..] without opening a transaction
+     */
+    bool insertDataPoints(int testId, const Curve& data, qsizetype from);
+    
+    /**
+     * @brief Replace the stored break burst without opening a transaction
+     */
+    bool replaceBreakBurst(int testId, const QVector<SensorData>& burst);
+    
+    QVector<SensorData> loadBreakBurst(int testId);
+    
+    /**
+     * @brief Replace the stored unfiltered curve without opening a transaction
+     */
+    bool replaceRawCurve(int testId, const Curve& curve);
+    
+    Curve loadRawCurve(int testId);
+    
+    /**
+     * @brief Replace a test's rows in a point table (break or raw points)
+     */
+    bool replacePoints(const QString& table, int testId, const Curve& points);
+    
+    QVector<SensorData> loadPoints(const QString& table, int testId);
+    
     /**
      * @brief Convert database row to Test entity
      */
@@ -74,6 +117,8 @@ private:
      * @brief Convert database row to Sample entity
      */
     Sample sampleFromQuery(const QSqlQuery& query);
+    
+    CurveCache m_curveCache;
 };
 
 } // namespace HorizonUTM
@@ -1,13 +1,18 @@
 // Horizon UTM - Main Entry Point
 #include <QApplication>
+#include <QCommandLineParser>
 #include "presentation/MainWindow.h"
 #include "application/controllers/TestController.h"
 #include "application/controllers/HardwareController.h"
+#include "application/controllers/FrameManager.h"
 #include "application/controllers/DataExportController.h"
 #include "infrastructure/hardware/MockUTMDriver.h"
+#include "infrastructure/hardware/ReplayUTMDriver.h"
 #include "infrastructure/persistence/DatabaseManager.h"
 #include "infrastructure/persistence/SQLiteTestRepository.h"
+#include "infrastructure/persistence/CurveSpillFile.h"
 #include "infrastructure/export/CSVExportService.h"
+#include "infrastructure/export/BinaryExportService.h"
 #include "core/Logger.h"
 #include "core/Config.h"
 
@@ -21,6 +26,23 @@ int main(int argc, char *argv[]) {
     app.setApplicationName("Horizon UTM");
     app.setApplicationVersion("1.0.0 MVP");
     
+    // Command line: optional replay of a recorded curve instead of the simulator
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Horizon UTM");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    QCommandLineOption replayOption("replay",
+        "Replay a recorded curve (*.csv or *.hzb) instead of the simulated machine.", "file");
+    QCommandLineOption replaySpeedOption("replay-speed",
+        "Replay speed factor, or \"max\" to replay as fast as possible (default 1).", "factor", "1");
+    QCommandLineOption simSpeedOption("sim-speed",
+        "Simulated machine speed factor, or \"max\" to run as fast as the data is consumed (default 1).",
+        "factor", "1");
+    parser.addOption(replayOption);
+    parser.addOption(replaySpeedOption);
+    parser.addOption(simSpeedOption);
+    parser.process(app);
+    
     // Initialize logger
     Logger::initialize(LogLevel::Debug);
     LOG_INFO("=== Horizon UTM Starting ===");
@@ -39,17 +61,95 @@ int main(int argc, char *argv[]) {
     LOG_INFO("Database initialized");
     
     // Create infrastructure components (all through new for proper initialization)
-    MockUTMDriver* utmDriver = new MockUTMDriver();
-    SQLiteTestRepository* repository = new SQLiteTestRepository();
+    IUTMDriver* utmDriver = nullptr;
+    if (parser.isSet(replayOption)) {
+        ReplayUTMDriver* replayDriver = new ReplayUTMDriver();
+        if (!replayDriver->loadRecording(parser.value(replayOption))) {
+            LOG_ERROR("Failed to load replay recording");
+            delete replayDriver;
+            return 1;
+        }
+        
+        QString speed = parser.value(replaySpeedOption);
+        double factor = speed.toDouble();
+        if (speed == "max") {
+            replayDriver->setReplayMode(ReplayMode::AsFastAsPossible);
+        } else if (factor > 0 && factor != 1.0) {
+            replayDriver->setReplayMode(ReplayMode::Accelerated, factor);
+        }
+        utmDriver = replayDriver;
+    } else {
+        // Simulated machine, optionally running faster than real time
+        MockUTMDriver* mockDriver = new MockUTMDriver();
+        QString speed = parser.value(simSpeedOption);
+        double factor = speed.toDouble();
+        if (speed == "max") {
+            mockDriver->setSimulationMode(SimulationMode::AsFastAsConsumed);
+        } else if (factor > 0 && factor != 1.0) {
+            mockDriver->setSimulationMode(SimulationMode::Accelerated, factor);
+        }
+        utmDriver = mockDriver;
+    }
+    SQLiteTestRepository* repository = new SQLiteTestRepository(
+        qint64(config.getCurveCacheSizeMB()) * 1024 * 1024);
     CSVExportService* csvExporter = new CSVExportService();
+    BinaryExportService* binaryExporter = new BinaryExportService();
     
     // Create application controllers
     TestController* testController = new TestController(repository);
-    HardwareController* hardwareController = new HardwareController(utmDriver, testController);
+    if (config.getModulusMethod() == "best_fit") {
+        testController->setModulusMethod(ModulusMethod::BestFitWindow);
+    } else if (config.getModulusMethod() == "chord") {
+        testController->setModulusMethod(ModulusMethod::Chord);
+    }
+    
+    // One frame, driven by the GUI; further frames need UI of their own first
+    FrameManager* frameManager = new FrameManager(testController);
+    frameManager->addFrame(utmDriver, "Frame 1", false);
+    const QString spillDirectory = config.getAppDataPath() + "/spill";
+    frameManager->setLiveBufferBudget(
+        qint64(config.getLiveBufferSizeMB()) * 1024 * 1024,
+        [spillDirectory]() { return std::make_shared<CurveSpillFile>(spillDirectory); });
+    
+    FilterSettings filter;
+    filter.type = filterTypeFromString(config.getFilterType());
+    filter.windowSize = config.getFilterWindow();
+    filter.cutoffHz = config.getFilterCutoffHz();
+    // Each frame designs it for its driver's sample rate
+    frameManager->setFilter(filter);
+    
+    RecordingSettings recording;
+    recording.enabled = config.isRecordingDeadbandEnabled();
+    recording.forceDeadband = config.getRecordingForceDeadband();
+    recording.extensionDeadband = config.getRecordingExtensionDeadband();
+    recording.maxIntervalMs = config.getRecordingMaxIntervalMs();
+    recording.eventWindowMs = config.getRecordingEventWindowMs();
+    recording.maxEventDelayMs = config.getRecordingMaxEventDelayMs();
+    recording.peakDropPercent = config.getRecordingPeakDropPercent();
+    recording.yieldSlopeRatio = config.getRecordingYieldSlopeRatio();
+    frameManager->setRecordingPolicy(recording);
+    
+    BreakCaptureSettings breakCapture;
+    breakCapture.enabled = config.isBreakCaptureEnabled();
+    breakCapture.preTriggerMs = config.getBreakPreTriggerMs();
+    breakCapture.postTriggerMs = config.getBreakPostTriggerMs();
+    frameManager->setBreakCapture(breakCapture);
+    
+    // The break the capture and the recording policy both act on
+    BreakDetectorSettings breakDetector;
+    breakDetector.forceDropPercent = config.getBreakForceDropPercent();
+    breakDetector.forceRateLimit = config.getBreakForceRateLimit();
+    breakDetector.minForce = config.getBreakMinForce();
+    frameManager->setBreakDetector(breakDetector);
+    HardwareController* hardwareController = frameManager->frame(0);
     DataExportController* exportController = new DataExportController();
     
     // Register export services
     exportController->registerExportService(csvExporter);
+    exportController->registerExportService(binaryExporter);
+    
+    // Export workers load stored tests themselves, on their own connections
+    exportController->setTestLoader([repository](int testId) { return repository->getTest(testId); });
     
     // Create and show main window
     MainWindow* mainWindow = new MainWindow(testController, hardwareController, exportController);
@@ -64,15 +164,16 @@ int main(int argc, char *argv[]) {
     
     delete mainWindow;
     delete exportController;
-    delete hardwareController;
+    delete frameManager;
     delete testController;
+    delete binaryExporter;
     delete csvExporter;
     delete repository;
-    delete utmDriver;
     
     dbManager.close();
     
     LOG_INFO("=== Horizon UTM Stopped ===");
+    Logger::instance().shutdown();
     
     return result;
 }
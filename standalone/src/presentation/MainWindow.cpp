@@ -7,6 +7,7 @@
 #include "application/controllers/TestController.h"
 #include "application/controllers/HardwareController.h"
 #include "application/controllers/DataExportController.h"
+#include "application/controllers/SampleQueueRunner.h"
 #include "core/Logger.h"
 
 #include <QMenuBar>
@@ -14,6 +15,7 @@
 #include <QStatusBar>
 #include <QMessageBox>
 #include <QFileDialog>
+#include <QFileInfo>
 #include <QCloseEvent>
 
 namespace HorizonUTM {
@@ -26,6 +28,7 @@ MainWindow::MainWindow(TestController* testController,
     , m_testController(testController)
     , m_hardwareController(hardwareController)
     , m_exportController(exportController)
+    , m_queueRunner(nullptr)
     , m_stackedWidget(nullptr)
     , m_dashboardView(nullptr)
     , m_sampleQueueView(nullptr)
@@ -58,8 +61,9 @@ void MainWindow::setupUi() {
     
     // Create views
     m_dashboardView = new DashboardView(m_testController, m_hardwareController, this);
-    m_sampleQueueView = new SampleQueueView(m_testController, this);
-    m_resultsView = new ResultsView(m_testController, this);
+    m_queueRunner = new SampleQueueRunner(m_hardwareController, m_testController, m_exportController, this);
+    m_sampleQueueView = new SampleQueueView(m_testController, m_queueRunner, this);
+    m_resultsView = new ResultsView(m_testController, m_exportController, this);
     
     // Add views to stack
     m_stackedWidget->addWidget(m_dashboardView);
@@ -84,6 +88,9 @@ void MainWindow::setupMenuBar() {
     m_exportAction->setShortcut(QKeySequence("Ctrl+E"));
     connect(m_exportAction, &QAction::triggered, this, &MainWindow::onExportData);
     
+    m_exportFolderAction = fileMenu->addAction("Export Tests to &Folder...");
+    connect(m_exportFolderAction, &QAction::triggered, this, &MainWindow::onExportToFolder);
+    
     fileMenu->addSeparator();
     
     m_exitAction = fileMenu->addAction("E&xit");
@@ -186,8 +193,16 @@ void MainWindow::setupConnections() {
             this, &MainWindow::onTestStarted);
     connect(m_hardwareController, &HardwareController::testCompleted,
             this, &MainWindow::onTestCompleted);
+    connect(m_hardwareController, &HardwareController::testStopped,
+            this, &MainWindow::onTestStopped);
+    connect(m_hardwareController, &HardwareController::testFinalized,
+            this, &MainWindow::onTestFinalized);
     connect(m_hardwareController, &HardwareController::machineStateChanged,
             this, &MainWindow::onMachineStateChanged);
+    
+    // Background export jobs
+    connect(m_exportController, &DataExportController::exportJobFinished,
+            this, &MainWindow::onExportJobFinished);
 }
 
 void MainWindow::updateActions() {
@@ -269,27 +284,84 @@ void MainWindow::onZeroSensors() {
 }
 
 void MainWindow::onExportData() {
+    QStringList filters;
+    for (const QString& format : m_exportController->getAvailableFormats()) {
+        filters << m_exportController->getFileTypeDescription(format);
+    }
+    
     QString fileName = QFileDialog::getSaveFileName(this,
                                                     "Export Test Data",
                                                     "",
-                                                    "CSV Files (*.csv)");
+                                                    filters.join(";;"));
     
     if (fileName.isEmpty()) {
         return;
     }
     
-    // Get all completed tests
-    QVector<Test> tests = m_testController->getTestsByStatus(TestStatus::Completed);
+    // Summaries only; the export worker loads the curves
+    QVector<int> testIds;
+    for (const Test& summary : m_testController->getTestsByStatus(TestStatus::Completed)) {
+        testIds.append(summary.getId());
+    }
     
-    if (tests.isEmpty()) {
+    if (testIds.isEmpty()) {
         QMessageBox::information(this, "Export", "No completed tests to export");
         return;
     }
     
-    if (m_exportController->exportTests(tests, fileName, "csv")) {
-        QMessageBox::information(this, "Export", "Data exported successfully");
-    } else {
+    QString format = QFileInfo(fileName).suffix().toLower();
+    if (!m_exportController->getAvailableFormats().contains(format)) {
+        format = "csv";
+    }
+    
+    // Export runs in the background; completion is reported by onExportJobFinished
+    if (m_exportController->submitExport(testIds, fileName, format) < 0) {
+        QMessageBox::critical(this, "Export Error", "Failed to export data");
+        return;
+    }
+    
+    m_statusLabel->setText(QString("Exporting %1 tests...").arg(testIds.size()));
+}
+
+void MainWindow::onExportToFolder() {
+    QString dirPath = QFileDialog::getExistingDirectory(this, "Export Tests to Folder");
+    
+    if (dirPath.isEmpty()) {
+        return;
+    }
+    
+    // Per-test files need the curves; the export worker loads them
+    QVector<int> testIds;
+    for (const Test& summary : m_testController->getTestsByStatus(TestStatus::Completed)) {
+        testIds.append(summary.getId());
+    }
+    
+    if (testIds.isEmpty()) {
+        QMessageBox::information(this, "Export", "No completed tests to export");
+        return;
+    }
+    
+    if (m_exportController->submitBundleExport(testIds, dirPath, "csv") < 0) {
         QMessageBox::critical(this, "Export Error", "Failed to export data");
+        return;
+    }
+    
+    m_statusLabel->setText(QString("Exporting %1 tests to folder...").arg(testIds.size()));
+}
+
+void MainWindow::onExportJobFinished(int jobId, ExportJobState state, const QString& filePath) {
+    Q_UNUSED(jobId);
+    
+    switch (state) {
+        case ExportJobState::Completed:
+            m_statusLabel->setText(QString("Data exported: %1").arg(filePath));
+            break;
+        case ExportJobState::Cancelled:
+            m_statusLabel->setText("Export cancelled");
+            break;
+        default:
+            m_statusLabel->setText(QString("Export failed: %1").arg(filePath));
+            break;
     }
 }
 
@@ -320,6 +392,19 @@ void MainWindow::onTestCompleted() {
     QMessageBox::information(this, "Test Complete", "Test completed successfully");
 }
 
+void MainWindow::onTestStopped() {
+    m_statusLabel->setText("Test stopped");
+    updateActions();
+}
+
+void MainWindow::onTestFinalized(int testId, bool saved) {
+    if (saved) {
+        m_statusLabel->setText(QString("Test %1 saved").arg(testId));
+    } else {
+        m_statusLabel->setText(QString("Failed to save test %1").arg(testId));
+    }
+}
+
 void MainWindow::onMachineStateChanged() {
     updateActions();
 }
@@ -338,6 +423,19 @@ void MainWindow::closeEvent(QCloseEvent* event) {
         m_hardwareController->stopTest();
     }
     
+    if (m_exportController->activeExportCount() > 0) {
+        auto result = QMessageBox::question(this, "Exit",
+                                           "Exports are still running. Cancel them and exit?",
+                                           QMessageBox::Yes | QMessageBox::No);
+        
+        if (result == QMessageBox::No) {
+            event->ignore();
+            return;
+        }
+        
+        m_exportController->cancelAllExports();
+    }
+    
     LOG_INFO("Application closing");
     event->accept();
 }
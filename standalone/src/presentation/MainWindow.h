@@ -6,6 +6,7 @@
 #include <QStatusBar>
 #include <QLabel>
 #include <memory>
+#include "application/controllers/DataExportController.h"
 
 namespace HorizonUTM {
 
@@ -15,7 +16,7 @@ class ResultsView;
 class SettingsDialog;
 class TestController;
 class HardwareController;
-class DataExportController;
+class SampleQueueRunner;
 class StatusIndicator;
 
 /**
@@ -49,13 +50,17 @@ private slots:
     void onPauseTest();
     void onZeroSensors();
     void onExportData();
+    void onExportToFolder();
     
     // Status updates
     void onHardwareConnected();
     void onHardwareDisconnected();
     void onTestStarted();
     void onTestCompleted();
+    void onTestStopped();
+    void onTestFinalized(int testId, bool saved);
     void onMachineStateChanged();
+    void onExportJobFinished(int jobId, ExportJobState state, const QString& filePath);
 
 private:
     void setupUi();
@@ -70,6 +75,7 @@ private:
     TestController* m_testController;
     HardwareController* m_hardwareController;
     DataExportController* m_exportController;
+    SampleQueueRunner* m_queueRunner;
     
     // Views
     QStackedWidget* m_stackedWidget;
@@ -91,6 +97,7 @@ private:
     QAction* m_pauseTestAction;
     QAction* m_zeroAction;
     QAction* m_exportAction;
+    QAction* m_exportFolderAction;
     QAction* m_dashboardAction;
     QAction* m_sampleQueueAction;
     QAction* m_resultsAction;
@@ -8,17 +8,24 @@
 #include <QHeaderView>
 #include <QMessageBox>
 #include <QFileDialog>
+#include <QFileInfo>
 
 namespace HorizonUTM {
 
-ResultsView::ResultsView(TestController* testController, QWidget* parent)
+ResultsView::ResultsView(TestController* testController,
+                         DataExportController* exportController,
+                         QWidget* parent)
     : QWidget(parent)
     , m_testController(testController)
+    , m_exportController(exportController)
     , m_tableWidget(nullptr)
     , m_viewDetailsBtn(nullptr)
     , m_deleteBtn(nullptr)
     , m_exportBtn(nullptr)
     , m_refreshBtn(nullptr)
+    , m_exportStatusLabel(nullptr)
+    , m_exportProgressBar(nullptr)
+    , m_cancelExportBtn(nullptr)
 {
     setupUI();
     setupConnections();
@@ -71,6 +78,21 @@ void ResultsView::setupUI() {
 
     buttonLayout->addStretch();
 
+    // Background export status (hidden while no export is running)
+    m_exportStatusLabel = new QLabel(this);
+    m_exportStatusLabel->setVisible(false);
+    buttonLayout->addWidget(m_exportStatusLabel);
+
+    m_exportProgressBar = new QProgressBar(this);
+    m_exportProgressBar->setRange(0, 100);
+    m_exportProgressBar->setMaximumWidth(200);
+    m_exportProgressBar->setVisible(false);
+    buttonLayout->addWidget(m_exportProgressBar);
+
+    m_cancelExportBtn = new QPushButton("Cancel Export", this);
+    m_cancelExportBtn->setVisible(false);
+    buttonLayout->addWidget(m_cancelExportBtn);
+
     m_refreshBtn = new QPushButton("Refresh", this);
     buttonLayout->addWidget(m_refreshBtn);
 
@@ -96,6 +118,15 @@ void ResultsView::setupConnections() {
 
     connect(m_refreshBtn, &QPushButton::clicked,
             this, &ResultsView::onRefresh);
+
+    connect(m_cancelExportBtn, &QPushButton::clicked,
+            this, &ResultsView::onCancelExport);
+
+    connect(m_exportController, &DataExportController::exportProgress,
+            this, &ResultsView::onExportProgress);
+
+    connect(m_exportController, &DataExportController::exportJobFinished,
+            this, &ResultsView::onExportJobFinished);
 }
 
 void ResultsView::loadTests() {
@@ -174,15 +205,11 @@ void ResultsView::onViewDetails() {
     int testId = getSelectedTestId();
     if (testId < 0) return;
 
-    qDebug() << "=== ResultsView::onViewDetails ===";
-    qDebug() << "=== Loading test ID:" << testId;
-
     // Load full test data including data points
     Test fullTest = m_testController->getTest(testId);
 
-    qDebug() << "=== Loaded test ID:" << fullTest.getId();
-    qDebug() << "=== Sample name:" << fullTest.getSampleName();
-    qDebug() << "=== Data points:" << fullTest.getDataPointCount();
+    LOG_DEBUG(QString("Loaded test ID=%1 (%2) with %3 points for details")
+        .arg(fullTest.getId()).arg(fullTest.getSampleName()).arg(fullTest.getDataPointCount()));
 
     if (fullTest.getId() < 0) {
         QMessageBox::warning(this, "Error", "Failed to load test data");
@@ -223,14 +250,74 @@ void ResultsView::onExportTest() {
         this,
         "Export Test Data",
         QString("test_%1.csv").arg(testId),
-        "CSV Files (*.csv)"
+        buildExportFilter()
     );
 
-    if (!fileName.isEmpty()) {
-        // TODO: Export single test to CSV
-        QMessageBox::information(this, "Export",
-            "Single test export will be implemented in Phase 2.1");
+    if (fileName.isEmpty()) {
+        return;
+    }
+
+    QString format = QFileInfo(fileName).suffix().toLower();
+    if (!m_exportController->getAvailableFormats().contains(format)) {
+        format = "csv";
+    }
+
+    // The export worker loads the curve; the view stays usable meanwhile
+    int jobId = m_exportController->submitExport(QVector<int>{testId}, fileName, format);
+    if (jobId < 0) {
+        QMessageBox::critical(this, "Export Error", "Failed to start export");
+        return;
+    }
+
+    m_activeExportJobs.append(jobId);
+    m_exportProgressBar->setValue(0);
+    updateExportStatus();
+}
+
+void ResultsView::onCancelExport() {
+    for (int jobId : m_activeExportJobs) {
+        m_exportController->cancelExport(jobId);
+    }
+}
+
+void ResultsView::onExportProgress(int jobId, int completed, int total) {
+    if (!m_activeExportJobs.contains(jobId) || total <= 0) {
+        return;
+    }
+
+    m_exportProgressBar->setValue((completed * 100) / total);
+}
+
+void ResultsView::onExportJobFinished(int jobId, ExportJobState state, const QString& filePath) {
+    if (!m_activeExportJobs.removeOne(jobId)) {
+        return;
+    }
+
+    updateExportStatus();
+
+    if (state == ExportJobState::Failed) {
+        QMessageBox::critical(this, "Export Error",
+            QString("Failed to export data to:\n%1").arg(filePath));
+    } else if (state == ExportJobState::Completed) {
+        LOG_INFO(QString("Export finished: %1").arg(filePath));
+    }
+}
+
+void ResultsView::updateExportStatus() {
+    bool exporting = !m_activeExportJobs.isEmpty();
+
+    m_exportStatusLabel->setText(QString("Exporting (%1)...").arg(m_activeExportJobs.size()));
+    m_exportStatusLabel->setVisible(exporting);
+    m_exportProgressBar->setVisible(exporting);
+    m_cancelExportBtn->setVisible(exporting);
+}
+
+QString ResultsView::buildExportFilter() const {
+    QStringList filters;
+    for (const QString& format : m_exportController->getAvailableFormats()) {
+        filters << m_exportController->getFileTypeDescription(format);
     }
+    return filters.join(";;");
 }
 
 void ResultsView::onRefresh() {
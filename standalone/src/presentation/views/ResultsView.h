@@ -3,8 +3,11 @@
 #include <QWidget>
 #include <QTableWidget>
 #include <QPushButton>
+#include <QProgressBar>
+#include <QLabel>
 #include <QDateTime>
 #include "domain/entities/Test.h"
+#include "application/controllers/DataExportController.h"
 
 namespace HorizonUTM {
 
@@ -17,7 +20,9 @@ class ResultsView : public QWidget {
     Q_OBJECT
 
 public:
-    explicit ResultsView(TestController* testController, QWidget* parent = nullptr);
+    explicit ResultsView(TestController* testController,
+                         DataExportController* exportController,
+                         QWidget* parent = nullptr);
     
     /**
      * @brief Refresh the test list
@@ -30,17 +35,23 @@ private slots:
     void onExportTest();
     void onRefresh();
     void onSelectionChanged();
+    void onCancelExport();
+    void onExportProgress(int jobId, int completed, int total);
+    void onExportJobFinished(int jobId, ExportJobState state, const QString& filePath);
 
 private:
     void setupUI();
     void setupConnections();
     void loadTests();
     void updateButtonStates();
+    void updateExportStatus();
+    QString buildExportFilter() const;
     
     int getSelectedTestId() const;
     
 private:
     TestController* m_testController;
+    DataExportController* m_exportController;
     
     // UI Components
     QTableWidget* m_tableWidget;
@@ -49,6 +60,12 @@ private:
     QPushButton* m_exportBtn;
     QPushButton* m_refreshBtn;
     
+    // Background export status
+    QLabel* m_exportStatusLabel;
+    QProgressBar* m_exportProgressBar;
+    QPushButton* m_cancelExportBtn;
+    QList<int> m_activeExportJobs;
+    
     QList<Test> m_tests;
 };
 
@@ -1,18 +1,132 @@
 #include "SampleQueueView.h"
+#include "application/controllers/TestController.h"
+
 #include <QVBoxLayout>
-#include <QLabel>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QMessageBox>
 
 namespace HorizonUTM {
 
-SampleQueueView::SampleQueueView(TestController* testController, QWidget* parent)
+SampleQueueView::SampleQueueView(TestController* testController,
+                                 SampleQueueRunner* queueRunner,
+                                 QWidget* parent)
     : QWidget(parent)
     , m_testController(testController)
+    , m_queueRunner(queueRunner)
+    , m_tableWidget(nullptr)
+    , m_runBtn(nullptr)
+    , m_cancelBtn(nullptr)
+    , m_refreshBtn(nullptr)
+    , m_statusLabel(nullptr)
 {
-    QVBoxLayout* layout = new QVBoxLayout(this);
-    
-    QLabel* label = new QLabel("Sample Queue View - Full UI in Phase 6", this);
-    label->setAlignment(Qt::AlignCenter);
-    layout->addWidget(label);
+    setupUI();
+
+    connect(m_runBtn, &QPushButton::clicked, this, &SampleQueueView::onRunBatch);
+    connect(m_cancelBtn, &QPushButton::clicked, this, &SampleQueueView::onCancelBatch);
+    connect(m_refreshBtn, &QPushButton::clicked, this, &SampleQueueView::refreshQueue);
+    connect(m_queueRunner, &SampleQueueRunner::specimenFinished,
+            this, &SampleQueueView::onSpecimenFinished);
+    connect(m_queueRunner, &SampleQueueRunner::batchFinished,
+            this, &SampleQueueView::onBatchFinished);
+
+    refreshQueue();
+}
+
+void SampleQueueView::setupUI() {
+    QVBoxLayout* mainLayout = new QVBoxLayout(this);
+    mainLayout->setContentsMargins(10, 10, 10, 10);
+
+    m_tableWidget = new QTableWidget(this);
+    m_tableWidget->setColumnCount(5);
+    m_tableWidget->setHorizontalHeaderLabels({
+        "ID", "Sample", "Geometry (mm)", "Method", "Operator"
+    });
+    m_tableWidget->setSelectionMode(QAbstractItemView::NoSelection);
+    m_tableWidget->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_tableWidget->horizontalHeader()->setStretchLastSection(true);
+    m_tableWidget->horizontalHeader()->setSectionResizeMode(1, QHeaderView::Stretch);
+    m_tableWidget->verticalHeader()->setVisible(false);
+    m_tableWidget->setAlternatingRowColors(true);
+    mainLayout->addWidget(m_tableWidget);
+
+    QHBoxLayout* buttonLayout = new QHBoxLayout();
+
+    m_runBtn = new QPushButton("Run Batch", this);
+    buttonLayout->addWidget(m_runBtn);
+
+    m_cancelBtn = new QPushButton("Cancel Batch", this);
+    buttonLayout->addWidget(m_cancelBtn);
+
+    buttonLayout->addStretch();
+
+    m_refreshBtn = new QPushButton("Refresh", this);
+    buttonLayout->addWidget(m_refreshBtn);
+
+    mainLayout->addLayout(buttonLayout);
+
+    m_statusLabel = new QLabel(this);
+    m_statusLabel->setWordWrap(true);
+    mainLayout->addWidget(m_statusLabel);
+
+    updateButtonStates();
+}
+
+void SampleQueueView::refreshQueue() {
+    QVector<Sample> samples = m_testController->getSamplesByStatus(SampleStatus::Ready);
+
+    m_tableWidget->setRowCount(samples.size());
+    for (int row = 0; row < samples.size(); ++row) {
+        const Sample& sample = samples[row];
+        m_tableWidget->setItem(row, 0, new QTableWidgetItem(QString::number(sample.getId())));
+        m_tableWidget->setItem(row, 1, new QTableWidgetItem(sample.getName()));
+        m_tableWidget->setItem(row, 2, new QTableWidgetItem(QString("%1 × %2, L0 %3")
+            .arg(sample.getWidth()).arg(sample.getThickness()).arg(sample.getGaugeLength())));
+        m_tableWidget->setItem(row, 3, new QTableWidgetItem(sample.getTestMethod()));
+        m_tableWidget->setItem(row, 4, new QTableWidgetItem(sample.getOperatorName()));
+    }
+
+    if (!m_queueRunner->isRunning()) {
+        m_statusLabel->setText(QString("%1 samples ready").arg(samples.size()));
+    }
+    updateButtonStates();
+}
+
+void SampleQueueView::onRunBatch() {
+    if (!m_queueRunner->startBatch()) {
+        QMessageBox::warning(this, "Run Batch",
+                             "Cannot start the batch. Connect the hardware, make sure no test "
+                             "is running and that samples are ready.");
+        return;
+    }
+
+    m_statusLabel->setText(QString("Running batch: %1 specimens left")
+        .arg(m_queueRunner->remainingCount()));
+    updateButtonStates();
+}
+
+void SampleQueueView::onCancelBatch() {
+    m_queueRunner->cancel();
+    updateButtonStates();
+}
+
+void SampleQueueView::onSpecimenFinished(int /*sampleId*/, int /*testId*/, bool /*success*/) {
+    const BatchReport& report = m_queueRunner->report();
+    m_statusLabel->setText(QString("Running batch: %1 done, %2 failed, %3 specimens left")
+        .arg(report.completed).arg(report.failed).arg(m_queueRunner->remainingCount()));
+    refreshQueue();
+}
+
+void SampleQueueView::onBatchFinished(const BatchReport& report) {
+    refreshQueue();
+    m_statusLabel->setText("Batch finished: " + report.toString());
+}
+
+void SampleQueueView::updateButtonStates() {
+    bool running = m_queueRunner->isRunning();
+    m_runBtn->setEnabled(!running && m_tableWidget->rowCount() > 0);
+    m_cancelBtn->setEnabled(running);
+    m_refreshBtn->setEnabled(!running);
 }
 
 } // namespace HorizonUTM
@@ -1,19 +1,50 @@
 #pragma once
 
 #include <QWidget>
+#include <QTableWidget>
+#include <QPushButton>
+#include <QLabel>
+#include "application/controllers/SampleQueueRunner.h"
 
 namespace HorizonUTM {
 
 class TestController;
 
+/**
+ * @brief View for the sample queue and running it as a batch
+ */
 class SampleQueueView : public QWidget {
     Q_OBJECT
 
 public:
-    explicit SampleQueueView(TestController* testController, QWidget* parent = nullptr);
+    explicit SampleQueueView(TestController* testController,
+                             SampleQueueRunner* queueRunner,
+                             QWidget* parent = nullptr);
+
+    /**
+     * @brief Reload the Ready samples
+     */
+    void refreshQueue();
+
+private slots:
+    void onRunBatch();
+    void onCancelBatch();
+    void onSpecimenFinished(int sampleId, int testId, bool success);
+    void onBatchFinished(const BatchReport& report);
+
+private:
+    void setupUI();
+    void updateButtonStates();
 
 private:
     TestController* m_testController;
+    SampleQueueRunner* m_queueRunner;
+
+    QTableWidget* m_tableWidget;
+    QPushButton* m_runBtn;
+    QPushButton* m_cancelBtn;
+    QPushButton* m_refreshBtn;
+    QLabel* m_statusLabel;
 };
 
 } // namespace HorizonUTM
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <QVector>
+#include <QDateTime>
+#include "domain/entities/Test.h"
+#include "domain/value_objects/SensorData.h"
+
+namespace HorizonUTM {
+namespace TestData {
+
+/**
+ * @brief Noise-free tensile curve shaped like the MockUTMDriver material
+ *
+ * Linear elastic at 3 GPa up to 0.5% strain, yield to 50 MPa at 1.5%,
+ * hardening to 60 MPa at 5%, necking to 48 MPa at 8% (break).
+ * Specimen 10 × 4 mm, gauge length 50 mm, one sample every 10 ms.
+ */
+inline QVector<SensorData> tensileCurve(int pointCount) {
+    constexpr double modulusMPa = 3000.0;
+    constexpr double area = 40.0;
+    constexpr double gaugeLength = 50.0;
+    constexpr double breakStrain = 8.0;
+    const qint64 start = QDateTime(QDate(2024, 1, 1), QTime(12, 0)).toMSecsSinceEpoch();
+
+    QVector<SensorData> data;
+    data.reserve(pointCount);
+
+    for (int i = 1; i <= pointCount; ++i) {
+        double strain = breakStrain * i / pointCount;
+        double stress;
+        if (strain <= 0.5) {
+            stress = modulusMPa * strain / 100.0;
+        } else if (strain <= 1.5) {
+            stress = 15.0 + (50.0 - 15.0) * (strain - 0.5);
+        } else if (strain <= 5.0) {
+            stress = 50.0 + (60.0 - 50.0) * (strain - 1.5) / 3.5;
+        } else {
+            stress = 60.0 * (1.0 - 0.2 * (strain - 5.0) / 3.0);
+        }
+
+        SensorData point;
+        point.timestamp = start + i * 10;
+        point.strain = strain;
+        point.stress = stress;
+        point.extension = strain / 100.0 * gaugeLength;
+        point.force = stress * area;
+        point.temperature = 23.0;
+        data.append(point);
+    }
+
+    return data;
+}
+
+/**
+ * @brief Valid test matching tensileCurve()
+ */
+inline Test tensileTest(const QString& sampleName, int pointCount = 0) {
+    Test test;
+    test.setSampleName(sampleName);
+    test.setOperatorName("Tester");
+    test.setTestMethod("ISO 527-2");
+    test.setWidth(10.0);
+    test.setThickness(4.0);
+    test.setGaugeLength(50.0);
+    test.setSpeed(5.0);
+    test.setForceLimit(10000.0);
+    test.setTemperature(23.0);
+    test.setStatus(TestStatus::Completed);
+    test.setStartTime(QDateTime(QDate(2024, 1, 1), QTime(12, 0)));
+    test.setEndTime(QDateTime(QDate(2024, 1, 1), QTime(12, 1)));
+    if (pointCount > 0) {
+        test.setData(tensileCurve(pointCount));
+    }
+    return test;
+}
+
+} // namespace TestData
+} // namespace HorizonUTM
@@ -0,0 +1,69 @@
+#include <QtTest>
+#include <QTemporaryDir>
+#include "infrastructure/export/CSVExportService.h"
+#include "core/Logger.h"
+#include "TestData.h"
+
+using namespace HorizonUTM;
+
+class BenchCSVExportService : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void exportTest_data();
+    void exportTest();
+    void exportTests_data();
+    void exportTests();
+
+private:
+    QTemporaryDir m_dir;
+    CSVExportService m_service;
+};
+
+void BenchCSVExportService::initTestCase() {
+    Logger::initialize(LogLevel::Warning);
+    QVERIFY(m_dir.isValid());
+}
+
+void BenchCSVExportService::exportTest_data() {
+    QTest::addColumn<int>("points");
+    QTest::newRow("1k") << 1000;
+    QTest::newRow("100k") << 100000;
+}
+
+void BenchCSVExportService::exportTest() {
+    QFETCH(int, points);
+    Test test = TestData::tensileTest("bench", points);
+    test.setId(1);
+    QString path = m_dir.filePath("single.csv");
+
+    QBENCHMARK {
+        QVERIFY(m_service.exportTest(test, path));
+    }
+}
+
+void BenchCSVExportService::exportTests_data() {
+    QTest::addColumn<int>("tests");
+    QTest::newRow("100") << 100;
+    QTest::newRow("10k") << 10000;
+}
+
+void BenchCSVExportService::exportTests() {
+    QFETCH(int, tests);
+    QVector<Test> batch;
+    for (int i = 1; i <= tests; ++i) {
+        Test test = TestData::tensileTest(QString("S%1").arg(i));
+        test.setId(i);
+        batch.append(test);
+    }
+    QString path = m_dir.filePath("summary.csv");
+
+    QBENCHMARK {
+        QVERIFY(m_service.exportTests(batch, path));
+    }
+}
+
+QTEST_GUILESS_MAIN(BenchCSVExportService)
+#include "bench_csvexportservice.moc"
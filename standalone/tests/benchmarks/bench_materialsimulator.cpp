@@ -0,0 +1,75 @@
+#include <QtTest>
+#include "infrastructure/hardware/MaterialSimulator.h"
+
+using namespace HorizonUTM;
+
+class BenchMaterialSimulator : public QObject {
+    Q_OBJECT
+
+private slots:
+    void stressBatch_data();
+    void stressBatch();
+    void stressAt_data();
+    void stressAt();
+};
+
+namespace {
+
+// One second of a 10 kHz channel
+constexpr int SAMPLES = 10000;
+
+void addMaterials() {
+    QTest::addColumn<QString>("material");
+    for (const char* name : {"ductile", "brittle", "elastomer", "metal"}) {
+        QTest::newRow(name) << QString(name);
+    }
+}
+
+QVector<double> strainsOf(const MaterialParameters& material) {
+    QVector<double> strains(SAMPLES);
+    for (int i = 0; i < SAMPLES; ++i) {
+        strains[i] = material.breakStrain * (i + 1) / (SAMPLES + 1);
+    }
+    return strains;
+}
+
+} // namespace
+
+void BenchMaterialSimulator::stressBatch_data() {
+    addMaterials();
+}
+
+void BenchMaterialSimulator::stressBatch() {
+    QFETCH(QString, material);
+    MaterialSimulator simulator(MaterialParameters::byName(material));
+    QVector<double> strains = strainsOf(simulator.parameters());
+    QVector<double> stresses(SAMPLES);
+    FastRandom random(1);
+
+    QBENCHMARK {
+        simulator.stressBatch(strains.constData(), stresses.data(), SAMPLES, random);
+    }
+    QVERIFY(stresses.last() > 0.0);
+}
+
+void BenchMaterialSimulator::stressAt_data() {
+    addMaterials();
+}
+
+void BenchMaterialSimulator::stressAt() {
+    QFETCH(QString, material);
+    MaterialSimulator simulator(MaterialParameters::byName(material));
+    QVector<double> strains = strainsOf(simulator.parameters());
+    FastRandom random(1);
+
+    double sum = 0.0;
+    QBENCHMARK {
+        for (double strain : strains) {
+            sum += simulator.stressAt(strain, random);
+        }
+    }
+    QVERIFY(sum > 0.0);
+}
+
+QTEST_APPLESS_MAIN(BenchMaterialSimulator)
+#include "bench_materialsimulator.moc"
@@ -0,0 +1,95 @@
+#include <QtTest>
+#include <QRandomGenerator>
+#include "domain/services/SignalFilter.h"
+
+using namespace HorizonUTM;
+
+Q_DECLARE_METATYPE(HorizonUTM::FilterType)
+
+// One second of one channel at 10 kHz per iteration
+class BenchSignalFilter : public QObject {
+    Q_OBJECT
+
+private slots:
+    void block_data();
+    void block();
+    void sampleBySample_data();
+    void sampleBySample();
+
+private:
+    static constexpr int RATE_HZ = 10000;
+};
+
+namespace {
+
+void addFilterTypes() {
+    QTest::addColumn<FilterType>("type");
+    QTest::newRow("moving average 21") << FilterType::MovingAverage;
+    QTest::newRow("median 21") << FilterType::Median;
+    QTest::newRow("butterworth 4th order") << FilterType::Butterworth;
+    QTest::newRow("savitzky-golay 21/3") << FilterType::SavitzkyGolay;
+}
+
+FilterSettings settingsFor(FilterType type, double rateHz) {
+    FilterSettings settings;
+    settings.type = type;
+    settings.windowSize = 21;
+    settings.polynomialOrder = 3;
+    settings.order = 4;
+    settings.cutoffHz = 100.0;
+    settings.sampleRateHz = rateHz;
+    return settings;
+}
+
+QVector<SensorData> noisySamples(int count) {
+    QRandomGenerator random(11);
+    QVector<SensorData> samples(count);
+    for (int i = 0; i < count; ++i) {
+        double force = 400.0 + 4.0 * (2.0 * random.generateDouble() - 1.0);
+        samples[i] = SensorData(i, force, i * 1e-4, force / 40.0, i * 2e-4, 23.0);
+    }
+    return samples;
+}
+
+} // namespace
+
+void BenchSignalFilter::block_data() {
+    addFilterTypes();
+}
+
+void BenchSignalFilter::block() {
+    QFETCH(FilterType, type);
+    const QVector<SensorData> samples = noisySamples(RATE_HZ);
+    QVector<double> input(samples.size());
+    for (int i = 0; i < samples.size(); ++i) {
+        input[i] = samples[i].force;
+    }
+    QVector<double> output(input.size());
+    SignalFilter filter(settingsFor(type, RATE_HZ));
+
+    QBENCHMARK {
+        filter.process(input.constData(), output.data(), input.size());
+    }
+}
+
+void BenchSignalFilter::sampleBySample_data() {
+    addFilterTypes();
+}
+
+void BenchSignalFilter::sampleBySample() {
+    // All four channels, one sample at a time as HardwareController feeds them
+    QFETCH(FilterType, type);
+    const QVector<SensorData> input = noisySamples(RATE_HZ);
+    SensorDataFilter filter(settingsFor(type, RATE_HZ));
+
+    double sum = 0.0;
+    QBENCHMARK {
+        for (const SensorData& sample : input) {
+            sum += filter.process(sample).force;
+        }
+    }
+    QVERIFY(sum > 0.0);
+}
+
+QTEST_APPLESS_MAIN(BenchSignalFilter)
+#include "bench_signalfilter.moc"
@@ -0,0 +1,135 @@
+#include <QtTest>
+#include <QTemporaryDir>
+#include <QSqlQuery>
+#include "infrastructure/persistence/DatabaseManager.h"
+#include "infrastructure/persistence/SQLiteTestRepository.h"
+#include "core/Logger.h"
+#include "TestData.h"
+
+using namespace HorizonUTM;
+
+class BenchSQLiteTestRepository : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void saveTest_data();
+    void saveTest();
+    void updateMetadata_data();
+    void updateMetadata();
+    void getTest_data();
+    void getTest();
+    void getTestUncached_data();
+    void getTestUncached();
+    void getAllTests();
+
+private:
+    QTemporaryDir m_dir;
+    SQLiteTestRepository* m_repository = nullptr;
+};
+
+namespace {
+
+void addCurveSizes() {
+    QTest::addColumn<int>("points");
+    QTest::newRow("1k") << 1000;
+    QTest::newRow("10k") << 10000;
+}
+
+} // namespace
+
+void BenchSQLiteTestRepository::initTestCase() {
+    // Keep debug traces out of the measurements
+    Logger::initialize(LogLevel::Warning);
+    QVERIFY(m_dir.isValid());
+    QVERIFY(DatabaseManager::instance().initialize(m_dir.filePath("bench.db")));
+    m_repository = new SQLiteTestRepository();
+}
+
+void BenchSQLiteTestRepository::cleanupTestCase() {
+    delete m_repository;
+    DatabaseManager::instance().close();
+}
+
+void BenchSQLiteTestRepository::saveTest_data() {
+    addCurveSizes();
+}
+
+void BenchSQLiteTestRepository::saveTest() {
+    QFETCH(int, points);
+    Test prototype = TestData::tensileTest("bench", points);
+
+    QBENCHMARK {
+        Test test = prototype;
+        QVERIFY(m_repository->saveTest(test));
+    }
+}
+
+void BenchSQLiteTestRepository::updateMetadata_data() {
+    addCurveSizes();
+}
+
+void BenchSQLiteTestRepository::updateMetadata() {
+    // Should not depend on the curve size
+    QFETCH(int, points);
+    Test test = TestData::tensileTest("bench", points);
+    QVERIFY(m_repository->saveTest(test));
+
+    int revision = 0;
+    QBENCHMARK {
+        test.setNotes(QString("revision %1").arg(++revision));
+        QVERIFY(m_repository->updateTest(test));
+    }
+}
+
+void BenchSQLiteTestRepository::getTest_data() {
+    addCurveSizes();
+}
+
+void BenchSQLiteTestRepository::getTest() {
+    QFETCH(int, points);
+    Test test = TestData::tensileTest("bench", points);
+    QVERIFY(m_repository->saveTest(test));
+
+    // Repeated loads are served by the curve cache
+    Test loaded;
+    QBENCHMARK {
+        loaded = m_repository->getTest(test.getId());
+    }
+    QCOMPARE(loaded.getDataPointCount(), points);
+}
+
+void BenchSQLiteTestRepository::getTestUncached_data() {
+    addCurveSizes();
+}
+
+void BenchSQLiteTestRepository::getTestUncached() {
+    QFETCH(int, points);
+    Test test = TestData::tensileTest("bench", points);
+    QVERIFY(m_repository->saveTest(test));
+
+    // Every load reads the points from SQLite
+    m_repository->setCurveCacheBudget(0);
+
+    Test loaded;
+    QBENCHMARK {
+        loaded = m_repository->getTest(test.getId());
+    }
+    QCOMPARE(loaded.getDataPointCount(), points);
+
+    m_repository->setCurveCacheBudget(qint64(Constants::DEFAULT_CURVE_CACHE_MB) * 1024 * 1024);
+}
+
+void BenchSQLiteTestRepository::getAllTests() {
+    // Metadata only, whatever the tables hold from the previous benchmarks
+    QVector<Test> tests;
+    QBENCHMARK {
+        tests = m_repository->getAllTests();
+    }
+    QVERIFY(!tests.isEmpty());
+}
+
+QTEST_GUILESS_MAIN(BenchSQLiteTestRepository)
+#include "bench_sqlitetestrepository.moc"
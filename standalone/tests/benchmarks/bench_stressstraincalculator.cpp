@@ -0,0 +1,111 @@
+#include <QtTest>
+#include "domain/services/StressStrainCalculator.h"
+#include "TestData.h"
+
+using namespace HorizonUTM;
+
+class BenchStressStrainCalculator : public QObject {
+    Q_OBJECT
+
+private slots:
+    void calculateResults_data();
+    void calculateResults();
+    void elasticModulus_data();
+    void elasticModulus();
+    void bestFitModulus_data();
+    void bestFitModulus();
+    void yieldStress_data();
+    void yieldStress();
+    void maxStress_data();
+    void maxStress();
+};
+
+namespace {
+
+void addCurveSizes() {
+    QTest::addColumn<int>("points");
+    QTest::newRow("1k") << 1000;
+    QTest::newRow("10k") << 10000;
+    QTest::newRow("100k") << 100000;
+}
+
+} // namespace
+
+void BenchStressStrainCalculator::calculateResults_data() {
+    addCurveSizes();
+}
+
+void BenchStressStrainCalculator::calculateResults() {
+    QFETCH(int, points);
+    QVector<SensorData> data = TestData::tensileCurve(points);
+
+    TestResult result;
+    QBENCHMARK {
+        result = StressStrainCalculator::calculateResults(data, 40.0, 50.0);
+    }
+    QVERIFY(result.isValid());
+}
+
+void BenchStressStrainCalculator::elasticModulus_data() {
+    addCurveSizes();
+}
+
+void BenchStressStrainCalculator::elasticModulus() {
+    QFETCH(int, points);
+    QVector<SensorData> data = TestData::tensileCurve(points);
+
+    double modulus = 0.0;
+    QBENCHMARK {
+        modulus = StressStrainCalculator::calculateElasticModulus(data);
+    }
+    QVERIFY(modulus > 0.0);
+}
+
+void BenchStressStrainCalculator::bestFitModulus_data() {
+    addCurveSizes();
+    QTest::newRow("1M") << 1000000;
+}
+
+void BenchStressStrainCalculator::bestFitModulus() {
+    QFETCH(int, points);
+    QVector<SensorData> data = TestData::tensileCurve(points);
+
+    ModulusFit fit;
+    QBENCHMARK {
+        fit = StressStrainCalculator::findBestFitModulus(data);
+    }
+    QVERIFY(fit.isValid());
+}
+
+void BenchStressStrainCalculator::yieldStress_data() {
+    addCurveSizes();
+}
+
+void BenchStressStrainCalculator::yieldStress() {
+    QFETCH(int, points);
+    QVector<SensorData> data = TestData::tensileCurve(points);
+
+    double yield = 0.0;
+    QBENCHMARK {
+        yield = StressStrainCalculator::calculateYieldStress(data);
+    }
+    QVERIFY(yield > 0.0);
+}
+
+void BenchStressStrainCalculator::maxStress_data() {
+    addCurveSizes();
+}
+
+void BenchStressStrainCalculator::maxStress() {
+    QFETCH(int, points);
+    QVector<SensorData> data = TestData::tensileCurve(points);
+
+    double maxStress = 0.0;
+    QBENCHMARK {
+        maxStress = StressStrainCalculator::findMaxStress(data);
+    }
+    QVERIFY(maxStress > 0.0);
+}
+
+QTEST_APPLESS_MAIN(BenchStressStrainCalculator)
+#include "bench_stressstraincalculator.moc"
@@ -0,0 +1,255 @@
+#include <QtTest>
+#include <QTemporaryDir>
+#include <QFile>
+#include <QtEndian>
+#include <QJsonArray>
+#include "infrastructure/export/BinaryExportService.h"
+#include "infrastructure/export/BinaryCurveReader.h"
+#include "core/Logger.h"
+#include "TestData.h"
+
+using namespace HorizonUTM;
+using namespace HorizonUTM::BinaryCurveFormat;
+
+namespace {
+
+// FileHeader::indexOffset and IndexEntry field positions
+constexpr int HEADER_INDEX_OFFSET = 16;
+constexpr int ENTRY_METADATA_SIZE = 4;
+constexpr int ENTRY_METADATA_OFFSET = 8;
+constexpr int ENTRY_CHANNEL_OFFSETS = 24;
+
+QByteArray readAll(const QString& filePath) {
+    QFile file(filePath);
+    return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+}
+
+bool writeAll(const QString& filePath, const QByteArray& bytes) {
+    QFile file(filePath);
+    return file.open(QIODevice::WriteOnly) && file.write(bytes) == bytes.size();
+}
+
+template <typename T>
+void poke(QByteArray& bytes, qint64 offset, T value) {
+    qToLittleEndian<T>(value, bytes.data() + offset);
+}
+
+quint64 indexOffsetOf(const QByteArray& bytes) {
+    return qFromLittleEndian<quint64>(bytes.constData() + HEADER_INDEX_OFFSET);
+}
+
+double channelOf(const SensorData& point, Channel channel) {
+    switch (channel) {
+        case Channel::Timestamp:   return static_cast<double>(point.timestamp);
+        case Channel::Force:       return point.force;
+        case Channel::Extension:   return point.extension;
+        case Channel::Stress:      return point.stress;
+        case Channel::Strain:      return point.strain;
+        case Channel::Temperature: return point.temperature;
+    }
+    return 0.0;
+}
+
+} // namespace
+
+class TestBinaryExportService : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void roundTripKeepsChannelsAndMetadata();
+    void multiSegmentCurveIsWrittenInOrder();
+    void badMagicIsRejected();
+    void truncatedIndexIsRejected();
+    void indexOffsetOutOfRangeIsRejected();
+    void metadataOutOfRangeIsRejected();
+    void channelOffsetOutOfRangeIsRejected();
+
+private:
+    /**
+     * @brief Valid two-test file, returned as bytes to corrupt
+     */
+    QByteArray validFile();
+    bool opens(const QByteArray& bytes);
+
+    QTemporaryDir m_dir;
+    BinaryExportService m_service;
+};
+
+void TestBinaryExportService::initTestCase() {
+    Logger::initialize(LogLevel::Error);
+    QVERIFY(m_dir.isValid());
+}
+
+QByteArray TestBinaryExportService::validFile() {
+    Test first = TestData::tensileTest("first", 100);
+    first.setId(1);
+    Test second = TestData::tensileTest("second", 30);
+    second.setId(2);
+
+    const QString path = m_dir.filePath("valid.hzb");
+    return m_service.exportTests({first, second}, path) ? readAll(path) : QByteArray();
+}
+
+bool TestBinaryExportService::opens(const QByteArray& bytes) {
+    const QString path = m_dir.filePath("corrupt.hzb");
+    if (!writeAll(path, bytes)) {
+        return false;
+    }
+    BinaryCurveReader reader;
+    return reader.open(path);
+}
+
+void TestBinaryExportService::roundTripKeepsChannelsAndMetadata() {
+    Test test = TestData::tensileTest("round, \"trip\"", 250);
+    test.setId(42);
+    test.setNotes("notes");
+    TestResult result;
+    result.maxStress = 60.0;
+    result.maxStrain = 5.0;
+    result.yieldStress = 50.0;
+    result.yieldStrain = 1.5;
+    result.ultimateStress = 60.0;
+    result.ultimateStrain = 5.0;
+    result.breakStress = 48.0;
+    result.breakStrain = 8.0;
+    result.elasticModulus = 3.0;
+    result.elongationAtBreak = 8.0;
+    test.setResult(result);
+
+    Test empty = TestData::tensileTest("empty");
+    empty.setId(43);
+
+    const QString path = m_dir.filePath("roundtrip.hzb");
+    QVERIFY(m_service.exportTests({test, empty}, path));
+
+    BinaryCurveReader reader;
+    QVERIFY2(reader.open(path), qPrintable(reader.lastError()));
+    QCOMPARE(reader.testCount(), 2);
+    QCOMPARE(reader.testId(0), 42);
+    QCOMPARE(reader.testId(1), 43);
+    QCOMPARE(reader.pointCount(0), qint64(250));
+    QCOMPARE(reader.pointCount(1), qint64(0));
+
+    // Every channel, value for value
+    const QVector<SensorData> data = test.getData();
+    for (int c = 0; c < CHANNEL_COUNT; ++c) {
+        const Channel channel = static_cast<Channel>(c);
+        const QVector<double> values = reader.channelValues(0, channel);
+        QCOMPARE(values.size(), data.size());
+        for (qsizetype i = 0; i < data.size(); ++i) {
+            QCOMPARE(values[i], channelOf(data[i], channel));
+        }
+    }
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+    QCOMPARE(reader.channel(0, Channel::Stress)[249], data[249].stress);
+    QCOMPARE(reader.timestamps(0)[0], data[0].timestamp);
+#endif
+
+    // Metadata
+    const QJsonObject metadata = reader.metadata(0);
+    QCOMPARE(metadata["sample_name"].toString(), QString("round, \"trip\""));
+    QCOMPARE(metadata["channels"].toArray().size(), CHANNEL_COUNT);
+
+    Test restored = reader.test(0);
+    QCOMPARE(restored.getId(), 42);
+    QCOMPARE(restored.getSampleName(), test.getSampleName());
+    QCOMPARE(restored.getOperatorName(), test.getOperatorName());
+    QCOMPARE(restored.getTestMethod(), test.getTestMethod());
+    QCOMPARE(restored.getStatus(), test.getStatus());
+    QCOMPARE(restored.getStartTime(), test.getStartTime());
+    QCOMPARE(restored.getEndTime(), test.getEndTime());
+    QCOMPARE(restored.getWidth(), test.getWidth());
+    QCOMPARE(restored.getThickness(), test.getThickness());
+    QCOMPARE(restored.getGaugeLength(), test.getGaugeLength());
+    QCOMPARE(restored.getSpeed(), test.getSpeed());
+    QCOMPARE(restored.getForceLimit(), test.getForceLimit());
+    QCOMPARE(restored.getNotes(), test.getNotes());
+    QCOMPARE(restored.getResult().maxStress, result.maxStress);
+    QCOMPARE(restored.getResult().yieldStrain, result.yieldStrain);
+    QCOMPARE(restored.getResult().elasticModulus, result.elasticModulus);
+    QCOMPARE(restored.getDataPointCount(), 250);
+
+    QCOMPARE(reader.test(1).getSampleName(), QString("empty"));
+    QCOMPARE(reader.test(1).getDataPointCount(), 0);
+}
+
+void TestBinaryExportService::multiSegmentCurveIsWrittenInOrder() {
+    // Several blocks and more than one write chunk
+    const QVector<SensorData> points = TestData::tensileCurve(3 * int(Curve::BLOCK_SIZE) + 17);
+    CurveBuilder builder;
+    for (const SensorData& point : points) {
+        builder.append(point);
+    }
+    Test test = TestData::tensileTest("segments");
+    test.setId(1);
+    test.setCurve(builder.snapshot());
+    QVERIFY(test.getCurve().segmentCount() > 1);
+
+    const QString path = m_dir.filePath("segments.hzb");
+    QVERIFY(m_service.exportTest(test, path));
+
+    BinaryCurveReader reader;
+    QVERIFY(reader.open(path));
+    const QVector<SensorData> read = reader.dataPoints(0);
+    QCOMPARE(read.size(), points.size());
+    for (qsizetype i = 0; i < points.size(); ++i) {
+        QCOMPARE(read[i].timestamp, points[i].timestamp);
+        QCOMPARE(read[i].stress, points[i].stress);
+    }
+}
+
+void TestBinaryExportService::badMagicIsRejected() {
+    QByteArray bytes = validFile();
+    QVERIFY(opens(bytes));
+
+    bytes[0] = 'X';
+    QVERIFY(!opens(bytes));
+}
+
+void TestBinaryExportService::truncatedIndexIsRejected() {
+    QByteArray bytes = validFile();
+    bytes.chop(int(sizeof(IndexEntry)) / 2);
+    QVERIFY(!opens(bytes));
+}
+
+void TestBinaryExportService::indexOffsetOutOfRangeIsRejected() {
+    QByteArray bytes = validFile();
+
+    poke<quint64>(bytes, HEADER_INDEX_OFFSET, quint64(bytes.size()) + 8);
+    QVERIFY(!opens(bytes));
+
+    // Would wrap around when added to the index size
+    poke<quint64>(bytes, HEADER_INDEX_OFFSET, ~quint64(0) - 8);
+    QVERIFY(!opens(bytes));
+}
+
+void TestBinaryExportService::metadataOutOfRangeIsRejected() {
+    QByteArray bytes = validFile();
+    const qint64 entry = qint64(indexOffsetOf(bytes)) + qint64(sizeof(IndexHeader));
+
+    poke<quint32>(bytes, entry + ENTRY_METADATA_SIZE, quint32(bytes.size()));
+    QVERIFY(!opens(bytes));
+
+    // Offset + size wraps to a small value
+    poke<quint32>(bytes, entry + ENTRY_METADATA_SIZE, 0x100);
+    poke<quint64>(bytes, entry + ENTRY_METADATA_OFFSET, ~quint64(0) - 0x10);
+    QVERIFY(!opens(bytes));
+}
+
+void TestBinaryExportService::channelOffsetOutOfRangeIsRejected() {
+    QByteArray bytes = validFile();
+    const qint64 entry = qint64(indexOffsetOf(bytes)) + qint64(sizeof(IndexHeader));
+    const qint64 stressOffset = entry + ENTRY_CHANNEL_OFFSETS + int(Channel::Stress) * 8;
+
+    poke<quint64>(bytes, stressOffset, alignOffset(quint64(bytes.size())));
+    QVERIFY(!opens(bytes));
+
+    // Aligned, and offset + array size wraps
+    poke<quint64>(bytes, stressOffset, ~quint64(ALIGNMENT - 1));
+    QVERIFY(!opens(bytes));
+}
+
+QTEST_GUILESS_MAIN(TestBinaryExportService)
+#include "tst_binaryexportservice.moc"
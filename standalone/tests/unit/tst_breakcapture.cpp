@@ -0,0 +1,207 @@
+#include <QtTest>
+#include "domain/services/BreakCapture.h"
+#include "domain/services/BreakDetector.h"
+
+using namespace HorizonUTM;
+
+namespace {
+
+BreakCaptureSettings enabledSettings() {
+    BreakCaptureSettings settings;
+    settings.enabled = true;
+    settings.sampleRateHz = 1000.0;
+    return settings;
+}
+
+/**
+ * @brief perMs samples per millisecond, loading at 1 N/sample, then a
+ *        break to 5 N at breakMs
+ */
+QVector<SensorData> breakingTest(int perMs, qint64 breakMs, qint64 endMs) {
+    QVector<SensorData> samples;
+    for (qint64 i = 0; i < endMs * perMs; ++i) {
+        SensorData sample;
+        sample.timestamp = i / perMs;
+        sample.force = sample.timestamp < breakMs ? double(i) : 5.0;
+        samples.append(sample);
+    }
+    return samples;
+}
+
+int feed(BreakCapture& capture, const QVector<SensorData>& samples,
+         const BreakDetectorSettings& detection = BreakDetectorSettings()) {
+    BreakDetector detector(detection);
+    int completedAt = -1;
+    for (int i = 0; i < samples.size(); ++i) {
+        if (capture.process(samples[i], detector.process(samples[i]))) {
+            completedAt = i;
+        }
+    }
+    return completedAt;
+}
+
+} // namespace
+
+class TestBreakCapture : public QObject {
+    Q_OBJECT
+
+private slots:
+    void disabledCapturesNothing();
+    void forceDropTriggersBurst();
+    void ringGrowsForFasterSensor();
+    void forceRateTriggersBurst();
+    void belowMinForceIsIgnored();
+    void endedBeforePostTriggerKeepsPartialBurst();
+    void largerDropReplacesBurst();
+    void collapsedForceDisarms();
+    void resetRearms();
+};
+
+void TestBreakCapture::disabledCapturesNothing() {
+    BreakCapture capture;
+    QCOMPARE(feed(capture, breakingTest(1, 1000, 1200)), -1);
+    QVERIFY(!capture.isTriggered());
+    QVERIFY(capture.burst().isEmpty());
+}
+
+void TestBreakCapture::forceDropTriggersBurst() {
+    const BreakCaptureSettings settings = enabledSettings();
+    BreakCapture capture(settings);
+    const QVector<SensorData> samples = breakingTest(1, 1000, 1200);
+    const int completedAt = feed(capture, samples);
+
+    QVERIFY(capture.isComplete());
+    QCOMPARE(capture.triggerTimestamp(), qint64(1000));
+    QCOMPARE(samples[completedAt].timestamp, qint64(1000 + settings.postTriggerMs + 1));
+
+    // Every sample from 100 ms before to 50 ms after, in order
+    const QVector<SensorData>& burst = capture.burst();
+    QCOMPARE(burst.size(), int(settings.preTriggerMs + settings.postTriggerMs + 1));
+    QCOMPARE(burst.first().timestamp, qint64(1000 - settings.preTriggerMs));
+    QCOMPARE(burst.last().timestamp, qint64(1000 + settings.postTriggerMs));
+    for (int i = 1; i < burst.size(); ++i) {
+        QCOMPARE(burst[i].timestamp, burst[i - 1].timestamp + 1);
+    }
+}
+
+void TestBreakCapture::ringGrowsForFasterSensor() {
+    // Sized for 1 kHz, fed at 4 kHz
+    const BreakCaptureSettings settings = enabledSettings();
+    BreakCapture capture(settings);
+    feed(capture, breakingTest(4, 1000, 1200));
+
+    QVERIFY(capture.isComplete());
+    const QVector<SensorData>& burst = capture.burst();
+    QCOMPARE(burst.size(), int(4 * (settings.preTriggerMs + settings.postTriggerMs + 1)));
+    QCOMPARE(burst.first().timestamp, qint64(1000 - settings.preTriggerMs));
+    QCOMPARE(burst.last().timestamp, qint64(1000 + settings.postTriggerMs));
+}
+
+void TestBreakCapture::forceRateTriggersBurst() {
+    BreakDetectorSettings detection;
+    detection.forceDropPercent = 100.0;
+    detection.forceRateLimit = 5000.0;
+    BreakCapture capture(enabledSettings());
+
+    // Unloading at 10 N/ms, each step only 0.5 % of the maximum
+    QVector<SensorData> samples;
+    for (int i = 0; i < 3000; ++i) {
+        SensorData sample;
+        sample.timestamp = i;
+        sample.force = i < 2000 ? double(i) : 2000.0 - (i - 2000) * 10.0;
+        samples.append(sample);
+    }
+    feed(capture, samples, detection);
+
+    QVERIFY(capture.isTriggered());
+    QCOMPARE(capture.triggerTimestamp(), qint64(2001));
+}
+
+void TestBreakCapture::belowMinForceIsIgnored() {
+    BreakCapture capture(enabledSettings());
+
+    // Noise around zero before loading
+    QVector<SensorData> samples;
+    for (int i = 0; i < 500; ++i) {
+        SensorData sample;
+        sample.timestamp = i;
+        sample.force = (i % 2) ? 4.0 : 0.0;
+        samples.append(sample);
+    }
+    feed(capture, samples);
+    QVERIFY(!capture.isTriggered());
+}
+
+void TestBreakCapture::endedBeforePostTriggerKeepsPartialBurst() {
+    const BreakCaptureSettings settings = enabledSettings();
+    BreakCapture capture(settings);
+    QCOMPARE(feed(capture, breakingTest(1, 1000, 1020)), -1);
+
+    QVERIFY(capture.isTriggered());
+    QVERIFY(!capture.isComplete());
+    QCOMPARE(capture.burst().first().timestamp, qint64(1000 - settings.preTriggerMs));
+    QCOMPARE(capture.burst().last().timestamp, qint64(1019));
+}
+
+void TestBreakCapture::largerDropReplacesBurst() {
+    const BreakCaptureSettings settings = enabledSettings();
+    BreakCapture capture(settings);
+
+    // Loading to 1000 N, a 15 % slip at 1000 ms, the break at 1500 ms
+    QVector<SensorData> samples;
+    for (int i = 0; i < 1700; ++i) {
+        SensorData sample;
+        sample.timestamp = i;
+        sample.force = i < 1000 ? double(i) : (i < 1500 ? 850.0 + (i - 1000) * 0.1 : 5.0);
+        samples.append(sample);
+    }
+    const int completedAt = feed(capture, samples);
+
+    QVERIFY(capture.isComplete());
+    QCOMPARE(capture.triggerTimestamp(), qint64(1500));
+    QCOMPARE(samples[completedAt].timestamp, qint64(1500 + settings.postTriggerMs + 1));
+    QCOMPARE(capture.burst().size(), int(settings.preTriggerMs + settings.postTriggerMs + 1));
+    QCOMPARE(capture.burst().first().timestamp, qint64(1500 - settings.preTriggerMs));
+}
+
+void TestBreakCapture::collapsedForceDisarms() {
+    BreakDetector detector;
+
+    // A slip, the force decays to zero, then a spike and drop of handling noise
+    QVector<SensorData> samples;
+    for (int i = 0; i < 3000; ++i) {
+        SensorData sample;
+        sample.timestamp = i;
+        if (i < 1000) {
+            sample.force = i;
+        } else if (i < 1850) {
+            sample.force = 850.0 - (i - 1000);
+        } else {
+            sample.force = (i == 2500) ? 1000.0 : 0.0;
+        }
+        samples.append(sample);
+    }
+
+    for (const SensorData& sample : samples) {
+        detector.process(sample);
+    }
+    QCOMPARE(detector.triggerCount(), 1);
+    QCOMPARE(detector.triggerTimestamp(), qint64(1000));
+}
+
+void TestBreakCapture::resetRearms() {
+    BreakCapture capture(enabledSettings());
+    const QVector<SensorData> samples = breakingTest(1, 1000, 1200);
+    feed(capture, samples);
+    const QVector<SensorData> first = capture.burst();
+
+    capture.reset();
+    QVERIFY(!capture.isTriggered());
+    QVERIFY(capture.burst().isEmpty());
+
+    feed(capture, samples);
+    QCOMPARE(capture.burst().size(), first.size());
+}
+
+QTEST_APPLESS_MAIN(TestBreakCapture)
+#include "tst_breakcapture.moc"
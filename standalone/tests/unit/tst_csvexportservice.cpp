@@ -0,0 +1,148 @@
+#include <QtTest>
+#include <QTemporaryDir>
+#include <QFile>
+#include <QDir>
+#include "infrastructure/export/CSVExportService.h"
+#include "core/Logger.h"
+#include "TestData.h"
+
+using namespace HorizonUTM;
+
+namespace {
+
+QStringList readLines(const QString& filePath) {
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return QStringList();
+    }
+    return QString::fromUtf8(file.readAll()).split('\n', Qt::SkipEmptyParts);
+}
+
+QVector<Test> numberedTests(int count, int pointCount = 0) {
+    QVector<Test> tests;
+    for (int i = 1; i <= count; ++i) {
+        Test test = TestData::tensileTest(QString("S%1").arg(i), pointCount);
+        test.setId(i);
+        tests.append(test);
+    }
+    return tests;
+}
+
+} // namespace
+
+class TestCSVExportService : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void singleTestHasSummaryAndCurve();
+    void fieldsAreEscaped();
+    void multipleTestsKeepOrder();
+    void progressReachesTotal();
+    void cancelRemovesFile();
+    void emptyExportFails();
+    void directoryExportWritesOneFilePerTest();
+
+private:
+    QTemporaryDir m_dir;
+    CSVExportService m_service;
+};
+
+void TestCSVExportService::initTestCase() {
+    Logger::initialize(LogLevel::Warning);
+    QVERIFY(m_dir.isValid());
+}
+
+void TestCSVExportService::singleTestHasSummaryAndCurve() {
+    Test test = TestData::tensileTest("single", 100);
+    test.setId(7);
+    QString path = m_dir.filePath("single.csv");
+
+    QVERIFY(m_service.exportTest(test, path));
+
+    QStringList lines = readLines(path);
+    QCOMPARE(lines.size(), 2 + 1 + 100); // summary header + row, curve header, points
+    QVERIFY(lines[0].startsWith("Test ID,Sample Name"));
+    QVERIFY(lines[1].startsWith("7,single,"));
+    QVERIFY(lines[2].startsWith("Timestamp (ms),Time (s),Force (N)"));
+    QCOMPARE(lines[3].split(',').value(1), QString("0.000"));
+    QCOMPARE(lines.last().split(',').value(5), QString("8.0000"));
+}
+
+void TestCSVExportService::fieldsAreEscaped() {
+    Test test = TestData::tensileTest("a,b");
+    test.setId(1);
+    test.setNotes("say \"hi\"");
+    QString path = m_dir.filePath("escaped.csv");
+
+    QVERIFY(m_service.exportTest(test, path));
+
+    QStringList lines = readLines(path);
+    QVERIFY(lines[1].startsWith("1,\"a,b\","));
+    QVERIFY(lines[1].endsWith(",\"say \"\"hi\"\"\""));
+}
+
+void TestCSVExportService::multipleTestsKeepOrder() {
+    // Enough tests to be split into many parallel shards
+    QVector<Test> tests = numberedTests(1000);
+    QString path = m_dir.filePath("many.csv");
+
+    QVERIFY(m_service.exportTests(tests, path));
+
+    QStringList lines = readLines(path);
+    QCOMPARE(lines.size(), 1001);
+    for (int i = 1; i <= 1000; ++i) {
+        QCOMPARE(lines[i].section(',', 0, 0).toInt(), i);
+    }
+}
+
+void TestCSVExportService::progressReachesTotal() {
+    QVector<Test> tests = numberedTests(50);
+    int lastCompleted = 0;
+    int calls = 0;
+    bool monotonic = true;
+    bool totalsMatch = true;
+
+    QVERIFY(m_service.exportTestsWithProgress(tests, m_dir.filePath("progress.csv"),
+        [&](int completed, int total) {
+            ++calls;
+            monotonic = monotonic && completed >= lastCompleted;
+            totalsMatch = totalsMatch && total == 50;
+            lastCompleted = completed;
+            return true;
+        }));
+
+    QVERIFY(calls > 0);
+    QVERIFY(monotonic);
+    QVERIFY(totalsMatch);
+    QCOMPARE(lastCompleted, 50);
+}
+
+void TestCSVExportService::cancelRemovesFile() {
+    QVector<Test> tests = numberedTests(500);
+    QString path = m_dir.filePath("cancelled.csv");
+
+    QVERIFY(!m_service.exportTestsWithProgress(tests, path, [](int, int) { return false; }));
+    QVERIFY(!QFile::exists(path));
+}
+
+void TestCSVExportService::emptyExportFails() {
+    QVERIFY(!m_service.exportTests(QVector<Test>(), m_dir.filePath("empty.csv")));
+}
+
+void TestCSVExportService::directoryExportWritesOneFilePerTest() {
+    QVector<Test> tests = numberedTests(20, 50);
+    QString dirPath = m_dir.filePath("bundle");
+
+    QVERIFY(m_service.exportTestsToDirectory(tests, dirPath, ExportProgressCallback()));
+
+    QDir dir(dirPath);
+    QStringList files = dir.entryList(QStringList() << "*.csv", QDir::Files);
+    QCOMPARE(files.size(), 20);
+    QVERIFY(files.contains("test_1_S1.csv"));
+    QCOMPARE(readLines(dir.filePath("test_20_S20.csv")).size(), 2 + 1 + 50);
+}
+
+QTEST_GUILESS_MAIN(TestCSVExportService)
+#include "tst_csvexportservice.moc"
@@ -0,0 +1,149 @@
+#include <QtTest>
+#include <QThread>
+#include "domain/value_objects/Curve.h"
+#include "domain/entities/Test.h"
+#include "TestData.h"
+
+using namespace HorizonUTM;
+
+namespace {
+
+CurveBuilder builderWith(const QVector<SensorData>& points) {
+    CurveBuilder builder;
+    for (const SensorData& point : points) {
+        builder.append(point);
+    }
+    return builder;
+}
+
+} // namespace
+
+class TestCurve : public QObject {
+    Q_OBJECT
+
+private slots:
+    void emptyCurve();
+    void fromVectorSharesPoints();
+    void builderSpansBlocks();
+    void snapshotIsUnaffectedByLaterAppends();
+    void snapshotsShareSealedBlocks();
+    void sealProducesSingleBlock();
+    void testCopiesShareCurve();
+    void concurrentReaders();
+};
+
+void TestCurve::emptyCurve() {
+    Curve curve;
+    QVERIFY(curve.isEmpty());
+    QCOMPARE(curve.segmentCount(), 0);
+    QVERIFY(curve.points().isEmpty());
+    QVERIFY(CurveBuilder().snapshot().isEmpty());
+}
+
+void TestCurve::fromVectorSharesPoints() {
+    QVector<SensorData> points = TestData::tensileCurve(100);
+    Curve curve = Curve::fromVector(points);
+
+    QCOMPARE(curve.size(), 100);
+    QCOMPARE(curve.segmentCount(), 1);
+    QVERIFY(curve.points().constData() == points.constData());
+}
+
+void TestCurve::builderSpansBlocks() {
+    const int count = int(Curve::BLOCK_SIZE) * 2 + 10;
+    QVector<SensorData> points = TestData::tensileCurve(count);
+    Curve curve = builderWith(points).snapshot();
+
+    QCOMPARE(curve.size(), qsizetype(count));
+    QCOMPARE(curve.segmentCount(), 3);
+    for (int i : {0, int(Curve::BLOCK_SIZE) - 1, int(Curve::BLOCK_SIZE), count - 1}) {
+        QCOMPARE(curve.at(i).timestamp, points[i].timestamp);
+    }
+
+    const QVector<SensorData>& flat = curve.points();
+    QCOMPARE(flat.size(), count);
+    QCOMPARE(flat.last().strain, points.last().strain);
+    // Flattened once and cached
+    QVERIFY(curve.points().constData() == flat.constData());
+}
+
+void TestCurve::snapshotIsUnaffectedByLaterAppends() {
+    QVector<SensorData> points = TestData::tensileCurve(20);
+    CurveBuilder builder = builderWith(points.mid(0, 10));
+
+    Curve before = builder.snapshot();
+    for (int i = 10; i < 20; ++i) {
+        builder.append(points[i]);
+    }
+
+    QCOMPARE(before.size(), 10);
+    QCOMPARE(before.last().timestamp, points[9].timestamp);
+    QCOMPARE(builder.snapshot().size(), 20);
+}
+
+void TestCurve::snapshotsShareSealedBlocks() {
+    CurveBuilder builder = builderWith(TestData::tensileCurve(int(Curve::BLOCK_SIZE) + 1));
+
+    Curve first = builder.snapshot();
+    Curve second = builder.snapshot();
+    QVERIFY(!first.isSharedWith(second));
+    QVERIFY(first.segment(0).data == second.segment(0).data);
+}
+
+void TestCurve::sealProducesSingleBlock() {
+    const int count = int(Curve::BLOCK_SIZE) + 100;
+    QVector<SensorData> points = TestData::tensileCurve(count);
+    CurveBuilder builder = builderWith(points);
+
+    Curve curve = builder.seal();
+    QVERIFY(builder.isEmpty());
+    QCOMPARE(curve.size(), qsizetype(count));
+    QCOMPARE(curve.segmentCount(), 1);
+    QCOMPARE(curve.at(count - 1).timestamp, points.last().timestamp);
+}
+
+void TestCurve::testCopiesShareCurve() {
+    Test test = TestData::tensileTest("shared", 1000);
+    Test copy = test;
+
+    QVERIFY(copy.getCurve().isSharedWith(test.getCurve()));
+    QVERIFY(copy.getData().constData() == test.getData().constData());
+
+    copy.setNotes("changed");
+    QVERIFY(copy.getCurve().isSharedWith(test.getCurve()));
+}
+
+void TestCurve::concurrentReaders() {
+    CurveBuilder builder = builderWith(TestData::tensileCurve(int(Curve::BLOCK_SIZE) * 3));
+    const Curve curve = builder.snapshot();
+
+    double expected = 0.0;
+    for (qsizetype i = 0; i < curve.size(); ++i) {
+        expected += curve.at(i).stress;
+    }
+
+    // Readers race on the lazily flattened view
+    QVector<double> sums(8, 0.0);
+    QVector<QThread*> threads;
+    for (int t = 0; t < sums.size(); ++t) {
+        threads.append(QThread::create([curve, &sums, t]() {
+            for (const SensorData& point : curve.points()) {
+                sums[t] += point.stress;
+            }
+        }));
+    }
+    for (QThread* thread : threads) {
+        thread->start();
+    }
+    for (QThread* thread : threads) {
+        QVERIFY(thread->wait(10000));
+        delete thread;
+    }
+
+    for (double sum : sums) {
+        QCOMPARE(sum, expected);
+    }
+}
+
+QTEST_APPLESS_MAIN(TestCurve)
+#include "tst_curve.moc"
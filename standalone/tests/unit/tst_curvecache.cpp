@@ -0,0 +1,158 @@
+#include <QtTest>
+#include "infrastructure/persistence/CurveCache.h"
+#include "TestData.h"
+
+using namespace HorizonUTM;
+
+namespace {
+
+Curve curveOf(int points) {
+    return Curve::fromVector(TestData::tensileCurve(points));
+}
+
+qint64 bytesOf(int points) {
+    return qint64(points) * qint64(sizeof(SensorData));
+}
+
+} // namespace
+
+class TestCurveCache : public QObject {
+    Q_OBJECT
+
+private slots:
+    void missThenHit();
+    void hitSharesCurve();
+    void evictsLeastRecentlyUsed();
+    void oversizedCurveIsNotCached();
+    void invalidateRemovesEntry();
+    void shrinkingBudgetEvicts();
+    void invalidateDuringLoadSkipsInsert();
+    void clearDuringLoadSkipsInsert();
+};
+
+void TestCurveCache::missThenHit() {
+    CurveCache cache(bytesOf(1000));
+    Curve curve;
+
+    QVERIFY(!cache.lookup(1, curve));
+    cache.insert(1, curveOf(100));
+    QVERIFY(cache.lookup(1, curve));
+    QCOMPARE(curve.size(), 100);
+
+    CurveCache::Stats stats = cache.stats();
+    QCOMPARE(stats.hits, qint64(1));
+    QCOMPARE(stats.misses, qint64(1));
+    QCOMPARE(stats.entries, qint64(1));
+    QCOMPARE(stats.bytes, bytesOf(100));
+}
+
+void TestCurveCache::hitSharesCurve() {
+    CurveCache cache(bytesOf(1000));
+    Curve original = curveOf(100);
+    cache.insert(1, original);
+
+    Curve cached;
+    QVERIFY(cache.lookup(1, cached));
+    QVERIFY(cached.isSharedWith(original));
+}
+
+void TestCurveCache::evictsLeastRecentlyUsed() {
+    CurveCache cache(bytesOf(300));
+    cache.insert(1, curveOf(100));
+    cache.insert(2, curveOf(100));
+    cache.insert(3, curveOf(100));
+
+    // Touch 1 so that 2 is the oldest
+    Curve curve;
+    QVERIFY(cache.lookup(1, curve));
+
+    cache.insert(4, curveOf(100));
+
+    QVERIFY(cache.lookup(1, curve));
+    QVERIFY(!cache.lookup(2, curve));
+    QVERIFY(cache.lookup(3, curve));
+    QVERIFY(cache.lookup(4, curve));
+    QCOMPARE(cache.stats().evictions, qint64(1));
+    QCOMPARE(cache.stats().bytes, bytesOf(300));
+}
+
+void TestCurveCache::oversizedCurveIsNotCached() {
+    CurveCache cache(bytesOf(100));
+    cache.insert(1, curveOf(50));
+    cache.insert(2, curveOf(101));
+
+    Curve curve;
+    QVERIFY(!cache.lookup(2, curve));
+    QVERIFY(cache.lookup(1, curve));
+    QCOMPARE(cache.stats().evictions, qint64(0));
+}
+
+void TestCurveCache::invalidateRemovesEntry() {
+    CurveCache cache(bytesOf(1000));
+    cache.insert(1, curveOf(100));
+    cache.insert(2, curveOf(100));
+
+    cache.invalidate(1);
+
+    Curve curve;
+    QVERIFY(!cache.lookup(1, curve));
+    QVERIFY(cache.lookup(2, curve));
+    QCOMPARE(cache.stats().bytes, bytesOf(100));
+}
+
+void TestCurveCache::shrinkingBudgetEvicts() {
+    CurveCache cache(bytesOf(1000));
+    for (int id = 1; id <= 5; ++id) {
+        cache.insert(id, curveOf(100));
+    }
+
+    cache.setBudget(bytesOf(200));
+    QCOMPARE(cache.stats().entries, qint64(2));
+    QCOMPARE(cache.stats().evictions, qint64(3));
+
+    // The two most recent survive
+    Curve curve;
+    QVERIFY(cache.lookup(5, curve));
+    QVERIFY(cache.lookup(4, curve));
+
+    cache.setBudget(0);
+    QCOMPARE(cache.stats().entries, qint64(0));
+}
+
+void TestCurveCache::invalidateDuringLoadSkipsInsert() {
+    CurveCache cache(bytesOf(1000));
+    Curve curve;
+
+    // Miss, then a writer invalidates before the loader inserts
+    quint64 generation = 0;
+    QVERIFY(!cache.lookup(1, curve, &generation));
+    cache.invalidate(1);
+    QVERIFY(!cache.insertIfCurrent(1, curveOf(100), generation));
+    QVERIFY(!cache.lookup(1, curve));
+
+    // Other ids are unaffected
+    quint64 other = 0;
+    QVERIFY(!cache.lookup(2, curve, &other));
+    cache.invalidate(1);
+    QVERIFY(cache.insertIfCurrent(2, curveOf(100), other));
+    QVERIFY(cache.lookup(2, curve));
+
+    // A load started after the write is cached
+    QVERIFY(!cache.lookup(1, curve, &generation));
+    QVERIFY(cache.insertIfCurrent(1, curveOf(100), generation));
+    QVERIFY(cache.lookup(1, curve));
+}
+
+void TestCurveCache::clearDuringLoadSkipsInsert() {
+    CurveCache cache(bytesOf(1000));
+    Curve curve;
+
+    quint64 generation = 0;
+    QVERIFY(!cache.lookup(1, curve, &generation));
+    cache.clear();
+    QVERIFY(!cache.insertIfCurrent(1, curveOf(100), generation));
+    QCOMPARE(cache.stats().entries, qint64(0));
+}
+
+QTEST_APPLESS_MAIN(TestCurveCache)
+#include "tst_curvecache.moc"
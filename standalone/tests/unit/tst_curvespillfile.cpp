@@ -0,0 +1,184 @@
+#include <QtTest>
+#include <QFileInfo>
+#include <QTemporaryDir>
+#include "infrastructure/persistence/CurveSpillFile.h"
+#include "domain/services/StressStrainCalculator.h"
+#include "core/Logger.h"
+#include "TestData.h"
+
+using namespace HorizonUTM;
+
+namespace {
+
+qint64 bytesOfBlocks(int blocks) {
+    return qint64(blocks) * Curve::BLOCK_SIZE * qint64(sizeof(SensorData));
+}
+
+} // namespace
+
+class TestCurveSpillFile : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void builderStaysWithinBudget();
+    void readsAcrossSpilledSegments();
+    void resultsMatchInMemoryCurve();
+    void sealKeepsSpilledSegments();
+    void curveOutlivesStore();
+    void blocksShareMappedChunks();
+    void withoutStoreNothingSpills();
+
+private:
+    QTemporaryDir m_dir;
+};
+
+void TestCurveSpillFile::initTestCase() {
+    Logger::initialize(LogLevel::Warning);
+    QVERIFY(m_dir.isValid());
+}
+
+void TestCurveSpillFile::builderStaysWithinBudget() {
+    auto store = std::make_shared<CurveSpillFile>(m_dir.path());
+    CurveBuilder builder;
+    builder.setMemoryBudget(bytesOfBlocks(2), store);
+
+    const int count = int(Curve::BLOCK_SIZE) * 6 + 17;
+    for (const SensorData& point : TestData::tensileCurve(count)) {
+        builder.append(point);
+        QVERIFY(builder.memoryBytes() <= bytesOfBlocks(3));
+    }
+
+    QCOMPARE(builder.size(), qsizetype(count));
+    QVERIFY(builder.spilledCount() >= Curve::BLOCK_SIZE * 4);
+    QCOMPARE(store->bytesWritten(), qint64(builder.spilledCount()) * qint64(sizeof(SensorData)));
+}
+
+void TestCurveSpillFile::readsAcrossSpilledSegments() {
+    auto store = std::make_shared<CurveSpillFile>(m_dir.path());
+    CurveBuilder builder;
+    builder.setMemoryBudget(bytesOfBlocks(1), store);
+
+    const int count = int(Curve::BLOCK_SIZE) * 4 + 100;
+    QVector<SensorData> points = TestData::tensileCurve(count);
+    for (const SensorData& point : points) {
+        builder.append(point);
+    }
+
+    Curve curve = builder.snapshot();
+    QVERIFY(curve.spilledCount() > 0);
+    QVERIFY(curve.segment(0).isSpilled());
+    QVERIFY(!curve.segment(curve.segmentCount() - 1).isSpilled());
+
+    for (int i = 0; i < count; ++i) {
+        QCOMPARE(curve.at(i).timestamp, points[i].timestamp);
+        QCOMPARE(curve.at(i).stress, points[i].stress);
+    }
+
+    qsizetype index = 0;
+    for (const SensorData& point : curve) {
+        QCOMPARE(point.strain, points[index++].strain);
+    }
+    QCOMPARE(index, qsizetype(count));
+
+    QCOMPARE(curve.points().size(), count);
+    QCOMPARE(curve.points().last().force, points.last().force);
+}
+
+void TestCurveSpillFile::resultsMatchInMemoryCurve() {
+    auto store = std::make_shared<CurveSpillFile>(m_dir.path());
+    CurveBuilder builder;
+    builder.setMemoryBudget(bytesOfBlocks(1), store);
+
+    QVector<SensorData> points = TestData::tensileCurve(int(Curve::BLOCK_SIZE) * 3);
+    for (const SensorData& point : points) {
+        builder.append(point);
+    }
+    Curve curve = builder.snapshot();
+    QVERIFY(curve.spilledCount() > 0);
+
+    TestResult expected = StressStrainCalculator::calculateResults(points, 40.0, 50.0);
+    TestResult actual = StressStrainCalculator::calculateResults(curve, 40.0, 50.0);
+
+    QCOMPARE(actual.maxStress, expected.maxStress);
+    QCOMPARE(actual.yieldStress, expected.yieldStress);
+    QCOMPARE(actual.elasticModulus, expected.elasticModulus);
+    QCOMPARE(actual.breakStrain, expected.breakStrain);
+}
+
+void TestCurveSpillFile::sealKeepsSpilledSegments() {
+    auto store = std::make_shared<CurveSpillFile>(m_dir.path());
+    CurveBuilder builder;
+    builder.setMemoryBudget(bytesOfBlocks(1), store);
+
+    const int count = int(Curve::BLOCK_SIZE) * 3 + 5;
+    for (const SensorData& point : TestData::tensileCurve(count)) {
+        builder.append(point);
+    }
+
+    Curve curve = builder.seal();
+    QVERIFY(builder.isEmpty());
+    QCOMPARE(builder.spilledCount(), 0);
+    QCOMPARE(curve.size(), qsizetype(count));
+    QVERIFY(curve.spilledCount() > 0);
+}
+
+void TestCurveSpillFile::curveOutlivesStore() {
+    QVector<SensorData> points = TestData::tensileCurve(int(Curve::BLOCK_SIZE) * 3);
+    QString fileName;
+    Curve curve;
+    {
+        auto store = std::make_shared<CurveSpillFile>(m_dir.path());
+        fileName = store->fileName();
+
+        CurveBuilder builder;
+        builder.setMemoryBudget(bytesOfBlocks(1), store);
+        for (const SensorData& point : points) {
+            builder.append(point);
+        }
+        curve = builder.seal();
+    }
+
+    // The mapping keeps the file open after the store and builder are gone
+    QVERIFY(curve.spilledCount() > 0);
+    QCOMPARE(curve.first().timestamp, points.first().timestamp);
+    QVERIFY(QFileInfo::exists(fileName));
+
+    curve = Curve();
+    QVERIFY(!QFileInfo::exists(fileName));
+}
+
+void TestCurveSpillFile::blocksShareMappedChunks() {
+    auto store = std::make_shared<CurveSpillFile>(m_dir.path());
+    CurveBuilder builder;
+    builder.setMemoryBudget(bytesOfBlocks(1), store);
+
+    const int blocks = int(CurveSpillFile::MAP_CHUNK_BLOCKS) + 3;
+    QVector<SensorData> points = TestData::tensileCurve(int(Curve::BLOCK_SIZE) * blocks);
+    for (const SensorData& point : points) {
+        builder.append(point);
+    }
+    Curve curve = builder.seal();
+    QVERIFY(curve.spilledCount() >= Curve::BLOCK_SIZE * CurveSpillFile::MAP_CHUNK_BLOCKS);
+
+    // One mapping per chunk, not per block
+    QCOMPARE(store->mappingCount(), 2);
+    QCOMPARE(curve.segment(1).data, curve.segment(0).data + Curve::BLOCK_SIZE);
+    QCOMPARE(curve.at(curve.size() - 1).timestamp, points.last().timestamp);
+}
+
+void TestCurveSpillFile::withoutStoreNothingSpills() {
+    CurveBuilder builder;
+    builder.setMemoryBudget(bytesOfBlocks(1), nullptr);
+
+    for (const SensorData& point : TestData::tensileCurve(int(Curve::BLOCK_SIZE) * 3)) {
+        builder.append(point);
+    }
+
+    QCOMPARE(builder.spilledCount(), 0);
+    QCOMPARE(builder.memoryBytes(), bytesOfBlocks(3));
+}
+
+QTEST_APPLESS_MAIN(TestCurveSpillFile)
+#include "tst_curvespillfile.moc"
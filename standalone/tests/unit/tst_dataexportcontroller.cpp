@@ -0,0 +1,252 @@
+#include <QtTest>
+#include <QMutex>
+#include <QSemaphore>
+#include <QSignalSpy>
+#include <QThread>
+#include <atomic>
+#include "application/controllers/DataExportController.h"
+#include "core/Logger.h"
+#include "TestData.h"
+
+using namespace HorizonUTM;
+
+namespace {
+
+/**
+ * @brief Export service that blocks each job until the test releases it
+ */
+class GatedExportService : public IExportService {
+public:
+    bool exportTest(const Test& test, const QString& filePath) override {
+        return exportTests({test}, filePath);
+    }
+
+    bool exportTests(const QVector<Test>& tests, const QString& filePath) override {
+        return exportTestsWithProgress(tests, filePath, ExportProgressCallback());
+    }
+
+    bool exportTestsWithProgress(const QVector<Test>& tests, const QString& filePath,
+                                 const ExportProgressCallback& progress) override {
+        Q_UNUSED(filePath);
+        {
+            QMutexLocker locker(&m_mutex);
+            ++m_started;
+            for (const Test& test : tests) {
+                m_exported.append(qMakePair(test.getId(), test.getDataPointCount()));
+            }
+        }
+
+        gate.acquire();
+        for (int i = 1; i <= tests.size(); ++i) {
+            if (progress && !progress(i, tests.size())) {
+                return false;
+            }
+        }
+        return succeed;
+    }
+
+    QStringList getSupportedExtensions() const override { return {"gated"}; }
+    QString getFileTypeDescription() const override { return "Gated (*.gated)"; }
+
+    int started() const {
+        QMutexLocker locker(&m_mutex);
+        return m_started;
+    }
+
+    QVector<QPair<int, int>> exported() const {
+        QMutexLocker locker(&m_mutex);
+        return m_exported;
+    }
+
+    QSemaphore gate;
+    std::atomic<bool> succeed{true};
+
+private:
+    mutable QMutex m_mutex;
+    int m_started = 0;
+    QVector<QPair<int, int>> m_exported;    // id, point count
+};
+
+QVector<Test> numberedTests(int count) {
+    QVector<Test> tests;
+    for (int i = 1; i <= count; ++i) {
+        Test test = TestData::tensileTest(QString("S%1").arg(i), 10);
+        test.setId(i);
+        tests.append(test);
+    }
+    return tests;
+}
+
+} // namespace
+
+class TestDataExportController : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void init();
+    void cleanup();
+
+    void jobRunsToCompletion();
+    void failedJobIsReported();
+    void cancelQueuedJobNeverRuns();
+    void cancelRunningJob();
+    void storedTestsAreLoadedByWorker();
+    void unloadableTestFailsJob();
+    void storedTestsNeedLoader();
+
+private:
+    GatedExportService* m_service = nullptr;
+    DataExportController* m_controller = nullptr;
+};
+
+void TestDataExportController::initTestCase() {
+    Logger::initialize(LogLevel::Critical);
+}
+
+void TestDataExportController::init() {
+    m_service = new GatedExportService();
+    m_controller = new DataExportController();
+    m_controller->registerExportService(m_service);
+    m_controller->setMaxConcurrentExports(1);
+}
+
+void TestDataExportController::cleanup() {
+    // Let any blocked worker finish before the controller waits for its pool
+    m_service->gate.release(100);
+    delete m_controller;
+    delete m_service;
+}
+
+void TestDataExportController::jobRunsToCompletion() {
+    QSignalSpy queued(m_controller, &DataExportController::exportJobQueued);
+    QSignalSpy progress(m_controller, &DataExportController::exportProgress);
+    QSignalSpy completed(m_controller, &DataExportController::exportCompleted);
+    QSignalSpy finished(m_controller, &DataExportController::exportJobFinished);
+
+    int jobId = m_controller->submitExport(numberedTests(3), "out.gated", "gated");
+    QVERIFY(jobId > 0);
+    QCOMPARE(queued.count(), 1);
+    QCOMPARE(queued.at(0).at(0).toInt(), jobId);
+    QCOMPARE(m_controller->getExportState(jobId), ExportJobState::Queued);
+    QCOMPARE(m_controller->activeExportCount(), 1);
+
+    QTRY_COMPARE(m_controller->getExportState(jobId), ExportJobState::Running);
+
+    m_service->gate.release();
+    QTRY_COMPARE(finished.count(), 1);
+    QCOMPARE(finished.at(0).at(0).toInt(), jobId);
+    QCOMPARE(finished.at(0).at(1).value<ExportJobState>(), ExportJobState::Completed);
+    QCOMPARE(finished.at(0).at(2).toString(), QString("out.gated"));
+    QCOMPARE(completed.count(), 1);
+
+    // Whole-percent steps, ending at the total
+    QVERIFY(progress.count() >= 1);
+    QCOMPARE(progress.last().at(0).toInt(), jobId);
+    QCOMPARE(progress.last().at(1).toInt(), 3);
+    QCOMPARE(progress.last().at(2).toInt(), 3);
+
+    // Finished jobs are not kept
+    QCOMPARE(m_controller->activeExportCount(), 0);
+    QVERIFY(!m_controller->cancelExport(jobId));
+}
+
+void TestDataExportController::failedJobIsReported() {
+    m_service->succeed = false;
+    QSignalSpy failed(m_controller, &DataExportController::exportFailed);
+    QSignalSpy finished(m_controller, &DataExportController::exportJobFinished);
+
+    int jobId = m_controller->submitExport(numberedTests(1), "failed.gated", "gated");
+    m_service->gate.release();
+
+    QTRY_COMPARE(finished.count(), 1);
+    QCOMPARE(finished.at(0).at(0).toInt(), jobId);
+    QCOMPARE(finished.at(0).at(1).value<ExportJobState>(), ExportJobState::Failed);
+    QCOMPARE(failed.count(), 1);
+    QCOMPARE(m_controller->activeExportCount(), 0);
+}
+
+void TestDataExportController::cancelQueuedJobNeverRuns() {
+    QSignalSpy finished(m_controller, &DataExportController::exportJobFinished);
+
+    // One worker: the second job waits behind the first
+    int running = m_controller->submitExport(numberedTests(1), "first.gated", "gated");
+    int waiting = m_controller->submitExport(numberedTests(1), "second.gated", "gated");
+    QTRY_COMPARE(m_controller->getExportState(running), ExportJobState::Running);
+    QCOMPARE(m_controller->getExportState(waiting), ExportJobState::Queued);
+    QCOMPARE(m_controller->activeExportCount(), 2);
+
+    QVERIFY(m_controller->cancelExport(waiting));
+    m_service->gate.release();
+
+    QTRY_COMPARE(finished.count(), 2);
+    QCOMPARE(finished.at(0).at(0).toInt(), running);
+    QCOMPARE(finished.at(0).at(1).value<ExportJobState>(), ExportJobState::Completed);
+    QCOMPARE(finished.at(1).at(0).toInt(), waiting);
+    QCOMPARE(finished.at(1).at(1).value<ExportJobState>(), ExportJobState::Cancelled);
+    QCOMPARE(m_service->started(), 1);
+    QCOMPARE(m_controller->activeExportCount(), 0);
+}
+
+void TestDataExportController::cancelRunningJob() {
+    QSignalSpy failed(m_controller, &DataExportController::exportFailed);
+    QSignalSpy finished(m_controller, &DataExportController::exportJobFinished);
+
+    int jobId = m_controller->submitExport(numberedTests(5), "cancelled.gated", "gated");
+    QTRY_COMPARE(m_controller->getExportState(jobId), ExportJobState::Running);
+
+    QVERIFY(m_controller->cancelExport(jobId));
+    m_service->gate.release();
+
+    QTRY_COMPARE(finished.count(), 1);
+    QCOMPARE(finished.at(0).at(1).value<ExportJobState>(), ExportJobState::Cancelled);
+    QCOMPARE(failed.count(), 0);
+}
+
+void TestDataExportController::storedTestsAreLoadedByWorker() {
+    QThread* mainThread = QThread::currentThread();
+    std::atomic<bool> loadedOnWorker{true};
+    m_controller->setTestLoader([mainThread, &loadedOnWorker](int testId) {
+        loadedOnWorker = loadedOnWorker && QThread::currentThread() != mainThread;
+        Test test = TestData::tensileTest(QString("stored %1").arg(testId), 50);
+        test.setId(testId);
+        return test;
+    });
+    QSignalSpy finished(m_controller, &DataExportController::exportJobFinished);
+
+    int jobId = m_controller->submitExport(QVector<int>{5, 6}, "stored.gated", "gated");
+    QVERIFY(jobId > 0);
+    m_service->gate.release();
+
+    QTRY_COMPARE(finished.count(), 1);
+    QCOMPARE(finished.at(0).at(1).value<ExportJobState>(), ExportJobState::Completed);
+    QVERIFY(loadedOnWorker);
+    QCOMPARE(m_service->exported(), (QVector<QPair<int, int>>{{5, 50}, {6, 50}}));
+}
+
+void TestDataExportController::unloadableTestFailsJob() {
+    m_controller->setTestLoader([](int testId) {
+        Test test = TestData::tensileTest("stored", 10);
+        test.setId(testId == 2 ? -1 : testId);
+        return test;
+    });
+    QSignalSpy finished(m_controller, &DataExportController::exportJobFinished);
+
+    m_controller->submitExport(QVector<int>{1, 2}, "missing.gated", "gated");
+
+    QTRY_COMPARE(finished.count(), 1);
+    QCOMPARE(finished.at(0).at(1).value<ExportJobState>(), ExportJobState::Failed);
+    QCOMPARE(m_service->started(), 0);
+}
+
+void TestDataExportController::storedTestsNeedLoader() {
+    QSignalSpy failed(m_controller, &DataExportController::exportFailed);
+
+    QCOMPARE(m_controller->submitExport(QVector<int>{1}, "unloaded.gated", "gated"), -1);
+    QCOMPARE(m_controller->submitExport(numberedTests(1), "unknown.xyz", "xyz"), -1);
+    QCOMPARE(failed.count(), 2);
+    QCOMPARE(m_controller->activeExportCount(), 0);
+}
+
+QTEST_GUILESS_MAIN(TestDataExportController)
+#include "tst_dataexportcontroller.moc"
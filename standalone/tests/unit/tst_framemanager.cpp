@@ -0,0 +1,150 @@
+#include <QtTest>
+#include <QTemporaryDir>
+#include <QSignalSpy>
+#include <atomic>
+#include "application/controllers/FrameManager.h"
+#include "application/controllers/HardwareController.h"
+#include "application/controllers/TestController.h"
+#include "infrastructure/hardware/MockUTMDriver.h"
+#include "infrastructure/persistence/DatabaseManager.h"
+#include "infrastructure/persistence/SQLiteTestRepository.h"
+#include "core/Logger.h"
+#include "TestData.h"
+
+using namespace HorizonUTM;
+
+class TestFrameManager : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void framesRunConcurrently();
+    void frameStateIsIndependent();
+
+private:
+    /**
+     * @brief Manager with count simulated frames on their own threads
+     */
+    FrameManager* createFrames(int count, int samplingRateHz);
+
+    /**
+     * @brief Test ready to run on a frame
+     */
+    static Test readyTest(const QString& sampleName);
+
+    QTemporaryDir m_dir;
+    SQLiteTestRepository* m_repository = nullptr;
+    TestController* m_testController = nullptr;
+};
+
+void TestFrameManager::initTestCase() {
+    Logger::initialize(LogLevel::Warning);
+    QVERIFY(m_dir.isValid());
+    QVERIFY(DatabaseManager::instance().initialize(m_dir.filePath("frames.db")));
+    m_repository = new SQLiteTestRepository();
+    m_testController = new TestController(m_repository);
+}
+
+void TestFrameManager::cleanupTestCase() {
+    delete m_testController;
+    delete m_repository;
+    DatabaseManager::instance().close();
+}
+
+FrameManager* TestFrameManager::createFrames(int count, int samplingRateHz) {
+    auto* manager = new FrameManager(m_testController);
+    for (int i = 0; i < count; ++i) {
+        auto* driver = new MockUTMDriver();
+        driver->setSamplingRate(samplingRateHz);
+        driver->setStopSettleTime(10);
+        manager->addFrame(driver, QString("Frame %1").arg(i + 1));
+        manager->connectFrame(i);
+    }
+    return manager;
+}
+
+Test TestFrameManager::readyTest(const QString& sampleName) {
+    Test test = TestData::tensileTest(sampleName);
+    test.setStatus(TestStatus::Ready);
+    test.setSpeed(500.0);
+    return test;
+}
+
+void TestFrameManager::framesRunConcurrently() {
+    const int frames = 8;
+    const int rateHz = 1000;
+    const int runMs = 500;
+
+    FrameManager* manager = createFrames(frames, rateHz);
+    QSignalSpy started(manager, &FrameManager::testStarted);
+    QSignalSpy finalized(manager, &FrameManager::testFinalized);
+
+    // Count points per frame as they are acquired, on the frame threads
+    QVector<std::shared_ptr<std::atomic<int>>> received;
+    for (int i = 0; i < frames; ++i) {
+        auto counter = std::make_shared<std::atomic<int>>(0);
+        received.append(counter);
+        connect(manager->frame(i), &HardwareController::sensorDataReceived, manager->frame(i),
+                [counter](SensorData) { ++*counter; }, Qt::DirectConnection);
+    }
+
+    for (int i = 0; i < frames; ++i) {
+        manager->startTest(i, readyTest(QString("frame-%1").arg(i)));
+    }
+    QTRY_COMPARE(started.count(), frames);
+
+    QTest::qWait(runMs);
+    for (int i = 0; i < frames; ++i) {
+        manager->stopTest(i);
+    }
+    QTRY_COMPARE_WITH_TIMEOUT(finalized.count(), frames, 20000);
+
+    // Every frame kept up with its own rate and saved exactly its own points
+    QHash<int, int> frameOfTest;
+    for (const QList<QVariant>& args : started) {
+        frameOfTest.insert(args.at(1).toInt(), args.at(0).toInt());
+    }
+    for (const QList<QVariant>& args : finalized) {
+        QVERIFY(args.at(2).toBool());
+        int frame = args.at(0).toInt();
+        int testId = args.at(1).toInt();
+        QCOMPARE(frameOfTest.value(testId, -1), frame);
+
+        Test stored = m_testController->getTest(testId);
+        QCOMPARE(stored.getSampleName(), QString("frame-%1").arg(frame));
+        QCOMPARE(stored.getDataPointCount(), received[frame]->load());
+        QVERIFY2(stored.getDataPointCount() >= runMs * rateHz / 1000 * 9 / 10,
+                 qPrintable(QString("frame %1: %2 points").arg(frame).arg(stored.getDataPointCount())));
+    }
+    delete manager;
+}
+
+void TestFrameManager::frameStateIsIndependent() {
+    FrameManager* manager = createFrames(2, 1000);
+    QSignalSpy started(manager, &FrameManager::testStarted);
+    QSignalSpy ended(manager, &FrameManager::testEnded);
+    QSignalSpy finalized(manager, &FrameManager::testFinalized);
+
+    manager->startTest(0, readyTest("first"));
+    manager->startTest(1, readyTest("second"));
+    QTRY_COMPARE(started.count(), 2);
+
+    // Stopping one frame leaves the other running
+    manager->stopTest(0);
+    QTRY_COMPARE(finalized.count(), 1);
+    QCOMPARE(finalized.first().at(0).toInt(), 0);
+    QCOMPARE(ended.count(), 1);
+    QTest::qWait(50);
+    QCOMPARE(ended.count(), 1);
+
+    manager->stopTest(1);
+    QTRY_COMPARE(finalized.count(), 2);
+    QCOMPARE(finalized.last().at(0).toInt(), 1);
+
+    delete manager;
+}
+
+QTEST_GUILESS_MAIN(TestFrameManager)
+#include "tst_framemanager.moc"
@@ -0,0 +1,326 @@
+#include <QtTest>
+#include <QDir>
+#include <QTemporaryDir>
+#include <QSignalSpy>
+#include "application/controllers/HardwareController.h"
+#include "application/controllers/TestController.h"
+#include "infrastructure/hardware/MockUTMDriver.h"
+#include "infrastructure/persistence/DatabaseManager.h"
+#include "infrastructure/persistence/SQLiteTestRepository.h"
+#include "infrastructure/persistence/CurveSpillFile.h"
+#include "core/Logger.h"
+#include "TestData.h"
+
+using namespace HorizonUTM;
+
+class TestHardwareController : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void init();
+    void cleanup();
+    void cleanupTestCase();
+
+    void stopReturnsBeforeMachineSettles();
+    void stoppedTestIsFinalizedInBackground();
+    void nextTestStartsWhilePreviousIsSaved();
+    void secondStopIsRejected();
+    void disconnectWhileStoppingKeepsData();
+    void filterKeepsRawSamplesAlongside();
+    void stagesFollowDriverSampleRate();
+    void recordingPolicyStoresFewerSamples();
+    void spillFileIsReleasedAfterEachTest();
+    void filteredRunSharesLiveBufferBudget();
+
+private:
+    /**
+     * @brief Start a test and let it acquire for a while
+     */
+    int startAndAcquire(const QString& sampleName);
+
+    QTemporaryDir m_dir;
+    SQLiteTestRepository* m_repository = nullptr;
+    TestController* m_testController = nullptr;
+    MockUTMDriver* m_driver = nullptr;
+    HardwareController* m_hardware = nullptr;
+};
+
+void TestHardwareController::initTestCase() {
+    Logger::initialize(LogLevel::Warning);
+    QVERIFY(m_dir.isValid());
+    QVERIFY(DatabaseManager::instance().initialize(m_dir.filePath("hardware.db")));
+    m_repository = new SQLiteTestRepository();
+}
+
+void TestHardwareController::init() {
+    m_testController = new TestController(m_repository);
+    m_driver = new MockUTMDriver();
+    m_driver->setSamplingRate(10000);
+    m_driver->setStopSettleTime(100);
+    m_hardware = new HardwareController(m_driver, m_testController);
+    QVERIFY(m_hardware->connectToHardware());
+}
+
+void TestHardwareController::cleanup() {
+    delete m_hardware;
+    delete m_driver;
+    delete m_testController;
+    m_hardware = nullptr;
+}
+
+void TestHardwareController::cleanupTestCase() {
+    delete m_repository;
+    DatabaseManager::instance().close();
+}
+
+int TestHardwareController::startAndAcquire(const QString& sampleName) {
+    Test test = TestData::tensileTest(sampleName);
+    test.setStatus(TestStatus::Ready);
+    test.setSpeed(500.0);
+    if (!m_hardware->startTest(test)) {
+        return -1;
+    }
+    QTest::qWait(50);
+    return test.getId();
+}
+
+void TestHardwareController::stopReturnsBeforeMachineSettles() {
+    QSignalSpy stopped(m_hardware, &HardwareController::testStopped);
+    QVERIFY(startAndAcquire("settle") > 0);
+
+    QVERIFY(m_hardware->stopTest());
+    QCOMPARE(m_hardware->getTestPhase(), TestPhase::Stopping);
+    QVERIFY(m_hardware->isTestRunning());
+    QCOMPARE(stopped.count(), 0);
+
+    QTRY_COMPARE(stopped.count(), 1);
+    QCOMPARE(m_hardware->getTestPhase(), TestPhase::Idle);
+    QVERIFY(!m_hardware->isTestRunning());
+}
+
+void TestHardwareController::stoppedTestIsFinalizedInBackground() {
+    QSignalSpy analyzed(m_hardware, &HardwareController::testAnalyzed);
+    QSignalSpy finalized(m_hardware, &HardwareController::testFinalized);
+
+    int testId = startAndAcquire("finalized");
+    QVERIFY(testId > 0);
+    QVERIFY(m_hardware->stopTest());
+
+    QTRY_COMPARE(finalized.count(), 1);
+    QCOMPARE(finalized.first().at(0).toInt(), testId);
+    QVERIFY(finalized.first().at(1).toBool());
+    QCOMPARE(analyzed.count(), 1);
+
+    Test stored = m_repository->getTest(testId);
+    QCOMPARE(stored.getStatus(), TestStatus::Stopped);
+    QVERIFY(stored.getDataPointCount() > 0);
+    QVERIFY(stored.getResult().maxStress > 0.0);
+}
+
+void TestHardwareController::nextTestStartsWhilePreviousIsSaved() {
+    QSignalSpy finalized(m_hardware, &HardwareController::testFinalized);
+
+    int firstId = startAndAcquire("first");
+    QVERIFY(firstId > 0);
+    QVERIFY(m_hardware->stopTest());
+    QTRY_COMPARE(m_hardware->getTestPhase(), TestPhase::Idle);
+
+    // The machine is free before the first test has been saved
+    int secondId = startAndAcquire("second");
+    QVERIFY(secondId > firstId);
+    QVERIFY(m_hardware->stopTest());
+
+    QTRY_COMPARE(finalized.count(), 2);
+    QCOMPARE(finalized.at(0).at(0).toInt(), firstId);
+    QCOMPARE(finalized.at(1).at(0).toInt(), secondId);
+    QCOMPARE(m_hardware->pendingFinalizations(), 0);
+
+    QVERIFY(m_repository->getTest(firstId).getDataPointCount() > 0);
+    QVERIFY(m_repository->getTest(secondId).getDataPointCount() > 0);
+}
+
+void TestHardwareController::secondStopIsRejected() {
+    QVERIFY(startAndAcquire("twice") > 0);
+
+    QVERIFY(m_hardware->stopTest());
+    QVERIFY(!m_hardware->stopTest());
+
+    QTRY_COMPARE(m_hardware->getTestPhase(), TestPhase::Idle);
+    QVERIFY(!m_hardware->stopTest());
+}
+
+void TestHardwareController::disconnectWhileStoppingKeepsData() {
+    QSignalSpy finalized(m_hardware, &HardwareController::testFinalized);
+
+    int testId = startAndAcquire("unplugged");
+    QVERIFY(testId > 0);
+    QVERIFY(m_hardware->stopTest());
+    QVERIFY(m_hardware->disconnectFromHardware());
+    QCOMPARE(m_hardware->getTestPhase(), TestPhase::Idle);
+
+    QTRY_COMPARE(finalized.count(), 1);
+    QVERIFY(m_repository->getTest(testId).getDataPointCount() > 0);
+}
+
+void TestHardwareController::filterKeepsRawSamplesAlongside() {
+    FilterSettings settings;
+    settings.type = FilterType::MovingAverage;
+    settings.windowSize = 9;
+    settings.sampleRateHz = 10000.0;
+    QVERIFY(m_hardware->setFilter(settings));
+
+    QSignalSpy filtered(m_hardware, &HardwareController::sensorDataReceived);
+    QSignalSpy raw(m_hardware, &HardwareController::rawSensorDataReceived);
+    QVERIFY(startAndAcquire("filtered") > 0);
+    QVERIFY(!m_hardware->setFilter(FilterSettings()));
+    QVERIFY(m_hardware->stopTest());
+    QTRY_COMPARE(m_hardware->getTestPhase(), TestPhase::Idle);
+
+    QVERIFY(filtered.count() > 100);
+    QCOMPARE(raw.count(), filtered.count());
+
+    // Sample-to-sample noise is what the filter removes
+    auto roughness = [](QSignalSpy& spy) {
+        double sum = 0.0;
+        for (int i = 1; i < spy.count(); ++i) {
+            sum += qAbs(spy.at(i).at(0).value<SensorData>().force
+                        - spy.at(i - 1).at(0).value<SensorData>().force);
+        }
+        return sum;
+    };
+    QVERIFY(roughness(filtered) < roughness(raw) / 2.0);
+
+    const SensorData first = filtered.first().at(0).value<SensorData>();
+    QCOMPARE(first.timestamp, raw.first().at(0).value<SensorData>().timestamp);
+}
+
+void TestHardwareController::stagesFollowDriverSampleRate() {
+    FilterSettings settings;
+    settings.type = FilterType::Butterworth;
+    settings.cutoffHz = 200.0;
+    settings.sampleRateHz = 100.0;     // not what the driver delivers
+    QVERIFY(m_hardware->setFilter(settings));
+    QCOMPARE(m_hardware->getFilter().sampleRateHz, 10000.0);
+    QCOMPARE(m_hardware->getFilter().cutoffHz, 200.0);
+
+    BreakCaptureSettings capture;
+    capture.enabled = true;
+    QVERIFY(m_hardware->setBreakCapture(capture));
+    QCOMPARE(m_hardware->getBreakCapture().sampleRateHz, 10000.0);
+
+    // Redesigned when the driver changes rate
+    QVERIFY(m_driver->setSamplingRate(2000));
+    QCOMPARE(m_hardware->getFilter().sampleRateHz, 2000.0);
+    QCOMPARE(m_hardware->getBreakCapture().sampleRateHz, 2000.0);
+
+    // Deferred to the next test while one is running
+    QVERIFY(startAndAcquire("rate") > 0);
+    QVERIFY(m_driver->setSamplingRate(5000));
+    QCOMPARE(m_hardware->getFilter().sampleRateHz, 2000.0);
+    QVERIFY(m_hardware->stopTest());
+    QTRY_COMPARE(m_hardware->getTestPhase(), TestPhase::Idle);
+    QVERIFY(startAndAcquire("rate") > 0);
+    QCOMPARE(m_hardware->getFilter().sampleRateHz, 5000.0);
+    QCOMPARE(m_hardware->getBreakCapture().sampleRateHz, 5000.0);
+    QVERIFY(m_hardware->stopTest());
+    QTRY_COMPARE(m_hardware->getTestPhase(), TestPhase::Idle);
+}
+
+void TestHardwareController::recordingPolicyStoresFewerSamples() {
+    RecordingSettings settings;
+    settings.enabled = true;
+    settings.forceDeadband = 20.0;
+    settings.extensionDeadband = 0.05;
+    settings.eventWindowMs = 5;
+    QVERIFY(m_hardware->setRecordingPolicy(settings));
+
+    QSignalSpy received(m_hardware, &HardwareController::sensorDataReceived);
+    QSignalSpy finalized(m_hardware, &HardwareController::testFinalized);
+    int testId = startAndAcquire("deadband");
+    QVERIFY(testId > 0);
+    QVERIFY(!m_hardware->setRecordingPolicy(RecordingSettings()));
+    QVERIFY(m_hardware->stopTest());
+    QTRY_COMPARE(finalized.count(), 1);
+
+    // The UI sees every sample, the curve only what the policy kept
+    Test stored = m_repository->getTest(testId);
+    QVERIFY(stored.getDataPointCount() > 0);
+    QVERIFY(stored.getDataPointCount() < received.count());
+    QCOMPARE(stored.getCurve().last().timestamp,
+             received.last().at(0).value<SensorData>().timestamp);
+}
+
+void TestHardwareController::spillFileIsReleasedAfterEachTest() {
+    QTemporaryDir spillDir;
+    QVERIFY(spillDir.isValid());
+    auto spillFiles = [&spillDir]() {
+        return QDir(spillDir.path()).entryList(QDir::Files).size();
+    };
+    auto spilledBytes = [&spillDir]() {
+        qint64 bytes = 0;
+        for (const QFileInfo& file : QDir(spillDir.path()).entryInfoList(QDir::Files)) {
+            bytes += file.size();
+        }
+        return bytes;
+    };
+
+    int stores = 0;
+    m_hardware->setLiveBufferBudget(qint64(Curve::BLOCK_SIZE) * qint64(sizeof(SensorData)),
+        [&stores, &spillDir]() {
+            ++stores;
+            return std::make_shared<CurveSpillFile>(spillDir.path());
+        });
+
+    QSignalSpy finalized(m_hardware, &HardwareController::testFinalized);
+    for (int run = 1; run <= 2; ++run) {
+        Test test = TestData::tensileTest(QString("spilled %1").arg(run));
+        test.setStatus(TestStatus::Ready);
+        test.setSpeed(50.0);
+        QVERIFY(m_hardware->startTest(test));
+        QTRY_VERIFY(spilledBytes() > 0);
+
+        // Only this test's file exists
+        QCOMPARE(spillFiles(), 1);
+
+        QVERIFY(m_hardware->stopTest());
+        QTRY_COMPARE(finalized.count(), run);
+        QVERIFY(m_repository->getTest(test.getId()).getDataPointCount() > int(Curve::BLOCK_SIZE));
+
+        // Gone once the curve is saved, nothing carried into the next test
+        QTRY_COMPARE(spillFiles(), 0);
+    }
+    QCOMPARE(stores, 2);
+}
+
+void TestHardwareController::filteredRunSharesLiveBufferBudget() {
+    QTemporaryDir spillDir;
+    QVERIFY(spillDir.isValid());
+    const qint64 blockBytes = qint64(Curve::BLOCK_SIZE) * qint64(sizeof(SensorData));
+    m_hardware->setLiveBufferBudget(2 * blockBytes, [&spillDir]() {
+        return std::make_shared<CurveSpillFile>(spillDir.path());
+    });
+
+    FilterSettings settings;
+    settings.type = FilterType::MovingAverage;
+    settings.windowSize = 9;
+    settings.sampleRateHz = 10000.0;
+    QVERIFY(m_hardware->setFilter(settings));
+
+    Test test = TestData::tensileTest("budget");
+    test.setStatus(TestStatus::Ready);
+    test.setSpeed(50.0);
+    QVERIFY(m_hardware->startTest(test));
+    QTRY_VERIFY(m_hardware->getLiveRawCurve().size() > 3 * Curve::BLOCK_SIZE);
+
+    // Half the budget each: one sealed block plus the open one in RAM
+    const Curve raw = m_hardware->getLiveRawCurve();
+    QVERIFY(raw.spilledCount() > 0);
+    QVERIFY(raw.size() - raw.spilledCount() < 2 * Curve::BLOCK_SIZE);
+
+    QVERIFY(m_hardware->stopTest());
+    QTRY_COMPARE(m_hardware->getTestPhase(), TestPhase::Idle);
+}
+
+QTEST_GUILESS_MAIN(TestHardwareController)
+#include "tst_hardwarecontroller.moc"
@@ -0,0 +1,196 @@
+#include <QtTest>
+#include <QTemporaryDir>
+#include <QFile>
+#include <QThread>
+#include "core/Logger.h"
+#include "core/LogThrottle.h"
+
+using namespace HorizonUTM;
+
+namespace {
+
+QStringList readLines(const QString& filePath) {
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return QStringList();
+    }
+    return QString::fromUtf8(file.readAll()).split('\n', Qt::SkipEmptyParts);
+}
+
+// Console output of the writer thread is not part of these tests
+void quietMessageHandler(QtMsgType, const QMessageLogContext&, const QString&) {
+}
+
+} // namespace
+
+class TestLogger : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void init();
+
+    void flushWritesEverything();
+    void levelFilterDropsRecords();
+    void disabledMessageIsNotEvaluated();
+    void concurrentProducersKeepPerThreadOrder();
+    void errorIsFlushedWithoutWaitingForInterval();
+
+    void everyNReportsSuppressedCount();
+    void firstNThenSummarizes();
+    void rateLimiterResetsEachPeriod();
+
+private:
+    QTemporaryDir m_dir;
+    QString m_path;
+    int m_fileIndex = 0;
+};
+
+void TestLogger::initTestCase() {
+    QVERIFY(m_dir.isValid());
+    qInstallMessageHandler(quietMessageHandler);
+}
+
+void TestLogger::init() {
+    // Fresh file per test
+    m_path = m_dir.filePath(QString("log_%1.log").arg(++m_fileIndex));
+    Logger::instance().setLogLevel(LogLevel::Debug);
+    Logger::instance().setFlushInterval(100);
+    Logger::instance().setLogFile(m_path);
+}
+
+void TestLogger::flushWritesEverything() {
+    for (int i = 0; i < 1000; ++i) {
+        LOG_INFO(QString("message %1").arg(i));
+    }
+    Logger::instance().flush();
+
+    QStringList lines = readLines(m_path);
+    QCOMPARE(lines.size(), 1000);
+    QVERIFY(lines.first().contains("[INFO]"));
+    QVERIFY(lines.first().endsWith("message 0"));
+    QVERIFY(lines.last().endsWith("message 999"));
+}
+
+void TestLogger::levelFilterDropsRecords() {
+    Logger::instance().setLogLevel(LogLevel::Warning);
+    QVERIFY(!Logger::instance().isEnabled(LogLevel::Info));
+    QVERIFY(Logger::instance().isEnabled(LogLevel::Error));
+
+    LOG_DEBUG("dropped");
+    LOG_INFO("dropped");
+    LOG_WARNING("kept");
+    Logger::instance().flush();
+
+    QStringList lines = readLines(m_path);
+    QCOMPARE(lines.size(), 1);
+    QVERIFY(lines.first().contains("[WARNING]"));
+}
+
+void TestLogger::disabledMessageIsNotEvaluated() {
+    int evaluations = 0;
+    auto message = [&evaluations]() {
+        ++evaluations;
+        return QString("built");
+    };
+
+    Logger::instance().setLogLevel(LogLevel::Error);
+    LOG_DEBUG(message());
+    LOG_WARNING(message());
+    QCOMPARE(evaluations, 0);
+
+    LOG_ERROR(message());
+    QCOMPARE(evaluations, 1);
+}
+
+void TestLogger::concurrentProducersKeepPerThreadOrder() {
+    constexpr int THREADS = 8;
+    constexpr int MESSAGES = 2000;
+
+    QVector<QThread*> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.append(QThread::create([t]() {
+            for (int i = 0; i < MESSAGES; ++i) {
+                Logger::instance().debug(QString("%1:%2").arg(t).arg(i), "producer");
+            }
+        }));
+    }
+    for (QThread* thread : threads) {
+        thread->start();
+    }
+    for (QThread* thread : threads) {
+        QVERIFY(thread->wait(30000));
+        delete thread;
+    }
+    Logger::instance().flush();
+
+    QStringList lines = readLines(m_path);
+    QCOMPARE(lines.size(), THREADS * MESSAGES);
+
+    QVector<int> next(THREADS, 0);
+    for (const QString& line : lines) {
+        QStringList ids = line.section(": ", -1).split(':');
+        QCOMPARE(ids.size(), 2);
+        int t = ids[0].toInt();
+        QCOMPARE(ids[1].toInt(), next[t]);
+        ++next[t];
+    }
+}
+
+void TestLogger::errorIsFlushedWithoutWaitingForInterval() {
+    Logger::instance().setFlushInterval(60000);
+    LOG_INFO("before");
+    LOG_ERROR("failure");
+
+    QTRY_COMPARE_WITH_TIMEOUT(readLines(m_path).size(), 2, 5000);
+    QVERIFY(readLines(m_path).last().contains("[ERROR]"));
+}
+
+void TestLogger::everyNReportsSuppressedCount() {
+    for (int i = 0; i < 250; ++i) {
+        LOG_EVERY_N(Info, 100, QString("sample %1").arg(i));
+    }
+    Logger::instance().flush();
+
+    QStringList lines = readLines(m_path);
+    QCOMPARE(lines.size(), 3);
+    QVERIFY(lines[0].endsWith("sample 0"));
+    QVERIFY(lines[1].endsWith("sample 100 (99 similar suppressed)"));
+    QVERIFY(lines[2].endsWith("sample 200 (99 similar suppressed)"));
+}
+
+void TestLogger::firstNThenSummarizes() {
+    LogFirstN throttle(3, 50);
+
+    int passed = 0;
+    for (int i = 0; i < 10; ++i) {
+        passed += throttle.check().pass ? 1 : 0;
+    }
+    // Only the first three until the period is over
+    QCOMPARE(passed, 3);
+
+    QTest::qSleep(60);
+    LogGate summary = throttle.check();
+    QVERIFY(summary.pass);
+    QCOMPARE(summary.suppressed, qint64(7));
+
+    // The next summary waits for another period
+    QVERIFY(!throttle.check().pass);
+}
+
+void TestLogger::rateLimiterResetsEachPeriod() {
+    LogRateLimiter throttle(2, 50);
+
+    QVERIFY(throttle.check().pass);
+    QVERIFY(throttle.check().pass);
+    QVERIFY(!throttle.check().pass);
+    QVERIFY(!throttle.check().pass);
+
+    QTest::qSleep(60);
+    LogGate gate = throttle.check();
+    QVERIFY(gate.pass);
+    QCOMPARE(gate.suppressed, qint64(2));
+}
+
+QTEST_GUILESS_MAIN(TestLogger)
+#include "tst_logger.moc"
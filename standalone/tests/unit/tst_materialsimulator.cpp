@@ -0,0 +1,184 @@
+#include <QtTest>
+#include "infrastructure/hardware/MaterialSimulator.h"
+
+using namespace HorizonUTM;
+
+namespace {
+
+/**
+ * @brief Strains from 0 to just below the break
+ */
+QVector<double> strainsOf(const MaterialParameters& material, int count) {
+    QVector<double> strains(count);
+    for (int i = 0; i < count; ++i) {
+        strains[i] = material.breakStrain * (i + 1) / (count + 1);
+    }
+    return strains;
+}
+
+MaterialParameters noiseless(MaterialParameters material) {
+    material.noise = 0.0;
+    return material;
+}
+
+} // namespace
+
+class TestMaterialSimulator : public QObject {
+    Q_OBJECT
+
+private slots:
+    void batchMatchesScalar_data();
+    void batchMatchesScalar();
+    void noiseStaysWithinAmplitude();
+    void sameSeedSameCurve();
+    void sampleBatchFollowsGridUpToBreak();
+    void linearElasticIsHookean();
+    void rambergOsgoodPassesYieldOffset();
+    void hyperelasticInitialModulus();
+    void presetsByName();
+};
+
+void TestMaterialSimulator::batchMatchesScalar_data() {
+    QTest::addColumn<QString>("material");
+    for (const char* name : {"ductile", "brittle", "elastomer", "metal"}) {
+        QTest::newRow(name) << QString(name);
+    }
+}
+
+void TestMaterialSimulator::batchMatchesScalar() {
+    QFETCH(QString, material);
+    MaterialSimulator simulator(MaterialParameters::byName(material));
+    QVector<double> strains = strainsOf(simulator.parameters(), 10000);
+
+    FastRandom batchRandom(7);
+    QVector<double> stresses(strains.size());
+    simulator.stressBatch(strains.constData(), stresses.data(), strains.size(), batchRandom);
+
+    FastRandom scalarRandom(7);
+    for (int i = 0; i < strains.size(); ++i) {
+        QCOMPARE(stresses[i], simulator.stressAt(strains[i], scalarRandom));
+    }
+}
+
+void TestMaterialSimulator::noiseStaysWithinAmplitude() {
+    MaterialParameters material = MaterialParameters::ductile();
+    material.noise = 0.05;
+    MaterialSimulator simulator(material);
+    FastRandom random(1);
+
+    double lowest = 1.0;
+    double highest = -1.0;
+    for (double strain : strainsOf(material, 10000)) {
+        double ratio = simulator.stressAt(strain, random) / simulator.idealStressAt(strain) - 1.0;
+        lowest = qMin(lowest, ratio);
+        highest = qMax(highest, ratio);
+    }
+
+    QVERIFY(lowest >= -0.05 - 1e-12);
+    QVERIFY(highest < 0.05 + 1e-12);
+    // Spread over the whole band
+    QVERIFY(lowest < -0.045);
+    QVERIFY(highest > 0.045);
+}
+
+void TestMaterialSimulator::sameSeedSameCurve() {
+    MaterialSimulator simulator(MaterialParameters::metal());
+    QVector<double> strains = strainsOf(simulator.parameters(), 1000);
+    QVector<double> first(strains.size());
+    QVector<double> second(strains.size());
+    QVector<double> other(strains.size());
+
+    FastRandom a(42), b(42), c(43);
+    simulator.stressBatch(strains.constData(), first.data(), strains.size(), a);
+    simulator.stressBatch(strains.constData(), second.data(), strains.size(), b);
+    simulator.stressBatch(strains.constData(), other.data(), strains.size(), c);
+
+    QCOMPARE(first, second);
+    QVERIFY(first != other);
+}
+
+void TestMaterialSimulator::sampleBatchFollowsGridUpToBreak() {
+    MaterialSimulator simulator(noiseless(MaterialParameters::brittle()));
+    ConstantSpeedRun run;
+    run.speedMmPerMin = 60.0;       // 1 mm/s
+    run.gaugeLength = 50.0;
+    run.crossSection = 40.0;
+    run.samplingRateHz = 100;
+    run.startMs = 1000;
+
+    QVector<SensorData> samples;
+    FastRandom random(1);
+    QCOMPARE(simulator.sampleBatch(run, 1, 10, samples, random), 10);
+    QCOMPARE(samples.size(), qsizetype(10));
+    QCOMPARE(samples[0].timestamp, qint64(1010));
+    QCOMPARE(samples[9].timestamp, qint64(1100));
+    QCOMPARE(samples[9].extension, 0.1);
+    QCOMPARE(samples[9].strain, 0.2);
+    QCOMPARE(samples[9].stress, simulator.idealStressAt(0.2));
+    QCOMPARE(samples[9].force, samples[9].stress * 40.0);
+
+    // Short batch at the break strain
+    const qint64 breakIndex = qint64(simulator.parameters().breakStrain / 100.0 * 50.0 * 100.0);
+    int count = simulator.sampleBatch(run, breakIndex - 4, 10, samples, random);
+    QVERIFY(count < 10);
+    QCOMPARE(samples.size(), qsizetype(count));
+    QVERIFY(samples.last().strain < simulator.parameters().breakStrain);
+}
+
+void TestMaterialSimulator::linearElasticIsHookean() {
+    MaterialSimulator simulator(noiseless(MaterialParameters::brittle()));
+    const double modulusMPa = simulator.parameters().elasticModulus * 1000.0;
+
+    QCOMPARE(simulator.idealStressAt(0.0), 0.0);
+    QCOMPARE(simulator.idealStressAt(1.0), modulusMPa * 0.01);
+    QCOMPARE(simulator.idealStressAt(1.7), modulusMPa * 0.017);
+}
+
+void TestMaterialSimulator::rambergOsgoodPassesYieldOffset() {
+    const MaterialParameters metal = MaterialParameters::metal();
+    MaterialSimulator simulator(noiseless(metal));
+    const double modulusMPa = metal.elasticModulus * 1000.0;
+
+    // 0.2% plastic strain at the yield stress
+    double yieldStrain = (metal.yieldStress / modulusMPa + 0.002) * 100.0;
+    QVERIFY(qAbs(simulator.idealStressAt(yieldStrain) - metal.yieldStress) < 0.01 * metal.yieldStress);
+
+    // Nearly elastic well below yield
+    QVERIFY(qAbs(simulator.idealStressAt(0.05) - modulusMPa * 0.0005) < 0.01 * modulusMPa * 0.0005);
+
+    // Hardening up to uniform elongation, necking after it
+    QVERIFY(simulator.idealStressAt(metal.plasticEnd) > simulator.idealStressAt(metal.plasticEnd / 2));
+    QVERIFY(simulator.idealStressAt(metal.breakStrain * 0.99) < simulator.idealStressAt(metal.plasticEnd));
+}
+
+void TestMaterialSimulator::hyperelasticInitialModulus() {
+    const MaterialParameters elastomer = MaterialParameters::elastomer();
+    MaterialSimulator simulator(noiseless(elastomer));
+    const double modulusMPa = elastomer.elasticModulus * 1000.0;
+
+    double slope = simulator.idealStressAt(0.01) / 0.0001;
+    QVERIFY(qAbs(slope - modulusMPa) < 0.001 * modulusMPa);
+
+    // Stiffening toward large stretches keeps the curve monotonic
+    double previous = 0.0;
+    for (double strain : strainsOf(elastomer, 500)) {
+        double stress = simulator.idealStressAt(strain);
+        QVERIFY(stress > previous);
+        previous = stress;
+    }
+}
+
+void TestMaterialSimulator::presetsByName() {
+    bool ok = false;
+    QCOMPARE(MaterialParameters::byName("metal", &ok).model, MaterialModel::RambergOsgood);
+    QVERIFY(ok);
+    QCOMPARE(MaterialParameters::byName("brittle").model, MaterialModel::LinearElastic);
+    QCOMPARE(MaterialParameters::byName("elastomer").model, MaterialModel::Hyperelastic);
+    QCOMPARE(MaterialParameters::byName("ductile").model, MaterialModel::Piecewise);
+
+    MaterialParameters::byName("unobtainium", &ok);
+    QVERIFY(!ok);
+}
+
+QTEST_APPLESS_MAIN(TestMaterialSimulator)
+#include "tst_materialsimulator.moc"
@@ -0,0 +1,172 @@
+#include <QtTest>
+#include <QSignalSpy>
+#include "infrastructure/hardware/MockUTMDriver.h"
+#include "core/Logger.h"
+
+using namespace HorizonUTM;
+
+namespace {
+
+constexpr qint64 CLOCK_START_MS = 1700000000000;
+
+/**
+ * @brief Driver at 1 kHz reading the given clock, connected
+ */
+std::unique_ptr<MockUTMDriver> driverWith(std::shared_ptr<SimulationClock> clock) {
+    auto driver = std::make_unique<MockUTMDriver>();
+    driver->setSamplingRate(1000);
+    driver->setStopSettleTime(0);
+    driver->setClock(std::move(clock));
+    driver->connect("mock");
+    return driver;
+}
+
+QVector<qint64> timestampsOf(const QSignalSpy& spy) {
+    QVector<qint64> timestamps;
+    for (const QList<QVariant>& args : spy) {
+        timestamps.append(args.at(0).value<SensorData>().timestamp);
+    }
+    return timestamps;
+}
+
+} // namespace
+
+class TestMockUTMDriver : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void realTimeFollowsClock();
+    void acceleratedFollowsClock();
+    void sameTimestampsInEveryMode();
+    void asFastAsConsumedRunsWholeTest();
+    void pauseDoesNotAdvanceSimulation();
+    void modeChangeKeepsPosition();
+};
+
+void TestMockUTMDriver::initTestCase() {
+    Logger::initialize(LogLevel::Warning);
+    qRegisterMetaType<SensorData>("SensorData");
+}
+
+void TestMockUTMDriver::realTimeFollowsClock() {
+    auto clock = std::make_shared<ManualClock>(CLOCK_START_MS);
+    auto driver = driverWith(clock);
+    QSignalSpy samples(driver.get(), &MockUTMDriver::sensorDataReceived);
+
+    QVERIFY(driver->startTest(5.0, 10000.0));
+    QTest::qWait(20);
+    QCOMPARE(samples.count(), 0);
+
+    clock->advance(100);
+    QTRY_COMPARE(samples.count(), 100);
+    QTest::qWait(20);
+    QCOMPARE(samples.count(), 100);
+}
+
+void TestMockUTMDriver::acceleratedFollowsClock() {
+    auto clock = std::make_shared<ManualClock>(CLOCK_START_MS);
+    auto driver = driverWith(clock);
+    driver->setSimulationMode(SimulationMode::Accelerated, 10.0);
+    QSignalSpy samples(driver.get(), &MockUTMDriver::sensorDataReceived);
+
+    QVERIFY(driver->startTest(5.0, 10000.0));
+    clock->advance(100);
+    QTRY_COMPARE(samples.count(), 1000);
+
+    // Simulated, not wall-clock, spacing
+    QVector<qint64> timestamps = timestampsOf(samples);
+    QCOMPARE(timestamps.first(), CLOCK_START_MS + 1);
+    QCOMPARE(timestamps.last(), CLOCK_START_MS + 1000);
+}
+
+void TestMockUTMDriver::sameTimestampsInEveryMode() {
+    const int count = 500;
+    QVector<QVector<qint64>> runs;
+
+    for (SimulationMode mode : {SimulationMode::RealTime, SimulationMode::Accelerated,
+                                SimulationMode::AsFastAsConsumed}) {
+        auto clock = std::make_shared<ManualClock>(CLOCK_START_MS);
+        auto driver = driverWith(clock);
+        driver->setSimulationMode(mode, 25.0);
+        driver->setBatchSize(100);
+        QSignalSpy samples(driver.get(), &MockUTMDriver::sensorDataReceived);
+
+        QVERIFY(driver->startTest(5.0, 10000.0));
+        clock->advance(count);
+        QTRY_VERIFY(samples.count() >= count);
+        driver->stopTest();
+
+        runs.append(timestampsOf(samples).mid(0, count));
+    }
+
+    for (int i = 0; i < count; ++i) {
+        QCOMPARE(runs[0][i], CLOCK_START_MS + i + 1);
+    }
+    QCOMPARE(runs[1], runs[0]);
+    QCOMPARE(runs[2], runs[0]);
+}
+
+void TestMockUTMDriver::asFastAsConsumedRunsWholeTest() {
+    auto driver = driverWith(nullptr);
+    driver->setSimulationMode(SimulationMode::AsFastAsConsumed);
+    QSignalSpy samples(driver.get(), &MockUTMDriver::sensorDataReceived);
+    QSignalSpy completed(driver.get(), &MockUTMDriver::testCompleted);
+
+    // 8% strain at 5 mm/min on a 50 mm gauge: 48 s of simulated time
+    QVERIFY(driver->startTest(5.0, 10000.0));
+    QTRY_COMPARE_WITH_TIMEOUT(completed.count(), 1, 30000);
+
+    QVERIFY(qAbs(samples.count() - 48000) <= 1);
+    QVector<qint64> timestamps = timestampsOf(samples);
+    QCOMPARE(timestamps.last() - timestamps.first(), qint64(samples.count() - 1));
+}
+
+void TestMockUTMDriver::pauseDoesNotAdvanceSimulation() {
+    auto clock = std::make_shared<ManualClock>(CLOCK_START_MS);
+    auto driver = driverWith(clock);
+    QSignalSpy samples(driver.get(), &MockUTMDriver::sensorDataReceived);
+
+    QVERIFY(driver->startTest(5.0, 10000.0));
+    clock->advance(100);
+    QTRY_COMPARE(samples.count(), 100);
+
+    QVERIFY(driver->pauseTest());
+    clock->advance(1000);
+    QTest::qWait(20);
+    QVERIFY(driver->resumeTest());
+    QTest::qWait(20);
+    QCOMPARE(samples.count(), 100);
+
+    clock->advance(100);
+    QTRY_COMPARE(samples.count(), 200);
+
+    // Sample 101 is 100 ms into the test, stamped after the pause
+    QVector<qint64> timestamps = timestampsOf(samples);
+    QCOMPARE(timestamps[100], CLOCK_START_MS + 1000 + 101);
+    QCOMPARE(samples.last().at(0).value<SensorData>().strain,
+             (5.0 / 60.0) * 0.2 / 50.0 * 100.0);
+}
+
+void TestMockUTMDriver::modeChangeKeepsPosition() {
+    auto clock = std::make_shared<ManualClock>(CLOCK_START_MS);
+    auto driver = driverWith(clock);
+    QSignalSpy samples(driver.get(), &MockUTMDriver::sensorDataReceived);
+
+    QVERIFY(driver->startTest(5.0, 10000.0));
+    clock->advance(100);
+    QTRY_COMPARE(samples.count(), 100);
+
+    driver->setSimulationMode(SimulationMode::Accelerated, 10.0);
+    clock->advance(10);
+    QTRY_COMPARE(samples.count(), 200);
+
+    QVector<qint64> timestamps = timestampsOf(samples);
+    for (int i = 1; i < timestamps.size(); ++i) {
+        QCOMPARE(timestamps[i] - timestamps[i - 1], qint64(1));
+    }
+}
+
+QTEST_GUILESS_MAIN(TestMockUTMDriver)
+#include "tst_mockutmdriver.moc"
@@ -0,0 +1,257 @@
+#include <QtTest>
+#include <QRandomGenerator>
+#include "domain/services/BreakDetector.h"
+#include "domain/services/RecordingPolicy.h"
+
+using namespace HorizonUTM;
+
+namespace {
+
+RecordingSettings enabledSettings() {
+    RecordingSettings settings;
+    settings.enabled = true;
+    return settings;
+}
+
+/**
+ * @brief 1 kHz samples: loading to 1000 N over 2 s, then a 60 s creep hold
+ */
+QVector<SensorData> creepTest() {
+    QRandomGenerator random(11);
+    QVector<SensorData> samples;
+    for (int i = 0; i < 62000; ++i) {
+        const double t = i / 1000.0;
+        SensorData sample;
+        sample.timestamp = i;
+        sample.force = (t < 2.0 ? 500.0 * t : 1000.0) + 0.6 * random.generateDouble() - 0.3;
+        sample.extension = t < 2.0 ? 0.5 * t : 1.0 + 0.001 * (t - 2.0);
+        samples.append(sample);
+    }
+    return samples;
+}
+
+/**
+ * @brief 1 kHz samples: linear to 1000 N, hardening to a break at 10 s
+ */
+QVector<SensorData> ductileTest() {
+    QVector<SensorData> samples;
+    for (int i = 0; i < 12000; ++i) {
+        const double x = i / 1000.0;
+        SensorData sample;
+        sample.timestamp = i;
+        sample.extension = x;
+        if (x < 2.0) {
+            sample.force = 500.0 * x;
+        } else if (x < 10.0) {
+            sample.force = 1000.0 + 20.0 * (x - 2.0) - 2.0 * (x - 2.0) * (x - 2.0);
+        }
+        samples.append(sample);
+    }
+    return samples;
+}
+
+/**
+ * @brief 1 kHz samples: linear to 1000 N, maximum of 1090 N at 5 s, necking
+ *        down 8 % to a break at 8 s
+ */
+QVector<SensorData> neckingTest() {
+    QVector<SensorData> samples;
+    for (int i = 0; i < 9000; ++i) {
+        const double x = i / 1000.0;
+        SensorData sample;
+        sample.timestamp = i;
+        sample.extension = x;
+        if (x < 2.0) {
+            sample.force = 500.0 * x;
+        } else if (x < 8.0) {
+            sample.force = 1000.0 + 60.0 * (x - 2.0) - 10.0 * (x - 2.0) * (x - 2.0);
+        }
+        samples.append(sample);
+    }
+    return samples;
+}
+
+int keptWithin(const QVector<SensorData>& kept, qint64 time, qint64 window) {
+    int count = 0;
+    for (const SensorData& sample : kept) {
+        if (qAbs(sample.timestamp - time) <= window) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+struct Recording {
+    QVector<SensorData> kept;
+    QVector<QPair<RecordingEvent, qint64>> events;
+};
+
+Recording record(RecordingPolicy& policy, const QVector<SensorData>& samples) {
+    Recording recording;
+    QVector<SensorData> kept;
+    BreakDetector detector;
+    for (const SensorData& sample : samples) {
+        RecordingEvent event = policy.process(sample, kept, detector.process(sample));
+        if (event != RecordingEvent::None) {
+            recording.events.append({event, sample.timestamp});
+        }
+        recording.kept += kept;
+    }
+    policy.flush(kept);
+    recording.kept += kept;
+    return recording;
+}
+
+} // namespace
+
+class TestRecordingPolicy : public QObject {
+    Q_OBJECT
+
+private slots:
+    void disabledKeepsEverySample();
+    void creepHoldIsThinned();
+    void droppedSamplesStayWithinDeadbands();
+    void eventsDetected();
+    void fullRateAroundBreak();
+    void fullRateAroundMaximum();
+    void runningMaximumIsKept();
+    void resetStartsOver();
+};
+
+void TestRecordingPolicy::disabledKeepsEverySample() {
+    RecordingPolicy policy;
+    QVERIFY(!policy.isEnabled());
+
+    const QVector<SensorData> samples = ductileTest();
+    Recording recording = record(policy, samples);
+    QCOMPARE(recording.kept.size(), samples.size());
+    QVERIFY(recording.events.isEmpty());
+}
+
+void TestRecordingPolicy::creepHoldIsThinned() {
+    RecordingPolicy policy(enabledSettings());
+    const QVector<SensorData> samples = creepTest();
+    Recording recording = record(policy, samples);
+
+    QCOMPARE(policy.seenCount(), qint64(samples.size()));
+    QCOMPARE(policy.keptCount(), qint64(recording.kept.size()));
+    QVERIFY(recording.kept.size() * 20 < samples.size());
+
+    // In order, from the first sample to the last
+    QCOMPARE(recording.kept.first().timestamp, samples.first().timestamp);
+    QCOMPARE(recording.kept.last().timestamp, samples.last().timestamp);
+    for (int i = 1; i < recording.kept.size(); ++i) {
+        QVERIFY(recording.kept[i].timestamp > recording.kept[i - 1].timestamp);
+    }
+
+    // The hold is still sampled at least every maxIntervalMs
+    for (int i = 1; i < recording.kept.size(); ++i) {
+        QVERIFY(recording.kept[i].timestamp - recording.kept[i - 1].timestamp
+                <= enabledSettings().maxIntervalMs);
+    }
+}
+
+void TestRecordingPolicy::droppedSamplesStayWithinDeadbands() {
+    const RecordingSettings settings = enabledSettings();
+    RecordingPolicy policy(settings);
+    const QVector<SensorData> samples = creepTest();
+    Recording recording = record(policy, samples);
+
+    int next = 0;
+    SensorData lastKept;
+    for (const SensorData& sample : samples) {
+        if (next < recording.kept.size() && recording.kept[next].timestamp == sample.timestamp) {
+            lastKept = recording.kept[next++];
+            continue;
+        }
+        QVERIFY(qAbs(sample.force - lastKept.force) <= settings.forceDeadband);
+        QVERIFY(qAbs(sample.extension - lastKept.extension) <= settings.extensionDeadband);
+    }
+    QCOMPARE(next, recording.kept.size());
+}
+
+void TestRecordingPolicy::eventsDetected() {
+    RecordingPolicy policy(enabledSettings());
+    Recording recording = record(policy, ductileTest());
+
+    QCOMPARE(recording.events.size(), 2);
+    QCOMPARE(recording.events[0].first, RecordingEvent::Yield);
+    QVERIFY(recording.events[0].second > 2000 && recording.events[0].second < 2600);
+    QCOMPARE(recording.events[1].first, RecordingEvent::Break);
+    QCOMPARE(recording.events[1].second, qint64(10000));
+    QCOMPARE(recordingEventToString(RecordingEvent::Break), QString("Break"));
+}
+
+void TestRecordingPolicy::fullRateAroundBreak() {
+    const RecordingSettings settings = enabledSettings();
+    RecordingPolicy policy(settings);
+    Recording recording = record(policy, ductileTest());
+
+    const qint64 breakTime = 10000;
+    int around = 0;
+    for (const SensorData& sample : recording.kept) {
+        if (qAbs(sample.timestamp - breakTime) <= settings.eventWindowMs) {
+            ++around;
+        }
+    }
+    QCOMPARE(around, int(2 * settings.eventWindowMs + 1));
+}
+
+void TestRecordingPolicy::fullRateAroundMaximum() {
+    const RecordingSettings settings = enabledSettings();
+    const int fullRate = int(2 * settings.eventWindowMs + 1);
+
+    // Peak shows 2.3 s after the maximum, when the force is 5 % down
+    RecordingPolicy necking(settings);
+    Recording recording = record(necking, neckingTest());
+    QCOMPARE(recording.events.size(), 3);
+    QCOMPARE(recording.events[1].first, RecordingEvent::Peak);
+    QVERIFY(recording.events[1].second > 7000 && recording.events[1].second < 7600);
+    QCOMPARE(keptWithin(recording.kept, 5000, settings.eventWindowMs), fullRate);
+
+    // Ductile: 1.7 % down at the break, the maximum at 7 s is kept at full rate anyway
+    RecordingPolicy ductile(settings);
+    recording = record(ductile, ductileTest());
+    QCOMPARE(keptWithin(recording.kept, 7000, settings.eventWindowMs), fullRate);
+
+    // In order despite the reach-back
+    for (int i = 1; i < recording.kept.size(); ++i) {
+        QVERIFY(recording.kept[i].timestamp > recording.kept[i - 1].timestamp);
+    }
+}
+
+void TestRecordingPolicy::runningMaximumIsKept() {
+    RecordingPolicy policy(enabledSettings());
+    const QVector<SensorData> samples = creepTest();
+    Recording recording = record(policy, samples);
+
+    // Noise alone sets the maximum during the hold, inside the deadband
+    const SensorData* maximum = &samples.first();
+    for (const SensorData& sample : samples) {
+        if (sample.force > maximum->force) {
+            maximum = &sample;
+        }
+    }
+    QVERIFY(maximum->timestamp > 2000);
+
+    bool kept = false;
+    for (const SensorData& sample : recording.kept) {
+        kept = kept || sample.timestamp == maximum->timestamp;
+    }
+    QVERIFY(kept);
+}
+
+void TestRecordingPolicy::resetStartsOver() {
+    RecordingPolicy policy(enabledSettings());
+    const QVector<SensorData> samples = ductileTest();
+    Recording first = record(policy, samples);
+
+    policy.reset();
+    QCOMPARE(policy.seenCount(), qint64(0));
+    Recording second = record(policy, samples);
+    QCOMPARE(second.kept.size(), first.kept.size());
+    QCOMPARE(second.events.size(), first.events.size());
+}
+
+QTEST_APPLESS_MAIN(TestRecordingPolicy)
+#include "tst_recordingpolicy.moc"
@@ -0,0 +1,254 @@
+#include <QtTest>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QFile>
+#include <QDateTime>
+#include "infrastructure/hardware/ReplayUTMDriver.h"
+#include "infrastructure/export/BinaryExportService.h"
+#include "core/Logger.h"
+#include "TestData.h"
+
+using namespace HorizonUTM;
+
+namespace {
+
+/**
+ * @brief Test export as written by CSVExportService: summary, blank line, curve
+ */
+const char* CSV_FIXTURE =
+    "Test ID,Sample Name,Operator\n"
+    "1,\"fixture, csv\",Tester\n"
+    "\n"
+    "Timestamp (ms),Time (s),Force (N),Extension (mm),Stress (MPa),Strain (%),Temperature (°C)\n"
+    "5000,0.000,100.0,0.0100,2.50,0.0200,23.0\n"
+    "5010,0.010,200.0,0.0200,5.00,0.0400,23.1\n"
+    "5020,0.020,300.0,0.0300,7.50,0.0600,23.2\n"
+    "5030,0.030,250.0,0.0400,6.25,0.0800,23.3\n";
+
+QVector<SensorData> samplesOf(const QSignalSpy& spy) {
+    QVector<SensorData> samples;
+    for (const QList<QVariant>& args : spy) {
+        samples.append(args.at(0).value<SensorData>());
+    }
+    return samples;
+}
+
+} // namespace
+
+class TestReplayUTMDriver : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void init();
+    void cleanup();
+
+    void csvCurveSectionIsParsed();
+    void csvWithoutCurveIsRejected();
+    void binaryRecordingIsLoaded();
+    void timestampsAreRebasedOntoReplayStart();
+    void forceLimitStopsReplay();
+    void pauseAndResumeKeepPosition();
+    void asFastAsPossibleIgnoresRecordedSpacing();
+
+private:
+    bool writeFile(const QString& name, const QByteArray& content);
+
+    QTemporaryDir m_dir;
+    ReplayUTMDriver* m_driver = nullptr;
+};
+
+void TestReplayUTMDriver::initTestCase() {
+    Logger::initialize(LogLevel::Error);
+    qRegisterMetaType<SensorData>("SensorData");
+    QVERIFY(m_dir.isValid());
+}
+
+void TestReplayUTMDriver::init() {
+    m_driver = new ReplayUTMDriver();
+    m_driver->setReplayMode(ReplayMode::AsFastAsPossible);
+}
+
+void TestReplayUTMDriver::cleanup() {
+    delete m_driver;
+    m_driver = nullptr;
+}
+
+bool TestReplayUTMDriver::writeFile(const QString& name, const QByteArray& content) {
+    QFile file(m_dir.filePath(name));
+    return file.open(QIODevice::WriteOnly) && file.write(content) == content.size();
+}
+
+void TestReplayUTMDriver::csvCurveSectionIsParsed() {
+    QVERIFY(writeFile("recording.csv", CSV_FIXTURE));
+    QSignalSpy rate(m_driver, &ReplayUTMDriver::sampleRateChanged);
+
+    QVERIFY(m_driver->loadRecording(m_dir.filePath("recording.csv")));
+    QCOMPARE(m_driver->getSampleCount(), 4);
+    QCOMPARE(m_driver->getSampleRateHz(), 100.0);
+    QCOMPARE(rate.count(), 1);
+
+    QSignalSpy samples(m_driver, &ReplayUTMDriver::sensorDataReceived);
+    QSignalSpy completed(m_driver, &ReplayUTMDriver::testCompleted);
+    QVERIFY(m_driver->connect("replay"));
+    QVERIFY(m_driver->startTest(5.0, 10000.0));
+    QTRY_COMPARE(completed.count(), 1);
+
+    const QVector<SensorData> emitted = samplesOf(samples);
+    QCOMPARE(emitted.size(), 4);
+    QCOMPARE(emitted[1].force, 200.0);
+    QCOMPARE(emitted[1].extension, 0.02);
+    QCOMPARE(emitted[1].stress, 5.0);
+    QCOMPARE(emitted[1].strain, 0.04);
+    QCOMPARE(emitted[1].temperature, 23.1);
+    QCOMPARE(emitted[3].force, 250.0);
+    QCOMPARE(m_driver->getState(), MachineState::Idle);
+}
+
+void TestReplayUTMDriver::csvWithoutCurveIsRejected() {
+    QVERIFY(writeFile("summary.csv", "Test ID,Sample Name\n1,summary only\n"));
+    QVERIFY(!m_driver->loadRecording(m_dir.filePath("summary.csv")));
+    QCOMPARE(m_driver->getSampleCount(), 0);
+
+    QVERIFY(!m_driver->loadRecording(m_dir.filePath("missing.csv")));
+}
+
+void TestReplayUTMDriver::binaryRecordingIsLoaded() {
+    Test first = TestData::tensileTest("first", 30);
+    first.setId(1);
+    Test second = TestData::tensileTest("second", 50);
+    second.setId(2);
+    BinaryExportService service;
+    const QString path = m_dir.filePath("recording.hzb");
+    QVERIFY(service.exportTests({first, second}, path));
+
+    QVERIFY(m_driver->loadRecording(path, 1));
+    QCOMPARE(m_driver->getSampleCount(), 50);
+    QCOMPARE(m_driver->getSampleRateHz(), 100.0);
+    QVERIFY(!m_driver->loadRecording(path, 2));
+
+    QVERIFY(m_driver->loadRecording(path, 1));
+    QSignalSpy samples(m_driver, &ReplayUTMDriver::sensorDataReceived);
+    QSignalSpy completed(m_driver, &ReplayUTMDriver::testCompleted);
+    QVERIFY(m_driver->connect("replay"));
+    QVERIFY(m_driver->startTest(5.0, 10000.0));
+    QTRY_COMPARE(completed.count(), 1);
+
+    const QVector<SensorData> emitted = samplesOf(samples);
+    const QVector<SensorData> recorded = second.getData();
+    QCOMPARE(emitted.size(), recorded.size());
+    for (qsizetype i = 0; i < recorded.size(); ++i) {
+        QCOMPARE(emitted[i].stress, recorded[i].stress);
+        QCOMPARE(emitted[i].strain, recorded[i].strain);
+        QCOMPARE(emitted[i].force, recorded[i].force);
+    }
+}
+
+void TestReplayUTMDriver::timestampsAreRebasedOntoReplayStart() {
+    QVector<SensorData> recording = TestData::tensileCurve(20);
+    recording[5].timestamp += 3;    // uneven spacing survives the rebase
+    m_driver->setRecording(recording);
+    QSignalSpy samples(m_driver, &ReplayUTMDriver::sensorDataReceived);
+    QSignalSpy completed(m_driver, &ReplayUTMDriver::testCompleted);
+    QVERIFY(m_driver->connect("replay"));
+
+    const qint64 before = QDateTime::currentMSecsSinceEpoch();
+    QVERIFY(m_driver->startTest(5.0, 10000.0));
+    const qint64 after = QDateTime::currentMSecsSinceEpoch();
+    QTRY_COMPARE(completed.count(), 1);
+
+    const QVector<SensorData> emitted = samplesOf(samples);
+    QCOMPARE(emitted.size(), recording.size());
+    QVERIFY(emitted[0].timestamp >= before && emitted[0].timestamp <= after);
+    for (qsizetype i = 1; i < recording.size(); ++i) {
+        QCOMPARE(emitted[i].timestamp - emitted[0].timestamp,
+                 recording[i].timestamp - recording[0].timestamp);
+    }
+}
+
+void TestReplayUTMDriver::forceLimitStopsReplay() {
+    const QVector<SensorData> recording = TestData::tensileCurve(100);
+    m_driver->setRecording(recording);
+    QSignalSpy samples(m_driver, &ReplayUTMDriver::sensorDataReceived);
+    QSignalSpy completed(m_driver, &ReplayUTMDriver::testCompleted);
+    QVERIFY(m_driver->connect("replay"));
+
+    // First sample at or above 2000 N ends the test without being emitted
+    const double limit = 2000.0;
+    qsizetype below = 0;
+    while (recording[below].force < limit) {
+        ++below;
+    }
+
+    QVERIFY(m_driver->startTest(5.0, limit));
+    QTRY_COMPARE(completed.count(), 1);
+    QTest::qWait(20);
+
+    QCOMPARE(samples.count(), int(below));
+    QCOMPARE(completed.count(), 1);
+    QCOMPARE(m_driver->getState(), MachineState::Idle);
+    QCOMPARE(m_driver->getCurrentData().force, recording[below].force);
+}
+
+void TestReplayUTMDriver::pauseAndResumeKeepPosition() {
+    const QVector<SensorData> recording = TestData::tensileCurve(100);
+    m_driver->setRecording(recording);
+    m_driver->setBatchSize(10);
+    QSignalSpy samples(m_driver, &ReplayUTMDriver::sensorDataReceived);
+    QSignalSpy completed(m_driver, &ReplayUTMDriver::testCompleted);
+    QVERIFY(m_driver->connect("replay"));
+
+    // Pause from the receiver, in the middle of a batch
+    bool pausedOnce = false;
+    QObject::connect(m_driver, &ReplayUTMDriver::sensorDataReceived, m_driver,
+        [this, &samples, &pausedOnce]() {
+            if (!pausedOnce && samples.count() == 14) {
+                pausedOnce = true;
+                QVERIFY(m_driver->pauseTest());
+            }
+        });
+
+    QVERIFY(m_driver->startTest(5.0, 10000.0));
+    QTRY_VERIFY(pausedOnce);
+    QTest::qWait(50);
+    QCOMPARE(samples.count(), 14);
+    QCOMPARE(m_driver->getReplayPosition(), 14);
+    QCOMPARE(m_driver->getState(), MachineState::Paused);
+
+    QVERIFY(m_driver->resumeTest());
+    QTRY_COMPARE(completed.count(), 1);
+
+    // Every sample once, in order
+    const QVector<SensorData> emitted = samplesOf(samples);
+    QCOMPARE(emitted.size(), recording.size());
+    for (qsizetype i = 1; i < emitted.size(); ++i) {
+        QCOMPARE(emitted[i].strain, recording[i].strain);
+    }
+}
+
+void TestReplayUTMDriver::asFastAsPossibleIgnoresRecordedSpacing() {
+    // Almost three hours of recording at one sample per second
+    QVector<SensorData> recording = TestData::tensileCurve(10000);
+    for (qsizetype i = 0; i < recording.size(); ++i) {
+        recording[i].timestamp = 1000 * i;
+    }
+    m_driver->setRecording(recording);
+    QCOMPARE(m_driver->getSampleRateHz(), 1.0);
+    m_driver->setBatchSize(500);
+
+    QSignalSpy samples(m_driver, &ReplayUTMDriver::sensorDataReceived);
+    QSignalSpy completed(m_driver, &ReplayUTMDriver::testCompleted);
+    QVERIFY(m_driver->connect("replay"));
+    QVERIFY(m_driver->startTest(5.0, 1.0e9));
+
+    // Batches go out from the event loop, not from startTest()
+    QCOMPARE(samples.count(), 0);
+    QTRY_COMPARE(completed.count(), 1);
+    QCOMPARE(samples.count(), 10000);
+    QCOMPARE(samples.last().at(0).value<SensorData>().timestamp
+                 - samples.first().at(0).value<SensorData>().timestamp,
+             qint64(9999 * 1000));
+}
+
+QTEST_GUILESS_MAIN(TestReplayUTMDriver)
+#include "tst_replayutmdriver.moc"
@@ -0,0 +1,191 @@
+#include <QtTest>
+#include <QTemporaryDir>
+#include <QSignalSpy>
+#include <QSqlQuery>
+#include <QDir>
+#include "application/controllers/SampleQueueRunner.h"
+#include "application/controllers/HardwareController.h"
+#include "application/controllers/TestController.h"
+#include "infrastructure/export/CSVExportService.h"
+#include "infrastructure/hardware/MockUTMDriver.h"
+#include "infrastructure/persistence/DatabaseManager.h"
+#include "infrastructure/persistence/SQLiteTestRepository.h"
+#include "core/Logger.h"
+
+using namespace HorizonUTM;
+
+namespace {
+
+// Brittle specimens break after 1 mm, i.e. ~100 ms at this speed
+BatchOptions fastBatch() {
+    BatchOptions options;
+    options.speedMmPerMin = 600.0;
+    options.forceLimitN = 1.0e6;
+    options.operatorName = "Tester";
+    return options;
+}
+
+} // namespace
+
+class TestSampleQueueRunner : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void init();
+    void cleanup();
+    void cleanupTestCase();
+
+    void runsAllReadySamples();
+    void exportsEachSpecimen();
+    void cancelLeavesRemainingSamplesReady();
+    void emptyQueueIsRejected();
+
+private:
+    void addSamples(int count);
+
+    QTemporaryDir m_dir;
+    SQLiteTestRepository* m_repository = nullptr;
+    TestController* m_testController = nullptr;
+    MockUTMDriver* m_driver = nullptr;
+    HardwareController* m_hardware = nullptr;
+    CSVExportService* m_csvExporter = nullptr;
+    DataExportController* m_exportController = nullptr;
+    SampleQueueRunner* m_runner = nullptr;
+};
+
+void TestSampleQueueRunner::initTestCase() {
+    Logger::initialize(LogLevel::Warning);
+    QVERIFY(m_dir.isValid());
+    QVERIFY(DatabaseManager::instance().initialize(m_dir.filePath("queue.db")));
+    m_repository = new SQLiteTestRepository();
+}
+
+void TestSampleQueueRunner::init() {
+    m_testController = new TestController(m_repository);
+    m_driver = new MockUTMDriver();
+    m_driver->setMaterial(MaterialParameters::brittle());
+    m_driver->setSamplingRate(10000);
+    m_driver->setStopSettleTime(10);
+    m_hardware = new HardwareController(m_driver, m_testController);
+    QVERIFY(m_hardware->connectToHardware());
+
+    m_csvExporter = new CSVExportService();
+    m_exportController = new DataExportController();
+    m_exportController->registerExportService(m_csvExporter);
+    m_exportController->setTestLoader([this](int testId) { return m_repository->getTest(testId); });
+
+    m_runner = new SampleQueueRunner(m_hardware, m_testController, m_exportController);
+}
+
+void TestSampleQueueRunner::cleanup() {
+    delete m_runner;
+    delete m_exportController;
+    delete m_csvExporter;
+    delete m_hardware;
+    delete m_driver;
+    delete m_testController;
+
+    QSqlQuery query(DatabaseManager::instance().database());
+    QVERIFY(query.exec("DELETE FROM test_data_points"));
+    QVERIFY(query.exec("DELETE FROM tests"));
+    QVERIFY(query.exec("DELETE FROM samples"));
+}
+
+void TestSampleQueueRunner::cleanupTestCase() {
+    delete m_repository;
+    DatabaseManager::instance().close();
+}
+
+void TestSampleQueueRunner::addSamples(int count) {
+    for (int i = 1; i <= count; ++i) {
+        Sample sample(QString("Bar %1").arg(i), 10.0, 4.0, 50.0);
+        QVERIFY(m_testController->saveSample(sample));
+    }
+}
+
+void TestSampleQueueRunner::runsAllReadySamples() {
+    addSamples(3);
+    QSignalSpy started(m_runner, &SampleQueueRunner::specimenStarted);
+    QSignalSpy finished(m_runner, &SampleQueueRunner::batchFinished);
+
+    QVERIFY(m_runner->startBatch(fastBatch()));
+    QVERIFY(m_runner->isRunning());
+    QVERIFY(!m_runner->startBatch(fastBatch()));
+
+    QTRY_COMPARE_WITH_TIMEOUT(finished.count(), 1, 15000);
+    QCOMPARE(started.count(), 3);
+
+    const BatchReport& report = m_runner->report();
+    QCOMPARE(report.specimens, 3);
+    QCOMPARE(report.completed, 3);
+    QCOMPARE(report.failed, 0);
+    QCOMPARE(report.setup.count, 3);
+    QCOMPARE(report.acquisition.count, 3);
+    QCOMPARE(report.finalization.count, 3);
+    QCOMPARE(report.exporting.count, 0);
+    QVERIFY(report.specimensPerHour() > 0.0);
+
+    QCOMPARE(m_testController->getSamplesByStatus(SampleStatus::Completed).size(), 3);
+    QCOMPARE(m_testController->getTestsByStatus(TestStatus::Completed).size(), 3);
+}
+
+void TestSampleQueueRunner::exportsEachSpecimen() {
+    addSamples(2);
+    QSignalSpy finished(m_runner, &SampleQueueRunner::batchFinished);
+
+    QTemporaryDir exportDir;
+    BatchOptions options = fastBatch();
+    options.exportDirectory = exportDir.path();
+
+    QVERIFY(m_runner->startBatch(options));
+    QTRY_COMPARE_WITH_TIMEOUT(finished.count(), 1, 15000);
+
+    QCOMPARE(m_runner->report().completed, 2);
+    QCOMPARE(m_runner->report().exporting.count, 2);
+    QCOMPARE(m_runner->report().exportFailures, 0);
+    const QFileInfoList files = QDir(exportDir.path()).entryInfoList({"*.csv"}, QDir::Files);
+    QCOMPARE(files.size(), 2);
+
+    // Loaded by the export worker, with the whole curve
+    int storedPoints = 0;
+    for (const Test& test : m_repository->getTestsByStatus(TestStatus::Completed)) {
+        storedPoints += m_repository->getTest(test.getId()).getDataPointCount();
+    }
+    QVERIFY(storedPoints > 0);
+
+    int exportedLines = 0;
+    for (const QFileInfo& file : files) {
+        QFile csv(file.filePath());
+        QVERIFY(csv.open(QIODevice::ReadOnly | QIODevice::Text));
+        exportedLines += csv.readAll().count('\n');
+    }
+    QVERIFY(exportedLines >= storedPoints);
+}
+
+void TestSampleQueueRunner::cancelLeavesRemainingSamplesReady() {
+    addSamples(3);
+    QSignalSpy finished(m_runner, &SampleQueueRunner::batchFinished);
+
+    BatchOptions options = fastBatch();
+    options.speedMmPerMin = 6.0;    // ~10 s per specimen
+    QVERIFY(m_runner->startBatch(options));
+    QTest::qWait(50);
+
+    m_runner->cancel();
+    QTRY_COMPARE_WITH_TIMEOUT(finished.count(), 1, 15000);
+
+    const BatchReport& report = m_runner->report();
+    QCOMPARE(report.specimens, 1);
+    QCOMPARE(report.failed, 1);
+    QCOMPARE(m_testController->getSamplesByStatus(SampleStatus::Ready).size(), 2);
+    QCOMPARE(m_testController->getTestsByStatus(TestStatus::Stopped).size(), 1);
+}
+
+void TestSampleQueueRunner::emptyQueueIsRejected() {
+    QVERIFY(!m_runner->startBatch(fastBatch()));
+    QVERIFY(!m_runner->isRunning());
+}
+
+QTEST_GUILESS_MAIN(TestSampleQueueRunner)
+#include "tst_samplequeuerunner.moc"
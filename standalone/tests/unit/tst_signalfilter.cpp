@@ -0,0 +1,212 @@
+#include <QtTest>
+#include <QRandomGenerator>
+#include "domain/services/SignalFilter.h"
+
+using namespace HorizonUTM;
+
+Q_DECLARE_METATYPE(HorizonUTM::FilterType)
+
+namespace {
+
+FilterSettings settingsFor(FilterType type) {
+    FilterSettings settings;
+    settings.type = type;
+    settings.windowSize = 21;
+    settings.polynomialOrder = 3;
+    settings.order = 4;
+    settings.cutoffHz = 5.0;
+    settings.sampleRateHz = 100.0;
+    return settings;
+}
+
+QVector<double> noise(int count) {
+    QRandomGenerator random(7);
+    QVector<double> samples(count);
+    for (double& sample : samples) {
+        sample = 2.0 * random.generateDouble() - 1.0;
+    }
+    return samples;
+}
+
+} // namespace
+
+class TestSignalFilter : public QObject {
+    Q_OBJECT
+
+private slots:
+    void typeNamesRoundTrip();
+    void invalidSettingsPassThrough();
+    void constantSignalHasNoStartupRamp_data();
+    void constantSignalHasNoStartupRamp();
+    void blockMatchesSampleBySample_data();
+    void blockMatchesSampleBySample();
+    void savitzkyGolayTaps();
+    void savitzkyGolayKeepsQuadratics();
+    void medianRejectsSpikes();
+    void butterworthGainAtCutoff();
+    void butterworthLatencyMatchesRampLag();
+    void sensorDataChannelsStayProportional();
+};
+
+void TestSignalFilter::typeNamesRoundTrip() {
+    for (FilterType type : {FilterType::None, FilterType::MovingAverage, FilterType::Median,
+                            FilterType::Butterworth, FilterType::SavitzkyGolay}) {
+        bool ok = false;
+        QCOMPARE(filterTypeFromString(filterTypeToString(type), &ok), type);
+        QVERIFY(ok);
+    }
+
+    bool ok = true;
+    QCOMPARE(filterTypeFromString("kalman", &ok), FilterType::None);
+    QVERIFY(!ok);
+}
+
+void TestSignalFilter::invalidSettingsPassThrough() {
+    FilterSettings even;
+    even.type = FilterType::Median;
+    even.windowSize = 4;
+    QVERIFY(!even.isValid());
+
+    FilterSettings aliased = settingsFor(FilterType::Butterworth);
+    aliased.cutoffHz = 60.0;
+    QVERIFY(!aliased.isValid());
+
+    SignalFilter filter;
+    QVERIFY(!filter.setSettings(even));
+    QCOMPARE(filter.settings().type, FilterType::None);
+    QCOMPARE(filter.process(3.5), 3.5);
+}
+
+void TestSignalFilter::constantSignalHasNoStartupRamp_data() {
+    QTest::addColumn<FilterType>("type");
+    QTest::newRow("moving average") << FilterType::MovingAverage;
+    QTest::newRow("median") << FilterType::Median;
+    QTest::newRow("butterworth") << FilterType::Butterworth;
+    QTest::newRow("savitzky-golay") << FilterType::SavitzkyGolay;
+}
+
+void TestSignalFilter::constantSignalHasNoStartupRamp() {
+    QFETCH(FilterType, type);
+    SignalFilter filter(settingsFor(type));
+
+    for (int i = 0; i < 50; ++i) {
+        QVERIFY(qAbs(filter.process(1234.5) - 1234.5) < 1e-9);
+    }
+}
+
+void TestSignalFilter::blockMatchesSampleBySample_data() {
+    constantSignalHasNoStartupRamp_data();
+}
+
+void TestSignalFilter::blockMatchesSampleBySample() {
+    QFETCH(FilterType, type);
+    // Longer than one block, so chunking is covered too
+    const QVector<double> input = noise(int(SignalFilter::MAX_BLOCK_SIZE) * 3 + 17);
+
+    SignalFilter blockFilter(settingsFor(type));
+    QVector<double> block(input.size());
+    blockFilter.process(input.constData(), block.data(), input.size());
+
+    SignalFilter sampleFilter(settingsFor(type));
+    for (int i = 0; i < input.size(); ++i) {
+        QCOMPARE(sampleFilter.process(input[i]), block[i]);
+    }
+}
+
+void TestSignalFilter::savitzkyGolayTaps() {
+    // Quadratic over 5 points: (-3, 12, 17, 12, -3) / 35
+    FilterSettings settings;
+    settings.type = FilterType::SavitzkyGolay;
+    settings.windowSize = 5;
+    settings.polynomialOrder = 2;
+    SignalFilter filter(settings);
+
+    const QVector<double> impulse = {0, 0, 0, 0, 1, 0, 0, 0, 0};
+    const QVector<double> expected = {0, 0, 0, 0, -3, 12, 17, 12, -3};
+    for (int i = 0; i < impulse.size(); ++i) {
+        QVERIFY(qAbs(filter.process(impulse[i]) * 35.0 - expected[i]) < 1e-9);
+    }
+}
+
+void TestSignalFilter::savitzkyGolayKeepsQuadratics() {
+    FilterSettings settings;
+    settings.type = FilterType::SavitzkyGolay;
+    settings.windowSize = 7;
+    settings.polynomialOrder = 2;
+    SignalFilter filter(settings);
+
+    auto signal = [](double t) { return 0.5 * t * t - 3.0 * t + 2.0; };
+    const int delay = int(settings.latencySamples());
+    for (int i = 0; i < 40; ++i) {
+        double out = filter.process(signal(i));
+        if (i >= settings.windowSize) {
+            QVERIFY(qAbs(out - signal(i - delay)) < 1e-9);
+        }
+    }
+}
+
+void TestSignalFilter::medianRejectsSpikes() {
+    FilterSettings settings;
+    settings.type = FilterType::Median;
+    settings.windowSize = 5;
+    SignalFilter filter(settings);
+
+    const QVector<double> input = {1, 1, 1, 100, 1, 1, 2, 3, 4, 5, 6, 7};
+    const QVector<double> expected = {1, 1, 1, 1, 1, 1, 1, 2, 2, 3, 4, 5};
+    QVector<double> output(input.size());
+    filter.process(input.constData(), output.data(), input.size());
+    QCOMPARE(output, expected);
+}
+
+void TestSignalFilter::butterworthGainAtCutoff() {
+    FilterSettings settings = settingsFor(FilterType::Butterworth);
+    settings.sampleRateHz = 10000.0;
+    settings.cutoffHz = 100.0;
+
+    auto gainAt = [&settings](double frequency) {
+        SignalFilter filter(settings);
+        double amplitude = 0.0;
+        for (int i = 0; i < 40000; ++i) {
+            double out = filter.process(qCos(2.0 * M_PI * frequency * i / settings.sampleRateHz));
+            if (i >= 20000) amplitude = qMax(amplitude, qAbs(out));
+        }
+        return amplitude;
+    };
+
+    QVERIFY(qAbs(gainAt(100.0) - M_SQRT1_2) < 0.005);
+    QVERIFY(gainAt(1000.0) < 1e-3);
+}
+
+void TestSignalFilter::butterworthLatencyMatchesRampLag() {
+    FilterSettings settings = settingsFor(FilterType::Butterworth);
+    SignalFilter filter(settings);
+
+    double lag = 0.0;
+    for (int i = 0; i < 2000; ++i) {
+        lag = i - filter.process(i);
+    }
+    QVERIFY2(qAbs(lag - settings.latencySamples()) < 1e-6,
+             qPrintable(QString("%1 vs %2").arg(lag).arg(settings.latencySamples())));
+    QCOMPARE(settings.latencyMs(), settings.latencySamples() * 10.0);
+}
+
+void TestSignalFilter::sensorDataChannelsStayProportional() {
+    SensorDataFilter filter(settingsFor(FilterType::Butterworth));
+    const QVector<double> input = noise(500);
+    const double area = 40.0;
+
+    for (int i = 0; i < input.size(); ++i) {
+        SensorData raw(1000 + i, 400.0 + input[i] * 10.0, i * 0.01, 0.0, 0.0, 23.0);
+        raw.stress = raw.force / area;
+        raw.strain = raw.extension / 50.0 * 100.0;
+
+        SensorData out = filter.process(raw);
+        QCOMPARE(out.timestamp, raw.timestamp);
+        QCOMPARE(out.temperature, raw.temperature);
+        QVERIFY(qAbs(out.stress - out.force / area) < 1e-9);
+        QVERIFY(qAbs(out.strain - out.extension * 2.0) < 1e-9);
+    }
+}
+
+QTEST_APPLESS_MAIN(TestSignalFilter)
+#include "tst_signalfilter.moc"
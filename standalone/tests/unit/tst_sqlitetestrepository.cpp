@@ -0,0 +1,406 @@
+#include <QtTest>
+#include <QTemporaryDir>
+#include <QSqlQuery>
+#include <QThread>
+#include <atomic>
+#include "infrastructure/persistence/DatabaseManager.h"
+#include "infrastructure/persistence/SQLiteTestRepository.h"
+#include "infrastructure/persistence/CurveSpillFile.h"
+#include "core/Logger.h"
+#include "TestData.h"
+
+using namespace HorizonUTM;
+
+class TestSQLiteTestRepository : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanup();
+    void cleanupTestCase();
+
+    void saveAssignsId();
+    void invalidIdReturnsEmptyTest();
+    void metadataRoundTrip();
+    void dataPointsRoundTrip();
+    void repeatedUpdatesAppendOnlyNewPoints();
+    void metadataUpdateKeepsCurve();
+    void clearedDataReplacesStoredPoints();
+    void breakBurstRoundTrip();
+    void rawCurveRoundTrip();
+    void spilledCurveRoundTrip();
+    void reloadHitsCurveCache();
+    void updateInvalidatesCachedCurve();
+    void loadDuringSaveKeepsCacheCurrent();
+    void testsByStatus();
+    void countsByStatus();
+    void deleteTest();
+    void sampleRoundTrip();
+
+private:
+    QTemporaryDir m_dir;
+    SQLiteTestRepository* m_repository = nullptr;
+};
+
+void TestSQLiteTestRepository::initTestCase() {
+    Logger::initialize(LogLevel::Warning);
+    QVERIFY(m_dir.isValid());
+    QVERIFY(DatabaseManager::instance().initialize(m_dir.filePath("repository.db")));
+    m_repository = new SQLiteTestRepository();
+}
+
+void TestSQLiteTestRepository::cleanup() {
+    QSqlQuery query(DatabaseManager::instance().database());
+    QVERIFY(query.exec("DELETE FROM test_data_points"));
+    QVERIFY(query.exec("DELETE FROM test_break_points"));
+    QVERIFY(query.exec("DELETE FROM test_raw_points"));
+    QVERIFY(query.exec("DELETE FROM tests"));
+    QVERIFY(query.exec("DELETE FROM samples"));
+}
+
+void TestSQLiteTestRepository::cleanupTestCase() {
+    delete m_repository;
+    DatabaseManager::instance().close();
+}
+
+void TestSQLiteTestRepository::saveAssignsId() {
+    Test first = TestData::tensileTest("A");
+    Test second = TestData::tensileTest("B");
+
+    QVERIFY(m_repository->saveTest(first));
+    QVERIFY(m_repository->saveTest(second));
+
+    QVERIFY(first.getId() > 0);
+    QVERIFY(second.getId() > first.getId());
+}
+
+void TestSQLiteTestRepository::invalidIdReturnsEmptyTest() {
+    Test test = m_repository->getTest(123456);
+    QVERIFY(test.getId() <= 0);
+    QCOMPARE(test.getDataPointCount(), 0);
+}
+
+void TestSQLiteTestRepository::metadataRoundTrip() {
+    Test test = TestData::tensileTest("PP-42");
+    test.setNotes("notch, \"quoted\"");
+    TestResult result;
+    result.maxStress = 60.0;
+    result.yieldStress = 50.0;
+    result.ultimateStress = 60.0;
+    result.breakStress = 48.0;
+    result.elasticModulus = 3000.0;
+    result.elongationAtBreak = 8.0;
+    test.setResult(result);
+
+    QVERIFY(m_repository->saveTest(test));
+    Test loaded = m_repository->getTest(test.getId());
+
+    QCOMPARE(loaded.getId(), test.getId());
+    QCOMPARE(loaded.getSampleName(), QString("PP-42"));
+    QCOMPARE(loaded.getOperatorName(), test.getOperatorName());
+    QCOMPARE(loaded.getTestMethod(), test.getTestMethod());
+    QCOMPARE(loaded.getWidth(), test.getWidth());
+    QCOMPARE(loaded.getThickness(), test.getThickness());
+    QCOMPARE(loaded.getGaugeLength(), test.getGaugeLength());
+    QCOMPARE(loaded.getSpeed(), test.getSpeed());
+    QCOMPARE(loaded.getStatus(), TestStatus::Completed);
+    QCOMPARE(loaded.getStartTime(), test.getStartTime());
+    QCOMPARE(loaded.getNotes(), test.getNotes());
+    QCOMPARE(loaded.getResult().maxStress, 60.0);
+    QCOMPARE(loaded.getResult().elasticModulus, 3000.0);
+    QCOMPARE(loaded.getResult().elongationAtBreak, 8.0);
+}
+
+void TestSQLiteTestRepository::dataPointsRoundTrip() {
+    Test test = TestData::tensileTest("curve", 500);
+    QVERIFY(m_repository->saveTest(test));
+
+    QVector<SensorData> loaded = m_repository->getDataPoints(test.getId());
+    QCOMPARE(loaded.size(), 500);
+
+    for (int i = 0; i < loaded.size(); ++i) {
+        const SensorData& expected = test.getData()[i];
+        QCOMPARE(loaded[i].timestamp, expected.timestamp);
+        QCOMPARE(loaded[i].force, expected.force);
+        QCOMPARE(loaded[i].extension, expected.extension);
+        QCOMPARE(loaded[i].stress, expected.stress);
+        QCOMPARE(loaded[i].strain, expected.strain);
+    }
+
+    QCOMPARE(m_repository->getTest(test.getId()).getDataPointCount(), 500);
+}
+
+void TestSQLiteTestRepository::repeatedUpdatesAppendOnlyNewPoints() {
+    QVector<SensorData> curve = TestData::tensileCurve(300);
+    CurveBuilder builder;
+    for (int i = 0; i < 100; ++i) {
+        builder.append(curve[i]);
+    }
+
+    Test test = TestData::tensileTest("growing");
+    test.setCurve(builder.snapshot());
+    QVERIFY(m_repository->saveTest(test));
+    QCOMPARE(test.getPersistedCount(), 100);
+
+    for (int i = 100; i < 300; ++i) {
+        builder.append(curve[i]);
+        if (i % 50 == 49) {
+            test.extendCurve(builder.snapshot());
+            QVERIFY(m_repository->updateTest(test));
+            QCOMPARE(test.getPersistedCount(), i + 1);
+        }
+    }
+
+    // Saving again without changes writes nothing
+    QVERIFY(!test.hasUnsavedChanges());
+    QVERIFY(m_repository->updateTest(test));
+
+    QVector<SensorData> loaded = m_repository->getDataPoints(test.getId());
+    QCOMPARE(loaded.size(), 300);
+    for (int i = 0; i < loaded.size(); ++i) {
+        QCOMPARE(loaded[i].timestamp, curve[i].timestamp);
+    }
+}
+
+void TestSQLiteTestRepository::metadataUpdateKeepsCurve() {
+    Test test = TestData::tensileTest("annotated", 200);
+    QVERIFY(m_repository->saveTest(test));
+
+    test.setNotes("re-checked");
+    test.setStatus(TestStatus::Failed);
+    QCOMPARE(test.getDirtyFields(), quint32(Test::DirtyNotes | Test::DirtyStatus));
+    QVERIFY(m_repository->updateTest(test));
+
+    Test loaded = m_repository->getTest(test.getId());
+    QCOMPARE(loaded.getNotes(), QString("re-checked"));
+    QCOMPARE(loaded.getStatus(), TestStatus::Failed);
+    QCOMPARE(loaded.getSampleName(), QString("annotated"));
+    QCOMPARE(loaded.getDataPointCount(), 200);
+    QVERIFY(!loaded.hasUnsavedChanges());
+}
+
+void TestSQLiteTestRepository::breakBurstRoundTrip() {
+    Test test = TestData::tensileTest("burst", 200);
+    QVERIFY(m_repository->saveTest(test));
+    QVERIFY(m_repository->getTest(test.getId()).getBreakBurst().isEmpty());
+
+    // Several samples per millisecond keep their order
+    QVector<SensorData> burst = TestData::tensileCurve(40);
+    for (int i = 0; i < burst.size(); ++i) {
+        burst[i].timestamp = 5000 + i / 4;
+    }
+    test.setBreakBurst(burst);
+    QCOMPARE(test.getDirtyFields(), quint32(Test::DirtyBreakBurst));
+    QVERIFY(m_repository->updateTest(test));
+
+    Test loaded = m_repository->getTest(test.getId());
+    QCOMPARE(loaded.getDataPointCount(), 200);
+    QCOMPARE(loaded.getBreakBurst().size(), burst.size());
+    for (int i = 0; i < burst.size(); ++i) {
+        QCOMPARE(loaded.getBreakBurst()[i].timestamp, burst[i].timestamp);
+        QCOMPARE(loaded.getBreakBurst()[i].force, burst[i].force);
+    }
+    QVERIFY(!loaded.hasUnsavedChanges());
+
+    // Replaced, not appended
+    test.setBreakBurst(burst.mid(0, 10));
+    QVERIFY(m_repository->updateTest(test));
+    QCOMPARE(m_repository->getTest(test.getId()).getBreakBurst().size(), 10);
+}
+
+void TestSQLiteTestRepository::rawCurveRoundTrip() {
+    Test test = TestData::tensileTest("raw", 200);
+    QVERIFY(m_repository->saveTest(test));
+    QVERIFY(m_repository->getTest(test.getId()).getRawCurve().isEmpty());
+
+    // Unfiltered: same timestamps, noisier force
+    QVector<SensorData> raw = TestData::tensileCurve(200);
+    for (int i = 0; i < raw.size(); ++i) {
+        raw[i].force += (i % 2 ? 0.5 : -0.5);
+    }
+    test.setRawCurve(Curve::fromVector(raw));
+    QCOMPARE(test.getDirtyFields(), quint32(Test::DirtyRawCurve));
+    QVERIFY(m_repository->updateTest(test));
+
+    Test loaded = m_repository->getTest(test.getId());
+    QCOMPARE(loaded.getDataPointCount(), 200);
+    QCOMPARE(loaded.getRawCurve().size(), raw.size());
+    for (int i = 0; i < raw.size(); ++i) {
+        QCOMPARE(loaded.getRawCurve()[i].timestamp, raw[i].timestamp);
+        QCOMPARE(loaded.getRawCurve()[i].force, raw[i].force);
+        QCOMPARE(loaded.getCurve()[i].force, test.getCurve()[i].force);
+    }
+    QVERIFY(!loaded.hasUnsavedChanges());
+
+    // Removed with the test
+    QVERIFY(m_repository->deleteTest(test.getId()));
+    QSqlQuery query(DatabaseManager::instance().database());
+    QVERIFY(query.exec("SELECT COUNT(*) FROM test_raw_points"));
+    QVERIFY(query.next());
+    QCOMPARE(query.value(0).toInt(), 0);
+}
+
+void TestSQLiteTestRepository::clearedDataReplacesStoredPoints() {
+    Test test = TestData::tensileTest("rerun", 200);
+    QVERIFY(m_repository->saveTest(test));
+
+    test.clearData();
+    CurveBuilder builder;
+    for (const SensorData& point : TestData::tensileCurve(50)) {
+        builder.append(point);
+    }
+    test.extendCurve(builder.seal());
+    QVERIFY(m_repository->updateTest(test));
+
+    QCOMPARE(m_repository->getDataPoints(test.getId()).size(), 50);
+}
+
+void TestSQLiteTestRepository::spilledCurveRoundTrip() {
+    const int count = int(Curve::BLOCK_SIZE) * 3 + 10;
+    QVector<SensorData> curve = TestData::tensileCurve(count);
+
+    CurveBuilder builder;
+    builder.setMemoryBudget(qint64(Curve::BLOCK_SIZE) * qint64(sizeof(SensorData)),
+                            std::make_shared<CurveSpillFile>(m_dir.path()));
+    for (const SensorData& point : curve) {
+        builder.append(point);
+    }
+
+    Test test = TestData::tensileTest("spilled");
+    test.setCurve(builder.seal());
+    QVERIFY(test.getCurve().spilledCount() > 0);
+    QVERIFY(m_repository->saveTest(test));
+
+    QVector<SensorData> loaded = m_repository->getDataPoints(test.getId());
+    QCOMPARE(loaded.size(), count);
+    for (int i = 0; i < count; ++i) {
+        QCOMPARE(loaded[i].timestamp, curve[i].timestamp);
+        QCOMPARE(loaded[i].stress, curve[i].stress);
+    }
+}
+
+void TestSQLiteTestRepository::reloadHitsCurveCache() {
+    Test test = TestData::tensileTest("cached", 200);
+    QVERIFY(m_repository->saveTest(test));
+
+    CurveCache::Stats before = m_repository->getCurveCacheStats();
+    Test first = m_repository->getTest(test.getId());
+    Test second = m_repository->getTest(test.getId());
+    CurveCache::Stats after = m_repository->getCurveCacheStats();
+
+    QCOMPARE(after.misses - before.misses, qint64(1));
+    QCOMPARE(after.hits - before.hits, qint64(1));
+    QVERIFY(second.getCurve().isSharedWith(first.getCurve()));
+    QCOMPARE(m_repository->getDataPoints(test.getId()).size(), 200);
+}
+
+void TestSQLiteTestRepository::updateInvalidatesCachedCurve() {
+    Test test = TestData::tensileTest("changing", 100);
+    QVERIFY(m_repository->saveTest(test));
+    QCOMPARE(m_repository->getTest(test.getId()).getDataPointCount(), 100);
+
+    test.setData(TestData::tensileCurve(150));
+    QVERIFY(m_repository->updateTest(test));
+    QCOMPARE(m_repository->getTest(test.getId()).getDataPointCount(), 150);
+
+    QVERIFY(m_repository->deleteTest(test.getId()));
+    QCOMPARE(m_repository->getDataPoints(test.getId()).size(), 0);
+}
+
+void TestSQLiteTestRepository::loadDuringSaveKeepsCacheCurrent() {
+    Test test = TestData::tensileTest("racing", 100);
+    QVERIFY(m_repository->saveTest(test));
+    const int testId = test.getId();
+
+    // Reload on another thread, with its own connection, while the update is open
+    std::atomic<bool> saving{true};
+    std::atomic<int> loads{0};
+    QThread* reader = QThread::create([this, testId, &saving, &loads]() {
+        do {
+            m_repository->getDataPoints(testId);
+            ++loads;
+        } while (saving);
+    });
+    reader->start();
+    QTRY_VERIFY(loads > 0);
+
+    test.setData(TestData::tensileCurve(20000));
+    QVERIFY(m_repository->updateTest(test));
+    saving = false;
+    QVERIFY(reader->wait(10000));
+    delete reader;
+
+    // A curve read before the commit must not stay cached
+    QCOMPARE(m_repository->getDataPoints(testId).size(), 20000);
+}
+
+void TestSQLiteTestRepository::testsByStatus() {
+    Test completed = TestData::tensileTest("done");
+    Test failed = TestData::tensileTest("broken");
+    failed.setStatus(TestStatus::Failed);
+
+    QVERIFY(m_repository->saveTest(completed));
+    QVERIFY(m_repository->saveTest(failed));
+
+    QVector<Test> tests = m_repository->getTestsByStatus(TestStatus::Failed);
+    QCOMPARE(tests.size(), 1);
+    QCOMPARE(tests.first().getSampleName(), QString("broken"));
+    QCOMPARE(m_repository->getAllTests().size(), 2);
+}
+
+void TestSQLiteTestRepository::countsByStatus() {
+    for (int i = 0; i < 3; ++i) {
+        Test test = TestData::tensileTest(QString("S%1").arg(i));
+        QVERIFY(m_repository->saveTest(test));
+    }
+    Test stopped = TestData::tensileTest("stopped");
+    stopped.setStatus(TestStatus::Stopped);
+    QVERIFY(m_repository->saveTest(stopped));
+
+    QCOMPARE(m_repository->getTestCount(), 4);
+    QCOMPARE(m_repository->getTestCountByStatus(TestStatus::Completed), 3);
+    QCOMPARE(m_repository->getTestCountByStatus(TestStatus::Stopped), 1);
+}
+
+void TestSQLiteTestRepository::deleteTest() {
+    Test test = TestData::tensileTest("gone");
+    test.setBreakBurst(TestData::tensileCurve(20));
+    QVERIFY(m_repository->saveTest(test));
+    QVERIFY(m_repository->deleteTest(test.getId()));
+
+    QCOMPARE(m_repository->getTestCount(), 0);
+    QVERIFY(m_repository->getTest(test.getId()).getId() <= 0);
+
+    // No rows left behind, foreign keys are not enforced
+    QSqlQuery query(DatabaseManager::instance().database());
+    for (const QString& table : QStringList{"test_data_points", "test_break_points"}) {
+        QVERIFY(query.exec(QString("SELECT COUNT(*) FROM %1").arg(table)));
+        QVERIFY(query.next());
+        QCOMPARE(query.value(0).toInt(), 0);
+    }
+}
+
+void TestSQLiteTestRepository::sampleRoundTrip() {
+    Sample sample;
+    sample.setName("Bar 1");
+    sample.setWidth(10.0);
+    sample.setThickness(4.0);
+    sample.setGaugeLength(50.0);
+    sample.setTestMethod("ISO 527-2");
+    sample.setOperatorName("Tester");
+    sample.setStatus(SampleStatus::Ready);
+
+    QVERIFY(m_repository->saveSample(sample));
+    QVERIFY(sample.getId() > 0);
+
+    sample.setStatus(SampleStatus::Completed);
+    QVERIFY(m_repository->updateSample(sample));
+
+    Sample loaded = m_repository->getSample(sample.getId());
+    QCOMPARE(loaded.getName(), QString("Bar 1"));
+    QCOMPARE(loaded.getStatus(), SampleStatus::Completed);
+    QCOMPARE(m_repository->getSamplesByStatus(SampleStatus::Ready).size(), 0);
+}
+
+QTEST_GUILESS_MAIN(TestSQLiteTestRepository)
+#include "tst_sqlitetestrepository.moc"
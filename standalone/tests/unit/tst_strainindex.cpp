@@ -0,0 +1,134 @@
+#include <QtTest>
+#include "domain/services/StrainIndex.h"
+#include "TestData.h"
+
+using namespace HorizonUTM;
+
+namespace {
+
+QVector<SensorData> pointsAt(const QVector<double>& strains, const QVector<double>& stresses) {
+    QVector<SensorData> data;
+    for (int i = 0; i < strains.size(); ++i) {
+        SensorData point;
+        point.timestamp = i * 10;
+        point.strain = strains[i];
+        point.stress = stresses[i];
+        data.append(point);
+    }
+    return data;
+}
+
+} // namespace
+
+class TestStrainIndex : public QObject {
+    Q_OBJECT
+
+private slots:
+    void emptyIndex();
+    void interpolatesBetweenSamples();
+    void outsideCurveFails();
+    void envelopeKeepsStrainMonotone();
+    void crossingIsInterpolated();
+    void noCrossingWhileAboveLine();
+    void startBelowLineCrossesAtStart();
+    void curveMatchesVector();
+};
+
+void TestStrainIndex::emptyIndex() {
+    StrainIndex index;
+    double value = 0.0;
+    QVERIFY(index.isEmpty());
+    QVERIFY(!index.stressAtStrain(0.0, value));
+    QVERIFY(!index.firstCrossing(0.0, 1.0, 0, 10, value, value));
+}
+
+void TestStrainIndex::interpolatesBetweenSamples() {
+    StrainIndex index(pointsAt({0.0, 1.0, 2.0}, {0.0, 10.0, 30.0}));
+
+    double stress = 0.0;
+    QVERIFY(index.stressAtStrain(0.5, stress));
+    QCOMPARE(stress, 5.0);
+    QVERIFY(index.stressAtStrain(1.75, stress));
+    QCOMPARE(stress, 25.0);
+    QVERIFY(index.stressAtStrain(2.0, stress));
+    QCOMPARE(stress, 30.0);
+}
+
+void TestStrainIndex::outsideCurveFails() {
+    StrainIndex index(pointsAt({0.1, 1.0}, {1.0, 10.0}));
+
+    double stress = -1.0;
+    QVERIFY(!index.stressAtStrain(0.05, stress));
+    QVERIFY(!index.stressAtStrain(1.5, stress));
+    QCOMPARE(stress, -1.0);
+}
+
+void TestStrainIndex::envelopeKeepsStrainMonotone() {
+    // Strain steps back at index 3
+    StrainIndex index(pointsAt({0.0, 1.0, 2.0, 1.5, 4.0}, {0.0, 10.0, 20.0, 30.0, 40.0}));
+
+    QCOMPARE(index.strainAt(3), 2.0);
+    QCOMPARE(index.lowerBound(2.0), qsizetype(2));
+    QCOMPARE(index.lowerBound(3.0), qsizetype(4));
+
+    double stress = 0.0;
+    QVERIFY(index.stressAtStrain(3.0, stress));
+    QCOMPARE(stress, 35.0);
+}
+
+void TestStrainIndex::crossingIsInterpolated() {
+    // Tensile curve yield: 0.2% offset line at 3 GPa meets the hardening
+    // segment at 1.905263% / 51.157895 MPa whatever the sample rate
+    for (int points : {500, 2000, 100000}) {
+        QVector<SensorData> data = TestData::tensileCurve(points);
+        StrainIndex index(data);
+
+        double strain = 0.0;
+        double stress = 0.0;
+        QVERIFY(index.firstCrossing(-30.0 * 0.2, 30.0, 0, data.size() - 1, strain, stress));
+        QVERIFY2(qAbs(strain - 1.9052632) < 1e-6, qPrintable(QString::number(strain, 'g', 10)));
+        QVERIFY2(qAbs(stress - 51.157895) < 1e-5, qPrintable(QString::number(stress, 'g', 10)));
+    }
+}
+
+void TestStrainIndex::noCrossingWhileAboveLine() {
+    StrainIndex index(TestData::tensileCurve(1000));
+
+    double strain = -1.0;
+    double stress = -1.0;
+    QVERIFY(!index.firstCrossing(-100.0, 1.0, 0, index.size() - 1, strain, stress));
+    QCOMPARE(strain, -1.0);
+}
+
+void TestStrainIndex::startBelowLineCrossesAtStart() {
+    StrainIndex index(pointsAt({0.0, 1.0, 2.0}, {0.0, 10.0, 20.0}));
+
+    double strain = -1.0;
+    double stress = -1.0;
+    QVERIFY(index.firstCrossing(5.0, 1.0, 0, 2, strain, stress));
+    QCOMPARE(strain, 0.0);
+    QCOMPARE(stress, 0.0);
+}
+
+void TestStrainIndex::curveMatchesVector() {
+    QVector<SensorData> data = TestData::tensileCurve(int(Curve::BLOCK_SIZE) * 2 + 7);
+    CurveBuilder builder;
+    for (const SensorData& point : data) {
+        builder.append(point);
+    }
+
+    StrainIndex fromVector(data);
+    StrainIndex fromCurve(builder.snapshot());
+    QCOMPARE(fromCurve.size(), fromVector.size());
+
+    double a = 0.0;
+    double b = 0.0;
+    for (double strain : {0.05, 0.25, 3.3333, 7.99}) {
+        QVERIFY(fromVector.stressAtStrain(strain, a));
+        QVERIFY(fromCurve.stressAtStrain(strain, b));
+        QCOMPARE(b, a);
+    }
+}
+
+QTEST_APPLESS_MAIN(TestStrainIndex)
+#include "tst_strainindex.moc"
@@ -0,0 +1,213 @@
+#include <QtTest>
+#include <QRandomGenerator>
+#include "domain/services/StressStrainCalculator.h"
+#include "TestData.h"
+
+using namespace HorizonUTM;
+
+namespace {
+
+/**
+ * @brief Curve with an initial toe (slack) region
+ *
+ * Quadratic toe up to 0.1% strain, linear at 3 GPa up to 0.4%, then a
+ * gradually flattening yield up to 3% strain. Noise is uniform ±noise MPa.
+ */
+QVector<SensorData> toeCurve(int pointCount, double noise = 0.0) {
+    QRandomGenerator random(42);
+    QVector<SensorData> data;
+    data.reserve(pointCount);
+
+    for (int i = 1; i <= pointCount; ++i) {
+        double strain = 3.0 * i / pointCount;
+        double stress;
+        if (strain < 0.1) {
+            stress = 150.0 * strain * strain;
+        } else if (strain <= 0.4) {
+            stress = 30.0 * (strain - 0.05);
+        } else {
+            stress = 10.5 + 10.0 * (1.0 - qExp(-(strain - 0.4) / 0.4));
+        }
+
+        SensorData point;
+        point.timestamp = i * 10;
+        point.strain = strain;
+        point.stress = stress + noise * (2.0 * random.generateDouble() - 1.0);
+        data.append(point);
+    }
+    return data;
+}
+
+} // namespace
+
+class TestStressStrainCalculator : public QObject {
+    Q_OBJECT
+
+private slots:
+    void stressFromForce();
+    void strainFromExtension();
+    void invalidGeometryGivesZero();
+    void emptyDataGivesInvalidResult();
+    void tooFewPointsGivesNoModulus();
+    void elasticModulusOfLinearRegion();
+    void maxStressAndStrainAtMax();
+    void breakAndElongation();
+    void yieldBetweenElasticLimitAndMax();
+    void resultsMatchIndividualCalculations();
+    void bestFitSkipsToeRegion();
+    void bestFitToleratesNoise();
+    void bestFitOfCurveMatchesVector();
+    void resultsUseSelectedModulusMethod();
+    void chordModulusIsSampleRateIndependent();
+    void chordModulusNeedsBothStrains();
+    void yieldPointIsInterpolated();
+};
+
+void TestStressStrainCalculator::stressFromForce() {
+    QCOMPARE(StressStrainCalculator::calculateStress(400.0, 40.0), 10.0);
+}
+
+void TestStressStrainCalculator::strainFromExtension() {
+    QCOMPARE(StressStrainCalculator::calculateStrain(1.0, 50.0), 2.0);
+}
+
+void TestStressStrainCalculator::invalidGeometryGivesZero() {
+    QCOMPARE(StressStrainCalculator::calculateStress(400.0, 0.0), 0.0);
+    QCOMPARE(StressStrainCalculator::calculateStrain(1.0, -5.0), 0.0);
+
+    TestResult result = StressStrainCalculator::calculateResults(TestData::tensileCurve(100), 0.0, 50.0);
+    QVERIFY(!result.isValid());
+}
+
+void TestStressStrainCalculator::emptyDataGivesInvalidResult() {
+    TestResult result = StressStrainCalculator::calculateResults(QVector<SensorData>(), 40.0, 50.0);
+    QVERIFY(!result.isValid());
+    QCOMPARE(result.elasticModulus, 0.0);
+}
+
+void TestStressStrainCalculator::tooFewPointsGivesNoModulus() {
+    QCOMPARE(StressStrainCalculator::calculateElasticModulus(TestData::tensileCurve(9)), 0.0);
+    QCOMPARE(StressStrainCalculator::calculateYieldStress(TestData::tensileCurve(9)), 0.0);
+    QVERIFY(!StressStrainCalculator::findBestFitModulus(TestData::tensileCurve(9)).isValid());
+}
+
+void TestStressStrainCalculator::elasticModulusOfLinearRegion() {
+    // Modulus is reported in MPa
+    double modulus = StressStrainCalculator::calculateElasticModulus(TestData::tensileCurve(2000));
+    QVERIFY2(qAbs(modulus - 3000.0) < 1.0, qPrintable(QString::number(modulus)));
+}
+
+void TestStressStrainCalculator::maxStressAndStrainAtMax() {
+    QVector<SensorData> data = TestData::tensileCurve(2000);
+
+    QVERIFY(qAbs(StressStrainCalculator::findMaxStress(data) - 60.0) < 0.01);
+    QVERIFY(qAbs(StressStrainCalculator::findStrainAtMaxStress(data) - 5.0) < 0.01);
+    QCOMPARE(StressStrainCalculator::findUltimateTensileStrength(data),
+             StressStrainCalculator::findMaxStress(data));
+}
+
+void TestStressStrainCalculator::breakAndElongation() {
+    QVector<SensorData> data = TestData::tensileCurve(800);
+    TestResult result = StressStrainCalculator::calculateResults(data, 40.0, 50.0);
+
+    QCOMPARE(result.breakStress, data.last().stress);
+    QCOMPARE(result.breakStrain, data.last().strain);
+    QVERIFY(qAbs(result.elongationAtBreak - 8.0) < 1e-9);
+}
+
+void TestStressStrainCalculator::yieldBetweenElasticLimitAndMax() {
+    QVector<SensorData> data = TestData::tensileCurve(2000);
+    double yield = StressStrainCalculator::calculateYieldStress(data, 0.2);
+
+    QVERIFY(yield > 0.0);
+    QVERIFY(yield <= StressStrainCalculator::findMaxStress(data));
+}
+
+void TestStressStrainCalculator::resultsMatchIndividualCalculations() {
+    QVector<SensorData> data = TestData::tensileCurve(1000);
+    TestResult result = StressStrainCalculator::calculateResults(data, 40.0, 50.0);
+
+    QVERIFY(result.isValid());
+    QCOMPARE(result.maxStress, StressStrainCalculator::findMaxStress(data));
+    QCOMPARE(result.maxStrain, StressStrainCalculator::findStrainAtMaxStress(data));
+    QCOMPARE(result.elasticModulus, StressStrainCalculator::calculateElasticModulus(data));
+    QCOMPARE(result.yieldStress, StressStrainCalculator::calculateYieldStress(data, 0.2));
+    QCOMPARE(result.ultimateStress, result.maxStress);
+    QCOMPARE(result.ultimateStrain, result.maxStrain);
+}
+
+void TestStressStrainCalculator::bestFitSkipsToeRegion() {
+    QVector<SensorData> data = toeCurve(3000);
+    ModulusFit fit = StressStrainCalculator::findBestFitModulus(data);
+
+    QVERIFY(fit.isValid());
+    QVERIFY2(qAbs(fit.modulus - 3000.0) < 1.0, qPrintable(QString::number(fit.modulus)));
+    QVERIFY(fit.rSquared > 0.9999);
+    QVERIFY(data[fit.startIndex].strain >= 0.1);
+    QVERIFY(data[fit.endIndex].strain <= 0.4);
+    QCOMPARE(fit.endIndex - fit.startIndex + 1, qsizetype(150));
+
+    // The fixed region starts inside the toe and underestimates
+    QVERIFY(StressStrainCalculator::calculateElasticModulus(data) < fit.modulus - 1.0);
+}
+
+void TestStressStrainCalculator::bestFitToleratesNoise() {
+    QVector<SensorData> data = toeCurve(20000, 0.05);
+    ModulusFit fit = StressStrainCalculator::findBestFitModulus(data);
+
+    QVERIFY2(qAbs(fit.modulus - 3000.0) < 30.0, qPrintable(QString::number(fit.modulus)));
+    QVERIFY(fit.rSquared >= StressStrainCalculator::DEFAULT_MIN_R_SQUARED);
+}
+
+void TestStressStrainCalculator::bestFitOfCurveMatchesVector() {
+    QVector<SensorData> data = toeCurve(int(Curve::BLOCK_SIZE) * 2 + 100);
+    CurveBuilder builder;
+    for (const SensorData& point : data) {
+        builder.append(point);
+    }
+
+    ModulusFit fromVector = StressStrainCalculator::findBestFitModulus(data, 200);
+    ModulusFit fromCurve = StressStrainCalculator::findBestFitModulus(builder.snapshot(), 200);
+    QCOMPARE(fromCurve.modulus, fromVector.modulus);
+    QCOMPARE(fromCurve.startIndex, fromVector.startIndex);
+    QCOMPARE(fromCurve.endIndex - fromCurve.startIndex + 1, qsizetype(200));
+}
+
+void TestStressStrainCalculator::resultsUseSelectedModulusMethod() {
+    QVector<SensorData> data = toeCurve(3000);
+    TestResult result = StressStrainCalculator::calculateResults(
+        data, 40.0, 50.0, ModulusMethod::BestFitWindow);
+
+    QCOMPARE(result.elasticModulus, StressStrainCalculator::findBestFitModulus(data).modulus);
+    QCOMPARE(result.elasticModulus,
+             StressStrainCalculator::calculateElasticModulus(data, ModulusMethod::BestFitWindow));
+    QVERIFY(result.elasticModulus != StressStrainCalculator::calculateResults(data, 40.0, 50.0).elasticModulus);
+}
+
+void TestStressStrainCalculator::chordModulusIsSampleRateIndependent() {
+    for (int points : {500, 2000, 100000}) {
+        double modulus = StressStrainCalculator::calculateChordModulus(TestData::tensileCurve(points));
+        QVERIFY2(qAbs(modulus - 3000.0) < 1e-6, qPrintable(QString::number(modulus)));
+    }
+}
+
+void TestStressStrainCalculator::chordModulusNeedsBothStrains() {
+    // First sample at 0.08% strain, past the 0.05% chord start
+    QCOMPARE(StressStrainCalculator::calculateChordModulus(TestData::tensileCurve(100)), 0.0);
+    QCOMPARE(StressStrainCalculator::calculateChordModulus(TestData::tensileCurve(1000), 0.25, 0.05), 0.0);
+}
+
+void TestStressStrainCalculator::yieldPointIsInterpolated() {
+    // 0.2% offset line at 3 GPa meets the hardening segment at
+    // 1.905263% / 51.157895 MPa
+    for (int points : {500, 2000, 100000}) {
+        TestResult result = StressStrainCalculator::calculateResults(
+            TestData::tensileCurve(points), 40.0, 50.0, ModulusMethod::Chord);
+
+        QVERIFY2(qAbs(result.yieldStress - 51.157895) < 1e-5, qPrintable(QString::number(result.yieldStress)));
+        QVERIFY2(qAbs(result.yieldStrain - 1.9052632) < 1e-6, qPrintable(QString::number(result.yieldStrain)));
+    }
+}
+
+QTEST_APPLESS_MAIN(TestStressStrainCalculator)
+#include "tst_stressstraincalculator.moc"